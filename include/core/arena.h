@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Alignment of every allocation (fits Vector4, Matrix and SIMD loads)
+#define ARENA_ALIGNMENT 16
+
+/**
+ * @brief Linear allocator over one fixed block
+ *
+ * Allocating bumps an offset; memory is only given back all at once by
+ * arena_reset. Meant for data that lives for one frame.
+ *
+ * @field used Bytes allocated since the last reset, padding included
+ * @field peak Largest `used` seen since creation
+ * @field failed Allocations refused because the block was full
+ */
+typedef struct Arena {
+    uint8_t* data;
+    size_t capacity;
+    size_t used;
+    size_t peak;
+    int failed;
+} Arena;
+
+/**
+ * @return NULL on allocation failure
+ */
+Arena* arena_create(size_t capacity);
+
+/**
+ * @brief ARENA_ALIGNMENT-aligned block of size bytes
+ *
+ * @return NULL if the arena is full
+ */
+void* arena_alloc(Arena* arena, size_t size);
+
+/**
+ * @brief Frees every allocation at once
+ */
+void arena_reset(Arena* arena);
+
+void arena_destroy(Arena* arena);
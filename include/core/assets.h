@@ -0,0 +1,182 @@
+#pragma once
+
+#include <SDL.h>
+
+#include "core/mesh.h"
+#include "core/cook.h"
+#include "core/spsc.h"
+
+// Longest mesh file path, NUL included
+#define ASSETS_PATH_MAX 256
+
+// Loader wake-up period when it has to poll: no inotify (file times are compared), or a reload held back
+#define ASSETS_POLL_MS 50
+
+/**
+ * @brief A watched mesh file
+ *
+ * @field path File the mesh is loaded from (set once, before the loader sees the asset)
+ * @field mesh Published version, swapped atomically by assets_update (NULL until the first load)
+ * @field version Versions published so far (main thread)
+ * @field in_flight A loaded version waits in Assets.ready: the loader holds further reloads back
+ * @field watch, name, stamp, pending Loader thread only: inotify watch of the directory,
+ *        file name in it, file time and size seen last (polling), a reload is due
+ */
+typedef struct Asset {
+    char path[ASSETS_PATH_MAX];
+    Mesh* mesh;
+    int version;
+    SDL_atomic_t in_flight;
+
+    int watch;
+    const char* name;
+    long long stamp[2];
+    int pending;
+} Asset;
+
+/**
+ * @brief A load finished by the loader thread, waiting for assets_update
+ *
+ * @field mesh New version, NULL if the file could not be loaded
+ * @field load_ms Time to read and import (or read the cooked copy) on the loader thread
+ */
+typedef struct AssetLoad {
+    int handle;
+    Mesh* mesh;
+    double load_ms;
+} AssetLoad;
+
+/**
+ * @brief A replaced version, freed once no frame in flight can still read it
+ *
+ * @field frame Frame whose assets_update published the replacement
+ */
+typedef struct AssetRetired {
+    Mesh* mesh;
+    Uint64 frame;
+} AssetRetired;
+
+/**
+ * @brief Reload counters, updated by assets_update
+ *
+ * @field loads Versions published (first loads included)
+ * @field reloads Versions that replaced an earlier one
+ * @field errors Loads that failed: the previous version stays
+ * @field retired Replaced versions freed
+ * @field total_load_ms, max_load_ms Loader thread time per load
+ * @field last_update_ms, max_update_ms Main thread time in assets_update (swaps and frees)
+ */
+typedef struct AssetsStats {
+    int loads;
+    int reloads;
+    int errors;
+    int retired;
+    double total_load_ms;
+    double max_load_ms;
+    double last_update_ms;
+    double max_update_ms;
+} AssetsStats;
+
+/**
+ * @brief Mesh files loaded and hot-reloaded on a background thread
+ *
+ * The loader thread watches the directory of every mesh file (inotify on
+ * Linux: a file closed after writing, or renamed over, triggers a reload;
+ * elsewhere file times are polled every ASSETS_POLL_MS), imports the file
+ * (cook_load_mesh: parsed and processed, or read from the cooked cache)
+ * and hands the new mesh over through a lock-free ring. The main thread never waits on it: at a frame
+ * boundary, assets_update swaps the finished versions in with an atomic
+ * pointer exchange, and the replaced ones are freed frames_in_flight
+ * frames later, when no frame can still be reading them.
+ *
+ * @field assets Fixed array: the loader reads it while assets are added
+ * @field count Assets added (main thread)
+ * @field published Assets the loader may see, stored after the asset is filled in
+ * @field ready Loader -> main thread ring of AssetLoad, one per asset at most (in_flight)
+ * @field retired Replaced versions not freed yet, capacity * (frames_in_flight + 1) at most
+ * @field cook, cache_dir Processing and cooked cache directory ("" for none) of every load
+ * @field wake Pipe the main thread writes to wake the loader (new asset, quit)
+ * @field notify inotify descriptor, -1 when file times are polled
+ */
+typedef struct Assets {
+    Asset* assets;
+    int count;
+    int capacity;
+    SDL_atomic_t published;
+    int frames_in_flight;
+
+    SpscQueue* ready;
+    AssetRetired* retired;
+    int retired_count;
+    int retired_capacity;
+
+    CookOptions cook;
+    char cache_dir[ASSETS_PATH_MAX];
+
+    SDL_Thread* loader;
+    SDL_atomic_t quit;
+    int wake[2];
+    int notify;
+
+    AssetsStats stats;
+} Assets;
+
+/**
+ * @brief Starts the loader thread
+ *
+ * @param capacity Most mesh files watched
+ * @param frames_in_flight Frames drawn at once: 1 when each frame is finished
+ *                         before the next one starts, COMMAND_FRAMES with a
+ *                         render thread. A replaced version is freed by the
+ *                         assets_update frames_in_flight frames after the swap
+ *
+ * @return NULL on invalid parameters or if the thread cannot be started
+ */
+Assets* assets_create(int capacity, int frames_in_flight);
+
+/**
+ * @brief Sets the processing of the loaded meshes (COOK_DEFAULTS until then) and their cache
+ *
+ * Call before the first assets_add_mesh: the loader reads both freely afterwards.
+ *
+ * @param cache_dir Cooked cache directory, NULL to always import the source
+ *
+ * @return 0 if assets were added already or cache_dir is too long
+ */
+int assets_set_cooking(Assets* assets, CookOptions options, const char* cache_dir);
+
+/**
+ * @brief Watches a mesh file and queues its first load
+ *
+ * Returns at once; assets_mesh stays NULL until an assets_update after
+ * the load has finished.
+ *
+ * @return Handle of the asset, -1 if full or the path is too long
+ */
+int assets_add_mesh(Assets* assets, const char* path);
+
+/**
+ * @brief Frame boundary: publishes the loads finished since the last call
+ *
+ * Main thread only, never blocks. Objects holding a mesh of an asset
+ * rebind to assets_mesh afterwards (scene_set_mesh), before the frame
+ * uses them; the version they held is freed frames_in_flight frames on.
+ *
+ * @param frame Number of the frame about to start, increasing
+ *
+ * @return Versions published by this call
+ */
+int assets_update(Assets* assets, Uint64 frame);
+
+/**
+ * @brief Current version of an asset, NULL before its first load
+ *
+ * The pointer stays valid for the frame that read it and the
+ * frames_in_flight - 1 next ones.
+ */
+const Mesh* assets_mesh(Assets* assets, int handle);
+
+/**
+ * @brief Stops the loader thread and frees every version
+ */
+void assets_destroy(Assets* assets);
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "core/mesh.h"
+#include "core/sort.h"
+
+/**
+ * @brief Two objects whose world boxes overlap, a < b
+ */
+typedef struct BroadphasePair {
+    int a, b;
+} BroadphasePair;
+
+/**
+ * @brief What one broadphase_update cost
+ *
+ * @field swaps Endpoint moves made by the insertion sort
+ * @field tests Box overlap tests made by the sweep
+ * @field rebuilt Endpoints were radix sorted from scratch (first update, new count, new axis or too many swaps)
+ */
+typedef struct BroadphaseStats {
+    long swaps;
+    long tests;
+    int rebuilt;
+} BroadphaseStats;
+
+/**
+ * @brief Start of a box interval on the sweep axis
+ *
+ * @field value Box min along the axis
+ * @field id Object index
+ */
+typedef struct BroadphaseEndpoint {
+    float value;
+    int id;
+} BroadphaseEndpoint;
+
+/**
+ * @brief Sweep-and-prune broadphase over world-space AABBs
+ *
+ * The interval starts (box mins) along one axis, the one where the box
+ * centers vary the most, are kept sorted across frames. Objects move
+ * little between frames, so an insertion sort puts them back in order in
+ * close to linear time; the radix sort of sort.h rebuilds the list when
+ * that assumption breaks. The boxes are then copied in that order into
+ * flat per-axis arrays, and each box is only tested against the boxes
+ * that follow it until one starts past its max on the sweep axis.
+ *
+ * @field count Objects in the last update
+ * @field capacity Objects the buffers are sized for
+ * @field axis Sweep axis (0 = x, 1 = y, 2 = z), -1 before the first update
+ * @field endpoints count interval starts, sorted by value
+ * @field keys, scratch Radix sort buffers
+ * @field min, max Boxes in sorted order, one array per axis: [0] is the sweep axis, [1] and [2] the others
+ * @field pairs Overlapping pairs of the last update, reused across updates
+ */
+typedef struct Broadphase {
+    int count;
+    int capacity;
+    int axis;
+
+    BroadphaseEndpoint* endpoints;
+    SortKey* keys;
+    SortKey* scratch;
+    float* min[3];
+    float* max[3];
+
+    BroadphasePair* pairs;
+    int pair_count;
+    int pair_capacity;
+
+    BroadphaseStats stats;
+} Broadphase;
+
+/**
+ * @return NULL on allocation failure
+ */
+Broadphase* broadphase_create(int capacity);
+
+/**
+ * @brief Grows the buffers to hold count objects without allocating in broadphase_update
+ *
+ * @return 0 on allocation failure
+ */
+int broadphase_reserve(Broadphase* bp, int count);
+
+/**
+ * @brief Finds every pair of overlapping boxes
+ *
+ * Boxes are closed: touching boxes overlap. Object i is boxes[i]; pairs
+ * are written to bp->pairs (bp->pair_count of them) in no particular
+ * order. The pair buffer only grows, so steady frames do not allocate.
+ *
+ * @param boxes World-space AABBs, e.g. from world_bounds. Bounds may be
+ *              infinite (ground planes, sky volumes) but not NaN: a NaN
+ *              bound ends the sweep early and loses pairs
+ *
+ * @return 0 on allocation failure (pairs may be missing)
+ */
+int broadphase_update(Broadphase* bp, const Bounds* boxes, int count);
+
+void broadphase_destroy(Broadphase* bp);
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+#include <SDL.h>
+
+#include "core/framebuffer.h"
+
+// Staging buffer of the writer thread: encoded frames are written in batches of about this size
+#define CAPTURE_BATCH_BYTES (4 << 20)
+
+typedef enum CaptureFormat {
+    CAPTURE_Y4M,    // YUV4MPEG2 stream, 4:4:4 planar, BT.601 studio range
+    CAPTURE_PPM     // Concatenated binary PPM (P6) images
+} CaptureFormat;
+
+/**
+ * @brief What capture_frame does when every ring buffer is still queued
+ */
+typedef enum CapturePolicy {
+    CAPTURE_DROP,   // skip the frame, the frame loop never waits
+    CAPTURE_BLOCK   // wait for the writer thread, no frame is lost
+} CapturePolicy;
+
+/**
+ * @brief Capture counters
+ *
+ * Frame loop side: submitted frames, captured (copied into the ring) and
+ * dropped ones, the time spent copying and the time spent waiting for a
+ * free buffer (BLOCK policy). Writer side: frames written, bytes, write
+ * calls (one per batch) and the time spent encoding and writing.
+ * max_queued is the deepest the ring got.
+ */
+typedef struct CaptureStats {
+    int submitted;
+    int captured;
+    int dropped;
+    int written;
+    int max_queued;
+    int errors;
+
+    double copy_ms;
+    double max_copy_ms;
+    double blocked_ms;
+    double max_blocked_ms;
+
+    double encode_ms;
+    double write_ms;
+    size_t bytes_written;
+    int writes;
+} CaptureStats;
+
+/**
+ * @brief Records rendered frames to disk from a writer thread
+ *
+ * capture_frame only copies the framebuffer into the next free buffer of
+ * a ring allocated at open; the writer thread encodes queued frames into
+ * a staging buffer (the ring buffer is released as soon as it is
+ * encoded) and writes the staging buffer with a single call when the
+ * next frame no longer fits. The stream is unbuffered, so each batch is
+ * one write to the file. Frames are width x height: larger framebuffers
+ * are cropped, smaller ones padded with black.
+ *
+ * Meant for one producer thread (the frame loop).
+ *
+ * @field ring ring_size buffers of width * height ARGB8888 pixels
+ * @field head, count Queued buffers, oldest first; the writer's current one stays counted until encoded
+ * @field staging Encoded frames waiting for the next batch write
+ * @field failed Set by the writer on a write error: later frames are dropped
+ */
+typedef struct Capture {
+    FILE* file;
+    CaptureFormat format;
+    CapturePolicy policy;
+    int width, height;
+
+    uint32_t** ring;
+    int ring_size;
+    int head;
+    int count;
+
+    uint8_t* staging;
+    size_t staging_size;
+    size_t staging_used;
+    size_t frame_bytes;
+
+    SDL_Thread* writer;
+    SDL_mutex* lock;
+    SDL_cond* wake;
+    SDL_cond* space;
+    int quit;
+    int failed;
+
+    CaptureStats stats;
+} Capture;
+
+/**
+ * @brief Bytes of one encoded frame, per-frame headers included
+ */
+size_t capture_frame_bytes(CaptureFormat format, int width, int height);
+
+/**
+ * @brief Encodes ARGB8888 pixels as one frame of the format
+ *
+ * @param pitch Row stride of pixels, in pixels
+ * @param out capture_frame_bytes(format, width, height) bytes
+ *
+ * @return Bytes written to out
+ */
+size_t capture_encode(CaptureFormat format, const uint32_t* pixels, int width, int height, int pitch,
+                      uint8_t* out);
+
+/**
+ * @brief Creates the file, writes the stream header and starts the writer thread
+ *
+ * @param ring_size Frames that can be queued before the policy applies
+ * @param fps Frame rate written in the Y4M header
+ *
+ * @return NULL on invalid parameters, if the file cannot be created or on allocation failure
+ */
+Capture* capture_open(const char* path, CaptureFormat format, int width, int height, int ring_size,
+                      CapturePolicy policy, int fps);
+
+/**
+ * @brief Queues a copy of the visible framebuffer
+ *
+ * @return 1 if the frame was queued, 0 if it was dropped
+ */
+int capture_frame(Capture* capture, const Framebuffer* fb);
+
+/**
+ * @brief Snapshot of the counters, taken under the lock
+ */
+CaptureStats capture_stats(Capture* capture);
+
+/**
+ * @brief Writes every queued frame, stops the writer thread and closes the file
+ *
+ * @param stats Final counters, writer side included (may be NULL)
+ *
+ * @return 0 if a frame could not be written
+ */
+int capture_close(Capture* capture, CaptureStats* stats);
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "core/arena.h"
+#include "core/spsc.h"
+#include "core/scene.h"
+
+// Frames whose payloads can be in flight at once: one arena each
+#define COMMAND_FRAMES 3
+
+typedef enum CommandType {
+    COMMAND_TRANSFORM,      // payload: Transform of object
+    COMMAND_CAMERA,         // payload: Camera
+    COMMAND_MESH_ADD,       // payload: CommandMeshAdd
+    COMMAND_MESH_REMOVE,    // removes object (scene_remove)
+    COMMAND_FRAME_END       // last command of a simulation frame
+} CommandType;
+
+typedef struct CommandMeshAdd {
+    const Mesh* mesh;
+    Color color;
+    Transform transform;
+    int flags;
+} CommandMeshAdd;
+
+/**
+ * @brief One entry of the ring, 16 bytes on 64-bit targets
+ *
+ * @field object Scene index of the target object (transform, remove)
+ * @field payload In the arena of the frame that pushed it, NULL if none
+ */
+typedef struct Command {
+    CommandType type;
+    int object;
+    void* payload;
+} Command;
+
+/**
+ * @brief Counters, each written by one side only
+ *
+ * Simulation side: frames ended, commands pushed, pushes
+ * refused because the ring (ring_full) or the frame arena (arena_full)
+ * was full, and command_begin_frame calls refused because the render
+ * thread still held the arena (stalls).
+ * Render side: commands and frames applied.
+ */
+typedef struct CommandStats {
+    int frames_ended;
+    int pushed;
+    int ring_full;
+    int arena_full;
+    int stalls;
+
+    int applied;
+    int frames_applied;
+} CommandStats;
+
+/**
+ * @brief Per-frame commands from a simulation thread to the render thread
+ *
+ * The simulation thread brackets each frame with command_begin_frame and
+ * command_end_frame and pushes commands in between; payloads are
+ * allocated in that frame's arena, never one by one. The render thread
+ * calls command_drain, which applies whole frames only: commands of a
+ * frame that has not ended stay queued, so a frame (end marker included)
+ * must fit in the ring.
+ *
+ * Arenas are reused round-robin: frame f writes arenas[f % COMMAND_FRAMES]
+ * and may only start once frame f - COMMAND_FRAMES has been applied, so
+ * the render thread never reads a payload that is being overwritten.
+ *
+ * Object indices are the scene's own, as the render thread will see
+ * them: an add takes index count, a remove moves the last object into
+ * the hole.
+ *
+ * @field frame Simulation frame being written (simulation side)
+ * @field ended Frames ended, published by the simulation thread
+ * @field applied Frames applied, published by the render thread
+ * @field drained Private copy of applied (render side)
+ */
+typedef struct CommandQueue {
+    SpscQueue* ring;
+    Arena* arenas[COMMAND_FRAMES];
+
+    int frame;
+    int open;
+    SDL_atomic_t ended;
+
+    int drained;
+    SDL_atomic_t applied;
+
+    CommandStats stats;
+} CommandQueue;
+
+/**
+ * @param capacity Commands the ring holds (rounded up to a power of two)
+ * @param arena_bytes Payload bytes per frame
+ *
+ * @return NULL on invalid parameters or allocation failure
+ */
+CommandQueue* command_queue_create(int capacity, size_t arena_bytes);
+
+/**
+ * @brief Simulation side: starts the next frame and resets its arena
+ *
+ * @return 0 if the render thread is COMMAND_FRAMES frames behind (retry later)
+ */
+int command_begin_frame(CommandQueue* queue);
+
+/**
+ * @brief Simulation side: pushes a command of the current frame
+ *
+ * The command_push_* functions return 0 when no frame is open, or when
+ * the ring or the arena is full (retry later).
+ */
+int command_push_transform(CommandQueue* queue, int object, Transform transform);
+
+int command_push_camera(CommandQueue* queue, Camera camera);
+
+int command_push_mesh_add(CommandQueue* queue, const Mesh* mesh, Color color, Transform transform, int flags);
+
+int command_push_mesh_remove(CommandQueue* queue, int object);
+
+/**
+ * @brief Simulation side: ends the frame, its commands become visible to command_drain
+ *
+ * @return 0 if the ring is full (the frame stays open, retry later)
+ */
+int command_end_frame(CommandQueue* queue);
+
+/**
+ * @brief Render side: applies every complete frame queued so far
+ *
+ * Transforms, adds and removes go to scene, camera changes to camera;
+ * either may be NULL, its commands are then skipped.
+ *
+ * @return Commands applied
+ */
+int command_drain(CommandQueue* queue, Scene* scene, Camera* camera);
+
+void command_queue_destroy(CommandQueue* queue);
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "core/mesh.h"
+
+#define COOK_MAGIC "3DMC"
+
+// Bumped whenever the file layout or a processing pass changes: older cooked files stop matching
+#define COOK_VERSION 1
+
+// Cooked file name: 16 hex digits of the key and this extension
+#define COOK_EXTENSION ".mesh"
+
+// Cooked stream flags
+#define COOK_POSITIONS (1 << 0) // compact Vector3 positions instead of Vector4 vertices
+#define COOK_INDEX16 (1 << 1)   // Triangle16 indices instead of Triangle
+#define COOK_NORMALS (1 << 2)
+#define COOK_UVS (1 << 3)
+
+/**
+ * @brief Processing applied to an imported mesh, in this order
+ *
+ * @field weld_epsilon mesh_weld distance, < 0 to skip welding
+ * @field normals Compute vertex normals
+ * @field compact mesh_compact the result
+ */
+typedef struct CookOptions {
+    float weld_epsilon;
+    int normals;
+    int compact;
+} CookOptions;
+
+// Normals only: what the asset loader always did
+#define COOK_DEFAULTS (CookOptions){-1.0f, 1, 0}
+
+/**
+ * @brief Start of a cooked file
+ *
+ * The header is followed by the vertex stream (positions or vertices),
+ * then the normals and UVs when flagged, then the triangle indices.
+ *
+ * Native byte order and struct layout: a cache belongs to one machine.
+ *
+ * @field key Content key the file was cooked for (cook_key)
+ * @field bounds Object-space AABB, computed while cooking
+ */
+typedef struct CookHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t key;
+    int32_t vertex_count;
+    int32_t triangle_count;
+    uint32_t flags;
+    Bounds bounds;
+} CookHeader;
+
+/**
+ * @brief Cache traffic of cook_load_mesh calls
+ *
+ * @field hits, misses Cooked file used / source imported
+ * @field write_errors Cooked files that could not be written (the mesh is still returned)
+ * @field read_ms Source read and hashed (every call)
+ * @field cache_ms Cooked files looked up and read
+ * @field import_ms Source parsed and processed (misses)
+ * @field write_ms Cooked files written (misses)
+ */
+typedef struct CookStats {
+    int hits;
+    int misses;
+    int write_errors;
+    double read_ms;
+    double cache_ms;
+    double import_ms;
+    double write_ms;
+} CookStats;
+
+/**
+ * @brief Cache key of a source file: hash64 of its bytes, seeded with the options and COOK_VERSION
+ */
+uint64_t cook_key(const void* source, size_t size, const CookOptions* options);
+
+/**
+ * @brief Cooked file of a key: cache_dir/<key as 16 hex digits>.mesh
+ */
+void cook_path(char* path, size_t size, const char* cache_dir, uint64_t key);
+
+/**
+ * @brief Imports a mesh file (OBJ), through the cooked cache when cache_dir is set
+ *
+ * The source is always read and hashed. When the cooked file of its key
+ * exists and is valid, the mesh is read from it as is: no parsing, no
+ * processing. Otherwise the source is parsed and processed, and the result
+ * written to a temporary file renamed over the cooked one, so a reader
+ * never sees a partial file (cache_dir is created if needed).
+ *
+ * @param cache_dir NULL to import without a cache
+ * @param bounds Optional, set to the object-space AABB of the mesh
+ * @param stats Optional, accumulated
+ *
+ * @return NULL if the source cannot be read or parsed, or on allocation failure
+ */
+Mesh* cook_load_mesh(const char* path, const CookOptions* options, const char* cache_dir, Bounds* bounds,
+                     CookStats* stats);
+
+/**
+ * @brief Writes a cooked file atomically (temporary file, then rename)
+ *
+ * @return 0 on a write error (no file left behind)
+ */
+int cook_write(const char* path, const Mesh* mesh, uint64_t key);
+
+/**
+ * @brief Reads a cooked file
+ *
+ * @return NULL if the file is missing, truncated, of another version, cooked for another key or has an
+ *         index past the vertices
+ */
+Mesh* cook_read(const char* path, uint64_t key, Bounds* bounds);
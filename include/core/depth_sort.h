@@ -0,0 +1,84 @@
+#pragma once
+
+#include "core/mesh.h"
+#include "core/jobs.h"
+#include "core/sort.h"
+
+// Triangles per depth key job batch
+#define DEPTH_SORT_BATCH 4096
+
+// Meshes up to this many triangles are insertion sorted (clearing radix histograms would cost more)
+#define DEPTH_SORT_INSERTION_MAX 32
+
+/**
+ * @brief Triangle draw order of depth_sort_mesh
+ *
+ * DEPTH_BACK_TO_FRONT is the painter's algorithm: farthest triangles first,
+ * for targets without a depth test (the SDL backend) and translucent surfaces.
+ * DEPTH_FRONT_TO_BACK lets a depth test reject hidden pixels early.
+ */
+typedef enum DepthOrder {
+    DEPTH_BACK_TO_FRONT,
+    DEPTH_FRONT_TO_BACK
+} DepthOrder;
+
+/**
+ * @brief Per-frame triangle depth sort of a clipped mesh
+ *
+ * Buffers are kept across frames: once they hold the largest mesh, sorting
+ * does not allocate.
+ *
+ * A Draw.triangle_order taken from order is only valid until the next
+ * depth_sort_mesh or depth_sort_reserve on the same DepthSort (the buffer
+ * is overwritten, or moved when it grows): use one DepthSort per Draw and
+ * sort it again every frame its clipped mesh changes, as scene_update does.
+ *
+ * @field order Triangle indices in draw order after depth_sort_mesh (count entries), for Draw.triangle_order
+ */
+typedef struct DepthSort {
+    SortKey* keys;
+    SortKey* scratch;
+    int* order;
+    int count;
+    int capacity;
+} DepthSort;
+
+/**
+ * @brief Sort key of a depth, ascending in the given order
+ *
+ * float_key, inverted for back to front.
+ */
+static inline uint64_t depth_key(float depth, DepthOrder order) {
+    uint32_t bits = float_key(depth);
+    return order == DEPTH_BACK_TO_FRONT ? (uint32_t)~bits : bits;
+}
+
+/**
+ * @return NULL on allocation failure
+ */
+DepthSort* depth_sort_create(int capacity);
+
+/**
+ * @brief Grows the buffers to sort count triangles
+ *
+ * @return 0 on allocation failure (order is then left in place)
+ */
+int depth_sort_reserve(DepthSort* sort, int count);
+
+/**
+ * @brief Orders the triangles of a clipped mesh by depth
+ *
+ * The depth of a triangle is the sum of the clip-space w of its vertices:
+ * w is the view-space distance along the camera axis, so this is its
+ * centroid depth, without a divide. Keys are 32-bit and radix sorted
+ * (radix_sort_parallel, stable: equal depths keep index order), or
+ * insertion sorted up to DEPTH_SORT_INSERTION_MAX triangles. Keys are
+ * computed and sorted across jobs for large meshes; jobs may be NULL.
+ *
+ * @param clipped update_mesh output (clip-space vertices)
+ *
+ * @return sort->order, NULL on allocation failure
+ */
+const int* depth_sort_mesh(DepthSort* sort, const Mesh* clipped, DepthOrder order, JobSystem* jobs);
+
+void depth_sort_destroy(DepthSort* sort);
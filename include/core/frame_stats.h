@@ -0,0 +1,145 @@
+#pragma once
+
+#include <stdio.h>
+#include <SDL.h>
+
+#include "core/scene.h"
+
+// Frames kept for the rolling average and min / max
+#define FRAME_STATS_WINDOW 120
+
+/**
+ * @brief What is measured every frame
+ *
+ * Counts are what the frame submitted: lines are the wireframe edges
+ * handed to a rasterizer (3 per triangle), pixels are the ones the
+ * software rasterizer stored (the SDL backend does not report its own).
+ * Stage times are in milliseconds: update (culling, vertex transform,
+ * queue sort), raster (clears, draws, framebuffer upload) and
+ * present (upscale and SDL_RenderPresent, which waits for vsync).
+ */
+typedef enum FrameMetric {
+    FRAME_VERTICES,         // vertices transformed
+    FRAME_TRIANGLES,        // triangles submitted to a rasterizer
+    FRAME_LINES,
+    FRAME_PIXELS,
+    FRAME_DRAWS,
+    FRAME_CULLED,           // objects rejected before any vertex work
+    FRAME_ALLOCATIONS,      // heap allocations made by the frame thread
+    FRAME_UPDATE_MS,
+    FRAME_RASTER_MS,
+    FRAME_PRESENT_MS,
+    FRAME_TOTAL_MS,
+    FRAME_METRICS
+} FrameMetric;
+
+/**
+ * @brief Average, min and max of one metric over the window
+ */
+typedef struct FrameSummary {
+    double avg;
+    double min;
+    double max;
+} FrameSummary;
+
+/**
+ * @brief Per-frame pipeline counters with a rolling window
+ *
+ * A frame is collected between frame_stats_begin and frame_stats_end:
+ * counts are added with frame_stats_add, stage times are closed with
+ * frame_stats_stage. frame_stats_end moves the frame into last and into
+ * the window, and appends it to the CSV sink if one is set. Nothing
+ * allocates after creation.
+ *
+ * @field current Frame being collected
+ * @field last Last completed frame
+ * @field history Ring of the last `window` frames (window * FRAME_METRICS values)
+ * @field samples Frames in the ring (up to window)
+ * @field frames Frames completed since creation
+ * @field csv Log sink, one row per frame (NULL if unused, not owned)
+ */
+typedef struct EngineFrameStats {
+    double current[FRAME_METRICS];
+    double last[FRAME_METRICS];
+
+    double* history;
+    int window;
+    int samples;
+    int head;
+    long frames;
+
+    Uint64 frame_start;
+    Uint64 stage_start;
+
+    FILE* csv;
+} EngineFrameStats;
+
+/**
+ * @param window Frames in the rolling window (FRAME_STATS_WINDOW if <= 0)
+ * @return NULL on allocation failure
+ */
+EngineFrameStats* frame_stats_create(int window);
+
+/**
+ * @brief Resizes the rolling window, which starts over empty
+ *
+ * @return 0 on allocation failure (the previous window is kept)
+ */
+int frame_stats_set_window(EngineFrameStats* stats, int window);
+
+/**
+ * @brief Logs every following frame to csv (NULL stops logging)
+ *
+ * A header row with the metric names is written first. The file is
+ * neither flushed nor closed by the stats.
+ */
+void frame_stats_set_csv(EngineFrameStats* stats, FILE* csv);
+
+/**
+ * @brief Starts a frame: zeroes the current counters and the stage clock
+ */
+void frame_stats_begin(EngineFrameStats* stats);
+
+static inline void frame_stats_add(EngineFrameStats* stats, FrameMetric metric, double value) {
+    stats->current[metric] += value;
+}
+
+/**
+ * @brief Counts one submitted draw: its vertices, triangles, wireframe lines and the draw call
+ *
+ * @param vertices Vertices transformed for it (those of the source mesh)
+ */
+void frame_stats_add_draw(EngineFrameStats* stats, const Draw* draw, int vertices);
+
+/**
+ * @brief Counts the visible objects of an updated scene as draws, and the others as culled
+ */
+void frame_stats_add_scene(EngineFrameStats* stats, const Scene* scene);
+
+/**
+ * @brief Counts what the frame thread did outside the draws: pixels stored and heap allocations
+ *
+ * Called once, between the last stage and frame_stats_end.
+ */
+void frame_stats_add_frame(EngineFrameStats* stats, size_t pixels_drawn);
+
+/**
+ * @brief Adds the time since the previous stage (or the frame begin) to a stage metric
+ *
+ * @return Milliseconds of that stage
+ */
+double frame_stats_stage(EngineFrameStats* stats, FrameMetric metric);
+
+/**
+ * @brief Ends the frame: sets FRAME_TOTAL_MS, updates last, the window and the CSV sink
+ */
+void frame_stats_end(EngineFrameStats* stats);
+
+/**
+ * @brief Rolling average, min and max over the frames in the window (zeros if none)
+ */
+FrameSummary frame_stats_summary(const EngineFrameStats* stats, FrameMetric metric);
+
+const char* frame_metric_name(FrameMetric metric);
+
+void frame_stats_destroy(EngineFrameStats* stats);
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "core/texture.h"
+
+// Tile edge in pixels (power of two): a tile is 8 x 8 pixels stored contiguously
+#define FRAMEBUFFER_TILE_SHIFT 3
+#define FRAMEBUFFER_TILE (1 << FRAMEBUFFER_TILE_SHIFT)
+#define FRAMEBUFFER_TILE_PIXELS (FRAMEBUFFER_TILE * FRAMEBUFFER_TILE)
+
+// Per-tile state: the tile holds drawn (or cleared) values instead of the pending clear
+#define FRAMEBUFFER_TILE_COLOR 1
+#define FRAMEBUFFER_TILE_DEPTH 2
+
+/**
+ * @brief Rectangle of the framebuffer, in pixels
+ */
+typedef struct Viewport {
+    int x, y, width, height;
+} Viewport;
+
+/**
+ * @brief Engine-owned CPU color and depth buffers
+ *
+ * Rasterizers write 32-bit ARGB8888 colors and float depths into 8x8
+ * tiles, each tile 64 contiguous values in row-major order, tiles
+ * themselves row-major. Clears are lazy: they only reset the per-tile
+ * flags, and a tile is filled with the clear value the first time a
+ * rasterizer touches it. Tiles never touched since the clear cost no
+ * bandwidth at all until the resolve, which writes them as the clear
+ * color.
+ *
+ * framebuffer_resolve converts the tiles to the linear layout of an SDL
+ * streaming texture created with SDL_PIXELFORMAT_ARGB8888: rows padded so
+ * that every row starts on a 16-byte boundary.
+ *
+ * @field pixels Linear resolve target (pitch * height entries), only valid after framebuffer_resolve
+ * @field color Tiled colors (tiles_x * tiles_y * FRAMEBUFFER_TILE_PIXELS entries)
+ * @field depth Tiled depths in [0, 1] (same layout), 1 = far plane
+ * @field tile_flags FRAMEBUFFER_TILE_COLOR / FRAMEBUFFER_TILE_DEPTH per tile
+ * @field clear_color Color of the tiles whose FRAMEBUFFER_TILE_COLOR flag is not set
+ * @field width Visible width in pixels
+ * @field height Visible height in pixels
+ * @field pitch Row stride of pixels (>= width, multiple of 4)
+ * @field max_width, max_height Allocated size, the visible size can shrink within it
+ * @field tiles_x, tiles_y Tile grid covering the allocated size
+ * @field viewport Rectangle the rasterizers clip to and draw_mesh_software maps clip space onto
+ * @field pixels_drawn Pixels stored by the line and triangle rasterizers (running count, reset by the caller)
+ * @field tiles_filled Color and depth tiles filled with their clear value (running count)
+ */
+typedef struct Framebuffer {
+    uint32_t* pixels;
+    uint32_t* color;
+    float* depth;
+    uint8_t* tile_flags;
+    uint32_t clear_color;
+    int width;
+    int height;
+    int pitch;
+    int max_width;
+    int max_height;
+    int tiles_x;
+    int tiles_y;
+    Viewport viewport;
+    size_t pixels_drawn;
+    size_t tiles_filled;
+} Framebuffer;
+
+Framebuffer* framebuffer_create(int width, int height);
+
+/**
+ * @brief Changes the visible size without reallocating
+ *
+ * The size is clamped to [1, max_width] x [1, max_height]; the pitch is
+ * kept, so rendering at a lower resolution uses the top-left corner of
+ * the allocation. The viewport is reset to the whole visible size.
+ */
+void framebuffer_resize(Framebuffer* fb, int width, int height);
+
+/**
+ * @brief Restricts drawing to a rectangle of the visible size
+ *
+ * Lines and triangles are clipped to the viewport, so several views can
+ * share one framebuffer (and one clear) without drawing over each other.
+ * The rectangle is clamped to the visible size.
+ */
+void framebuffer_set_viewport(Framebuffer* fb, Viewport viewport);
+
+/**
+ * @brief Clears the whole buffer to a single color
+ *
+ * Only marks every tile as cleared: the color is stored when a tile is
+ * first drawn to, or by the resolve.
+ */
+void framebuffer_clear(Framebuffer* fb, uint32_t color);
+
+/**
+ * @brief Resets the depth buffer to the far plane (1.0), lazily like framebuffer_clear
+ */
+void framebuffer_clear_depth(Framebuffer* fb);
+
+/**
+ * @brief Converts the visible tiles into pixels
+ */
+void framebuffer_resolve(Framebuffer* fb);
+
+/**
+ * @brief Converts the top-left width x height pixels into a linear buffer
+ *
+ * Drawn tiles are copied with 128-bit loads and stores (SSE2 / NEON) when
+ * available, cleared ones are filled with the clear color. The size is
+ * clamped to the visible size.
+ *
+ * @param dst Destination, e.g. a locked streaming texture
+ * @param dst_pitch Row stride of dst in pixels
+ */
+void framebuffer_resolve_to(const Framebuffer* fb, uint32_t* dst, int dst_pitch, int width, int height);
+
+/**
+ * @brief Draws a line between two pixel positions, endpoints included
+ *
+ * The segment is first clipped against the viewport with Cohen–Sutherland,
+ * then rasterized with an integer Bresenham walk. Pixels produced are the
+ * same as SDL_RenderDrawLine for segments that lie inside the viewport.
+ */
+void framebuffer_draw_line(Framebuffer* fb, int x0, int y0, int x1, int y1, uint32_t color);
+
+/**
+ * @brief Fills a depth-tested rectangle of constant depth and color
+ *
+ * Covers pixels [x0, x1) x [y0, y1), clipped to the viewport: a 1 x 1
+ * rectangle is a point. Used for particles.
+ *
+ * @param z Depth in [0, 1]
+ */
+void framebuffer_fill_rect(Framebuffer* fb, int x0, int y0, int x1, int y1, float z, uint32_t color);
+
+/**
+ * @brief Fills a depth-tested triangle with interpolated vertex colors
+ *
+ * Pixels whose center is inside the triangle (either winding) and whose
+ * interpolated depth is nearer than the depth buffer are written.
+ * Colors are interpolated linearly in screen space (Gouraud); three equal
+ * colors take a flat fast path.
+ *
+ * @param x, y Screen-space vertex positions in pixels
+ * @param z Depth of each vertex in [0, 1]
+ * @param color ARGB8888 color of each vertex
+ */
+void framebuffer_fill_triangle(Framebuffer* fb, const float x[3], const float y[3], const float z[3],
+                               const uint32_t color[3]);
+
+/**
+ * @brief Fills a depth-tested, perspective-correct textured triangle
+ *
+ * u/w, v/w and 1/w are interpolated linearly in screen space and divided
+ * per pixel. Covered pixels are sampled 4 at a time; the mip level of each
+ * group of 4 comes from the analytic UV derivatives at its first pixel.
+ *
+ * @param x, y Screen-space vertex positions in pixels
+ * @param z Depth of each vertex in [0, 1]
+ * @param inv_w 1 / w of each vertex (clip-space w)
+ * @param u, v Texture coordinates of each vertex
+ */
+void framebuffer_fill_triangle_textured(Framebuffer* fb, const float x[3], const float y[3], const float z[3],
+                                        const float inv_w[3], const float u[3], const float v[3],
+                                        const Texture* tex, TextureFilter filter);
+
+void framebuffer_destroy(Framebuffer* fb);
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief 64-bit XXH64 hash of a byte range
+ *
+ * Same values as the reference xxHash implementation (little-endian
+ * hosts). Processes 32 bytes per step in four independent lanes, several
+ * GB/s: cheap enough to key caches on whole file contents.
+ *
+ * @param seed Chains hashes: hash64(b, n, hash64(a, m, 0)) keys a and b together
+ */
+uint64_t hash64(const void* data, size_t size, uint64_t seed);
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <SDL.h>
+
+/**
+ * @brief Work function of a parallel loop, processes indices [start, end)
+ */
+typedef void (*JobFunction)(void* ctx, int start, int end);
+
+/**
+ * @brief Fixed pool of SDL worker threads running parallel loops
+ *
+ * The calling thread takes part in every loop, so a pool with 0 workers
+ * simply runs the loop inline.
+ *
+ * @field threads Worker threads
+ * @field thread_count Number of workers (not counting the caller)
+ * @field lock Protects the task fields and the counters below
+ * @field wake Signaled when a new task is published (or on shutdown)
+ * @field done Signaled when the last worker leaves the current task
+ * @field next Next unclaimed index of the current task
+ */
+typedef struct JobSystem {
+    SDL_Thread** threads;
+    int thread_count;
+
+    SDL_mutex* lock;
+    SDL_cond* wake;
+    SDL_cond* done;
+
+    JobFunction fn;
+    void* ctx;
+    int count;
+    int batch;
+    SDL_atomic_t next;
+
+    int generation;
+    int active;
+    int quit;
+} JobSystem;
+
+/**
+ * @brief Starts the worker threads
+ *
+ * @param thread_count Number of workers, negative for one per extra CPU core
+ *
+ * @return The pool, NULL on failure
+ */
+JobSystem* jobs_create(int thread_count);
+
+/**
+ * @brief Runs fn over [0, count) split in batches, returns when all are done
+ *
+ * Batches are at least min_batch indices long. A NULL pool, or a loop
+ * smaller than one batch, runs inline on the caller. Not reentrant: only
+ * one thread may issue loops on a given pool at a time.
+ */
+void jobs_parallel_for(JobSystem* jobs, int count, int min_batch, JobFunction fn, void* ctx);
+
+void jobs_destroy(JobSystem* jobs);
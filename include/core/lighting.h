@@ -0,0 +1,72 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "math/vector.h"
+
+#define LIGHTING_MAX_LIGHTS 8
+
+typedef enum LightType {
+    LIGHT_DIRECTIONAL,
+    LIGHT_POINT
+} LightType;
+
+/**
+ * @brief A world-space light
+ *
+ * @field type LIGHT_DIRECTIONAL or LIGHT_POINT
+ * @field direction Direction the light travels (directional lights)
+ * @field position Light position (point lights)
+ * @field color Linear RGB intensity, 1 is full brightness
+ * @field range Distance at which a point light has faded to 0 (linear falloff)
+ */
+typedef struct Light {
+    LightType type;
+    Vector3 direction;
+    Vector3 position;
+    Vector3 color;
+    float range;
+} Light;
+
+/**
+ * @brief Lights applied to the lit draws of a frame
+ *
+ * Intensity at a vertex is ambient + sum over lights of
+ * color * max(0, N.L) * attenuation, clamped to [0, 1] per channel.
+ *
+ * @field ambient Constant RGB term
+ * @field lights Active lights
+ * @field count Number of active lights
+ */
+typedef struct Lighting {
+    Vector3 ambient;
+    Light lights[LIGHTING_MAX_LIGHTS];
+    int count;
+} Lighting;
+
+/**
+ * @brief Adds a light
+ *
+ * @return Index of the light, -1 if LIGHTING_MAX_LIGHTS are already used
+ */
+int lighting_add(Lighting* lighting, Light light);
+
+/**
+ * @brief Light intensity at a point, scalar reference
+ *
+ * @param position World-space position
+ * @param normal World-space unit normal
+ *
+ * @return Clamped RGB intensity
+ */
+Vector3 lighting_evaluate(const Lighting* lighting, Vector3 position, Vector3 normal);
+
+/**
+ * @brief Modulates an ARGB color by an RGB intensity (alpha is kept)
+ */
+static inline uint32_t lighting_shade_argb(uint32_t base, Vector3 intensity) {
+    uint32_t r = (uint32_t)(((base >> 16) & 0xFF) * intensity.x + 0.5f);
+    uint32_t g = (uint32_t)(((base >> 8) & 0xFF) * intensity.y + 0.5f);
+    uint32_t b = (uint32_t)((base & 0xFF) * intensity.z + 0.5f);
+    return (base & 0xFF000000u) | (r << 16) | (g << 8) | b;
+}
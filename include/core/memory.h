@@ -0,0 +1,93 @@
+#pragma once
+
+#include <stddef.h>
+
+/**
+ * @brief Subsystem an allocation is counted against
+ */
+typedef enum MemoryTag {
+    MEMORY_ENGINE,
+    MEMORY_MESH,
+    MEMORY_SCENE,       // scenes, occlusion culling and broadphase
+    MEMORY_RENDER,      // framebuffer, render queue
+    MEMORY_TEXTURE,
+    MEMORY_TERRAIN,
+    MEMORY_SURFACE,
+    MEMORY_SKINNING,
+    MEMORY_PARTICLES,
+    MEMORY_ASSETS,      // asset tables (loaded meshes count as mesh)
+    MEMORY_THREADS,     // job system, SPSC rings, command queues
+    MEMORY_ARENA,       // arena blocks (not the allocations made in them)
+    MEMORY_CAPTURE,
+    MEMORY_REPLAY,
+    MEMORY_TAGS
+} MemoryTag;
+
+/**
+ * @brief Heap traffic of one subsystem
+ *
+ * @field bytes Bytes requested by allocations (reallocations count their new size)
+ * @field allocations malloc, calloc, realloc and aligned_alloc calls
+ * @field frees free calls on non-NULL pointers
+ */
+typedef struct MemoryCounters {
+    size_t bytes;
+    int allocations;
+    int frees;
+} MemoryCounters;
+
+/**
+ * @brief Counters since start-up, and for the frame in progress or last ended
+ *
+ * Frame counters only see the thread that called memory_frame_begin:
+ * workers allocating on their own schedule (terrain I/O, capture writer,
+ * simulation thread) are counted in total only.
+ */
+typedef struct MemoryStats {
+    MemoryCounters total[MEMORY_TAGS];
+    MemoryCounters frame[MEMORY_TAGS];
+} MemoryStats;
+
+/**
+ * @brief Engine allocator: the C allocator, counted per subsystem
+ *
+ * Every engine allocation goes through these, so a frame that touches the
+ * heap shows up in memory_stats. Pointers are plain heap pointers:
+ * memory_free and free are interchangeable.
+ */
+void* memory_alloc(MemoryTag tag, size_t size);
+
+void* memory_calloc(MemoryTag tag, size_t count, size_t size);
+
+void* memory_realloc(MemoryTag tag, void* ptr, size_t size);
+
+/**
+ * @param size Rounded up to a multiple of alignment (C11 aligned_alloc requirement)
+ */
+void* memory_aligned_alloc(MemoryTag tag, size_t alignment, size_t size);
+
+void memory_free(MemoryTag tag, void* ptr);
+
+/**
+ * @brief Starts counting the frame of the calling thread
+ */
+void memory_frame_begin(void);
+
+void memory_frame_end(void);
+
+/**
+ * @brief Debug mode: any allocation between frame begin and end aborts
+ *
+ * The offending subsystem and size are printed to stderr first. Also
+ * enabled from start-up by building with -DMEMORY_STRICT.
+ */
+void memory_set_strict(int strict);
+
+MemoryStats memory_stats(void);
+
+/**
+ * @brief Sum of counters over every subsystem
+ */
+MemoryCounters memory_sum(const MemoryCounters counters[MEMORY_TAGS]);
+
+const char* memory_tag_name(MemoryTag tag);
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <stdlib.h>
+#include <stdint.h>
 
 #include "math/vector.h"
+#include "core/jobs.h"
 
 /**
  * @brief A triplet of vertices index
@@ -15,25 +17,203 @@ typedef struct Triangle {
     int vert[3];
 } Triangle;
 
+/**
+ * @brief Triangle of a mesh with at most MESH_INDEX16_MAX_VERTICES vertices
+ */
+typedef struct Triangle16 {
+    uint16_t vert[3];
+} Triangle16;
+
+// Largest vertex count addressable by Triangle16
+#define MESH_INDEX16_MAX_VERTICES 65536
+
+// Triangles widened at a time by mesh_triangle_batch
+#define MESH_TRIANGLE_BATCH 256
+
+/**
+ * @brief Texture coordinates of a vertex
+ *
+ * (0, 0) is the top-left texel, (1, 1) the bottom-right corner; values
+ * outside [0, 1] repeat the texture.
+ */
+typedef struct TexCoord {
+    float u, v;
+} TexCoord;
+
 /**
  * @brief Mesh representation
  * 
  * array of vertices and array of triangles
  *
+ * Positions and indices each come in two formats, exactly one of each
+ * pair being set: vertices or positions, triangles or triangles16.
+ * mesh_generate builds the full formats, mesh_compact switches to the
+ * compact ones. Clip-space meshes (update_mesh output) always use vertices.
+ *
  * @field vertices Array of Vector4
+ * @field positions Compact positions, w = 1 implied (12 instead of 16 bytes)
+ * @field normals Unit vertex normals (w = 0), NULL until mesh_compute_normals
+ * @field uvs Texture coordinates per vertex, NULL until mesh_set_uvs
  * @field triangles Array of Triangles
+ * @field triangles16 16-bit indices (6 instead of 12 bytes per triangle)
+ * @field shared Indices and UVs belong to another mesh (mesh_create_clipped), mesh_destroy leaves them
  */
 typedef struct {
     Vector4* vertices;
+    Vector3* positions;
+    Vector4* normals;
+    TexCoord* uvs;
     int vertex_count;
 
     Triangle* triangles;
+    Triangle16* triangles16;
     int triangle_count;
+
+    int shared;
 } Mesh;
 
+/**
+ * @brief Axis-aligned bounding box
+ *
+ * @field min Smallest x, y, z over the vertices
+ * @field max Largest x, y, z over the vertices
+ */
+typedef struct Bounds {
+    Vector3 min, max;
+} Bounds;
+
+/**
+ * @brief What mesh_weld removed
+ *
+ * @field vertices_before, vertices_after Vertex count around the pass
+ * @field triangles_before, triangles_after Triangle count around the pass
+ * @field degenerate Triangles dropped because they had zero area
+ * @field duplicates Triangles dropped because an identical one (same winding) came first
+ */
+typedef struct MeshWeldStats {
+    int vertices_before, vertices_after;
+    int triangles_before, triangles_after;
+    int degenerate;
+    int duplicates;
+} MeshWeldStats;
+
+/**
+ * @brief Position of vertex i, whatever the format (w ignored)
+ */
+static inline Vector3 mesh_position(const Mesh* mesh, int i) {
+    if (mesh->positions) return mesh->positions[i];
+    return (Vector3){mesh->vertices[i].x, mesh->vertices[i].y, mesh->vertices[i].z};
+}
+
+/**
+ * @brief Triangle t, whatever the index format
+ */
+static inline Triangle mesh_triangle(const Mesh* mesh, int t) {
+    if (mesh->triangles) return mesh->triangles[t];
+    const uint16_t* v = mesh->triangles16[t].vert;
+    return (Triangle){{v[0], v[1], v[2]}};
+}
+
+/**
+ * @brief Triangles [start, start + count) as int indices
+ *
+ * Points straight into 32-bit index buffers; 16-bit ones are widened into
+ * scratch. Loops fetch a batch at a time, so the format is checked once
+ * per batch rather than per triangle.
+ *
+ * @param count At most MESH_TRIANGLE_BATCH
+ * @param scratch MESH_TRIANGLE_BATCH triangles
+ */
+static inline const Triangle* mesh_triangle_batch(const Mesh* mesh, int start, int count, Triangle* scratch) {
+    if (mesh->triangles) return mesh->triangles + start;
+
+    const Triangle16* src = mesh->triangles16 + start;
+    for (int t = 0; t < count; t++) {
+        scratch[t].vert[0] = src[t].vert[0];
+        scratch[t].vert[1] = src[t].vert[1];
+        scratch[t].vert[2] = src[t].vert[2];
+    }
+    return scratch;
+}
+
 Mesh* mesh_generate(const Vector4* vertices, int vertex_count,
                    const Triangle* triangles, int triangle_count);
 
+/**
+ * @brief Copies a mesh, keeping its formats
+ */
 Mesh* mesh_copy(const Mesh* src);
 
+/**
+ * @brief Output mesh for update_mesh: Vector4 vertices, src's indices and UVs
+ *
+ * Only the vertices are allocated (zeroed, i.e. w = 0: nothing is drawn
+ * before the first update_mesh); a compact source still gets Vector4
+ * vertices, since clip-space w is not implied. Indices and UVs are
+ * borrowed from src, which must outlive the clipped mesh and keep its
+ * buffers (no mesh_compact or mesh_weld on it afterwards).
+ */
+Mesh* mesh_create_clipped(const Mesh* src);
+
+/**
+ * @brief Switches a mesh to the compact formats, in place
+ *
+ * Positions become Vector3 (w must be 1), and indices become 16-bit when
+ * vertex_count <= MESH_INDEX16_MAX_VERTICES. Compact a mesh once it is
+ * final: mesh_weld only takes full-format meshes.
+ *
+ * @return 1 on success, 0 on allocation failure (mesh left unchanged)
+ */
+int mesh_compact(Mesh* mesh);
+
+/**
+ * @brief Bytes held by the position and index streams
+ */
+size_t mesh_geometry_bytes(const Mesh* mesh);
+
+/**
+ * @brief Computes the object-space AABB of a mesh
+ *
+ * @return Bounds of all vertices (w ignored), zero box for an empty mesh
+ */
+Bounds mesh_bounds(const Mesh* mesh);
+
+/**
+ * @brief Computes area-weighted vertex normals
+ *
+ * Each vertex normal is the normalized sum of the (unnormalized, hence
+ * area-weighted) face normals of the triangles using it. Face normals and
+ * the per-vertex sums are split across the job system; jobs may be NULL.
+ * Vertices used by no triangle get a zero normal.
+ *
+ * @return 1 on success, 0 on allocation failure (mesh left unchanged)
+ */
+int mesh_compute_normals(Mesh* mesh, JobSystem* jobs);
+
+/**
+ * @brief Sets (copies) one texture coordinate per vertex
+ *
+ * @return 1 on success, 0 on allocation failure (mesh left unchanged)
+ */
+int mesh_set_uvs(Mesh* mesh, const TexCoord* uvs);
+
+/**
+ * @brief Merges close vertices and drops degenerate and duplicate triangles
+ *
+ * Vertices whose positions are within epsilon of each other (and, when the
+ * mesh has UVs, whose UVs are too) become one vertex, found through a
+ * spatial hash grid with 2 * epsilon cells: O(n) expected. Each vertex
+ * joins the first earlier vertex within reach, so the result keeps the
+ * original vertex order. Hashing and the neighbour search are split
+ * across the job system; jobs may be NULL. Triangles are remapped, then
+ * those with zero area or repeating an earlier triangle are removed.
+ * Normals, if present, are recomputed.
+ *
+ * @param epsilon Welding distance, 0 for exact matches only
+ * @param stats Optional, filled with the reduction
+ *
+ * @return 1 on success, 0 on allocation failure or a compact mesh (mesh left unchanged)
+ */
+int mesh_weld(Mesh* mesh, float epsilon, JobSystem* jobs, MeshWeldStats* stats);
+
 void mesh_destroy(Mesh* mesh);
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "core/mesh.h"
+
+/**
+ * @brief Parses Wavefront OBJ text into a mesh
+ *
+ * Only geometry is read: `v` positions (w = 1) and `f` faces. Face
+ * corners may be written v, v/vt, v//vn or v/vt/vn, only the position
+ * index is used; negative indices count back from the last position.
+ * Polygons are split into a fan of triangles around their first corner.
+ * Every other statement (vt, vn, o, g, s, usemtl, comments) is skipped.
+ *
+ * @param text NUL-terminated file contents
+ *
+ * @return Full-format mesh, NULL on a syntax error, an index out of range,
+ *         no triangle, or allocation failure
+ */
+Mesh* obj_parse(const char* text);
+
+/**
+ * @brief Reads and parses an OBJ file (obj_parse)
+ *
+ * @return NULL if the file cannot be read or is not a valid mesh
+ */
+Mesh* obj_load(const char* path);
+
+/**
+ * @brief Writes the positions and triangles of a full-format mesh as OBJ
+ *
+ * @return 0 on a compact mesh or a write error
+ */
+int obj_save(const char* path, const Mesh* mesh);
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "math/matrix.h"
+#include "core/mesh.h"
+
+#define OCCLUSION_MAX_LEVELS 16
+
+/**
+ * @brief Per-frame culling counters
+ *
+ * @field tested Objects tested against the pyramid
+ * @field occluders Objects rasterized into the depth buffer
+ * @field frustum_culled Objects whose bounds are entirely off-screen
+ * @field occluded Objects hidden behind the occluders
+ * @field vertices_skipped Vertices of culled objects (transform work saved)
+ */
+typedef struct OcclusionStats {
+    int tested;
+    int occluders;
+    int frustum_culled;
+    int occluded;
+    long vertices_skipped;
+} OcclusionStats;
+
+/**
+ * @brief Low-resolution software depth buffer with a min/max pyramid
+ *
+ * A few large occluders are rasterized into level 0, then every level
+ * stores the min and max depth ([0, 1], 1 = far plane) of its 2x2 children.
+ * Objects are tested with their screen rectangle and nearest depth.
+ *
+ * @field width Level 0 width in texels
+ * @field height Level 0 height in texels
+ * @field levels Number of pyramid levels (last one is 1x1)
+ * @field max_occluders How many objects to pick when none is flagged
+ * @field min_depth Nearest occluder depth per texel, per level
+ * @field max_depth Farthest occluder depth per texel, per level
+ * @field clip Scratch storage for clip-space occluder vertices (occlusion_reserve)
+ * @field stats Counters of the current frame
+ */
+typedef struct OcclusionCuller {
+    int width, height;
+    int levels;
+    int max_occluders;
+
+    float* min_depth[OCCLUSION_MAX_LEVELS];
+    float* max_depth[OCCLUSION_MAX_LEVELS];
+
+    Vector4* clip;
+    int clip_capacity;
+
+    OcclusionStats stats;
+} OcclusionCuller;
+
+OcclusionCuller* occlusion_create(int width, int height, int max_occluders);
+
+/**
+ * @brief Grows the occluder clip buffer to max_vertices, so that frames do not allocate
+ *
+ * @return 0 on allocation failure
+ */
+int occlusion_reserve(OcclusionCuller* culler, int max_vertices);
+
+/**
+ * @brief Resets the depth buffer to the far plane and clears the stats
+ */
+void occlusion_begin(OcclusionCuller* culler);
+
+/**
+ * @brief Rasterizes the triangles of an occluder into level 0
+ *
+ * Never allocates: an occluder with more vertices than occlusion_reserve
+ * made room for is skipped (occluders only save work, culling stays correct).
+ *
+ * @param mvp Model-view-projection matrix of the occluder
+ */
+void occlusion_add_occluder(OcclusionCuller* culler, const Mesh* mesh, const Matrix* mvp);
+
+/**
+ * @brief Builds the min/max pyramid from level 0
+ *
+ * Must be called after the last occlusion_add_occluder of the frame.
+ */
+void occlusion_build_pyramid(OcclusionCuller* culler);
+
+/**
+ * @brief Tests an object-space box against the pyramid
+ *
+ * Updates the stats (tested / frustum_culled / occluded).
+ *
+ * @param bounds Object-space AABB
+ * @param mvp Model-view-projection matrix of the object
+ * @return 1 if the object may be visible, 0 if it can be skipped
+ */
+int occlusion_test(OcclusionCuller* culler, Bounds bounds, const Matrix* mvp);
+
+void occlusion_destroy(OcclusionCuller* culler);
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "core/pipeline.h"
+#include "core/framebuffer.h"
+#include "core/jobs.h"
+
+// Particles per chunk of an update: chunks are integrated and compacted independently
+#define PARTICLE_CHUNK 16384
+
+/**
+ * @brief Particle attributes, structure of arrays
+ *
+ * Every stream is 16-byte aligned and holds capacity entries (rounded up
+ * to a multiple of 4), so the update reads and writes 4 particles per
+ * SIMD register.
+ *
+ * @field x, y, z World-space positions
+ * @field vx, vy, vz Velocities in units per second
+ * @field life Seconds left to live, the particle dies when it reaches 0
+ * @field color ARGB8888 color
+ */
+typedef struct ParticleStreams {
+    float* x;
+    float* y;
+    float* z;
+    float* vx;
+    float* vy;
+    float* vz;
+    float* life;
+    uint32_t* color;
+} ParticleStreams;
+
+/**
+ * @brief Fixed pool of point particles (sparks, debris, dust)
+ *
+ * The particle range is split in PARTICLE_CHUNK chunks, integrated and
+ * aged in parallel. Each chunk packs its survivors, in order, at its own
+ * start with a branch-free stream compaction (every particle is stored at
+ * the survivor count, which only advances for survivors). The holes left
+ * below the new count are then filled with the survivors of the last
+ * chunks, so only as many particles move as died.
+ *
+ * @field count Live particles, the first count entries of live
+ * @field capacity Particles the pool holds
+ * @field live Particle streams
+ * @field chunk_alive Survivors of each chunk in the last update
+ */
+typedef struct ParticleSystem {
+    int count;
+    int capacity;
+    ParticleStreams live;
+    int* chunk_alive;
+} ParticleSystem;
+
+/**
+ * @return NULL on allocation failure
+ */
+ParticleSystem* particles_create(int capacity);
+
+/**
+ * @brief Adds a particle
+ *
+ * @param life Seconds to live, > 0
+ *
+ * @return 0 if the pool is full
+ */
+int particles_spawn(ParticleSystem* ps, Vector3 position, Vector3 velocity, float life, uint32_t color);
+
+/**
+ * @brief Integration and compaction, scalar reference
+ *
+ * Semi-implicit Euler: v += gravity * dt, then p += v * dt, life -= dt.
+ * Particles whose life drops to 0 or below are removed. Survivors keep
+ * their order within a chunk; the last ones may move into earlier chunks.
+ */
+void particles_update_scalar(ParticleSystem* ps, float dt, Vector3 gravity);
+
+/**
+ * @brief Integration and compaction, SIMD and split across the job system
+ *
+ * Same result as particles_update_scalar. jobs may be NULL to run on the
+ * caller. Does not allocate.
+ */
+void particles_update(ParticleSystem* ps, float dt, Vector3 gravity, JobSystem* jobs);
+
+/**
+ * @brief Draws the particles into the framebuffer viewport, depth tested
+ *
+ * Positions are projected 4 at a time through the view and projection
+ * matrices of the camera. Particles outside the near / far range or the
+ * viewport are skipped.
+ *
+ * @param size World-space edge of the screen-aligned square of each particle, 0 for one-pixel points
+ *
+ * @return Particles drawn (not culled)
+ */
+int particles_draw(Framebuffer* fb, const ParticleSystem* ps, const Camera cam, const Projection proj, float size);
+
+void particles_destroy(ParticleSystem* ps);
@@ -1,6 +1,11 @@
+#pragma once
+
 #include "math/matrix.h"
 #include "core/transform.h"
 #include "core/mesh.h"
+#include "core/skinning.h"
+#include "core/lighting.h"
+#include "core/framebuffer.h"
 
 typedef struct Camera {
     Vector3 pos, target, up;
@@ -14,4 +19,101 @@ typedef struct Projection {
     float fov, aspect_ratio, near, far;
 } Projection;
 
-void update_mesh(Mesh* figure, Mesh* clipped, const Transform transformations, const Camera cam, const Projection proj);
+/**
+ * @brief One camera of a multi-view frame and the framebuffer rectangle it renders into
+ *
+ * projection.aspect_ratio should be viewport.width / viewport.height.
+ */
+typedef struct View {
+    Camera camera;
+    Projection projection;
+    Viewport viewport;
+} View;
+
+/**
+ * @brief Model (object -> world) matrix: T * Rz * Ry * Rx * S
+ */
+Matrix model_matrix(Transform transform);
+
+/**
+ * @brief World-space AABB of an object-space box under a transform
+ *
+ * The box center is transformed and its half extents are projected on
+ * the world axes with the absolute model matrix (Arvo): the result
+ * encloses the transformed box, tightly for rotations by multiples of 90 degrees.
+ */
+Bounds world_bounds(Bounds bounds, const Transform transformations);
+
+/**
+ * @brief View (world -> camera) matrix built with lookAt
+ */
+Matrix view_matrix(const Camera camera);
+
+/**
+ * @brief Perspective projection (camera -> clip space) matrix
+ */
+Matrix projection_matrix(Projection proj);
+
+/**
+ * @brief Writes the clip-space vertices of figure (either position format) into clipped->vertices
+ */
+void update_mesh(const Mesh* figure, Mesh* clipped, const Transform transformations, const Camera cam, const Projection proj);
+
+/**
+ * @brief update_mesh plus per-vertex lighting in the same loop
+ *
+ * Every vertex position and normal is read once: the clip-space position
+ * goes to clipped, and the lit color (base modulated by lighting_evaluate
+ * at the world-space position and normal) goes to colors. Vertices are
+ * processed 4 at a time with SIMD. figure->normals must be set
+ * (see mesh_compute_normals).
+ *
+ * @param colors Output, one ARGB8888 color per vertex
+ * @param base ARGB8888 surface color
+ */
+void update_mesh_lit(const Mesh* figure, Mesh* clipped, uint32_t* colors, uint32_t base,
+                     const Transform transformations, const Camera cam, const Projection proj,
+                     const Lighting* lighting);
+
+/**
+ * @brief Skins a mesh and projects it to clip space in a single pass
+ *
+ * The MVP is folded into every palette matrix (blending is linear), so each
+ * vertex is only transformed once. clipped must have skin->vertex_count vertices.
+ *
+ * @param palette Skinning palette from skeleton_pose
+ * @param jobs Optional job system the vertices are split across
+ */
+void update_skinned_mesh(const SkinnedMesh* skin, const Matrix* palette, Mesh* clipped,
+                         const Transform transformations, const Camera cam, const Projection proj,
+                         JobSystem* jobs);
+
+/* **************************** MULTI-VIEW ****************************** */
+
+/**
+ * @brief Object -> world space half of update_mesh, shared by every view of a frame
+ *
+ * @param world Output, figure->vertex_count world-space positions (w = 1)
+ */
+void update_mesh_world(const Mesh* figure, Vector4* world, const Transform transformations);
+
+/**
+ * @brief update_mesh_world plus the lighting of update_mesh_lit
+ *
+ * Lighting only depends on world-space positions and normals, so the
+ * colors are computed once for all the views.
+ */
+void update_mesh_world_lit(const Mesh* figure, Vector4* world, uint32_t* colors, uint32_t base,
+                           const Transform transformations, const Lighting* lighting);
+
+/**
+ * @brief World -> clip space for several views
+ *
+ * Each view only applies its projection * view matrix to the shared
+ * world-space vertices: clipped[v] receives the vertices of views[v].
+ * Views and vertex ranges are split across the job system; jobs may be
+ * NULL. Drawing clipped[v] with fb->viewport set to views[v].viewport
+ * gives the same frame as update_mesh from that camera, up to rounding.
+ */
+void update_mesh_views(const Vector4* world, int vertex_count, const View* views, int view_count,
+                       Mesh* const* clipped, JobSystem* jobs);
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "core/renderer.h"
+#include "core/sort.h"
+
+// Draw order groups, lower layers draw first
+#define RENDER_LAYERS 8
+
+/**
+ * @brief Sort key bits, most significant first
+ *
+ * pass (software before SDL, the framebuffer covers the whole target),
+ * layer, shading, material (texture, or color of SDL draws) and quantized
+ * depth. Everything above the depth is render state.
+ *
+ * Software draws go near to far, so the depth test rejects hidden pixels
+ * early. SDL has no depth test: filled SDL draws go far to near, SDL
+ * wireframes keep their submission order.
+ */
+#define RENDER_KEY_DEPTH_BITS 24
+#define RENDER_KEY_MATERIAL_SHIFT 24
+#define RENDER_KEY_SHADING_SHIFT 56
+#define RENDER_KEY_LAYER_SHIFT 58
+#define RENDER_KEY_PASS_SHIFT 61
+
+/**
+ * @brief What one frame of the queue cost in render state
+ *
+ * @field state_changes Render state switches between consecutive draws, in sorted order
+ * @field submitted_state_changes Same count in submission order (what an unsorted frame pays)
+ * @field color_sets SDL_SetRenderDrawColor calls issued by render_queue_execute
+ */
+typedef struct RenderQueueStats {
+    int draws;
+    int state_changes;
+    int submitted_state_changes;
+    int color_sets;
+} RenderQueueStats;
+
+/**
+ * @brief Per-frame draw list, sorted by key before it is executed
+ *
+ * Draws are recorded with render_queue_push, radix sorted by
+ * render_queue_sort, then executed one backend at a time by
+ * render_queue_execute, which only sets the SDL draw color when it
+ * changes. Draws are referenced, not copied: they must outlive the frame.
+ *
+ * @field sorted Entries in key order after render_queue_sort (keys or scratch)
+ */
+typedef struct RenderQueue {
+    const Draw** draws;
+    SortKey* keys;
+    SortKey* scratch;
+    SortKey* sorted;
+    int count;
+    int capacity;
+
+    RenderQueueStats stats;
+} RenderQueue;
+
+/**
+ * @brief Sort key of a draw
+ *
+ * @param layer Clamped to [0, RENDER_LAYERS - 1]
+ * @param depth View distance normalized to [0, 1] (clamped)
+ */
+uint64_t render_key(const Draw* draw, int layer, float depth);
+
+/**
+ * @return NULL on allocation failure
+ */
+RenderQueue* render_queue_create(int capacity);
+
+/**
+ * @brief Empties the queue and its stats for a new frame
+ */
+void render_queue_reset(RenderQueue* queue);
+
+/**
+ * @brief Grows the queue to hold count draws without allocating in render_queue_push
+ *
+ * @return 0 on allocation failure
+ */
+int render_queue_reserve(RenderQueue* queue, int count);
+
+/**
+ * @brief Records a draw, growing the queue if needed
+ *
+ * @return 0 on allocation failure (the draw is dropped)
+ */
+int render_queue_push(RenderQueue* queue, const Draw* draw, int layer, float depth);
+
+/**
+ * @brief Sorts the recorded draws and counts their state changes
+ */
+void render_queue_sort(RenderQueue* queue);
+
+/**
+ * @brief Executes the sorted draws of one backend
+ *
+ * RENDER_SOFTWARE draws go to fb, RENDER_SDL draws to sdl_renderer
+ * (screen_w x screen_h). Wireframe colors are only set when they differ
+ * from the previous wireframe draw.
+ *
+ * @return Draws executed
+ */
+int render_queue_execute(RenderQueue* queue, RenderBackend backend, SDL_Renderer* sdl_renderer, Framebuffer* fb,
+                         int screen_w, int screen_h);
+
+void render_queue_destroy(RenderQueue* queue);
@@ -1,5 +1,10 @@
+#pragma once
+
+#include <SDL.h>
+
 #include "math/matrix.h"
 #include "core/mesh.h"
+#include "core/framebuffer.h"
 
 typedef struct Pixel { 
     int x, y;
@@ -10,9 +15,76 @@ typedef struct Color {
     size_t r, g, b, a; 
 } Color;
 
+/**
+ * @brief Rasterization path used for a Draw
+ *
+ * RENDER_SDL issues one SDL_RenderDrawLine per edge.
+ * RENDER_SOFTWARE rasterizes edges into the engine Framebuffer, which is
+ * uploaded once per frame.
+ */
+typedef enum RenderBackend {
+    RENDER_SDL,
+    RENDER_SOFTWARE
+} RenderBackend;
+
+/**
+ * @brief How triangles of a Draw are rasterized
+ *
+ * SHADE_FLAT and SHADE_GOURAUD fill triangles with the per-vertex colors
+ * of update_mesh_lit: one averaged color per triangle, or colors
+ * interpolated across it. Without vertex colors they fall back to the
+ * wireframe.
+ * SHADE_TEXTURED maps Draw.texture with the mesh UVs (software backend
+ * only, the SDL backend draws it as SHADE_GOURAUD).
+ */
+typedef enum ShadeMode {
+    SHADE_WIREFRAME,
+    SHADE_FLAT,
+    SHADE_GOURAUD,
+    SHADE_TEXTURED
+} ShadeMode;
+
 typedef struct Draw { 
     Mesh* clipped_mesh;
     Color color;
+    RenderBackend backend;
+    ShadeMode shading;
+    uint32_t* vertex_colors;    // ARGB8888 per vertex, written by update_mesh_lit
+    const Texture* texture;     // SHADE_TEXTURED source (not owned)
+    TextureFilter filter;
+    const int* triangle_order;  // All triangle indices in draw order (depth_sort_mesh), NULL for index order
 } Draw;
 
+static inline uint32_t color_to_argb(Color c) {
+    return ((uint32_t)(c.a & 0xFF) << 24) | ((uint32_t)(c.r & 0xFF) << 16) |
+           ((uint32_t)(c.g & 0xFF) << 8) | (uint32_t)(c.b & 0xFF);
+}
+
+/**
+ * @brief Draws a mesh with the SDL renderer
+ *
+ * Wireframes use SDL_RenderDrawLine, filled modes batch triangles into
+ * SDL_RenderGeometry. SDL has no depth test: filled triangles are drawn in
+ * index order, or in triangle_order (back to front for the painter's algorithm).
+ */
 void draw_mesh(SDL_Renderer* sdl_renderer, const Draw* figure, const size_t screen_w, const size_t screen_h);
+
+/**
+ * @brief Wireframe edges of a mesh in the current SDL draw color
+ *
+ * draw_mesh without its SDL_SetRenderDrawColor, for callers that keep
+ * track of the color themselves (render_queue_execute).
+ */
+void draw_mesh_edges(SDL_Renderer* sdl_renderer, const Draw* figure, const size_t screen_w, const size_t screen_h);
+
+/**
+ * @brief Wireframe rasterization into a CPU framebuffer
+ *
+ * Same projection to screen space as draw_mesh, onto fb->viewport instead
+ * of the whole screen. Edges are written into fb, clipped to the viewport;
+ * triangles with a vertex behind the eye (w <= 0) are skipped. Filled
+ * modes are depth tested against fb->depth, which the caller clears with
+ * framebuffer_clear_depth. SHADE_TEXTURED needs a texture and UVs on the
+ * clipped mesh, and interpolates them with the 1/w of its vertices.
+ */
+void draw_mesh_software(Framebuffer* fb, const Draw* figure);
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "core/pipeline.h"
+#include "core/renderer.h"
+
+#define REPLAY_VERSION 1
+#define REPLAY_MAX_MESHES 256
+
+/**
+ * @brief Full state of one recorded frame
+ *
+ * @field dt Delta time the frame was simulated with, in seconds
+ * @field mesh Index in Replay.meshes
+ * @field transform, camera, projection Inputs of update_mesh
+ * @field color ARGB8888 draw color
+ * @field backend, shading Draw settings of the session
+ * @field lighting Lights used by filled shading modes
+ */
+typedef struct ReplayFrame {
+    float dt;
+    int mesh;
+    Transform transform;
+    Camera camera;
+    Projection projection;
+    uint32_t color;
+    RenderBackend backend;
+    ShadeMode shading;
+    Lighting lighting;
+} ReplayFrame;
+
+/**
+ * @brief Writes a session to a binary file, frame by frame
+ *
+ * File layout (native endianness): a header ("3DRP", version, screen
+ * size, background color), then records. A mesh record holds the geometry of a mesh the
+ * first time a frame uses it. A frame record holds the delta time, a
+ * bit mask of what changed since the previous frame, and only those
+ * fields.
+ */
+typedef struct Recorder {
+    FILE* file;
+    const Mesh* meshes[REPLAY_MAX_MESHES];
+    int mesh_count;
+    int frame_count;
+    ReplayFrame last;
+} Recorder;
+
+/**
+ * @brief A loaded session
+ *
+ * @field screen_w, screen_h Size of the window the session was recorded in
+ * @field background ARGB8888 clear color
+ * @field meshes Meshes used by the session (owned, normals computed)
+ * @field frames Every frame with its full state
+ */
+typedef struct Replay {
+    int screen_w;
+    int screen_h;
+    uint32_t background;
+    Mesh** meshes;
+    int mesh_count;
+    ReplayFrame* frames;
+    int frame_count;
+} Replay;
+
+/**
+ * @brief Result of replay_run
+ *
+ * @field total_ms Wall time of all frames (update + raster)
+ * @field session_ms Sum of the recorded delta times
+ * @field p50_ms, p90_ms, p99_ms, max_ms Frame time percentiles
+ * @field frame_ms Wall time of every frame
+ * @field checksums FNV-1a hash of the visible framebuffer after every frame
+ */
+typedef struct ReplayReport {
+    int frame_count;
+    double total_ms;
+    double session_ms;
+    double p50_ms, p90_ms, p99_ms, max_ms;
+    double* frame_ms;
+    uint32_t* checksums;
+} ReplayReport;
+
+/* **************************** RECORDING ****************************** */
+
+Recorder* recorder_open(const char* path, int screen_w, int screen_h, Color background);
+
+/**
+ * @brief Appends a frame
+ *
+ * @param mesh Source mesh passed to update_mesh (written once, the first time it is seen)
+ * @param draw Draw settings (color, backend, shading)
+ *
+ * @return 0 on write error or when more than REPLAY_MAX_MESHES meshes are used
+ */
+int recorder_frame(Recorder* rec, float dt, const Mesh* mesh, const Draw* draw, Transform transform,
+                   Camera cam, Projection proj, const Lighting* lighting);
+
+/**
+ * @brief Writes the end marker and closes the file
+ *
+ * @return 0 if the file could not be completed
+ */
+int recorder_close(Recorder* rec);
+
+/* **************************** REPLAY ****************************** */
+
+/**
+ * @return NULL if the file cannot be read or is not a valid recording
+ */
+Replay* replay_load(const char* path);
+
+/**
+ * @brief Replays every frame headless, as fast as possible
+ *
+ * Each frame runs update_mesh (update_mesh_lit for lit shading modes) and
+ * rasterizes into a screen-sized Framebuffer with draw_mesh_software,
+ * whatever backend was recorded: no window is needed and checksums are
+ * reproducible.
+ *
+ * @return 0 on allocation failure
+ */
+int replay_run(const Replay* replay, ReplayReport* report);
+
+/**
+ * @brief FNV-1a hash of the visible pixels of a framebuffer
+ *
+ * Hashes fb->pixels: resolve the framebuffer first.
+ */
+uint32_t framebuffer_checksum(const Framebuffer* fb);
+
+void replay_report_free(ReplayReport* report);
+
+void replay_destroy(Replay* replay);
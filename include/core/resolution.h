@@ -0,0 +1,58 @@
+#pragma once
+
+/**
+ * @brief Dynamic resolution controller
+ *
+ * Picks the internal render scale (per axis) that keeps the raster time
+ * of a frame close to target_ms. Raster cost is assumed proportional to
+ * the pixel count, i.e. to scale^2.
+ *
+ * @field target_ms Raster time budget per frame
+ * @field min_scale, max_scale Bounds of the scale (max is usually 1)
+ * @field smoothing Weight of the newest measurement in the moving average, in (0, 1]
+ * @field scale Current scale
+ * @field smoothed_ms Exponential moving average of the raster time at the current scale
+ */
+typedef struct ResolutionController {
+    float target_ms;
+    float min_scale;
+    float max_scale;
+    float smoothing;
+    float scale;
+    float smoothed_ms;
+} ResolutionController;
+
+/**
+ * @brief What dynamic resolution did for one frame
+ *
+ * @field scale Scale the frame was rendered at
+ * @field width, height Internal render size in pixels
+ * @field raster_ms Measured raster time (clear, draws and upload)
+ * @field saved_ms Estimated raster time saved vs rendering at scale 1
+ */
+typedef struct ResolutionStats {
+    float scale;
+    int width;
+    int height;
+    float raster_ms;
+    float saved_ms;
+} ResolutionStats;
+
+/**
+ * @brief Controller starting at max_scale, with the default smoothing
+ */
+ResolutionController resolution_controller(float target_ms, float min_scale, float max_scale);
+
+/**
+ * @brief Feeds the raster time of the last frame, returns the scale for the next one
+ *
+ * The measurement is smoothed first. The scale only moves when the
+ * wanted change is above a small dead band, so it does not jitter
+ * around the budget.
+ */
+float resolution_update(ResolutionController* rc, float raster_ms);
+
+/**
+ * @brief Internal render size for a full_w x full_h output at the current scale
+ */
+void resolution_size(const ResolutionController* rc, int full_w, int full_h, int* w, int* h);
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "core/pipeline.h"
+#include "core/renderer.h"
+#include "core/occlusion.h"
+#include "core/render_queue.h"
+#include "core/depth_sort.h"
+
+// Object flags
+#define OBJECT_OCCLUDER (1 << 0) // always rasterized into the occlusion buffer
+#define OBJECT_DEPTH_SORT (1 << 1) // triangles drawn back to front on every backend (translucent surfaces)
+
+/**
+ * @brief A mesh instance placed in the world
+ *
+ * @field mesh Source mesh (not owned, may be shared between objects)
+ * @field draw Clip-space output of update_mesh and draw settings (owned)
+ * @field depth_sort Triangle order of the draw, sorted by scene_update (owned)
+ * @field transform Object -> world transform
+ * @field bounds Object-space AABB of mesh
+ * @field flags OBJECT_* flags
+ * @field layer Draw order group, lower layers first (0 to RENDER_LAYERS - 1, default 0)
+ * @field visible Result of the last scene_update
+ * @field occluding Used as an occluder in the last scene_update
+ */
+typedef struct Object {
+    const Mesh* mesh;
+    Draw draw;
+    DepthSort* depth_sort;
+    Transform transform;
+    Bounds bounds;
+    int flags;
+    int layer;
+    int visible;
+    int occluding;
+} Object;
+
+/**
+ * @brief Flat list of objects
+ *
+ * @field culler Optional occlusion culler, set with scene_set_culler (NULL disables culling, not owned)
+ * @field lighting Lights for objects with a filled draw.shading (NULL = unlit, not owned)
+ */
+typedef struct Scene {
+    Object* objects;
+    int count;
+    int capacity;
+
+    OcclusionCuller* culler;
+    const Lighting* lighting;
+} Scene;
+
+Scene* scene_create(int capacity);
+
+/**
+ * @brief Adds an object to the scene
+ *
+ * @return Index of the new object, -1 on allocation failure
+ */
+int scene_add(Scene* scene, const Mesh* mesh, Color color, Transform transform, int flags);
+
+/**
+ * @brief Sets the occlusion culler (NULL disables culling)
+ *
+ * Reserves the culler for the largest mesh of the scene, as scene_add and
+ * scene_set_mesh then do for new meshes, so that frames do not allocate.
+ *
+ * @return 0 on allocation failure (culler not set)
+ */
+int scene_set_culler(Scene* scene, OcclusionCuller* culler);
+
+/**
+ * @brief Removes an object and frees its draw buffers
+ *
+ * The last object moves into the hole, so only its index changes.
+ * Out-of-range indices are ignored.
+ */
+void scene_remove(Scene* scene, int index);
+
+/**
+ * @brief Points an object at another mesh (e.g. a reloaded version of an asset)
+ *
+ * The draw buffers are rebuilt for the new vertex count and the bounds
+ * recomputed. The previous mesh is no longer referenced, and the draw goes
+ * back to index order until the next scene_update sorts it.
+ *
+ * @return 0 on allocation failure (object unchanged)
+ */
+int scene_set_mesh(Scene* scene, int index, const Mesh* mesh);
+
+/**
+ * @brief Culls the objects and runs update_mesh on the visible ones
+ *
+ * Visible objects with a filled draw.shading, a mesh with normals and a
+ * scene lighting go through update_mesh_lit instead.
+ *
+ * The triangles of visible filled SDL draws (no depth test) and of
+ * OBJECT_DEPTH_SORT objects are then depth sorted back to front into
+ * draw.triangle_order; other draws keep index order.
+ *
+ * With a culler, occluders (flagged ones, or the culler->max_occluders
+ * largest on screen if none is flagged) are rasterized into the
+ * low-resolution depth buffer first, and every other object is tested
+ * against the depth pyramid before any vertex is transformed.
+ *
+ * @param jobs Pool the depth sorts of large meshes are split across (may be NULL)
+ */
+void scene_update(Scene* scene, const Camera cam, const Projection proj, JobSystem* jobs);
+
+/**
+ * @brief World-space AABB of every object (world_bounds of its mesh bounds), e.g. for broadphase_update
+ *
+ * @param boxes Output, scene->count boxes
+ */
+void scene_world_bounds(const Scene* scene, Bounds* boxes);
+
+void scene_destroy(Scene* scene);
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "math/matrix.h"
+#include "core/transform.h"
+#include "core/mesh.h"
+#include "core/jobs.h"
+
+#define SKIN_MAX_INFLUENCES 4   // bones per vertex
+#define SKIN_MAX_JOINTS 256     // joint indices are stored as uint8_t
+
+/**
+ * @brief Joint hierarchy with its bind pose
+ *
+ * Joints are sorted so that a parent always comes before its children.
+ *
+ * @field joint_count Number of joints
+ * @field parents Parent index of each joint, -1 for a root
+ * @field inverse_bind Mesh space -> joint space in the bind pose
+ */
+typedef struct Skeleton {
+    int joint_count;
+    int* parents;
+    Matrix* inverse_bind;
+} Skeleton;
+
+/**
+ * @brief Keyframed local joint transforms
+ *
+ * @field joint_count Joints animated by the clip
+ * @field key_count Number of keyframes
+ * @field times Keyframe times in seconds, increasing, times[0] = 0
+ * @field poses key_count * joint_count local transforms (key major)
+ * @field duration Time of the last keyframe, the clip loops after it
+ */
+typedef struct AnimationClip {
+    int joint_count;
+    int key_count;
+    float* times;
+    Transform* poses;
+    float duration;
+} AnimationClip;
+
+/**
+ * @brief Bind pose mesh with per-vertex bone influences, structure of arrays
+ *
+ * Every stream is a separate array indexed by vertex so the skinning loop
+ * reads contiguous memory. Unused influences have a weight of 0.
+ *
+ * @field vertex_count Number of vertices
+ * @field joint_count Highest referenced joint index + 1
+ * @field x, y, z Bind pose positions
+ * @field joints Joint index of each influence
+ * @field weights Weight of each influence, summing to 1 per vertex
+ */
+typedef struct SkinnedMesh {
+    int vertex_count;
+    int joint_count;
+
+    float* x;
+    float* y;
+    float* z;
+
+    uint8_t* joints[SKIN_MAX_INFLUENCES];
+    float* weights[SKIN_MAX_INFLUENCES];
+} SkinnedMesh;
+
+/* **************************** SKELETON ****************************** */
+
+/**
+ * @brief Creates a skeleton from its bind pose
+ *
+ * @param parents Parent of each joint (-1 for roots, otherwise smaller than the joint)
+ * @param bind_pose Local transform of each joint in the bind pose
+ *
+ * @return The skeleton, NULL if the hierarchy is invalid or a bind matrix is singular
+ */
+Skeleton* skeleton_create(int joint_count, const int* parents, const Transform* bind_pose);
+
+/**
+ * @brief Computes the skinning palette of a pose
+ *
+ * palette[j] = global(j) * inverse_bind[j], it maps bind pose mesh space
+ * to posed mesh space.
+ *
+ * @param local Local transform of each joint
+ * @param palette Output, joint_count matrices
+ */
+void skeleton_pose(const Skeleton* skeleton, const Transform* local, Matrix* palette);
+
+void skeleton_destroy(Skeleton* skeleton);
+
+/* **************************** ANIMATION ****************************** */
+
+AnimationClip* animation_clip_create(int joint_count, int key_count, const float* times, const Transform* poses);
+
+/**
+ * @brief Samples the local joint transforms at a given time
+ *
+ * The time wraps around the clip duration. Translation, rotation and
+ * scale are linearly interpolated between the two surrounding keyframes.
+ *
+ * @param local Output, joint_count transforms
+ */
+void animation_sample(const AnimationClip* clip, float time, Transform* local);
+
+void animation_clip_destroy(AnimationClip* clip);
+
+/* **************************** SKINNING ****************************** */
+
+/**
+ * @brief Creates a skinned mesh from a bind pose mesh
+ *
+ * @param joints SKIN_MAX_INFLUENCES joint indices per vertex
+ * @param weights SKIN_MAX_INFLUENCES weights per vertex, normalized on creation
+ */
+SkinnedMesh* skinned_mesh_create(const Mesh* bind, const uint8_t* joints, const float* weights);
+
+/**
+ * @brief Linear blend skinning, scalar reference
+ *
+ * out[i] = sum_k weights[k][i] * palette[joints[k][i]] * position[i]
+ */
+void skin_vertices_scalar(const SkinnedMesh* skin, const Matrix* palette, Vector4* out);
+
+/**
+ * @brief Linear blend skinning, SIMD and split across the job system
+ *
+ * Same result as skin_vertices_scalar. jobs may be NULL to run on the caller.
+ */
+void skin_vertices(const SkinnedMesh* skin, const Matrix* palette, Vector4* out, JobSystem* jobs);
+
+void skinned_mesh_destroy(SkinnedMesh* skin);
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include "core/jobs.h"
+
+// Fewest entries radix_sort_parallel splits across threads
+#define RADIX_PARALLEL_MIN 16384
+
+// Most chunks (threads) radix_sort_parallel splits the entries in
+#define RADIX_PARALLEL_CHUNKS 8
+
+/**
+ * @brief Sort entry: a 64-bit key and the index of what it stands for
+ */
+typedef struct SortKey {
+    uint64_t key;
+    int index;
+} SortKey;
+
+/**
+ * @brief Radix key of a float: its bits, made to sort like the floats as unsigned integers (negatives included)
+ */
+static inline uint32_t float_key(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+}
+
+/**
+ * @brief Stable LSD radix sort by key, ascending
+ *
+ * One pass per key byte (8 bits), ping-ponging between items and scratch;
+ * bytes shared by every key (e.g. unused high bits) are skipped, so the
+ * result may end up in either buffer. Both hold count entries.
+ *
+ * @return The buffer holding the sorted entries (items or scratch)
+ */
+SortKey* radix_sort(SortKey* items, SortKey* scratch, int count);
+
+/**
+ * @brief radix_sort split across a job system
+ *
+ * The entries are cut in one contiguous chunk per thread. Each pass counts
+ * the bytes of every chunk, then every chunk scatters from its own offsets
+ * within each bucket, so the result is the one of radix_sort (stable, same
+ * skipped passes, same buffer). Runs radix_sort when jobs is NULL, has no
+ * workers, or count is below RADIX_PARALLEL_MIN.
+ */
+SortKey* radix_sort_parallel(SortKey* items, SortKey* scratch, int count, JobSystem* jobs);
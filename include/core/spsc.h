@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stdint.h>
+#include <SDL.h>
+
+// Producer and consumer indices live on their own cache lines
+#define SPSC_CACHE_LINE 64
+
+/**
+ * @brief Bounded lock-free ring for exactly one producer and one consumer thread
+ *
+ * Elements are fixed-size and copied in and out. The producer publishes
+ * an element by storing tail after writing its slot; the consumer frees a
+ * slot by storing head after reading it (SDL atomics, sequentially
+ * consistent). Indices wrap at twice the capacity so a full ring and an
+ * empty one differ without a spare slot.
+ *
+ * Each side keeps a private copy of its own index and a cached copy of
+ * the other side's, refreshed only when the ring looks full (producer)
+ * or empty (consumer), so most operations touch one shared line.
+ *
+ * @field capacity Elements, a power of two
+ * @field tail, write, cached_head Producer side
+ * @field head, read, cached_tail Consumer side
+ */
+typedef struct SpscQueue {
+    uint8_t* slots;
+    int element_size;
+    int capacity;
+    int mask;
+    int wrap;
+
+    _Alignas(SPSC_CACHE_LINE) SDL_atomic_t tail;
+    int write;
+    int cached_head;
+
+    _Alignas(SPSC_CACHE_LINE) SDL_atomic_t head;
+    int read;
+    int cached_tail;
+} SpscQueue;
+
+/**
+ * @param capacity Rounded up to a power of two
+ *
+ * @return NULL on invalid parameters or allocation failure
+ */
+SpscQueue* spsc_create(int capacity, int element_size);
+
+/**
+ * @brief Producer only: copies element into the ring
+ *
+ * @return 0 if the ring is full
+ */
+int spsc_push(SpscQueue* queue, const void* element);
+
+/**
+ * @brief Consumer only: copies the oldest element out of the ring
+ *
+ * @return 0 if the ring is empty
+ */
+int spsc_pop(SpscQueue* queue, void* element);
+
+/**
+ * @brief Elements queued, exact from either side when the other one is idle
+ */
+int spsc_count(SpscQueue* queue);
+
+void spsc_destroy(SpscQueue* queue);
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "core/pipeline.h"
+
+// Finest tessellation of a patch side (power of two)
+#define SURFACE_MAX_SEGMENTS 64
+
+typedef enum SurfaceType {
+    SURFACE_SPHERE,
+    SURFACE_TORUS,
+    SURFACE_BEZIER
+} SurfaceType;
+
+/**
+ * @brief Parametric surface over [0, 1]^2, split into a grid of patches
+ *
+ * Each patch is tessellated independently, with its own number of
+ * segments per side. Sphere: u is the longitude, v goes pole to pole.
+ * Torus: u around the main ring, v around the tube. Bezier: one bicubic
+ * patch (4x4 control points, row-major along u) split into sub-patches.
+ *
+ * @field patches_u, patches_v Patch grid
+ * @field wrap_u, wrap_v Whether u = 1 is the same seam as u = 0 (v alike)
+ * @field max_segments Upper bound of the segments per patch side
+ */
+typedef struct Surface {
+    SurfaceType type;
+    float radius;
+    float tube_radius;
+    Vector3 control[16];
+
+    int patches_u, patches_v;
+    int wrap_u, wrap_v;
+    int max_segments;
+} Surface;
+
+/**
+ * @brief Per-frame tessellation of a Surface, ready for update_mesh
+ *
+ * mesh is allocated once for every patch at max_segments: tessellating
+ * only rewrites its vertices, triangles and counts, never reallocates.
+ *
+ * @field mesh Object-space vertex and index buffer
+ * @field levels Segments per side of each patch, last tessellation
+ * @field mvp, screen_w, screen_h View of the last adaptive tessellation
+ */
+typedef struct Tessellation {
+    Mesh* mesh;
+    int* levels;
+    int vertex_capacity;
+    int triangle_capacity;
+
+    Matrix mvp;
+    int screen_w, screen_h;
+    float target_px;
+    int valid;
+} Tessellation;
+
+Surface surface_sphere(float radius, int patches_u, int patches_v, int max_segments);
+
+Surface surface_torus(float radius, float tube_radius, int patches_u, int patches_v, int max_segments);
+
+Surface surface_bezier(const Vector3 control[16], int patches_u, int patches_v, int max_segments);
+
+/**
+ * @brief Point of the surface at (u, v)
+ */
+Vector3 surface_eval(const Surface* surface, float u, float v);
+
+/**
+ * @return NULL on allocation failure
+ */
+Tessellation* tessellation_create(const Surface* surface);
+
+/**
+ * @brief Tessellates each patch so its edges are about target_px pixels on screen
+ *
+ * A patch is measured by projecting a 3x3 grid of its points: its segment
+ * count is the projected length along its longest side over target_px,
+ * rounded up to a power of two within [1, max_segments]; patches entirely
+ * outside the view get 1. A patch edge shared with a coarser neighbour
+ * is snapped onto the neighbour's segments, so there are no cracks.
+ * Points come from one integer parameter lattice, so shared vertices are
+ * bit-identical on both sides.
+ *
+ * Does nothing when the view (MVP and screen size) and target have not
+ * changed since the last call.
+ *
+ * @return 1 if the mesh was rebuilt, 0 if it was reused
+ */
+int surface_tessellate(const Surface* surface, Tessellation* tess, Transform transform, Camera cam,
+                       Projection proj, int screen_w, int screen_h, float target_px);
+
+/**
+ * @brief Fixed tessellation: every patch gets `segments` per side (a power of two)
+ */
+void surface_tessellate_uniform(const Surface* surface, Tessellation* tess, int segments);
+
+void tessellation_destroy(Tessellation* tess);
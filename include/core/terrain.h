@@ -0,0 +1,184 @@
+#pragma once
+
+#include <stdio.h>
+#include <SDL.h>
+
+#include "core/pipeline.h"
+#include "core/renderer.h"
+#include "core/arena.h"
+
+#define TERRAIN_VERSION 1
+#define TERRAIN_MAX_LEVELS 8
+
+/**
+ * @brief Height of the terrain grid point (x, z), used to build a height file
+ */
+typedef float (*TerrainHeightFn)(void* ctx, int x, int z);
+
+typedef enum ChunkState {
+    CHUNK_EMPTY,
+    CHUNK_LOADING,
+    CHUNK_READY
+} ChunkState;
+
+/**
+ * @brief Cache slot holding the heights of one chunk at one level
+ *
+ * Only heights are stored: x and z follow from the grid position and the
+ * triangles are the same for every chunk of a level.
+ *
+ * @field cx, cz, level Chunk held by the slot (-1 when empty)
+ * @field state Written under Terrain.lock; heights belong to the I/O thread while loading
+ * @field heights (cells >> level) + 1 squared samples, row-major along x
+ * @field last_used Last frame the chunk was drawn (LRU key)
+ * @field requested Performance counter when the load was queued
+ */
+typedef struct TerrainChunk {
+    int cx, cz, level;
+    ChunkState state;
+    float* heights;
+    Uint64 last_used;
+    Uint64 requested;
+} TerrainChunk;
+
+/**
+ * @brief A chunk to draw this frame
+ *
+ * @field slot Cache slot with the heights
+ * @field wanted Level picked from the distance (slot may hold another one as a fallback)
+ */
+typedef struct TerrainVisible {
+    int slot;
+    int wanted;
+    float distance;
+} TerrainVisible;
+
+/**
+ * @brief Streaming counters
+ *
+ * Per frame: visible, fallbacks (drawn at another level while the wanted
+ * one loads), missing (no level resident: a hole), requested, and the
+ * vertices and triangles of the last terrain_render.
+ * Cumulative: hitches (frames with a hole), loads, evictions, errors and
+ * load latency from request to ready.
+ * Memory: cache_bytes (height slots), topology_bytes (shared triangles)
+ * and mesh_bytes, what the full-resolution terrain takes as a Mesh.
+ */
+typedef struct TerrainStats {
+    int visible;
+    int fallbacks;
+    int missing;
+    int requested;
+    int vertices;
+    int triangles;
+
+    int frames;
+    int hitches;
+    int loads;
+    int evictions;
+    int errors;
+    double total_load_ms;
+    double max_load_ms;
+
+    size_t cache_bytes;
+    size_t topology_bytes;
+    size_t mesh_bytes;
+} TerrainStats;
+
+/**
+ * @brief Chunked height field streamed from disk
+ *
+ * The file holds chunks_x * chunks_z chunks of cells x cells quads, at
+ * `levels` resolutions (level l keeps every 2^l-th sample). Every frame,
+ * terrain_update picks the chunks within view_distance of the camera, the
+ * level growing with the distance, and queues the missing ones for the
+ * I/O thread, which reads them into a fixed pool of cache slots. Chunks
+ * one chunk beyond view_distance are queued too, ahead of the camera. The
+ * main thread never waits for a read: until a chunk arrives, another
+ * resident level of it is drawn, or nothing.
+ *
+ * @field resident (level, cz, cx) -> cache slot, -1 if not cached
+ * @field topology Triangles of a chunk at each level, shared by all chunks
+ * @field queue Ring of slots waiting for the I/O thread
+ * @field vertices, clipped Scratch meshes for terrain_render
+ */
+typedef struct Terrain {
+    FILE* file;
+    int cells;
+    int chunks_x, chunks_z;
+    int levels;
+    float spacing;
+    float view_distance;
+    float lod_distance;
+
+    TerrainChunk* slots;
+    int slot_count;
+    int* resident;
+    Triangle* topology[TERRAIN_MAX_LEVELS];
+
+    SDL_Thread* io_thread;
+    SDL_mutex* lock;
+    SDL_cond* wake;
+    int* queue;
+    int queue_head;
+    int queue_count;
+    int quit;
+
+    TerrainVisible* visible;
+    int visible_count;
+    Uint64 frame;
+    TerrainStats stats;
+
+    Vector4* vertices;
+    Vector4* clipped;
+} Terrain;
+
+/**
+ * @brief Writes a height file
+ *
+ * @param cells Quads per chunk side, a power of two
+ * @param levels Resolutions stored, at most log2(cells) + 1 and TERRAIN_MAX_LEVELS
+ * @param height Called for every grid point x in [0, chunks_x * cells], z in [0, chunks_z * cells]
+ *
+ * @return 0 on invalid parameters or write error
+ */
+int terrain_build_file(const char* path, int cells, int chunks_x, int chunks_z, int levels, float spacing,
+                       TerrainHeightFn height, void* ctx);
+
+/**
+ * @brief Opens a height file and starts its I/O thread
+ *
+ * @param cache_chunks Number of cache slots (each sized for a level 0 chunk)
+ * @param view_distance Chunks farther than this (in xz) are not drawn
+ * @param lod_distance Level 0 up to this distance, then one level coarser each time it doubles
+ *
+ * @return NULL if the file is invalid or on allocation failure
+ */
+Terrain* terrain_open(const char* path, int cache_chunks, float view_distance, float lod_distance);
+
+/**
+ * @brief Selects this frame's chunks around the camera and queues missing ones
+ *
+ * Nearest chunks are served first; when there are more chunks in range
+ * (prefetch ring included) than cache slots, the farthest are skipped.
+ * Does not wait on the I/O thread.
+ *
+ * @param scratch Frame arena for the list of chunks in range (NULL, or
+ *                full: allocated on the heap and freed before returning)
+ */
+void terrain_update(Terrain* terrain, Vector3 eye, Arena* scratch);
+
+/**
+ * @brief Draws the chunks selected by terrain_update (software rasterizer)
+ */
+void terrain_render(Terrain* terrain, Framebuffer* fb, Camera cam, Projection proj, Color color);
+
+/**
+ * @brief Heights of a chunk if it is cached at that level, NULL otherwise
+ */
+const float* terrain_chunk_heights(Terrain* terrain, int cx, int cz, int level);
+
+/**
+ * @brief Stops the I/O thread and frees everything
+ */
+void terrain_close(Terrain* terrain);
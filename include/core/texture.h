@@ -0,0 +1,105 @@
+#pragma once
+
+#include <stdint.h>
+
+// Enough levels for a 32768 x 32768 texture
+#define TEXTURE_MAX_LEVELS 16
+
+/**
+ * @brief Order of the texels of each mip level in memory
+ *
+ * TEXTURE_LINEAR is row-major. TEXTURE_TILED stores 4x4 blocks one after
+ * the other (row-major inside a block and between blocks). TEXTURE_MORTON
+ * interleaves the bits of x and y (Z-order), so texels close in 2D stay
+ * close in memory whatever direction a triangle walks the texture.
+ */
+typedef enum TextureLayout {
+    TEXTURE_LINEAR,
+    TEXTURE_TILED,
+    TEXTURE_MORTON
+} TextureLayout;
+
+typedef enum TextureFilter {
+    TEXTURE_NEAREST,
+    TEXTURE_BILINEAR
+} TextureFilter;
+
+/**
+ * @brief One mip level
+ *
+ * @field texels ARGB8888 texels in the texture layout (points into Texture.storage)
+ * @field width, height Size in texels, powers of two
+ * @field log2_width, log2_height log2 of the size
+ */
+typedef struct TextureLevel {
+    uint32_t* texels;
+    int width;
+    int height;
+    int log2_width;
+    int log2_height;
+} TextureLevel;
+
+/**
+ * @brief Power-of-two ARGB8888 texture with a full mip chain
+ *
+ * Level 0 is the source image, every next level halves each dimension
+ * (down to 1) with a 2x2 box filter, the last level is 1x1.
+ * Coordinates wrap (repeat) in both directions.
+ *
+ * @field layout Texel order of every level
+ * @field level_count Number of levels in levels
+ * @field levels Mip levels, 0 is the largest
+ * @field storage Single allocation holding all levels
+ */
+typedef struct Texture {
+    TextureLayout layout;
+    int level_count;
+    TextureLevel levels[TEXTURE_MAX_LEVELS];
+    uint32_t* storage;
+} Texture;
+
+/**
+ * @brief Creates a texture from row-major ARGB8888 pixels
+ *
+ * Builds the whole mip chain and reorders every level to layout.
+ *
+ * @return NULL if width or height is not a power of two, or on allocation failure
+ */
+Texture* texture_create(const uint32_t* argb, int width, int height, TextureLayout layout);
+
+/**
+ * @brief Texel (x, y) of a level, coordinates wrap
+ */
+uint32_t texture_fetch(const Texture* tex, int level, int x, int y);
+
+/**
+ * @brief Mip level for the given screen-space UV derivatives
+ *
+ * Level log2(rho), rho being the largest texel footprint of a pixel step
+ * along x or y on level 0, clamped to the available levels.
+ *
+ * @param dudx, dvdx UV change for one pixel to the right
+ * @param dudy, dvdy UV change for one pixel down
+ */
+int texture_select_level(const Texture* tex, float dudx, float dvdx, float dudy, float dvdy);
+
+/**
+ * @brief Samples count UV pairs on one mip level
+ *
+ * 4 samples at a time with SSE2 / NEON: addresses are computed in vector
+ * registers, texels are gathered, and bilinear weights are applied to the
+ * four channels of four samples at once.
+ *
+ * @param u, v Texture coordinates, texel centers are at (i + 0.5) / size
+ * @param out ARGB8888 result per sample
+ */
+void texture_sample(const Texture* tex, const float* u, const float* v, int count, int level,
+                    TextureFilter filter, uint32_t* out);
+
+/**
+ * @brief Scalar reference of texture_sample
+ */
+void texture_sample_scalar(const Texture* tex, const float* u, const float* v, int count, int level,
+                           TextureFilter filter, uint32_t* out);
+
+void texture_destroy(Texture* tex);
@@ -1,3 +1,5 @@
+#pragma once
+
 #include "math/matrix.h"
 
 typedef enum { X, Y, Z } Axis;
@@ -2,11 +2,33 @@
 
 #include "core/renderer.h"
 #include "core/pipeline.h"
+#include "core/scene.h"
+#include "core/render_queue.h"
+#include "core/jobs.h"
+#include "core/resolution.h"
+#include "core/terrain.h"
+#include "core/commands.h"
+#include "core/memory.h"
+#include "core/frame_stats.h"
 
 typedef struct {
     SDL_Window* window;
     SDL_Renderer* sdl_renderer;
 
+    Framebuffer* framebuffer;           // CPU target for RENDER_SOFTWARE draws
+    SDL_Texture* framebuffer_texture;   // streaming texture it is uploaded to
+    SDL_Texture* render_target;         // internal-resolution frame with dynamic resolution (NULL until enabled)
+
+    int dynamic_resolution;
+    ResolutionController resolution;
+    ResolutionStats resolution_stats;   // last frame
+
+    JobSystem* jobs;                    // worker threads for per-vertex passes (skinning)
+    CommandQueue* commands;             // filled by a simulation thread, drained every frame (NULL if unused, not owned)
+    RenderQueue* render_queue;          // draws of update_scene, sorted by render state (stats of the last frame)
+    Arena* scratch;                     // per-frame scratch memory, reset when a frame begins
+    EngineFrameStats* stats;            // counts and stage times of every frame, rolling window, CSV sink
+
     Mesh* figure;
     Draw* draw;
 
@@ -15,14 +37,64 @@ typedef struct {
 
     Camera camera;
     Projection projection;
+    Lighting lighting;                  // used by draws with a filled shading mode
 
     Color background;
 } Engine;
 
+/**
+ * @brief Creates the window, renderer and every per-frame buffer
+ *
+ * Frames (update_step, update_scene, update_terrain) are bracketed with
+ * memory_frame_begin / memory_frame_end: memory_stats tells what the last
+ * one allocated, and memory_set_strict turns any allocation into an abort.
+ * They also fill engine->stats: vertices, triangles, lines, pixels, draws,
+ * culled objects, allocations and update / raster / present times, with
+ * frame_stats_summary for the rolling average, min and max.
+ *
+ * @return NULL on failure, with everything created so far released
+ */
 Engine* engine_init(const char* title, int w, int h, Color background);
 
 void draw_init(Engine* engine, const Mesh* mesh, Color color, Camera cam);
 
+/**
+ * @brief Renders at a lower internal resolution to hold a raster time budget
+ *
+ * Every frame is rendered at the controller scale into a render target,
+ * then upscaled into the window with a single SDL_RenderCopy. The raster
+ * time of each frame (clear, draws, framebuffer upload) drives the scale
+ * of the next one. A target_ms <= 0 disables it (full resolution).
+ *
+ * @return 0 if the render target cannot be created
+ */
+int engine_set_dynamic_resolution(Engine* engine, float target_ms, float min_scale, float max_scale);
+
+/**
+ * @brief Renders one frame of the engine figure
+ *
+ * Starts by draining engine->commands (camera commands only: there is no
+ * scene to apply object commands to).
+ */
 void update_step(Engine* engine, Transform draw_transform);
 
+/**
+ * @brief Renders one frame of a whole scene with the engine camera
+ *
+ * Applies the complete frames queued in engine->commands to the scene
+ * and the camera, runs scene_update (culling + update_mesh on visible
+ * objects), then records every visible object in engine->render_queue,
+ * sorts it (backend, layer, shading, material, then near to far) and
+ * executes it with one draw color change per run of equal colors.
+ */
+void update_scene(Engine* engine, Scene* scene);
+
+/**
+ * @brief Renders one frame of a streaming terrain with the engine camera
+ *
+ * Runs terrain_update around the camera (queues loads, never waits for
+ * them), then draws the resident chunks with the software rasterizer.
+ */
+void update_terrain(Engine* engine, Terrain* terrain, Color color);
+
 void engine_destroy(Engine* engine);
\ No newline at end of file
@@ -7,11 +7,121 @@
 
 #define MATRIX_N 4
 
+/**
+ * @brief Row-major 4x4 matrix, 16-byte aligned
+ *
+ * Each row can be loaded as one SIMD register.
+ */
 typedef struct Matrix
 {
-    float m[MATRIX_N][MATRIX_N];
+    _Alignas(16) float m[MATRIX_N][MATRIX_N];
 } Matrix;
 
+/* **************************** SCALAR REFERENCE ****************************** */
+
+Vector4 matrix_transform_scalar(const Matrix* M, Vector4 v);
+
+void matrix_transform_array_scalar(const Matrix* M, const Vector4* in, Vector4* out, int count);
+
+void matrix_transform_points_scalar(const Matrix* M, const Vector3* in, Vector4* out, int count);
+
+void matrix_multiply_scalar(Matrix* out, const Matrix* A, const Matrix* B);
+
+void matrix_transpose_scalar(Matrix* out, const Matrix* M);
+
+int matrix_inverse_scalar(Matrix* out, const Matrix* M);
+
+/* **************************** SIMD ****************************** */
+
+// Same contracts as the scalar versions; forward to them without a SIMD backend
+
+Vector4 matrix_transform_simd(const Matrix* M, Vector4 v);
+
+void matrix_transform_array_simd(const Matrix* M, const Vector4* in, Vector4* out, int count);
+
+void matrix_transform_points_simd(const Matrix* M, const Vector3* in, Vector4* out, int count);
+
+void matrix_multiply_simd(Matrix* out, const Matrix* A, const Matrix* B);
+
+void matrix_transpose_simd(Matrix* out, const Matrix* M);
+
+int matrix_inverse_simd(Matrix* out, const Matrix* M);
+
+/* **************************** API ****************************** */
+
+/**
+ * @brief Computes M * v
+ */
+static inline Vector4 matrix_transform(const Matrix* M, Vector4 v) {
+#if MATH_SIMD
+    return matrix_transform_simd(M, v);
+#else
+    return matrix_transform_scalar(M, v);
+#endif
+}
+
+/**
+ * @brief Computes out[i] = M * in[i] for count vectors
+ *
+ * The matrix is loaded once for the whole batch. in and out may be the same array.
+ */
+static inline void matrix_transform_array(const Matrix* M, const Vector4* in, Vector4* out, int count) {
+#if MATH_SIMD
+    matrix_transform_array_simd(M, in, out, count);
+#else
+    matrix_transform_array_scalar(M, in, out, count);
+#endif
+}
+
+/**
+ * @brief Computes out[i] = M * (in[i], 1) for count points
+ *
+ * Same as matrix_transform_array on 12-byte positions: w = 1 is implied,
+ * so the last matrix column is added instead of multiplied.
+ */
+static inline void matrix_transform_points(const Matrix* M, const Vector3* in, Vector4* out, int count) {
+#if MATH_SIMD
+    matrix_transform_points_simd(M, in, out, count);
+#else
+    matrix_transform_points_scalar(M, in, out, count);
+#endif
+}
+
+/**
+ * @brief Computes out = A * B (out may alias A or B)
+ */
+static inline void matrix_multiply(Matrix* out, const Matrix* A, const Matrix* B) {
+#if MATH_SIMD
+    matrix_multiply_simd(out, A, B);
+#else
+    matrix_multiply_scalar(out, A, B);
+#endif
+}
+
+/**
+ * @brief Computes out = M^T (out may alias M)
+ */
+static inline void matrix_transpose(Matrix* out, const Matrix* M) {
+#if MATH_SIMD
+    matrix_transpose_simd(out, M);
+#else
+    matrix_transpose_scalar(out, M);
+#endif
+}
+
+/**
+ * @brief Computes out = M^-1 (out may alias M)
+ *
+ * @return 1 on success, 0 if M is singular (out is left untouched)
+ */
+static inline int matrix_inverse(Matrix* out, const Matrix* M) {
+#if MATH_SIMD
+    return matrix_inverse_simd(out, M);
+#else
+    return matrix_inverse_scalar(out, M);
+#endif
+}
+
 /**
  * @brief Applies a matrix transformation to a 4D vector
  * @param M The transformation matrix to be applied
@@ -22,9 +132,21 @@ typedef struct Matrix
  * the vector v by matrix M. The transformation can represent various
  * operations such as rotation, translation, scaling, or any combination
  * of these.
+ *
+ * Value-based convenience wrapper over matrix_transform; inlined, so the
+ * matrix is not copied.
  */
-Vector4 transform(Matrix M, Vector4 v);
+static inline Vector4 transform(Matrix M, Vector4 v) {
+    return matrix_transform(&M, v);
+}
 
-Matrix multiply(Matrix A, Matrix B);
+/**
+ * @brief Returns A * B (value-based wrapper over matrix_multiply)
+ */
+static inline Matrix multiply(Matrix A, Matrix B) {
+    Matrix C;
+    matrix_multiply(&C, &A, &B);
+    return C;
+}
 
 Vector4 extract_column(const Matrix *M, size_t j);
@@ -0,0 +1,207 @@
+#pragma once
+
+/*
+ * 4-wide float SIMD backend for the math library.
+ *
+ * The backend is chosen at compile time:
+ * - SSE2 on x86-64
+ * - NEON on AArch64 (Apple Silicon)
+ * - scalar otherwise, or when building with -DMATH_SCALAR
+ *
+ * The scalar functions (*_scalar) are always compiled and are the
+ * reference implementation the SIMD ones are tested against.
+ */
+
+#if defined(MATH_SCALAR)
+#define MATH_SIMD 0
+#define MATH_BACKEND "scalar"
+#elif defined(__SSE2__)
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#define MATH_SIMD 1
+#define MATH_SIMD_SSE 1
+#define MATH_BACKEND "SSE2"
+typedef __m128 f32x4;
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define MATH_SIMD 1
+#define MATH_SIMD_NEON 1
+#define MATH_BACKEND "NEON"
+typedef float32x4_t f32x4;
+#else
+#define MATH_SIMD 0
+#define MATH_BACKEND "scalar"
+#endif
+
+#if MATH_SIMD
+
+#include <stdint.h>
+
+#if MATH_SIMD_SSE
+
+#define f32x4_load(p)       _mm_load_ps(p)
+#define f32x4_loadu(p)      _mm_loadu_ps(p)
+#define f32x4_store(p, a)   _mm_store_ps(p, a)
+#define f32x4_storeu(p, a)  _mm_storeu_ps(p, a)
+#define f32x4_set1(s)       _mm_set1_ps(s)
+#define f32x4_zero()        _mm_setzero_ps()
+#define f32x4_add(a, b)     _mm_add_ps(a, b)
+#define f32x4_sub(a, b)     _mm_sub_ps(a, b)
+#define f32x4_mul(a, b)     _mm_mul_ps(a, b)
+#define f32x4_div(a, b)     _mm_div_ps(a, b)
+#define f32x4_madd(a, b, c) _mm_add_ps(_mm_mul_ps(a, b), c) // a * b + c
+#define f32x4_min(a, b)     _mm_min_ps(a, b)
+#define f32x4_max(a, b)     _mm_max_ps(a, b)
+#define f32x4_lane(a, i)    _mm_cvtss_f32(_mm_shuffle_ps(a, a, _MM_SHUFFLE(i, i, i, i)))
+#define f32x4_splat(a, i)   _mm_shuffle_ps(a, a, _MM_SHUFFLE(i, i, i, i))
+
+// (a[x], a[y], b[z], b[w])
+#define f32x4_shuffle(a, b, x, y, z, w) _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x))
+
+// (x, y, z, w) -> (y, z, x, w)
+#define f32x4_yzxw(a)       _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1))
+
+// Comparisons give all-ones lanes where true; movemask packs lane i's sign bit into bit i
+#define f32x4_cmple(a, b)   _mm_cmple_ps(a, b)
+#define f32x4_cmplt(a, b)   _mm_cmplt_ps(a, b)
+#define f32x4_and(a, b)     _mm_and_ps(a, b)
+#define f32x4_movemask(a)   _mm_movemask_ps(a)
+
+static inline float f32x4_hsum(f32x4 a) {
+    f32x4 shuf = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)); // (y, x, w, z)
+    f32x4 sums = _mm_add_ps(a, shuf);                            // (x+y, ., z+w, .)
+    shuf = _mm_movehl_ps(shuf, sums);                            // (z+w, ., ., .)
+    return _mm_cvtss_f32(_mm_add_ss(sums, shuf));
+}
+
+static inline f32x4 f32x4_sqrt(f32x4 a) {
+    return _mm_sqrt_ps(a);
+}
+
+// ~12-bit estimate refined with one Newton-Raphson step (~22 bits)
+static inline f32x4 f32x4_rsqrt(f32x4 a) {
+    f32x4 r = _mm_rsqrt_ps(a);
+    f32x4 half_a = _mm_mul_ps(a, _mm_set1_ps(0.5f));
+    f32x4 r2 = _mm_mul_ps(r, r);
+    return _mm_mul_ps(r, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(half_a, r2)));
+}
+
+#define F32X4_TRANSPOSE(r0, r1, r2, r3) _MM_TRANSPOSE4_PS(r0, r1, r2, r3)
+
+// Packs 4 pixels from r, g, b channels in [0, 256) (truncated) into ARGB words
+static inline void f32x4_store_argb(uint32_t* dst, f32x4 r, f32x4 g, f32x4 b, uint32_t alpha) {
+    __m128i px = _mm_or_si128(_mm_slli_epi32(_mm_cvttps_epi32(r), 16), _mm_slli_epi32(_mm_cvttps_epi32(g), 8));
+    px = _mm_or_si128(_mm_or_si128(px, _mm_cvttps_epi32(b)), _mm_set1_epi32((int)alpha));
+    _mm_storeu_si128((__m128i*)dst, px);
+}
+
+// 4 x int32 lanes, used for texel addressing
+typedef __m128i i32x4;
+
+#define i32x4_loadu(p)      _mm_loadu_si128((const __m128i*)(p))
+#define i32x4_storeu(p, a)  _mm_storeu_si128((__m128i*)(p), a)
+#define i32x4_set1(s)       _mm_set1_epi32(s)
+#define i32x4_add(a, b)     _mm_add_epi32(a, b)
+#define i32x4_and(a, b)     _mm_and_si128(a, b)
+#define i32x4_or(a, b)      _mm_or_si128(a, b)
+#define i32x4_shl(a, n)     _mm_sll_epi32(a, _mm_cvtsi32_si128(n))
+#define i32x4_shr(a, n)     _mm_srl_epi32(a, _mm_cvtsi32_si128(n)) // logical
+#define i32x4_to_f32x4(a)   _mm_cvtepi32_ps(a)
+#define f32x4_to_i32x4(a)   _mm_cvttps_epi32(a) // truncates
+
+// floor(a) as int32 (SSE2 has no floor: truncate, then step down where that rounded up)
+static inline i32x4 f32x4_floor_i32x4(f32x4 a) {
+    i32x4 t = _mm_cvttps_epi32(a);
+    return _mm_add_epi32(t, _mm_castps_si128(_mm_cmpgt_ps(_mm_cvtepi32_ps(t), a)));
+}
+
+#elif MATH_SIMD_NEON
+
+#define f32x4_load(p)       vld1q_f32(p)
+#define f32x4_loadu(p)      vld1q_f32(p)
+#define f32x4_store(p, a)   vst1q_f32(p, a)
+#define f32x4_storeu(p, a)  vst1q_f32(p, a)
+#define f32x4_set1(s)       vdupq_n_f32(s)
+#define f32x4_zero()        vdupq_n_f32(0.0f)
+#define f32x4_add(a, b)     vaddq_f32(a, b)
+#define f32x4_sub(a, b)     vsubq_f32(a, b)
+#define f32x4_mul(a, b)     vmulq_f32(a, b)
+#define f32x4_div(a, b)     vdivq_f32(a, b)
+#define f32x4_madd(a, b, c) vfmaq_f32(c, a, b) // a * b + c
+#define f32x4_min(a, b)     vminq_f32(a, b)
+#define f32x4_max(a, b)     vmaxq_f32(a, b)
+#define f32x4_lane(a, i)    vgetq_lane_f32(a, i)
+#define f32x4_splat(a, i)   vdupq_laneq_f32(a, i)
+
+// (a[x], a[y], b[z], b[w])
+#define f32x4_shuffle(a, b, x, y, z, w) __builtin_shufflevector(a, b, x, y, (z) + 4, (w) + 4)
+
+// (x, y, z, w) -> (y, z, x, w)
+static inline f32x4 f32x4_yzxw(f32x4 a) {
+    f32x4 r = vextq_f32(a, a, 1);     // (y, z, w, x)
+    r = vcopyq_laneq_f32(r, 2, a, 0); // (y, z, x, x)
+    return vcopyq_laneq_f32(r, 3, a, 3);
+}
+
+// Comparisons give all-ones lanes where true; movemask packs lane i's sign bit into bit i
+#define f32x4_cmple(a, b)   vreinterpretq_f32_u32(vcleq_f32(a, b))
+#define f32x4_cmplt(a, b)   vreinterpretq_f32_u32(vcltq_f32(a, b))
+#define f32x4_and(a, b)     vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)))
+
+static inline int f32x4_movemask(f32x4 a) {
+    static const int32_t shifts[4] = {0, 1, 2, 3};
+    uint32x4_t bits = vshrq_n_u32(vreinterpretq_u32_f32(a), 31);
+    return (int)vaddvq_u32(vshlq_u32(bits, vld1q_s32(shifts)));
+}
+
+static inline float f32x4_hsum(f32x4 a) {
+    return vaddvq_f32(a);
+}
+
+static inline f32x4 f32x4_sqrt(f32x4 a) {
+    return vsqrtq_f32(a);
+}
+
+// ~8-bit estimate refined with two Newton-Raphson steps
+static inline f32x4 f32x4_rsqrt(f32x4 a) {
+    f32x4 r = vrsqrteq_f32(a);
+    r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(a, r), r));
+    return vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(a, r), r));
+}
+
+#define F32X4_TRANSPOSE(r0, r1, r2, r3) do {                                      \
+        float32x4x2_t t01_ = vtrnq_f32(r0, r1);                                   \
+        float32x4x2_t t23_ = vtrnq_f32(r2, r3);                                   \
+        r0 = vcombine_f32(vget_low_f32(t01_.val[0]), vget_low_f32(t23_.val[0]));  \
+        r1 = vcombine_f32(vget_low_f32(t01_.val[1]), vget_low_f32(t23_.val[1]));  \
+        r2 = vcombine_f32(vget_high_f32(t01_.val[0]), vget_high_f32(t23_.val[0]));\
+        r3 = vcombine_f32(vget_high_f32(t01_.val[1]), vget_high_f32(t23_.val[1]));\
+    } while (0)
+
+// Packs 4 pixels from r, g, b channels in [0, 256) (truncated) into ARGB words
+static inline void f32x4_store_argb(uint32_t* dst, f32x4 r, f32x4 g, f32x4 b, uint32_t alpha) {
+    uint32x4_t px = vorrq_u32(vshlq_n_u32(vcvtq_u32_f32(r), 16), vshlq_n_u32(vcvtq_u32_f32(g), 8));
+    px = vorrq_u32(vorrq_u32(px, vcvtq_u32_f32(b)), vdupq_n_u32(alpha));
+    vst1q_u32(dst, px);
+}
+
+// 4 x int32 lanes, used for texel addressing
+typedef int32x4_t i32x4;
+
+#define i32x4_loadu(p)      vld1q_s32((const int32_t*)(p))
+#define i32x4_storeu(p, a)  vst1q_s32((int32_t*)(p), a)
+#define i32x4_set1(s)       vdupq_n_s32(s)
+#define i32x4_add(a, b)     vaddq_s32(a, b)
+#define i32x4_and(a, b)     vandq_s32(a, b)
+#define i32x4_or(a, b)      vorrq_s32(a, b)
+#define i32x4_shl(a, n)     vshlq_s32(a, vdupq_n_s32(n))
+#define i32x4_shr(a, n)     vreinterpretq_s32_u32(vshlq_u32(vreinterpretq_u32_s32(a), vdupq_n_s32(-(n)))) // logical
+#define i32x4_to_f32x4(a)   vcvtq_f32_s32(a)
+#define f32x4_to_i32x4(a)   vcvtq_s32_f32(a) // truncates
+#define f32x4_floor_i32x4(a) vcvtmq_s32_f32(a)
+
+#endif
+
+#define f32x4_swizzle(a, x, y, z, w) f32x4_shuffle(a, a, x, y, z, w)
+
+#endif // MATH_SIMD
@@ -2,6 +2,8 @@
 
 #include "math.h"
 
+#include "math/simd.h"
+
 #define NULL_VECTOR3 (Vector3) {0.0f, 0.0f, 0.0f}
 #define NULL_VECTOR4 (Vector4) {0.0f, 0.0f, 0.0f, 0.0f}
 
@@ -24,10 +26,16 @@
  * @field z The z component
  * @field w The w component (1 for points, 0 for directions)
  * @field v Alternative array access (v[0]=x, v[1]=y, v[2]=z, v[3]=w)
+ * @field simd SIMD register view (only with a SIMD backend, see math/simd.h)
+ *
+ * Always 16-byte aligned so that it can be loaded with aligned SIMD loads.
  */
 typedef union {
     struct { float x, y, z, w; };
-    float v[4];
+    _Alignas(16) float v[4];
+#if MATH_SIMD
+    f32x4 simd;
+#endif
 } Vector4;
 
 typedef union {
@@ -55,6 +63,11 @@ typedef union {
     Vector4: dot4 \
 )(a, b)
 
+#define cross(a, b) _Generic((a), \
+    Vector3: cross3, \
+    Vector4: cross4 \
+)(a, b)
+
 #define norm(a) _Generic((a), \
     Vector3: norm3, \
     Vector4: norm4 \
@@ -65,6 +78,40 @@ typedef union {
     Vector4: normalize4 \
 )(a)
 
+// Uses an approximate reciprocal square root (relative error ~1e-6)
+#define normalize_fast(a) _Generic((a), \
+    Vector3: normalize3_fast, \
+    Vector4: normalize4_fast \
+)(a)
+
+/* **************************** SCALAR REFERENCE ****************************** */
+
+static inline Vector4 add4_scalar(Vector4 v1, Vector4 v2) {
+    return (Vector4){v1.x + v2.x, v1.y + v2.y, v1.z + v2.z, v1.w + v2.w};
+}
+
+static inline float dot4_scalar(Vector4 v1, Vector4 v2) {
+    return (v1.x * v2.x) + (v1.y * v2.y) + (v1.z * v2.z) + (v1.w * v2.w);
+}
+
+// Cross product of the xyz parts, w = 0
+static inline Vector4 cross4_scalar(Vector4 v1, Vector4 v2) {
+    return (Vector4){(v1.y * v2.z - v1.z * v2.y), (v1.z * v2.x - v1.x * v2.z), (v1.x * v2.y - v1.y * v2.x), 0.0f};
+}
+
+static inline Vector4 normalize4_scalar(Vector4 v) {
+    float v_norm = sqrtf(dot4_scalar(v, v));
+    return (Vector4){v.x / v_norm, v.y / v_norm, v.z / v_norm, v.w / v_norm};
+}
+
+static inline float rsqrt_fast(float x) {
+#if MATH_SIMD
+    return f32x4_lane(f32x4_rsqrt(f32x4_set1(x)), 0);
+#else
+    return 1.0f / sqrtf(x);
+#endif
+}
+
 static inline Vector4 neg4(Vector4 v) {
     return (Vector4){-v.x, -v.y, -v.z, -v.w};
 }
@@ -74,7 +121,11 @@ static inline Vector3 neg3(Vector3 v) {
 }
 
 static inline Vector4 add4(Vector4 v1, Vector4 v2) {
-    return (Vector4){v1.x + v2.x, v1.y + v2.y, v1.z + v2.z, v1.w + v2.w};
+#if MATH_SIMD
+    return (Vector4){ .simd = f32x4_add(v1.simd, v2.simd) };
+#else
+    return add4_scalar(v1, v2);
+#endif
 }
 
 static inline Vector3 add3(Vector3 v1, Vector3 v2) {
@@ -82,19 +133,41 @@ static inline Vector3 add3(Vector3 v1, Vector3 v2) {
 }
 
 static inline Vector4 subtract4(Vector4 v1, Vector4 v2) {
+#if MATH_SIMD
+    return (Vector4){ .simd = f32x4_sub(v1.simd, v2.simd) };
+#else
     return (Vector4){v1.x - v2.x, v1.y - v2.y, v1.z - v2.z, v1.w - v2.w};
+#endif
 }
 
 static inline Vector3 subtract3(Vector3 v1, Vector3 v2) {
     return (Vector3){v1.x - v2.x, v1.y - v2.y, v1.z - v2.z};
 }
 
-static inline Vector3 cross(Vector3 v1, Vector3 v2) {
+static inline Vector3 cross3(Vector3 v1, Vector3 v2) {
     return (Vector3) {(v1.y * v2.z - v1.z * v2.y), (v1.z * v2.x - v1.x * v2.z), (v1.x * v2.y - v1.y * v2.x)};
 }
 
+static inline Vector4 cross4(Vector4 v1, Vector4 v2) {
+#if MATH_SIMD
+    // a.yzx * b.zxy - a.zxy * b.yzx, computed as (a * b.yzx - a.yzx * b).yzx
+    f32x4 a_yzx = f32x4_yzxw(v1.simd);
+    f32x4 b_yzx = f32x4_yzxw(v2.simd);
+    f32x4 c = f32x4_sub(f32x4_mul(v1.simd, b_yzx), f32x4_mul(a_yzx, v2.simd));
+    Vector4 r = { .simd = f32x4_yzxw(c) };
+    r.w = 0.0f;
+    return r;
+#else
+    return cross4_scalar(v1, v2);
+#endif
+}
+
 static inline float dot4(Vector4 v1, Vector4 v2) {
-    return (v1.x * v2.x) + (v1.y * v2.y) + (v1.z * v2.z) + (v1.w * v2.w);
+#if MATH_SIMD
+    return f32x4_hsum(f32x4_mul(v1.simd, v2.simd));
+#else
+    return dot4_scalar(v1, v2);
+#endif
 }
 
 static inline float dot3(Vector3 v1, Vector3 v2) {
@@ -102,16 +175,20 @@ static inline float dot3(Vector3 v1, Vector3 v2) {
 }
 
 static inline float norm4(Vector4 v) {
-    return sqrt(pow(v.x, 2) + pow(v.y, 2) + pow(v.z, 2) + pow(v.w, 2));
+    return sqrtf(dot4(v, v));
 }
 
 static inline float norm3(Vector3 v) {
-    return sqrt(pow(v.x, 2) + pow(v.y, 2) + pow(v.z, 2));
+    return sqrtf(dot3(v, v));
 }
 
 static inline Vector4 normalize4(Vector4 v) {
-    float v_norm = norm(v);
-    return (Vector4){v.x / v_norm, v.y / v_norm, v.z / v_norm, v.w / v_norm};
+#if MATH_SIMD
+    float inv = 1.0f / sqrtf(dot4(v, v));
+    return (Vector4){ .simd = f32x4_mul(v.simd, f32x4_set1(inv)) };
+#else
+    return normalize4_scalar(v);
+#endif
 }
 
 static inline Vector3 normalize3(Vector3 v) {
@@ -119,6 +196,19 @@ static inline Vector3 normalize3(Vector3 v) {
     return (Vector3){v.x / v_norm, v.y / v_norm, v.z / v_norm};
 }
 
-static inline Vector4 array_to_vect(float arr[4]) {
+static inline Vector4 normalize4_fast(Vector4 v) {
+#if MATH_SIMD
+    return (Vector4){ .simd = f32x4_mul(v.simd, f32x4_rsqrt(f32x4_set1(dot4(v, v)))) };
+#else
+    return normalize4_scalar(v);
+#endif
+}
+
+static inline Vector3 normalize3_fast(Vector3 v) {
+    float inv = rsqrt_fast(dot3(v, v));
+    return (Vector3){v.x * inv, v.y * inv, v.z * inv};
+}
+
+static inline Vector4 array_to_vect(const float arr[4]) {
     return (Vector4){arr[0], arr[1], arr[2], arr[3]};
 }
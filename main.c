@@ -1,7 +1,10 @@
 #include <SDL.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "engine.h"
+#include "core/replay.h"
+#include "core/capture.h"
 
 #define SHOW_FPS 1
 
@@ -15,17 +18,204 @@
 #define CAM_TARGET (Vector3){0.0f, 0.0f, 0.0f}
 #define CAM_UP (Vector3){0.0f, 1.0f,  0.0f}
 
+#define CHECKER_SIZE 64
+#define CHECKER_SQUARE 8
+
+// Dynamic resolution: raster budget and scale bounds
+#define RASTER_BUDGET_MS 4.0f
+#define MIN_RENDER_SCALE 0.5f
+#define MAX_RENDER_SCALE 1.0f
+
+// Frame capture: buffers queued before frames are dropped
+#define CAPTURE_RING 8
+#define CAPTURE_FPS 60
+
+// Threaded mode: simulation rate and command queue size
+#define SIMULATION_HZ 120
+#define COMMAND_CAPACITY 256
+#define COMMAND_ARENA_BYTES (16 << 10)
+
 #define ROTATION_SPEED 45.0f // in degree
 #define TRANSLATION_SPEED 5.0f
 #define SCALE_SPEED 1.5f
 
+// Object movement keys, also the bits of the held-key mask in threaded mode
+static const SDL_Keycode MOVE_KEYS[] = {
+    SDLK_UP, SDLK_DOWN, SDLK_LEFT, SDLK_RIGHT, SDLK_w, SDLK_s, SDLK_d, SDLK_a,
+    SDLK_q, SDLK_e, SDLK_y, SDLK_x, SDLK_c, SDLK_v, SDLK_b, SDLK_n
+};
+#define MOVE_KEY_COUNT (int)(sizeof(MOVE_KEYS) / sizeof(MOVE_KEYS[0]))
+
+static void move(Transform* t, SDL_Keycode key, float dr, float ds, float dz) {
+    switch (key) {
+        case SDLK_UP:    t->rotation.x -= dr; break;
+        case SDLK_DOWN:  t->rotation.x += dr; break;
+        case SDLK_LEFT:  t->rotation.y -= dr; break;
+        case SDLK_RIGHT: t->rotation.y += dr; break;
+        case SDLK_w:    t->translation.z -= ds; break;
+        case SDLK_s:    t->translation.z += ds; break;
+        case SDLK_d:    t->translation.x -= ds; break;
+        case SDLK_a:    t->translation.x += ds; break;
+        case SDLK_q:    t->translation.y -= ds; break;
+        case SDLK_e:    t->translation.y += ds; break;
+        case SDLK_y:    t->scale.x += dz; break;
+        case SDLK_x:    t->scale.x -= dz; break;
+        case SDLK_c:    t->scale.y += dz; break;
+        case SDLK_v:    t->scale.y -= dz; break;
+        case SDLK_b:    t->scale.z += dz; break;
+        case SDLK_n:    t->scale.z -= dz; break;
+    }
+}
+
+/* **************************** THREADED MODE ****************************** */
+
+/**
+ * @brief State shared by the render (main) thread and the simulation thread
+ *
+ * @field keys Bit i set while MOVE_KEYS[i] is held (written by the render thread)
+ * @field spawns, despawns Space / Backspace presses so far (written by the render thread)
+ */
+typedef struct Simulation {
+    CommandQueue* queue;
+    const Mesh* mesh;
+    SDL_atomic_t keys;
+    SDL_atomic_t spawns;
+    SDL_atomic_t despawns;
+    SDL_atomic_t quit;
+} Simulation;
+
+// Fixed-rate simulation: moves the figure (object 0) and spawns cubes around it, as commands
+static int simulate(void* data) {
+    Simulation* sim = data;
+    Transform figure = NO_TRANSFORM;
+    int objects = 1, spawned = 0, despawned = 0;
+    float step = 1.0f / SIMULATION_HZ;
+    float dr = ROTATION_SPEED * (M_PI / 180.0f) * step, ds = TRANSLATION_SPEED * step, dz = SCALE_SPEED * step;
+
+    while (!SDL_AtomicGet(&sim->quit)) {
+        Uint32 tick = SDL_GetTicks();
+
+        // Render thread more than COMMAND_FRAMES behind: skip this step
+        if (command_begin_frame(sim->queue)) {
+            int keys = SDL_AtomicGet(&sim->keys);
+            for (int k = 0; k < MOVE_KEY_COUNT; k++)
+                if (keys & (1 << k)) move(&figure, MOVE_KEYS[k], dr, ds, dz);
+            figure.rotation.x += dr;
+            figure.rotation.y += dr;
+            figure.rotation.z += dr;
+            command_push_transform(sim->queue, 0, figure);
+
+            for (int spawns = SDL_AtomicGet(&sim->spawns); spawned < spawns; spawned++) {
+                Transform t = NO_TRANSFORM;
+                t.translation = (Vector3){3.0f * cosf(objects * 0.9f), 3.0f * sinf(objects * 0.9f), -2.0f};
+                t.scale = (Vector3){0.4f, 0.4f, 0.4f};
+                if (command_push_mesh_add(sim->queue, sim->mesh, RED, t, 0)) objects++;
+            }
+            for (int despawns = SDL_AtomicGet(&sim->despawns); despawned < despawns; despawned++)
+                if (objects > 1 && command_push_mesh_remove(sim->queue, objects - 1)) objects--;
+
+            while (!command_end_frame(sim->queue) && !SDL_AtomicGet(&sim->quit))
+                SDL_Delay(0);
+        }
+
+        Uint32 elapsed = SDL_GetTicks() - tick;
+        if (elapsed < 1000 / SIMULATION_HZ) SDL_Delay(1000 / SIMULATION_HZ - elapsed);
+    }
+    return 0;
+}
+
+// Render thread: events and drawing only, the scene changes through engine->commands
+static void run_threaded(Engine* engine, const Mesh* mesh) {
+    Scene* scene = scene_create(16);
+    CommandQueue* queue = command_queue_create(COMMAND_CAPACITY, COMMAND_ARENA_BYTES);
+    if (!scene || !queue || scene_add(scene, mesh, RED, NO_TRANSFORM, 0) < 0) {
+        printf("Cannot start the simulation thread\n");
+        if (queue) command_queue_destroy(queue);
+        if (scene) scene_destroy(scene);
+        return;
+    }
+
+    scene->lighting = &engine->lighting;
+    Simulation sim = {.queue = queue, .mesh = mesh};
+    engine->commands = queue;
+    SDL_Thread* thread = SDL_CreateThread(simulate, "simulation", &sim);
+    RenderBackend backend = RENDER_SDL;
+    ShadeMode shading = SHADE_WIREFRAME;
+    int keys = 0, running = thread != NULL;
+
+    while (running) {
+        SDL_Event event;
+        while (SDL_PollEvent(&event)) {
+            if (event.type == SDL_QUIT) running = 0;
+            if (event.type != SDL_KEYDOWN && event.type != SDL_KEYUP) continue;
+
+            SDL_Keycode key = event.key.keysym.sym;
+            for (int k = 0; k < MOVE_KEY_COUNT; k++)
+                if (key == MOVE_KEYS[k]) keys = event.type == SDL_KEYDOWN ? keys | (1 << k) : keys & ~(1 << k);
+            SDL_AtomicSet(&sim.keys, keys);
+
+            if (event.type != SDL_KEYDOWN) continue;
+            switch (key) {
+                case SDLK_ESCAPE: running = 0; break;
+                case SDLK_SPACE: SDL_AtomicAdd(&sim.spawns, 1); break;
+                case SDLK_BACKSPACE: SDL_AtomicAdd(&sim.despawns, 1); break;
+                case SDLK_r: backend = backend == RENDER_SDL ? RENDER_SOFTWARE : RENDER_SDL; break;
+                case SDLK_f: shading = (shading + 1) % SHADE_TEXTURED; break;
+                case SDLK_g:
+                    engine_set_dynamic_resolution(engine, engine->dynamic_resolution ? 0.0f : RASTER_BUDGET_MS,
+                                                  MIN_RENDER_SCALE, MAX_RENDER_SCALE);
+                    break;
+            }
+        }
+
+        // Objects added by the simulation pick up the current draw settings
+        for (int i = 0; i < scene->count; i++) {
+            scene->objects[i].draw.backend = backend;
+            scene->objects[i].draw.shading = shading;
+        }
+        update_scene(engine, scene);
+    }
+
+    SDL_AtomicSet(&sim.quit, 1);
+    if (thread) SDL_WaitThread(thread, NULL);
+    engine->commands = NULL;
+    CommandStats stats = queue->stats;
+    printf("Simulation: %d frames, %d applied, %d stalls\n", stats.frames_ended, stats.frames_applied, stats.stalls);
+    command_queue_destroy(queue);
+    scene_destroy(scene);
+}
+
 int main(int argc, char *argv[]) {
+    // --record <file>: capture the session for perf_test_replay
+    // --capture <file>: write the software-rendered frames to a .y4m (or .ppm) video
+    // --threaded: simulation on its own thread, sending commands to the render thread
+    // --strict-memory: abort if a frame touches the heap
+    // --stats <file>: log the counters and stage times of every frame as CSV
+    const char* record_path = NULL;
+    const char* capture_path = NULL;
+    const char* stats_path = NULL;
+    int threaded = 0;
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "--record") == 0) record_path = argv[i + 1];
+        if (i + 1 < argc && strcmp(argv[i], "--capture") == 0) capture_path = argv[i + 1];
+        if (i + 1 < argc && strcmp(argv[i], "--stats") == 0) stats_path = argv[i + 1];
+        if (strcmp(argv[i], "--threaded") == 0) threaded = 1;
+        if (strcmp(argv[i], "--strict-memory") == 0) memory_set_strict(1);
+    }
+
     Engine* engine = engine_init("3d engine", WIN_WIDTH, WIN_HEIGHT, BLACK);
     if (engine == NULL) {
         printf("Error during engine creation: %s\n", SDL_GetError());
         return 1;
     }
 
+    FILE* stats_csv = NULL;
+    if (stats_path) {
+        stats_csv = fopen(stats_path, "w");
+        if (!stats_csv) printf("Cannot log stats to %s\n", stats_path);
+        frame_stats_set_csv(engine->stats, stats_csv);
+    }
+
     // 8 unique cube vertices
     Vector4 cube_vertices[8] = {
         {-1, -1, -1, 1},  // 0
@@ -50,6 +240,18 @@ int main(int argc, char *argv[]) {
 
     Mesh* cube = mesh_generate(cube_vertices, 8, cube_triangles, 12);
 
+    // Planar mapping on x/y: front and back faces get the whole texture
+    TexCoord cube_uvs[8];
+    for (int i = 0; i < 8; i++)
+        cube_uvs[i] = (TexCoord){(cube_vertices[i].x + 1) * 0.5f, (1 - cube_vertices[i].y) * 0.5f};
+    mesh_set_uvs(cube, cube_uvs);
+
+    uint32_t checker[CHECKER_SIZE * CHECKER_SIZE];
+    for (int y = 0; y < CHECKER_SIZE; y++)
+        for (int x = 0; x < CHECKER_SIZE; x++)
+            checker[y * CHECKER_SIZE + x] = ((x / CHECKER_SQUARE + y / CHECKER_SQUARE) & 1) ? 0xFFFFFFFFu : 0xFFC03030u;
+    Texture* texture = texture_create(checker, CHECKER_SIZE, CHECKER_SIZE, TEXTURE_MORTON);
+
     Camera cam = {
         .pos    = CAM_POS,   // placed a bit away from the origin
         .target = CAM_TARGET,   // looking at the origin
@@ -57,6 +259,31 @@ int main(int argc, char *argv[]) {
     };
 
     draw_init(engine, cube, RED, cam);
+    engine->draw->texture = texture;
+
+    if (threaded) {
+        run_threaded(engine, cube);
+        engine_destroy(engine);
+        if (texture) texture_destroy(texture);
+        if (stats_csv) fclose(stats_csv);
+        return 0;
+    }
+
+    Recorder* recorder = NULL;
+    if (record_path) {
+        recorder = recorder_open(record_path, WIN_WIDTH, WIN_HEIGHT, BLACK);
+        if (!recorder) printf("Cannot record to %s\n", record_path);
+    }
+
+    Capture* capture = NULL;
+    if (capture_path) {
+        size_t len = strlen(capture_path);
+        CaptureFormat format = len > 4 && strcmp(capture_path + len - 4, ".ppm") == 0 ? CAPTURE_PPM : CAPTURE_Y4M;
+        capture = capture_open(capture_path, format, WIN_WIDTH, WIN_HEIGHT, CAPTURE_RING, CAPTURE_DROP, CAPTURE_FPS);
+        if (!capture) printf("Cannot capture to %s\n", capture_path);
+        // Only the software rasterizer leaves the frame in the CPU framebuffer
+        else engine->draw->backend = RENDER_SOFTWARE;
+    }
     
     int running = 1;
     SDL_Event event;
@@ -86,22 +313,19 @@ int main(int argc, char *argv[]) {
             if (event.type == SDL_KEYDOWN) {
                 switch (event.key.keysym.sym) {
                     case SDLK_ESCAPE: running = 0; break;
-                    case SDLK_UP:    draw_transform.rotation.x -= dr; break;
-                    case SDLK_DOWN:  draw_transform.rotation.x += dr; break;
-                    case SDLK_LEFT:  draw_transform.rotation.y -= dr; break;
-                    case SDLK_RIGHT: draw_transform.rotation.y += dr; break;
-                    case SDLK_w:    draw_transform.translation.z -= ds; break;
-                    case SDLK_s:    draw_transform.translation.z += ds; break;
-                    case SDLK_d:    draw_transform.translation.x -= ds; break;
-                    case SDLK_a:    draw_transform.translation.x += ds; break;
-                    case SDLK_q:    draw_transform.translation.y -= ds; break;
-                    case SDLK_e:    draw_transform.translation.y += ds; break;
-                    case SDLK_y:    draw_transform.scale.x += dz; break;
-                    case SDLK_x:    draw_transform.scale.x -= dz; break;
-                    case SDLK_c:    draw_transform.scale.y += dz; break;
-                    case SDLK_v:    draw_transform.scale.y -= dz; break;
-                    case SDLK_b:    draw_transform.scale.z += dz; break;
-                    case SDLK_n:    draw_transform.scale.z -= dz; break;
+                    case SDLK_r:
+                        engine->draw->backend = engine->draw->backend == RENDER_SDL ? RENDER_SOFTWARE : RENDER_SDL;
+                        break;
+                    case SDLK_f:
+                        engine->draw->shading = (engine->draw->shading + 1) % (SHADE_TEXTURED + 1);
+                        break;
+                    case SDLK_g:
+                        engine_set_dynamic_resolution(engine, engine->dynamic_resolution ? 0.0f : RASTER_BUDGET_MS,
+                                                      MIN_RENDER_SCALE, MAX_RENDER_SCALE);
+                        break;
+                    default:
+                        move(&draw_transform, event.key.keysym.sym, dr, ds, dz);
+                        break;
                 }
             }
         }
@@ -111,6 +335,15 @@ int main(int argc, char *argv[]) {
         draw_transform.rotation.z += dr;
 
         update_step(engine, draw_transform);
+
+        if (recorder && !recorder_frame(recorder, delta_time, engine->figure, engine->draw, draw_transform,
+                                        engine->camera, engine->projection, &engine->lighting)) {
+            printf("Recording stopped: cannot write %s\n", record_path);
+            recorder_close(recorder);
+            recorder = NULL;
+        }
+        if (capture && engine->draw->backend == RENDER_SOFTWARE)
+            capture_frame(capture, engine->framebuffer);
         
         // FPS calculation and display every second
         if (SHOW_FPS) {
@@ -120,7 +353,13 @@ int main(int argc, char *argv[]) {
                 fps = frames * 1000.0f / fps_elapsed;
                 frames = 0;
                 last_fps_time = current_time;
-                printf("FPS: %.2f\n", fps);
+                FrameSummary frame = frame_stats_summary(engine->stats, FRAME_TOTAL_MS);
+                const double* last = engine->stats->last;
+                printf("FPS: %.2f (frame %.2f ms avg, %.2f max; last frame %.0f triangles, %.0f pixels, "
+                       "%.0f allocations; render scale %.2f, %dx%d, saved %.2f ms)\n", fps, frame.avg, frame.max,
+                       last[FRAME_TRIANGLES], last[FRAME_PIXELS], last[FRAME_ALLOCATIONS],
+                       engine->resolution_stats.scale, engine->resolution_stats.width,
+                       engine->resolution_stats.height, engine->resolution_stats.saved_ms);
             }
         }
 
@@ -128,6 +367,18 @@ int main(int argc, char *argv[]) {
         last_time = current_time;
     }
 
+    if (recorder && !recorder_close(recorder))
+        printf("Recording %s is incomplete\n", record_path);
+    if (capture) {
+        CaptureStats stats;
+        if (!capture_close(capture, &stats))
+            printf("Capture %s is incomplete\n", capture_path);
+        printf("Captured %d of %d frames (%d dropped), copy %.3f ms/frame, %.1f MB written\n", stats.captured,
+               stats.submitted, stats.dropped, stats.submitted ? stats.copy_ms / stats.submitted : 0.0,
+               stats.bytes_written / 1048576.0);
+    }
     engine_destroy(engine);
+    if (texture) texture_destroy(texture);
+    if (stats_csv) fclose(stats_csv);
     return 0;
 }
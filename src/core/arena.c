@@ -0,0 +1,41 @@
+#include <stdlib.h>
+
+#include "core/arena.h"
+#include "core/memory.h"
+
+Arena* arena_create(size_t capacity) {
+    Arena* arena = memory_calloc(MEMORY_ARENA, 1, sizeof(Arena));
+    if (!arena) return NULL;
+
+    // Rounded up so the block end stays aligned
+    arena->capacity = (capacity + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+    arena->data = memory_aligned_alloc(MEMORY_ARENA, ARENA_ALIGNMENT, arena->capacity > 0 ? arena->capacity : ARENA_ALIGNMENT);
+    if (!arena->data) {
+        memory_free(MEMORY_ARENA, arena);
+        return NULL;
+    }
+
+    return arena;
+}
+
+void* arena_alloc(Arena* arena, size_t size) {
+    size_t padded = (size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+    if (padded > arena->capacity - arena->used) {
+        arena->failed++;
+        return NULL;
+    }
+
+    void* block = arena->data + arena->used;
+    arena->used += padded;
+    if (arena->used > arena->peak) arena->peak = arena->used;
+    return block;
+}
+
+void arena_reset(Arena* arena) {
+    arena->used = 0;
+}
+
+void arena_destroy(Arena* arena) {
+    memory_free(MEMORY_ARENA, arena->data);
+    memory_free(MEMORY_ARENA, arena);
+}
@@ -0,0 +1,285 @@
+#include <string.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+#include "core/assets.h"
+#include "core/memory.h"
+
+static inline double elapsed_ms(Uint64 start) {
+    return (double)((SDL_GetPerformanceCounter() - start) * 1000) / (double)SDL_GetPerformanceFrequency();
+}
+
+static void wake_loader(Assets* assets) {
+    char byte = 0;
+    if (write(assets->wake[1], &byte, 1) < 0) {
+        // Pipe full: the loader has a wake-up pending anyway
+    }
+}
+
+/* **************************** LOADER THREAD ****************************** */
+
+// Modification time and size, {-1, -1} if the file is missing
+static void file_stamp(const char* path, long long stamp[2]) {
+    struct stat info;
+    if (stat(path, &info) != 0) {
+        stamp[0] = stamp[1] = -1;
+        return;
+    }
+    stamp[0] = (long long)info.st_mtime;
+    stamp[1] = (long long)info.st_size;
+}
+
+// Directories are watched rather than files: editors often save to a new file renamed over the old one
+static void watch_asset(Assets* assets, Asset* asset) {
+    const char* slash = strrchr(asset->path, '/');
+    asset->name = slash ? slash + 1 : asset->path;
+    asset->watch = -1;
+#ifdef __linux__
+    if (assets->notify >= 0) {
+        char directory[ASSETS_PATH_MAX] = ".";
+        if (slash) {
+            size_t length = slash > asset->path ? (size_t)(slash - asset->path) : 1;
+            memcpy(directory, asset->path, length);
+            directory[length] = '\0';
+        }
+        asset->watch = inotify_add_watch(assets->notify, directory, IN_CLOSE_WRITE | IN_MOVED_TO);
+    }
+#else
+    (void)assets;
+#endif
+    file_stamp(asset->path, asset->stamp);
+    asset->pending = 1;
+}
+
+static void read_events(Assets* assets, int count) {
+#ifdef __linux__
+    _Alignas(struct inotify_event) char buffer[4096];
+    ssize_t size;
+    while ((size = read(assets->notify, buffer, sizeof(buffer))) > 0)
+        for (char* p = buffer; p < buffer + size;) {
+            const struct inotify_event* event = (const struct inotify_event*)p;
+            p += sizeof(struct inotify_event) + event->len;
+
+            // Events were dropped: reload everything
+            int overflow = (event->mask & IN_Q_OVERFLOW) != 0;
+            for (int i = 0; i < count; i++) {
+                Asset* asset = &assets->assets[i];
+                if (overflow || (event->len && asset->watch == event->wd && strcmp(asset->name, event->name) == 0))
+                    asset->pending = 1;
+            }
+        }
+#else
+    (void)assets;
+    (void)count;
+#endif
+}
+
+// Assets without an inotify watch: reload when the file time or size changed
+static void poll_stamps(Assets* assets, int count) {
+    for (int i = 0; i < count; i++) {
+        Asset* asset = &assets->assets[i];
+        if (asset->watch >= 0) continue;
+
+        long long stamp[2];
+        file_stamp(asset->path, stamp);
+        if (stamp[0] != asset->stamp[0] || stamp[1] != asset->stamp[1]) {
+            memcpy(asset->stamp, stamp, sizeof(stamp));
+            asset->pending = 1;
+        }
+    }
+}
+
+// Loads every due asset whose previous version was taken by assets_update
+static void load_pending(Assets* assets, int count) {
+    for (int i = 0; i < count && !SDL_AtomicGet(&assets->quit); i++) {
+        Asset* asset = &assets->assets[i];
+        if (!asset->pending || SDL_AtomicGet(&asset->in_flight)) continue;
+        asset->pending = 0;
+
+        Uint64 start = SDL_GetPerformanceCounter();
+        Mesh* mesh = cook_load_mesh(asset->path, &assets->cook, assets->cache_dir[0] ? assets->cache_dir : NULL,
+                                    NULL, NULL);
+
+        // Never full: one load per asset at most, and the ring holds capacity of them
+        AssetLoad load = {i, mesh, elapsed_ms(start)};
+        SDL_AtomicSet(&asset->in_flight, 1);
+        spsc_push(assets->ready, &load);
+    }
+}
+
+static int loader_main(void* data) {
+    Assets* assets = data;
+    int count = 0;
+
+    // Loads yield to the frame when they share a core with the main thread
+    SDL_SetThreadPriority(SDL_THREAD_PRIORITY_LOW);
+
+    for (;;) {
+        // Sleep until woken or a file changes, or poll when some asset needs it
+        int polled = 0;
+        for (int i = 0; i < count; i++)
+            polled |= assets->assets[i].watch < 0 || assets->assets[i].pending;
+        struct pollfd fds[2] = {{assets->wake[0], POLLIN, 0}, {assets->notify, POLLIN, 0}};
+        poll(fds, assets->notify >= 0 ? 2 : 1, polled ? ASSETS_POLL_MS : -1);
+
+        char drain[64];
+        while (read(assets->wake[0], drain, sizeof(drain)) > 0);
+        if (SDL_AtomicGet(&assets->quit)) break;
+
+        int published = SDL_AtomicGet(&assets->published);
+        for (; count < published; count++)
+            watch_asset(assets, &assets->assets[count]);
+
+        if (assets->notify >= 0) read_events(assets, count);
+        poll_stamps(assets, count);
+        load_pending(assets, count);
+    }
+
+    return 0;
+}
+
+/* **************************** MAIN THREAD ****************************** */
+
+Assets* assets_create(int capacity, int frames_in_flight) {
+    if (capacity <= 0 || frames_in_flight <= 0) return NULL;
+
+    Assets* assets = memory_calloc(MEMORY_ASSETS, 1, sizeof(Assets));
+    if (!assets) return NULL;
+
+    assets->capacity = capacity;
+    assets->frames_in_flight = frames_in_flight;
+    assets->wake[0] = assets->wake[1] = -1;
+    assets->notify = -1;
+    assets->cook = COOK_DEFAULTS;
+
+    assets->assets = memory_calloc(MEMORY_ASSETS, capacity, sizeof(Asset));
+    assets->retired_capacity = capacity * (frames_in_flight + 1);
+    assets->retired = memory_alloc(MEMORY_ASSETS, sizeof(AssetRetired) * assets->retired_capacity);
+    assets->ready = spsc_create(capacity, sizeof(AssetLoad));
+    if (!assets->assets || !assets->retired || !assets->ready || pipe(assets->wake) != 0) {
+        assets_destroy(assets);
+        return NULL;
+    }
+    fcntl(assets->wake[0], F_SETFL, O_NONBLOCK);
+    fcntl(assets->wake[1], F_SETFL, O_NONBLOCK);
+
+#ifdef __linux__
+    // Without inotify (limit reached), file times are polled
+    assets->notify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+
+    assets->loader = SDL_CreateThread(loader_main, "assets_loader", assets);
+    if (!assets->loader) {
+        assets_destroy(assets);
+        return NULL;
+    }
+
+    return assets;
+}
+
+int assets_set_cooking(Assets* assets, CookOptions options, const char* cache_dir) {
+    if (assets->count > 0 || (cache_dir && strlen(cache_dir) >= ASSETS_PATH_MAX)) return 0;
+
+    assets->cook = options;
+    strcpy(assets->cache_dir, cache_dir ? cache_dir : "");
+    return 1;
+}
+
+int assets_add_mesh(Assets* assets, const char* path) {
+    if (assets->count == assets->capacity || strlen(path) >= ASSETS_PATH_MAX) return -1;
+
+    Asset* asset = &assets->assets[assets->count];
+    strcpy(asset->path, path);
+    asset->mesh = NULL;
+    asset->version = 0;
+    SDL_AtomicSet(&asset->in_flight, 0);
+
+    // The loader reads the asset only once it is counted in published
+    SDL_AtomicSet(&assets->published, assets->count + 1);
+    wake_loader(assets);
+    return assets->count++;
+}
+
+int assets_update(Assets* assets, Uint64 frame) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    AssetsStats* stats = &assets->stats;
+    int published = 0;
+
+    // Loads stay in the ring while the retired list is full (several updates for the same frame)
+    AssetLoad load;
+    while (assets->retired_count < assets->retired_capacity && spsc_pop(assets->ready, &load)) {
+        Asset* asset = &assets->assets[load.handle];
+        stats->total_load_ms += load.load_ms;
+        if (load.load_ms > stats->max_load_ms) stats->max_load_ms = load.load_ms;
+
+        if (load.mesh) {
+            Mesh* replaced = SDL_AtomicSetPtr((void**)&asset->mesh, load.mesh);
+            asset->version++;
+            stats->loads++;
+            published++;
+            if (replaced) {
+                stats->reloads++;
+                assets->retired[assets->retired_count++] = (AssetRetired){replaced, frame};
+            }
+        } else {
+            stats->errors++;
+        }
+
+        // The loader may start on the next version
+        SDL_AtomicSet(&asset->in_flight, 0);
+    }
+
+    // Free the versions no frame in flight can read any more, keeping the others in order
+    int kept = 0;
+    for (int i = 0; i < assets->retired_count; i++) {
+        if (frame >= assets->retired[i].frame + assets->frames_in_flight) {
+            mesh_destroy(assets->retired[i].mesh);
+            stats->retired++;
+        } else {
+            assets->retired[kept++] = assets->retired[i];
+        }
+    }
+    assets->retired_count = kept;
+
+    stats->last_update_ms = elapsed_ms(start);
+    if (stats->last_update_ms > stats->max_update_ms) stats->max_update_ms = stats->last_update_ms;
+    return published;
+}
+
+const Mesh* assets_mesh(Assets* assets, int handle) {
+    return SDL_AtomicGetPtr((void**)&assets->assets[handle].mesh);
+}
+
+void assets_destroy(Assets* assets) {
+    if (!assets) return;
+
+    if (assets->loader) {
+        SDL_AtomicSet(&assets->quit, 1);
+        wake_loader(assets);
+        SDL_WaitThread(assets->loader, NULL);
+    }
+
+    if (assets->ready) {
+        AssetLoad load;
+        while (spsc_pop(assets->ready, &load))
+            if (load.mesh) mesh_destroy(load.mesh);
+        spsc_destroy(assets->ready);
+    }
+    for (int i = 0; i < assets->count; i++)
+        if (assets->assets[i].mesh) mesh_destroy(assets->assets[i].mesh);
+    for (int i = 0; i < assets->retired_count; i++)
+        mesh_destroy(assets->retired[i].mesh);
+
+    for (int i = 0; i < 2; i++)
+        if (assets->wake[i] >= 0) close(assets->wake[i]);
+    if (assets->notify >= 0) close(assets->notify);
+
+    memory_free(MEMORY_ASSETS, assets->assets);
+    memory_free(MEMORY_ASSETS, assets->retired);
+    memory_free(MEMORY_ASSETS, assets);
+}
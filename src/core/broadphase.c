@@ -0,0 +1,249 @@
+#include <math.h>
+
+#include "math/simd.h"
+#include "core/broadphase.h"
+#include "core/memory.h"
+
+// The sweep axis only changes when another axis spreads the boxes this much more
+#define AXIS_SWITCH_RATIO 1.5
+
+// Insertion sort gives up (and the endpoints are radix sorted) past this many moves per endpoint
+#define SWAP_BUDGET 8
+
+// Entries past the last box in the sorted arrays, so the sweep can read 4 boxes at a time
+#define SWEEP_PAD 4
+
+Broadphase* broadphase_create(int capacity) {
+    Broadphase* bp = memory_calloc(MEMORY_SCENE, 1, sizeof(Broadphase));
+    if (!bp) return NULL;
+
+    bp->axis = -1;
+    if (!broadphase_reserve(bp, capacity > 0 ? capacity : 1)) {
+        broadphase_destroy(bp);
+        return NULL;
+    }
+    return bp;
+}
+
+int broadphase_reserve(Broadphase* bp, int count) {
+    if (count <= bp->capacity) return 1;
+
+    int capacity = bp->capacity > 0 ? bp->capacity : 1;
+    while (capacity < count)
+        capacity *= 2;
+
+    BroadphaseEndpoint* endpoints = memory_realloc(MEMORY_SCENE, bp->endpoints, sizeof(BroadphaseEndpoint) * capacity);
+    if (!endpoints) return 0;
+    bp->endpoints = endpoints;
+
+    SortKey* keys = memory_realloc(MEMORY_SCENE, bp->keys, sizeof(SortKey) * capacity);
+    if (!keys) return 0;
+    bp->keys = keys;
+
+    SortKey* scratch = memory_realloc(MEMORY_SCENE, bp->scratch, sizeof(SortKey) * capacity);
+    if (!scratch) return 0;
+    bp->scratch = scratch;
+
+    for (int a = 0; a < 3; a++) {
+        float* min = memory_realloc(MEMORY_SCENE, bp->min[a], sizeof(float) * (capacity + SWEEP_PAD));
+        if (!min) return 0;
+        bp->min[a] = min;
+
+        float* max = memory_realloc(MEMORY_SCENE, bp->max[a], sizeof(float) * (capacity + SWEEP_PAD));
+        if (!max) return 0;
+        bp->max[a] = max;
+    }
+
+    bp->capacity = capacity;
+    return 1;
+}
+
+/* **************************** SWEEP AXIS ****************************** */
+
+// Axis along which the box centers have the largest variance, sticking to the current one unless clearly beaten
+static int pick_axis(const Bounds* boxes, int count, int current) {
+    double sum[3] = {0}, sum2[3] = {0};
+    int finite[3] = {0};
+    // Unbounded boxes (ground planes, sky volumes) have no center to spread
+    for (int i = 0; i < count; i++)
+        for (int a = 0; a < 3; a++) {
+            double c = 0.5 * ((double)boxes[i].min.v[a] + boxes[i].max.v[a]);
+            if (!isfinite(c)) continue;
+            finite[a]++;
+            sum[a] += c;
+            sum2[a] += c * c;
+        }
+
+    double variance[3];
+    int best = 0;
+    for (int a = 0; a < 3; a++) {
+        variance[a] = finite[a] > 0 ? sum2[a] - sum[a] * sum[a] / finite[a] : 0.0;
+        if (variance[a] > variance[best]) best = a;
+    }
+
+    if (current >= 0 && variance[best] <= AXIS_SWITCH_RATIO * variance[current])
+        return current;
+    return best;
+}
+
+/* **************************** ENDPOINT SORT ****************************** */
+
+// + 0.0f turns -0 into +0, so that both sorts agree on ties
+static inline float start_value(const Bounds* boxes, int id, int axis) {
+    return boxes[id].min.v[axis] + 0.0f;
+}
+
+static void rebuild_endpoints(Broadphase* bp, const Bounds* boxes, int count) {
+    for (int i = 0; i < count; i++)
+        bp->keys[i] = (SortKey){float_key(start_value(boxes, i, bp->axis)), i};
+
+    const SortKey* sorted = radix_sort(bp->keys, bp->scratch, count);
+    for (int i = 0; i < count; i++)
+        bp->endpoints[i] = (BroadphaseEndpoint){start_value(boxes, sorted[i].index, bp->axis), sorted[i].index};
+    bp->stats.rebuilt = 1;
+}
+
+// Refreshes the values in place and insertion sorts them, 0 when the swap budget ran out
+static int resort_endpoints(Broadphase* bp, const Bounds* boxes, int count) {
+    BroadphaseEndpoint* e = bp->endpoints;
+    for (int i = 0; i < count; i++)
+        e[i].value = start_value(boxes, e[i].id, bp->axis);
+
+    long budget = (long)SWAP_BUDGET * count;
+    long swaps = 0;
+    for (int i = 1; i < count; i++) {
+        BroadphaseEndpoint item = e[i];
+        int j = i;
+        while (j > 0 && item.value < e[j - 1].value) {
+            e[j] = e[j - 1];
+            j--;
+        }
+        e[j] = item;
+        swaps += i - j;
+        if (swaps > budget) break;
+    }
+
+    bp->stats.swaps = swaps;
+    return swaps <= budget;
+}
+
+/* **************************** SWEEP ****************************** */
+
+static int push_pair(Broadphase* bp, int a, int b) {
+    if (bp->pair_count == bp->pair_capacity) {
+        int capacity = bp->pair_capacity > 0 ? bp->pair_capacity * 2 : bp->capacity;
+        BroadphasePair* pairs = memory_realloc(MEMORY_SCENE, bp->pairs, sizeof(BroadphasePair) * capacity);
+        if (!pairs) return 0;
+        bp->pairs = pairs;
+        bp->pair_capacity = capacity;
+    }
+
+    bp->pairs[bp->pair_count++] = a < b ? (BroadphasePair){a, b} : (BroadphasePair){b, a};
+    return 1;
+}
+
+// Boxes in sweep order, sweep axis first, so that the pair loop streams through flat arrays
+static void gather(Broadphase* bp, const Bounds* boxes, int count) {
+    int axes[3] = {bp->axis, (bp->axis + 1) % 3, (bp->axis + 2) % 3};
+    for (int i = 0; i < count; i++) {
+        const Bounds* box = &boxes[bp->endpoints[i].id];
+        for (int a = 0; a < 3; a++) {
+            bp->min[a][i] = box->min.v[axes[a]];
+            bp->max[a][i] = box->max.v[axes[a]];
+        }
+    }
+
+    // Padding ends the sweep and never overlaps: a NaN start compares false even against an infinite max
+    for (int i = count; i < count + SWEEP_PAD; i++)
+        for (int a = 0; a < 3; a++) {
+            bp->min[a][i] = NAN;
+            bp->max[a][i] = NAN;
+        }
+}
+
+// A box overlaps later boxes on the sweep axis until one starts past its max
+static int sweep(Broadphase* bp, int count) {
+    const float* min0 = bp->min[0];
+    const float* min1 = bp->min[1];
+    const float* min2 = bp->min[2];
+    const float* max1 = bp->max[1];
+    const float* max2 = bp->max[2];
+    const BroadphaseEndpoint* order = bp->endpoints;
+    long tests = 0;
+
+    for (int i = 0; i < count; i++) {
+#if MATH_SIMD
+        // 4 candidates per step; the starts are sorted, so the ones in reach are a prefix of each group
+        f32x4 end = f32x4_set1(bp->max[0][i]);
+        f32x4 lo1 = f32x4_set1(min1[i]), hi1 = f32x4_set1(max1[i]);
+        f32x4 lo2 = f32x4_set1(min2[i]), hi2 = f32x4_set1(max2[i]);
+
+        for (int j = i + 1;; j += 4) {
+            f32x4 reach = f32x4_cmple(f32x4_loadu(min0 + j), end);
+            f32x4 axis1 = f32x4_and(f32x4_cmple(f32x4_loadu(min1 + j), hi1), f32x4_cmple(lo1, f32x4_loadu(max1 + j)));
+            f32x4 axis2 = f32x4_and(f32x4_cmple(f32x4_loadu(min2 + j), hi2), f32x4_cmple(lo2, f32x4_loadu(max2 + j)));
+            int hits = f32x4_movemask(f32x4_and(reach, f32x4_and(axis1, axis2)));
+            int in_reach = f32x4_movemask(reach);
+
+            for (int k = 0; hits; k++, hits >>= 1)
+                if ((hits & 1) && !push_pair(bp, order[i].id, order[j + k].id)) return 0;
+
+            if (in_reach != 0xF) {
+                for (int k = 0; k < 4; k++)
+                    tests += (in_reach >> k) & 1;
+                tests += j - i - 1;
+                break;
+            }
+        }
+#else
+        float end = bp->max[0][i];
+        float lo1 = min1[i], hi1 = max1[i], lo2 = min2[i], hi2 = max2[i];
+
+        int j = i + 1;
+        for (; min0[j] <= end; j++)
+            if (min1[j] <= hi1 && lo1 <= max1[j] && min2[j] <= hi2 && lo2 <= max2[j] &&
+                !push_pair(bp, order[i].id, order[j].id))
+                return 0;
+        tests += j - i - 1;
+#endif
+    }
+
+    bp->stats.tests = tests;
+    return 1;
+}
+
+int broadphase_update(Broadphase* bp, const Bounds* boxes, int count) {
+    bp->pair_count = 0;
+    bp->stats = (BroadphaseStats){0};
+    if (count <= 0) {
+        bp->count = 0;
+        return 1;
+    }
+    if (!broadphase_reserve(bp, count)) return 0;
+
+    int axis = pick_axis(boxes, count, bp->axis);
+    if (axis != bp->axis || count != bp->count) {
+        bp->axis = axis;
+        rebuild_endpoints(bp, boxes, count);
+    } else if (!resort_endpoints(bp, boxes, count)) {
+        rebuild_endpoints(bp, boxes, count);
+    }
+    bp->count = count;
+
+    gather(bp, boxes, count);
+    return sweep(bp, count);
+}
+
+void broadphase_destroy(Broadphase* bp) {
+    if (!bp) return;
+
+    memory_free(MEMORY_SCENE, bp->endpoints);
+    memory_free(MEMORY_SCENE, bp->keys);
+    memory_free(MEMORY_SCENE, bp->scratch);
+    for (int a = 0; a < 3; a++) {
+        memory_free(MEMORY_SCENE, bp->min[a]);
+        memory_free(MEMORY_SCENE, bp->max[a]);
+    }
+    memory_free(MEMORY_SCENE, bp->pairs);
+    memory_free(MEMORY_SCENE, bp);
+}
@@ -0,0 +1,250 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/capture.h"
+#include "core/memory.h"
+
+#define Y4M_FRAME_HEADER "FRAME\n"
+
+static inline double elapsed_ms(Uint64 start, Uint64 end) {
+    return (double)((end - start) * 1000) / (double)SDL_GetPerformanceFrequency();
+}
+
+/* **************************** ENCODING ****************************** */
+
+size_t capture_frame_bytes(CaptureFormat format, int width, int height) {
+    size_t samples = (size_t)width * height * 3;
+    if (format == CAPTURE_Y4M) return strlen(Y4M_FRAME_HEADER) + samples;
+    return (size_t)snprintf(NULL, 0, "P6\n%d %d\n255\n", width, height) + samples;
+}
+
+size_t capture_encode(CaptureFormat format, const uint32_t* pixels, int width, int height, int pitch,
+                      uint8_t* out) {
+    uint8_t* start = out;
+
+    if (format == CAPTURE_PPM) {
+        out += sprintf((char*)out, "P6\n%d %d\n255\n", width, height);
+        for (int y = 0; y < height; y++) {
+            const uint32_t* row = pixels + (size_t)y * pitch;
+            for (int x = 0; x < width; x++) {
+                *out++ = (uint8_t)(row[x] >> 16);
+                *out++ = (uint8_t)(row[x] >> 8);
+                *out++ = (uint8_t)row[x];
+            }
+        }
+        return out - start;
+    }
+
+    // BT.601 studio range, 8-bit fixed point
+    memcpy(out, Y4M_FRAME_HEADER, strlen(Y4M_FRAME_HEADER));
+    out += strlen(Y4M_FRAME_HEADER);
+    size_t plane = (size_t)width * height;
+    uint8_t* py = out;
+    uint8_t* pu = out + plane;
+    uint8_t* pv = out + 2 * plane;
+    for (int y = 0; y < height; y++) {
+        const uint32_t* row = pixels + (size_t)y * pitch;
+        for (int x = 0; x < width; x++) {
+            int r = (row[x] >> 16) & 0xFF, g = (row[x] >> 8) & 0xFF, b = row[x] & 0xFF;
+            *py++ = (uint8_t)(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+            *pu++ = (uint8_t)(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+            *pv++ = (uint8_t)(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+        }
+    }
+    return out + 3 * plane - start;
+}
+
+/* **************************** WRITER THREAD ****************************** */
+
+// One write call for every frame encoded since the last batch
+static void write_batch(Capture* capture, int frames) {
+    if (capture->staging_used == 0) return;
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    int ok = fwrite(capture->staging, 1, capture->staging_used, capture->file) == capture->staging_used;
+    double ms = elapsed_ms(start, SDL_GetPerformanceCounter());
+
+    SDL_LockMutex(capture->lock);
+    capture->stats.write_ms += ms;
+    capture->stats.writes++;
+    if (ok) {
+        capture->stats.written += frames;
+        capture->stats.bytes_written += capture->staging_used;
+    } else {
+        capture->stats.errors++;
+        capture->failed = 1;
+    }
+    SDL_UnlockMutex(capture->lock);
+
+    capture->staging_used = 0;
+}
+
+static int writer_main(void* data) {
+    Capture* capture = data;
+    int staged = 0;
+
+    SDL_LockMutex(capture->lock);
+    for (;;) {
+        while (!capture->quit && capture->count == 0)
+            SDL_CondWait(capture->wake, capture->lock);
+        // Quitting drains the queue first
+        if (capture->count == 0) break;
+
+        const uint32_t* pixels = capture->ring[capture->head];
+        int failed = capture->failed;
+        SDL_UnlockMutex(capture->lock);
+
+        // The buffer stays queued while it is read: encode without the lock
+        if (capture->staging_used + capture->frame_bytes > capture->staging_size) {
+            write_batch(capture, staged);
+            staged = 0;
+        }
+        Uint64 start = SDL_GetPerformanceCounter();
+        if (!failed) {
+            capture->staging_used += capture_encode(capture->format, pixels, capture->width, capture->height,
+                                                    capture->width, capture->staging + capture->staging_used);
+            staged++;
+        }
+        double ms = elapsed_ms(start, SDL_GetPerformanceCounter());
+
+        SDL_LockMutex(capture->lock);
+        capture->head = (capture->head + 1) % capture->ring_size;
+        capture->count--;
+        capture->stats.encode_ms += ms;
+        SDL_CondSignal(capture->space);
+    }
+    SDL_UnlockMutex(capture->lock);
+
+    write_batch(capture, staged);
+    return 0;
+}
+
+/* **************************** OPEN / CLOSE ****************************** */
+
+Capture* capture_open(const char* path, CaptureFormat format, int width, int height, int ring_size,
+                      CapturePolicy policy, int fps) {
+    if (width <= 0 || height <= 0 || ring_size <= 0 || fps <= 0) return NULL;
+
+    Capture* capture = memory_calloc(MEMORY_CAPTURE, 1, sizeof(Capture));
+    if (!capture) return NULL;
+
+    capture->file = fopen(path, "wb");
+    if (!capture->file) {
+        memory_free(MEMORY_CAPTURE, capture);
+        return NULL;
+    }
+    // Batches are already large: skip the stdio copy
+    setvbuf(capture->file, NULL, _IONBF, 0);
+
+    capture->format = format;
+    capture->policy = policy;
+    capture->width = width;
+    capture->height = height;
+    capture->ring_size = ring_size;
+    capture->frame_bytes = capture_frame_bytes(format, width, height);
+    capture->staging_size = capture->frame_bytes > CAPTURE_BATCH_BYTES ? capture->frame_bytes : CAPTURE_BATCH_BYTES;
+
+    capture->ring = memory_calloc(MEMORY_CAPTURE, ring_size, sizeof(uint32_t*));
+    capture->staging = memory_alloc(MEMORY_CAPTURE, capture->staging_size);
+    capture->lock = SDL_CreateMutex();
+    capture->wake = SDL_CreateCond();
+    capture->space = SDL_CreateCond();
+
+    int ok = capture->ring && capture->staging && capture->lock && capture->wake && capture->space;
+    for (int i = 0; ok && i < ring_size; i++) {
+        capture->ring[i] = memory_alloc(MEMORY_CAPTURE, sizeof(uint32_t) * width * height);
+        ok = capture->ring[i] != NULL;
+    }
+    if (ok && format == CAPTURE_Y4M)
+        ok = fprintf(capture->file, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C444\n", width, height, fps) > 0;
+    if (ok) {
+        capture->writer = SDL_CreateThread(writer_main, "capture_writer", capture);
+        ok = capture->writer != NULL;
+    }
+    if (!ok) {
+        capture_close(capture, NULL);
+        return NULL;
+    }
+
+    return capture;
+}
+
+int capture_close(Capture* capture, CaptureStats* stats) {
+    if (capture->writer) {
+        SDL_LockMutex(capture->lock);
+        capture->quit = 1;
+        SDL_CondSignal(capture->wake);
+        SDL_UnlockMutex(capture->lock);
+        SDL_WaitThread(capture->writer, NULL);
+    }
+
+    int ok = !capture->failed;
+    if (stats) *stats = capture->stats;
+    ok &= fclose(capture->file) == 0;
+
+    for (int i = 0; capture->ring && i < capture->ring_size; i++)
+        memory_free(MEMORY_CAPTURE, capture->ring[i]);
+    memory_free(MEMORY_CAPTURE, capture->ring);
+    memory_free(MEMORY_CAPTURE, capture->staging);
+    if (capture->space) SDL_DestroyCond(capture->space);
+    if (capture->wake) SDL_DestroyCond(capture->wake);
+    if (capture->lock) SDL_DestroyMutex(capture->lock);
+    memory_free(MEMORY_CAPTURE, capture);
+    return ok;
+}
+
+/* **************************** FRAME LOOP ****************************** */
+
+// Visible framebuffer into a width x height buffer: cropped, or padded with black
+static void copy_frame(uint32_t* dst, int width, int height, const Framebuffer* fb) {
+    int rows = fb->height < height ? fb->height : height;
+    int cols = fb->width < width ? fb->width : width;
+
+    framebuffer_resolve_to(fb, dst, width, cols, rows);
+    if (cols < width)
+        for (int y = 0; y < rows; y++)
+            memset(dst + (size_t)y * width + cols, 0, sizeof(uint32_t) * (width - cols));
+    if (rows < height) memset(dst + (size_t)rows * width, 0, sizeof(uint32_t) * width * (height - rows));
+}
+
+int capture_frame(Capture* capture, const Framebuffer* fb) {
+    Uint64 start = SDL_GetPerformanceCounter();
+
+    SDL_LockMutex(capture->lock);
+    capture->stats.submitted++;
+    while (capture->policy == CAPTURE_BLOCK && !capture->failed && capture->count == capture->ring_size)
+        SDL_CondWait(capture->space, capture->lock);
+    if (capture->failed || capture->count == capture->ring_size) {
+        capture->stats.dropped++;
+        SDL_UnlockMutex(capture->lock);
+        return 0;
+    }
+    // Single producer: the slot after the queued ones stays free until count grows
+    uint32_t* slot = capture->ring[(capture->head + capture->count) % capture->ring_size];
+    SDL_UnlockMutex(capture->lock);
+
+    Uint64 copy_start = SDL_GetPerformanceCounter();
+    copy_frame(slot, capture->width, capture->height, fb);
+    Uint64 end = SDL_GetPerformanceCounter();
+    double blocked = elapsed_ms(start, copy_start);
+    double copy = elapsed_ms(copy_start, end);
+
+    SDL_LockMutex(capture->lock);
+    capture->count++;
+    capture->stats.captured++;
+    if (capture->count > capture->stats.max_queued) capture->stats.max_queued = capture->count;
+    capture->stats.copy_ms += copy;
+    if (copy > capture->stats.max_copy_ms) capture->stats.max_copy_ms = copy;
+    capture->stats.blocked_ms += blocked;
+    if (blocked > capture->stats.max_blocked_ms) capture->stats.max_blocked_ms = blocked;
+    SDL_CondSignal(capture->wake);
+    SDL_UnlockMutex(capture->lock);
+    return 1;
+}
+
+CaptureStats capture_stats(Capture* capture) {
+    SDL_LockMutex(capture->lock);
+    CaptureStats stats = capture->stats;
+    SDL_UnlockMutex(capture->lock);
+    return stats;
+}
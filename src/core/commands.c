@@ -0,0 +1,146 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/commands.h"
+#include "core/memory.h"
+
+CommandQueue* command_queue_create(int capacity, size_t arena_bytes) {
+    CommandQueue* queue = memory_calloc(MEMORY_THREADS, 1, sizeof(CommandQueue));
+    if (!queue) return NULL;
+
+    queue->ring = spsc_create(capacity, sizeof(Command));
+    int ok = queue->ring != NULL;
+    for (int i = 0; ok && i < COMMAND_FRAMES; i++) {
+        queue->arenas[i] = arena_create(arena_bytes);
+        ok = queue->arenas[i] != NULL;
+    }
+    if (!ok) {
+        command_queue_destroy(queue);
+        return NULL;
+    }
+
+    return queue;
+}
+
+/* **************************** SIMULATION SIDE ****************************** */
+
+int command_begin_frame(CommandQueue* queue) {
+    if (queue->open) return 1;
+
+    // The arena was last used by frame - COMMAND_FRAMES
+    if (queue->frame - SDL_AtomicGet(&queue->applied) >= COMMAND_FRAMES) {
+        queue->stats.stalls++;
+        return 0;
+    }
+
+    arena_reset(queue->arenas[queue->frame % COMMAND_FRAMES]);
+    queue->open = 1;
+    return 1;
+}
+
+static int push(CommandQueue* queue, CommandType type, int object, const void* payload, size_t size) {
+    if (!queue->open) return 0;
+
+    Command command = {type, object, NULL};
+    if (payload) {
+        command.payload = arena_alloc(queue->arenas[queue->frame % COMMAND_FRAMES], size);
+        if (!command.payload) {
+            queue->stats.arena_full++;
+            return 0;
+        }
+        memcpy(command.payload, payload, size);
+    }
+
+    if (!spsc_push(queue->ring, &command)) {
+        queue->stats.ring_full++;
+        return 0;
+    }
+    queue->stats.pushed++;
+    return 1;
+}
+
+int command_push_transform(CommandQueue* queue, int object, Transform transform) {
+    return push(queue, COMMAND_TRANSFORM, object, &transform, sizeof(Transform));
+}
+
+int command_push_camera(CommandQueue* queue, Camera camera) {
+    return push(queue, COMMAND_CAMERA, -1, &camera, sizeof(Camera));
+}
+
+int command_push_mesh_add(CommandQueue* queue, const Mesh* mesh, Color color, Transform transform, int flags) {
+    CommandMeshAdd add = {mesh, color, transform, flags};
+    return push(queue, COMMAND_MESH_ADD, -1, &add, sizeof(CommandMeshAdd));
+}
+
+int command_push_mesh_remove(CommandQueue* queue, int object) {
+    return push(queue, COMMAND_MESH_REMOVE, object, NULL, 0);
+}
+
+int command_end_frame(CommandQueue* queue) {
+    if (!queue->open) return 0;
+
+    Command end = {COMMAND_FRAME_END, -1, NULL};
+    if (!spsc_push(queue->ring, &end)) {
+        queue->stats.ring_full++;
+        return 0;
+    }
+
+    queue->open = 0;
+    queue->frame++;
+    queue->stats.frames_ended++;
+    SDL_AtomicSet(&queue->ended, queue->frame);
+    return 1;
+}
+
+/* **************************** RENDER SIDE ****************************** */
+
+static void apply(const Command* command, Scene* scene, Camera* camera) {
+    switch (command->type) {
+        case COMMAND_TRANSFORM:
+            if (scene && command->object >= 0 && command->object < scene->count)
+                scene->objects[command->object].transform = *(const Transform*)command->payload;
+            break;
+        case COMMAND_CAMERA:
+            if (camera) *camera = *(const Camera*)command->payload;
+            break;
+        case COMMAND_MESH_ADD:
+            if (scene) {
+                const CommandMeshAdd* add = command->payload;
+                scene_add(scene, add->mesh, add->color, add->transform, add->flags);
+            }
+            break;
+        case COMMAND_MESH_REMOVE:
+            if (scene) scene_remove(scene, command->object);
+            break;
+        case COMMAND_FRAME_END:
+            break;
+    }
+}
+
+int command_drain(CommandQueue* queue, Scene* scene, Camera* camera) {
+    int ended = SDL_AtomicGet(&queue->ended);
+    int applied = 0;
+
+    // Every command up to the last FRAME_END is already in the ring
+    Command command;
+    while (queue->drained < ended && spsc_pop(queue->ring, &command)) {
+        apply(&command, scene, camera);
+        if (command.type == COMMAND_FRAME_END) {
+            queue->drained++;
+            queue->stats.frames_applied++;
+            SDL_AtomicSet(&queue->applied, queue->drained);
+        } else {
+            applied++;
+        }
+    }
+
+    queue->stats.applied += applied;
+    return applied;
+}
+
+void command_queue_destroy(CommandQueue* queue) {
+    if (queue->ring) spsc_destroy(queue->ring);
+    for (int i = 0; i < COMMAND_FRAMES; i++)
+        if (queue->arenas[i]) arena_destroy(queue->arenas[i]);
+    memory_free(MEMORY_THREADS, queue);
+}
@@ -0,0 +1,216 @@
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <SDL.h>
+
+#include "core/cook.h"
+#include "core/hash.h"
+#include "core/obj.h"
+#include "core/memory.h"
+
+// Longest cooked file path, temporary suffix included
+#define COOK_PATH_MAX 512
+
+static inline double elapsed_ms(Uint64 start) {
+    return (double)((SDL_GetPerformanceCounter() - start) * 1000) / (double)SDL_GetPerformanceFrequency();
+}
+
+// Whole file, NUL-terminated for obj_parse
+static char* read_file(const char* path, size_t* size) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return NULL;
+
+    long length = -1;
+    if (fseek(file, 0, SEEK_END) == 0) length = ftell(file);
+    char* data = length >= 0 && fseek(file, 0, SEEK_SET) == 0 ? memory_alloc(MEMORY_MESH, (size_t)length + 1) : NULL;
+    if (data && fread(data, 1, (size_t)length, file) != (size_t)length) {
+        memory_free(MEMORY_MESH, data);
+        data = NULL;
+    }
+    fclose(file);
+
+    if (data) {
+        data[length] = '\0';
+        *size = (size_t)length;
+    }
+    return data;
+}
+
+uint64_t cook_key(const void* source, size_t size, const CookOptions* options) {
+    // Options hashed field by field (no padding bytes), with the version so that a new format misses
+    float epsilon = options->weld_epsilon < 0.0f ? -1.0f : options->weld_epsilon;
+    uint32_t fields[4] = {COOK_VERSION, 0, options->normals != 0, options->compact != 0};
+    memcpy(&fields[1], &epsilon, sizeof(float));
+    return hash64(source, size, hash64(fields, sizeof(fields), 0));
+}
+
+void cook_path(char* path, size_t size, const char* cache_dir, uint64_t key) {
+    snprintf(path, size, "%s/%016llx" COOK_EXTENSION, cache_dir, (unsigned long long)key);
+}
+
+/* **************************** COOKED FILES ****************************** */
+
+// Byte size of each stream, in file order: positions, normals, UVs, indices
+static void stream_sizes(uint32_t flags, size_t vertex_count, size_t triangle_count, size_t sizes[4]) {
+    sizes[0] = vertex_count * (flags & COOK_POSITIONS ? sizeof(Vector3) : sizeof(Vector4));
+    sizes[1] = flags & COOK_NORMALS ? vertex_count * sizeof(Vector4) : 0;
+    sizes[2] = flags & COOK_UVS ? vertex_count * sizeof(TexCoord) : 0;
+    sizes[3] = triangle_count * (flags & COOK_INDEX16 ? sizeof(Triangle16) : sizeof(Triangle));
+}
+
+int cook_write(const char* path, const Mesh* mesh, uint64_t key) {
+    CookHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, COOK_MAGIC, 4);
+    header.version = COOK_VERSION;
+    header.key = key;
+    header.vertex_count = mesh->vertex_count;
+    header.triangle_count = mesh->triangle_count;
+    header.flags = (mesh->positions ? COOK_POSITIONS : 0) | (mesh->triangles16 ? COOK_INDEX16 : 0) |
+                   (mesh->normals ? COOK_NORMALS : 0) | (mesh->uvs ? COOK_UVS : 0);
+    header.bounds = mesh_bounds(mesh);
+
+    const void* streams[4] = {
+        mesh->positions ? (const void*)mesh->positions : (const void*)mesh->vertices,
+        mesh->normals,
+        mesh->uvs,
+        mesh->triangles16 ? (const void*)mesh->triangles16 : (const void*)mesh->triangles
+    };
+    size_t sizes[4];
+    stream_sizes(header.flags, (size_t)mesh->vertex_count, (size_t)mesh->triangle_count, sizes);
+
+    // Unique per process and thread, in the same directory so that the rename cannot cross file systems
+    char temporary[COOK_PATH_MAX];
+    if (snprintf(temporary, sizeof(temporary), "%s.%ld.%lu.tmp", path, (long)getpid(),
+                 (unsigned long)SDL_ThreadID()) >= (int)sizeof(temporary))
+        return 0;
+
+    FILE* file = fopen(temporary, "wb");
+    if (!file) return 0;
+
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    for (int i = 0; ok && i < 4; i++)
+        ok = sizes[i] == 0 || fwrite(streams[i], 1, sizes[i], file) == sizes[i];
+    ok &= fclose(file) == 0;
+
+    ok = ok && rename(temporary, path) == 0;
+    if (!ok) remove(temporary);
+    return ok;
+}
+
+// Every index addresses a vertex: a corrupt index stream would be read out of bounds by the pipeline
+static int valid_indices(const Mesh* mesh) {
+    int n = mesh->vertex_count;
+    for (int t = 0; t < mesh->triangle_count; t++)
+        for (int k = 0; k < 3; k++) {
+            int index = mesh->triangles16 ? mesh->triangles16[t].vert[k] : mesh->triangles[t].vert[k];
+            if (index < 0 || index >= n) return 0;
+        }
+    return 1;
+}
+
+Mesh* cook_read(const char* path, uint64_t key, Bounds* bounds) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return NULL;
+
+    long length = -1;
+    if (fseek(file, 0, SEEK_END) == 0) length = ftell(file);
+
+    CookHeader header;
+    int ok = length >= 0 && fseek(file, 0, SEEK_SET) == 0 && fread(&header, sizeof(header), 1, file) == 1 &&
+             memcmp(header.magic, COOK_MAGIC, 4) == 0 && header.version == COOK_VERSION && header.key == key &&
+             header.vertex_count >= 0 && header.triangle_count >= 0;
+
+    // The file size must match the header before anything is allocated from it
+    size_t sizes[4];
+    if (ok) {
+        stream_sizes(header.flags, (size_t)header.vertex_count, (size_t)header.triangle_count, sizes);
+        ok = sizeof(header) + sizes[0] + sizes[1] + sizes[2] + sizes[3] == (size_t)length;
+    }
+
+    Mesh* mesh = ok ? memory_calloc(MEMORY_MESH, 1, sizeof(Mesh)) : NULL;
+    if (mesh) {
+        mesh->vertex_count = header.vertex_count;
+        mesh->triangle_count = header.triangle_count;
+
+        void** streams[4] = {
+            header.flags & COOK_POSITIONS ? (void**)&mesh->positions : (void**)&mesh->vertices,
+            header.flags & COOK_NORMALS ? (void**)&mesh->normals : NULL,
+            header.flags & COOK_UVS ? (void**)&mesh->uvs : NULL,
+            header.flags & COOK_INDEX16 ? (void**)&mesh->triangles16 : (void**)&mesh->triangles
+        };
+        for (int i = 0; ok && i < 4; i++) {
+            if (!streams[i]) continue;
+            *streams[i] = memory_alloc(MEMORY_MESH, sizes[i] > 0 ? sizes[i] : 1);
+            ok = *streams[i] && fread(*streams[i], 1, sizes[i], file) == sizes[i];
+        }
+
+        if (!ok || !valid_indices(mesh)) {
+            mesh_destroy(mesh);
+            mesh = NULL;
+        }
+    }
+    fclose(file);
+
+    if (mesh && bounds) *bounds = header.bounds;
+    return mesh;
+}
+
+/* **************************** IMPORT ****************************** */
+
+static int process(Mesh* mesh, const CookOptions* options) {
+    if (options->weld_epsilon >= 0.0f && !mesh_weld(mesh, options->weld_epsilon, NULL, NULL)) return 0;
+    if (options->normals && !mesh_compute_normals(mesh, NULL)) return 0;
+    if (options->compact && !mesh_compact(mesh)) return 0;
+    return 1;
+}
+
+Mesh* cook_load_mesh(const char* path, const CookOptions* options, const char* cache_dir, Bounds* bounds,
+                     CookStats* stats) {
+    CookStats ignored = {0};
+    if (!stats) stats = &ignored;
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    size_t size;
+    char* source = read_file(path, &size);
+    if (!source) return NULL;
+    uint64_t key = cook_key(source, size, options);
+    stats->read_ms += elapsed_ms(start);
+
+    // Room for the temporary suffix of cook_write too
+    char cooked[COOK_PATH_MAX];
+    if (cache_dir && strlen(cache_dir) + 64 > sizeof(cooked)) cache_dir = NULL;
+
+    if (cache_dir) {
+        start = SDL_GetPerformanceCounter();
+        cook_path(cooked, sizeof(cooked), cache_dir, key);
+        Mesh* mesh = cook_read(cooked, key, bounds);
+        stats->cache_ms += elapsed_ms(start);
+        if (mesh) {
+            stats->hits++;
+            memory_free(MEMORY_MESH, source);
+            return mesh;
+        }
+    }
+
+    stats->misses++;
+    start = SDL_GetPerformanceCounter();
+    Mesh* mesh = obj_parse(source);
+    memory_free(MEMORY_MESH, source);
+    if (mesh && !process(mesh, options)) {
+        mesh_destroy(mesh);
+        mesh = NULL;
+    }
+    stats->import_ms += elapsed_ms(start);
+    if (!mesh) return NULL;
+
+    if (bounds) *bounds = mesh_bounds(mesh);
+    if (cache_dir) {
+        start = SDL_GetPerformanceCounter();
+        mkdir(cache_dir, 0755);
+        if (!cook_write(cooked, mesh, key)) stats->write_errors++;
+        stats->write_ms += elapsed_ms(start);
+    }
+    return mesh;
+}
@@ -0,0 +1,94 @@
+#include "core/depth_sort.h"
+#include "core/memory.h"
+
+typedef struct DepthKeyJob {
+    const Mesh* clipped;
+    SortKey* keys;
+    DepthOrder order;
+} DepthKeyJob;
+
+static void compute_keys(void* ctx, int start, int end) {
+    const DepthKeyJob* job = ctx;
+    const Vector4* vertices = job->clipped->vertices;
+    Triangle scratch[MESH_TRIANGLE_BATCH];
+
+    for (int batch = start; batch < end; batch += MESH_TRIANGLE_BATCH) {
+        int n = end - batch < MESH_TRIANGLE_BATCH ? end - batch : MESH_TRIANGLE_BATCH;
+        const Triangle* triangles = mesh_triangle_batch(job->clipped, batch, n, scratch);
+        for (int i = 0; i < n; i++) {
+            const int* idx = triangles[i].vert;
+            float depth = vertices[idx[0]].w + vertices[idx[1]].w + vertices[idx[2]].w;
+            job->keys[batch + i] = (SortKey){depth_key(depth, job->order), batch + i};
+        }
+    }
+}
+
+// Stable, in place: small meshes (a cube has 12 triangles) sort faster than their radix histograms clear
+static void insertion_sort(SortKey* keys, int count) {
+    for (int i = 1; i < count; i++) {
+        SortKey item = keys[i];
+        int j = i;
+        while (j > 0 && item.key < keys[j - 1].key) {
+            keys[j] = keys[j - 1];
+            j--;
+        }
+        keys[j] = item;
+    }
+}
+
+DepthSort* depth_sort_create(int capacity) {
+    DepthSort* sort = memory_calloc(MEMORY_RENDER, 1, sizeof(DepthSort));
+    if (!sort) return NULL;
+
+    if (!depth_sort_reserve(sort, capacity > 0 ? capacity : 1)) {
+        depth_sort_destroy(sort);
+        return NULL;
+    }
+    return sort;
+}
+
+int depth_sort_reserve(DepthSort* sort, int count) {
+    if (count <= sort->capacity) return 1;
+
+    SortKey* keys = memory_realloc(MEMORY_RENDER, sort->keys, sizeof(SortKey) * count);
+    if (!keys) return 0;
+    sort->keys = keys;
+
+    SortKey* scratch = memory_realloc(MEMORY_RENDER, sort->scratch, sizeof(SortKey) * count);
+    if (!scratch) return 0;
+    sort->scratch = scratch;
+
+    int* order = memory_realloc(MEMORY_RENDER, sort->order, sizeof(int) * count);
+    if (!order) return 0;
+    sort->order = order;
+
+    sort->capacity = count;
+    return 1;
+}
+
+const int* depth_sort_mesh(DepthSort* sort, const Mesh* clipped, DepthOrder order, JobSystem* jobs) {
+    int count = clipped->triangle_count;
+    if (!depth_sort_reserve(sort, count)) return NULL;
+
+    DepthKeyJob job = {clipped, sort->keys, order};
+    jobs_parallel_for(jobs, count, DEPTH_SORT_BATCH, compute_keys, &job);
+
+    const SortKey* sorted = sort->keys;
+    if (count <= DEPTH_SORT_INSERTION_MAX)
+        insertion_sort(sort->keys, count);
+    else
+        sorted = radix_sort_parallel(sort->keys, sort->scratch, count, jobs);
+    for (int i = 0; i < count; i++)
+        sort->order[i] = sorted[i].index;
+
+    sort->count = count;
+    return sort->order;
+}
+
+void depth_sort_destroy(DepthSort* sort) {
+    if (!sort) return;
+    memory_free(MEMORY_RENDER, sort->keys);
+    memory_free(MEMORY_RENDER, sort->scratch);
+    memory_free(MEMORY_RENDER, sort->order);
+    memory_free(MEMORY_RENDER, sort);
+}
@@ -0,0 +1,134 @@
+#include <string.h>
+
+#include "core/frame_stats.h"
+#include "core/memory.h"
+
+static const char* METRIC_NAMES[FRAME_METRICS] = {
+    "vertices", "triangles", "lines", "pixels", "draws", "culled", "allocations",
+    "update_ms", "raster_ms", "present_ms", "total_ms"
+};
+
+static double elapsed_ms(Uint64 start, Uint64 end) {
+    return (double)(end - start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+EngineFrameStats* frame_stats_create(int window) {
+    EngineFrameStats* stats = memory_calloc(MEMORY_ENGINE, 1, sizeof(EngineFrameStats));
+    if (!stats) return NULL;
+
+    if (!frame_stats_set_window(stats, window)) {
+        memory_free(MEMORY_ENGINE, stats);
+        return NULL;
+    }
+    return stats;
+}
+
+int frame_stats_set_window(EngineFrameStats* stats, int window) {
+    if (window <= 0) window = FRAME_STATS_WINDOW;
+
+    double* history = memory_alloc(MEMORY_ENGINE, sizeof(double) * FRAME_METRICS * window);
+    if (!history) return 0;
+
+    memory_free(MEMORY_ENGINE, stats->history);
+    stats->history = history;
+    stats->window = window;
+    stats->samples = 0;
+    stats->head = 0;
+    return 1;
+}
+
+void frame_stats_set_csv(EngineFrameStats* stats, FILE* csv) {
+    stats->csv = csv;
+    if (!csv) return;
+
+    fprintf(csv, "frame");
+    for (int m = 0; m < FRAME_METRICS; m++)
+        fprintf(csv, ",%s", METRIC_NAMES[m]);
+    fprintf(csv, "\n");
+}
+
+void frame_stats_begin(EngineFrameStats* stats) {
+    memset(stats->current, 0, sizeof(stats->current));
+    stats->frame_start = stats->stage_start = SDL_GetPerformanceCounter();
+}
+
+double frame_stats_stage(EngineFrameStats* stats, FrameMetric metric) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    double ms = elapsed_ms(stats->stage_start, now);
+    stats->current[metric] += ms;
+    stats->stage_start = now;
+    return ms;
+}
+
+// Lines a draw submits: 3 per triangle when it is drawn as a wireframe
+static int draw_lines(const Draw* draw) {
+    int filled = draw->shading != SHADE_WIREFRAME && draw->vertex_colors;
+    return filled ? 0 : 3 * draw->clipped_mesh->triangle_count;
+}
+
+void frame_stats_add_draw(EngineFrameStats* stats, const Draw* draw, int vertices) {
+    stats->current[FRAME_VERTICES] += vertices;
+    stats->current[FRAME_TRIANGLES] += draw->clipped_mesh->triangle_count;
+    stats->current[FRAME_LINES] += draw_lines(draw);
+    stats->current[FRAME_DRAWS] += 1;
+}
+
+void frame_stats_add_scene(EngineFrameStats* stats, const Scene* scene) {
+    int draws = 0;
+    for (int i = 0; i < scene->count; i++) {
+        const Object* obj = &scene->objects[i];
+        if (!obj->visible) continue;
+        frame_stats_add_draw(stats, &obj->draw, obj->mesh->vertex_count);
+        draws++;
+    }
+    stats->current[FRAME_CULLED] += scene->count - draws;
+}
+
+void frame_stats_add_frame(EngineFrameStats* stats, size_t pixels_drawn) {
+    stats->current[FRAME_PIXELS] += (double)pixels_drawn;
+    stats->current[FRAME_ALLOCATIONS] += memory_sum(memory_stats().frame).allocations;
+}
+
+void frame_stats_end(EngineFrameStats* stats) {
+    stats->current[FRAME_TOTAL_MS] = elapsed_ms(stats->frame_start, SDL_GetPerformanceCounter());
+    memcpy(stats->last, stats->current, sizeof(stats->last));
+
+    memcpy(stats->history + (size_t)stats->head * FRAME_METRICS, stats->current, sizeof(stats->current));
+    stats->head = (stats->head + 1) % stats->window;
+    if (stats->samples < stats->window) stats->samples++;
+
+    if (stats->csv) {
+        fprintf(stats->csv, "%ld", stats->frames);
+        for (int m = 0; m < FRAME_METRICS; m++) {
+            if (m < FRAME_UPDATE_MS) fprintf(stats->csv, ",%lld", (long long)stats->current[m]);
+            else fprintf(stats->csv, ",%.4f", stats->current[m]);
+        }
+        fprintf(stats->csv, "\n");
+    }
+    stats->frames++;
+}
+
+FrameSummary frame_stats_summary(const EngineFrameStats* stats, FrameMetric metric) {
+    FrameSummary summary = {0};
+    if (stats->samples == 0) return summary;
+
+    summary.min = summary.max = stats->history[metric];
+    double sum = 0.0;
+    for (int f = 0; f < stats->samples; f++) {
+        double v = stats->history[(size_t)f * FRAME_METRICS + metric];
+        sum += v;
+        if (v < summary.min) summary.min = v;
+        if (v > summary.max) summary.max = v;
+    }
+    summary.avg = sum / stats->samples;
+    return summary;
+}
+
+const char* frame_metric_name(FrameMetric metric) {
+    return metric >= 0 && metric < FRAME_METRICS ? METRIC_NAMES[metric] : "unknown";
+}
+
+void frame_stats_destroy(EngineFrameStats* stats) {
+    memory_free(MEMORY_ENGINE, stats->history);
+    memory_free(MEMORY_ENGINE, stats);
+}
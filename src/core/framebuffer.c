@@ -0,0 +1,677 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "core/framebuffer.h"
+#include "core/memory.h"
+
+#define FB_ALIGN 16
+
+#define TILE_MASK (FRAMEBUFFER_TILE - 1)
+
+// Tile containing a pixel, and the pixel inside that tile
+#define TILE_INDEX(fb, x, y) (((y) >> FRAMEBUFFER_TILE_SHIFT) * (fb)->tiles_x + ((x) >> FRAMEBUFFER_TILE_SHIFT))
+#define TILE_OFFSET(x, y) ((((y) & TILE_MASK) << FRAMEBUFFER_TILE_SHIFT) | ((x) & TILE_MASK))
+
+static const union { float f; uint32_t u; } FAR_DEPTH = { .f = 1.0f };
+
+Framebuffer* framebuffer_create(int width, int height) {
+    Framebuffer* fb = memory_calloc(MEMORY_RENDER, 1, sizeof(Framebuffer));
+    if (!fb) return NULL;
+
+    fb->width = fb->max_width = width;
+    fb->height = fb->max_height = height;
+    fb->pitch = (width + 3) & ~3; // 4 pixels = 16 bytes
+    fb->tiles_x = (width + TILE_MASK) >> FRAMEBUFFER_TILE_SHIFT;
+    fb->tiles_y = (height + TILE_MASK) >> FRAMEBUFFER_TILE_SHIFT;
+    fb->viewport = (Viewport){0, 0, width, height};
+
+    size_t tiles = (size_t)fb->tiles_x * (size_t)fb->tiles_y;
+    size_t bytes = sizeof(uint32_t) * (size_t)fb->pitch * (size_t)height;
+    fb->pixels = memory_aligned_alloc(MEMORY_RENDER, FB_ALIGN, bytes);
+    fb->color = memory_aligned_alloc(MEMORY_RENDER, FB_ALIGN, sizeof(uint32_t) * tiles * FRAMEBUFFER_TILE_PIXELS);
+    fb->depth = memory_aligned_alloc(MEMORY_RENDER, FB_ALIGN, sizeof(float) * tiles * FRAMEBUFFER_TILE_PIXELS);
+    fb->tile_flags = memory_calloc(MEMORY_RENDER, tiles, 1);
+    if (!fb->pixels || !fb->color || !fb->depth || !fb->tile_flags) {
+        framebuffer_destroy(fb);
+        return NULL;
+    }
+    // Every tile starts cleared: black, far depth
+    memset(fb->pixels, 0, bytes);
+
+    return fb;
+}
+
+void framebuffer_resize(Framebuffer* fb, int width, int height) {
+    fb->width = width < 1 ? 1 : width > fb->max_width ? fb->max_width : width;
+    fb->height = height < 1 ? 1 : height > fb->max_height ? fb->max_height : height;
+    fb->viewport = (Viewport){0, 0, fb->width, fb->height};
+}
+
+static inline int clamp_int(int v, int lo, int hi) {
+    return v < lo ? lo : v > hi ? hi : v;
+}
+
+void framebuffer_set_viewport(Framebuffer* fb, Viewport viewport) {
+    int x0 = clamp_int(viewport.x, 0, fb->width), x1 = clamp_int(viewport.x + viewport.width, 0, fb->width);
+    int y0 = clamp_int(viewport.y, 0, fb->height), y1 = clamp_int(viewport.y + viewport.height, 0, fb->height);
+    fb->viewport = (Viewport){x0, y0, x1 - x0, y1 - y0};
+}
+
+/* **************************** CLEAR ****************************** */
+
+// count 32-bit values at dst (colors, or the bits of float depths): count is a multiple of 4 and
+// dst is 16-byte aligned. Stored as vectors or bytes, never through a pointer to the wrong type
+static void fill_u32(void* dst, size_t count, uint32_t value) {
+
+#if defined(__SSE2__)
+    __m128i* p = dst;
+    __m128i v = _mm_set1_epi32((int)value);
+    size_t i = 0, n = count / 4;
+    for (; i + 4 <= n; i += 4) {
+        _mm_store_si128(p + i, v);
+        _mm_store_si128(p + i + 1, v);
+        _mm_store_si128(p + i + 2, v);
+        _mm_store_si128(p + i + 3, v);
+    }
+    for (; i < n; i++)
+        _mm_store_si128(p + i, v);
+#elif defined(__ARM_NEON)
+    uint8_t* p = dst;
+    uint8x16_t v = vreinterpretq_u8_u32(vdupq_n_u32(value));
+    size_t i = 0, n = count * sizeof(value);
+    for (; i + 64 <= n; i += 64) {
+        vst1q_u8(p + i, v);
+        vst1q_u8(p + i + 16, v);
+        vst1q_u8(p + i + 32, v);
+        vst1q_u8(p + i + 48, v);
+    }
+    for (; i < n; i += 16)
+        vst1q_u8(p + i, v);
+#else
+    unsigned char* p = dst;
+    for (size_t i = 0; i < count; i++)
+        memcpy(p + i * sizeof(value), &value, sizeof(value));
+#endif
+}
+
+static void clear_tiles(Framebuffer* fb, uint8_t flag) {
+    size_t tiles = (size_t)fb->tiles_x * (size_t)fb->tiles_y;
+    for (size_t i = 0; i < tiles; i++)
+        fb->tile_flags[i] &= (uint8_t)~flag;
+}
+
+void framebuffer_clear(Framebuffer* fb, uint32_t color) {
+    fb->clear_color = color;
+    clear_tiles(fb, FRAMEBUFFER_TILE_COLOR);
+}
+
+void framebuffer_clear_depth(Framebuffer* fb) {
+    clear_tiles(fb, FRAMEBUFFER_TILE_DEPTH);
+}
+
+// Fills a tile with its clear value, on the first write since the clear
+static void fill_tile(Framebuffer* fb, int tile, uint8_t flag) {
+    size_t offset = (size_t)tile * FRAMEBUFFER_TILE_PIXELS;
+    if (flag == FRAMEBUFFER_TILE_COLOR) fill_u32(fb->color + offset, FRAMEBUFFER_TILE_PIXELS, fb->clear_color);
+    else fill_u32(fb->depth + offset, FRAMEBUFFER_TILE_PIXELS, FAR_DEPTH.u);
+    fb->tile_flags[tile] |= flag;
+    fb->tiles_filled++;
+}
+
+// Colors of a tile about to be drawn to
+static inline uint32_t* color_tile(Framebuffer* fb, int tile) {
+    if (!(fb->tile_flags[tile] & FRAMEBUFFER_TILE_COLOR)) fill_tile(fb, tile, FRAMEBUFFER_TILE_COLOR);
+    return fb->color + (size_t)tile * FRAMEBUFFER_TILE_PIXELS;
+}
+
+static inline float* depth_tile(Framebuffer* fb, int tile) {
+    if (!(fb->tile_flags[tile] & FRAMEBUFFER_TILE_DEPTH)) fill_tile(fb, tile, FRAMEBUFFER_TILE_DEPTH);
+    return fb->depth + (size_t)tile * FRAMEBUFFER_TILE_PIXELS;
+}
+
+// Fills the color and depth tiles under a pixel block that are still pending a clear
+static inline void touch_tiles(Framebuffer* fb, int x_start, int x_end, int y_start, int y_end) {
+    const uint8_t both = FRAMEBUFFER_TILE_COLOR | FRAMEBUFFER_TILE_DEPTH;
+    for (int ty = y_start >> FRAMEBUFFER_TILE_SHIFT; ty <= y_end >> FRAMEBUFFER_TILE_SHIFT; ty++)
+        for (int tx = x_start >> FRAMEBUFFER_TILE_SHIFT; tx <= x_end >> FRAMEBUFFER_TILE_SHIFT; tx++) {
+            int tile = ty * fb->tiles_x + tx;
+            if ((fb->tile_flags[tile] & both) != both) {
+                color_tile(fb, tile);
+                depth_tile(fb, tile);
+            }
+        }
+}
+
+/* **************************** RESOLVE ****************************** */
+
+// One tile row (count <= FRAMEBUFFER_TILE) into dst; src is 16-byte aligned, dst may not be
+static inline void copy_span(uint32_t* dst, const uint32_t* src, int count) {
+    int i = 0;
+#if defined(__SSE2__)
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_load_si128((const __m128i*)(src + i)));
+#elif defined(__ARM_NEON)
+    for (; i + 4 <= count; i += 4)
+        vst1q_u32(dst + i, vld1q_u32(src + i));
+#endif
+    for (; i < count; i++)
+        dst[i] = src[i];
+}
+
+static inline void fill_span(uint32_t* dst, uint32_t color, int count) {
+    int i = 0;
+#if defined(__SSE2__)
+    __m128i c = _mm_set1_epi32((int)color);
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_si128((__m128i*)(dst + i), c);
+#elif defined(__ARM_NEON)
+    uint32x4_t c = vdupq_n_u32(color);
+    for (; i + 4 <= count; i += 4)
+        vst1q_u32(dst + i, c);
+#endif
+    for (; i < count; i++)
+        dst[i] = color;
+}
+
+void framebuffer_resolve_to(const Framebuffer* fb, uint32_t* dst, int dst_pitch, int width, int height) {
+    if (width > fb->width) width = fb->width;
+    if (height > fb->height) height = fb->height;
+
+    for (int y = 0; y < height; y++) {
+        uint32_t* out = dst + (size_t)y * dst_pitch;
+        int first = (y >> FRAMEBUFFER_TILE_SHIFT) * fb->tiles_x;
+        const uint32_t* src = fb->color + (size_t)first * FRAMEBUFFER_TILE_PIXELS +
+                              ((y & TILE_MASK) << FRAMEBUFFER_TILE_SHIFT);
+
+        for (int x = 0, tile = first; x < width; x += FRAMEBUFFER_TILE, tile++) {
+            int count = width - x < FRAMEBUFFER_TILE ? width - x : FRAMEBUFFER_TILE;
+            if (fb->tile_flags[tile] & FRAMEBUFFER_TILE_COLOR)
+                copy_span(out + x, src + (size_t)(tile - first) * FRAMEBUFFER_TILE_PIXELS, count);
+            else
+                fill_span(out + x, fb->clear_color, count);
+        }
+    }
+}
+
+void framebuffer_resolve(Framebuffer* fb) {
+    framebuffer_resolve_to(fb, fb->pixels, fb->pitch, fb->width, fb->height);
+}
+
+/* **************************** LINE CLIPPING ****************************** */
+
+// Cohen–Sutherland region codes
+#define CS_INSIDE 0
+#define CS_LEFT   1
+#define CS_RIGHT  2
+#define CS_BOTTOM 4
+#define CS_TOP    8
+
+static int out_code(long x, long y, long xmax, long ymax) {
+    int code = CS_INSIDE;
+
+    if (x < 0) code |= CS_LEFT;
+    else if (x > xmax) code |= CS_RIGHT;
+    if (y < 0) code |= CS_TOP;
+    else if (y > ymax) code |= CS_BOTTOM;
+
+    return code;
+}
+
+// Returns 0 when the segment is fully outside [0, xmax] x [0, ymax]
+static int clip_line(long* x0, long* y0, long* x1, long* y1, long xmax, long ymax) {
+    int code0 = out_code(*x0, *y0, xmax, ymax);
+    int code1 = out_code(*x1, *y1, xmax, ymax);
+
+    while (1) {
+        if (!(code0 | code1)) return 1; // trivially inside
+        if (code0 & code1) return 0;    // trivially outside
+
+        int code = code0 ? code0 : code1;
+        long dx = *x1 - *x0;
+        long dy = *y1 - *y0;
+        long x, y;
+
+        // dx/dy cannot be 0 here: the endpoint would share the out code
+        if (code & CS_BOTTOM) {
+            x = *x0 + dx * (ymax - *y0) / dy;
+            y = ymax;
+        } else if (code & CS_TOP) {
+            x = *x0 + dx * (0 - *y0) / dy;
+            y = 0;
+        } else if (code & CS_RIGHT) {
+            y = *y0 + dy * (xmax - *x0) / dx;
+            x = xmax;
+        } else {
+            y = *y0 + dy * (0 - *x0) / dx;
+            x = 0;
+        }
+
+        if (code == code0) {
+            *x0 = x; *y0 = y;
+            code0 = out_code(*x0, *y0, xmax, ymax);
+        } else {
+            *x1 = x; *y1 = y;
+            code1 = out_code(*x1, *y1, xmax, ymax);
+        }
+    }
+}
+
+/* **************************** LINE RASTER ****************************** */
+
+static inline void plot(Framebuffer* fb, int x, int y, uint32_t color) {
+    color_tile(fb, TILE_INDEX(fb, x, y))[TILE_OFFSET(x, y)] = color;
+}
+
+void framebuffer_draw_line(Framebuffer* fb, int x0, int y0, int x1, int y1, uint32_t color) {
+    // Clipped relative to the viewport origin
+    Viewport vp = fb->viewport;
+    if (vp.width <= 0 || vp.height <= 0) return;
+    long lx0 = x0 - vp.x, ly0 = y0 - vp.y, lx1 = x1 - vp.x, ly1 = y1 - vp.y;
+    if (!clip_line(&lx0, &ly0, &lx1, &ly1, vp.width - 1, vp.height - 1))
+        return;
+
+    int ax = (int)lx0 + vp.x, ay = (int)ly0 + vp.y, bx = (int)lx1 + vp.x, by = (int)ly1 + vp.y;
+
+    // Horizontal span: one tile row at a time
+    if (ay == by) {
+        if (ax > bx) { int t = ax; ax = bx; bx = t; }
+        for (int x = ax; x <= bx;) {
+            uint32_t* row = color_tile(fb, TILE_INDEX(fb, x, ay)) + TILE_OFFSET(0, ay);
+            int end = (x | TILE_MASK) < bx ? (x | TILE_MASK) : bx;
+            for (; x <= end; x++)
+                row[x & TILE_MASK] = color;
+        }
+        fb->pixels_drawn += bx - ax + 1;
+        return;
+    }
+
+    int dx = abs(bx - ax);
+    int dy = abs(by - ay);
+    fb->pixels_drawn += (dx >= dy ? dx : dy) + 1;
+    int sx = ax < bx ? 1 : -1;
+    int sy = ay < by ? 1 : -1;
+    int x = ax, y = ay;
+
+    if (dx >= dy) {
+        // x-major: one pixel per column
+        int err = 2 * dy - dx;
+        for (int i = 0; i <= dx; i++) {
+            plot(fb, x, y, color);
+            if (err > 0) {
+                y += sy;
+                err -= 2 * dx;
+            }
+            err += 2 * dy;
+            x += sx;
+        }
+    } else {
+        // y-major: one pixel per row
+        int err = 2 * dx - dy;
+        for (int i = 0; i <= dy; i++) {
+            plot(fb, x, y, color);
+            if (err > 0) {
+                x += sx;
+                err -= 2 * dy;
+            }
+            err += 2 * dx;
+            y += sy;
+        }
+    }
+}
+
+/* **************************** RECTANGLES ****************************** */
+
+void framebuffer_fill_rect(Framebuffer* fb, int x0, int y0, int x1, int y1, float z, uint32_t color) {
+    Viewport vp = fb->viewport;
+    x0 = clamp_int(x0, vp.x, vp.x + vp.width);
+    x1 = clamp_int(x1, vp.x, vp.x + vp.width);
+    y0 = clamp_int(y0, vp.y, vp.y + vp.height);
+    y1 = clamp_int(y1, vp.y, vp.y + vp.height);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    // Points (particles): one pixel, no tile walk
+    if (x1 - x0 == 1 && y1 - y0 == 1) {
+        int tile = TILE_INDEX(fb, x0, y0);
+        float* d = depth_tile(fb, tile) + TILE_OFFSET(x0, y0);
+        if (z < *d) {
+            *d = z;
+            color_tile(fb, tile)[TILE_OFFSET(x0, y0)] = color;
+            fb->pixels_drawn++;
+        }
+        return;
+    }
+
+    touch_tiles(fb, x0, x1 - 1, y0, y1 - 1);
+    size_t band = (size_t)fb->tiles_x * FRAMEBUFFER_TILE_PIXELS;
+    size_t drawn = 0;
+    for (int y = y0; y < y1; y++) {
+        size_t row = (size_t)(y >> FRAMEBUFFER_TILE_SHIFT) * band + TILE_OFFSET(0, y);
+        uint32_t* pixels = fb->color + row;
+        float* depth = fb->depth + row;
+        for (int x = x0; x < x1; x++) {
+            size_t i = (size_t)(x >> FRAMEBUFFER_TILE_SHIFT) * FRAMEBUFFER_TILE_PIXELS + (x & TILE_MASK);
+            if (z < depth[i]) {
+                depth[i] = z;
+                pixels[i] = color;
+                drawn++;
+            }
+        }
+    }
+    fb->pixels_drawn += drawn;
+}
+
+/* **************************** TRIANGLES ****************************** */
+
+static inline float edge(float ax, float ay, float bx, float by, float px, float py) {
+    return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+}
+
+/*
+ * Triangles whose pixel box is at least two tiles wide and tall are
+ * rasterized tile by tile, skipping the tiles outside one of their edges.
+ * Smaller ones are walked as a single block: splitting them costs more
+ * setup than the few pixels it could skip.
+ */
+static inline int spans_tiles(int min_x, int max_x, int min_y, int max_y) {
+    return max_x - min_x >= 2 * FRAMEBUFFER_TILE && max_y - min_y >= 2 * FRAMEBUFFER_TILE;
+}
+
+/*
+ * Whether a (w + 1) x (h + 1) block of pixel centers, with edge values e
+ * at its top-left center, is entirely outside one of the edges. Edge
+ * functions are linear, so their maximum over the block is at a corner.
+ */
+static inline int block_outside(const float e[3], const float dx[3], const float dy[3], int w, int h) {
+    for (int k = 0; k < 3; k++) {
+        float reach_x = dx[k] * w, reach_y = dy[k] * h;
+        if (e[k] + (reach_x > 0 ? reach_x : 0) + (reach_y > 0 ? reach_y : 0) < 0) return 1;
+    }
+    return 0;
+}
+
+static inline uint32_t lerp_argb(const uint32_t c[3], float l0, float l1, float l2) {
+    uint32_t out = c[0] & 0xFF000000u;
+    for (int shift = 0; shift <= 16; shift += 8) {
+        float v = l0 * ((c[0] >> shift) & 0xFF) + l1 * ((c[1] >> shift) & 0xFF) + l2 * ((c[2] >> shift) & 0xFF);
+        out |= (uint32_t)(v + 0.5f) << shift;
+    }
+    return out;
+}
+
+/*
+ * Depth-tested fill of the pixel centers of [x_start, x_end] x [y_start, y_end]
+ * inside the triangle, e being the edge values at the first one. The block may
+ * cross tiles, all of them are filled beforehand.
+ *
+ * @return Pixels stored
+ */
+static inline size_t fill_block(Framebuffer* fb, int x_start, int x_end, int y_start, int y_end, const float e[3],
+                                const float dx[3], const float dy[3], float inv_area, const float zs[3],
+                                const uint32_t c[3], int flat) {
+    // Locals, so that the depth and color stores cannot alias them
+    float dx0 = dx[0], dx1 = dx[1], dx2 = dx[2];
+    float z0 = zs[0], z1 = zs[1], z2 = zs[2];
+    uint32_t colors[3] = {c[0], c[1], c[2]};
+    uint32_t* color = fb->color;
+    float* depth_tiles = fb->depth;
+    size_t band = (size_t)fb->tiles_x * FRAMEBUFFER_TILE_PIXELS;
+
+    float row0 = e[0], row1 = e[1], row2 = e[2];
+    size_t drawn = 0;
+    touch_tiles(fb, x_start, x_end, y_start, y_end);
+
+    for (int yy = y_start; yy <= y_end; yy++) {
+        float w0 = row0, w1 = row1, w2 = row2;
+        size_t row = (size_t)(yy >> FRAMEBUFFER_TILE_SHIFT) * band + TILE_OFFSET(0, yy);
+        uint32_t* pixels = color + row;
+        float* depth = depth_tiles + row;
+
+        for (int xx = x_start; xx <= x_end; xx++) {
+            if (w0 >= 0 && w1 >= 0 && w2 >= 0) {
+                size_t i = (size_t)(xx >> FRAMEBUFFER_TILE_SHIFT) * FRAMEBUFFER_TILE_PIXELS + (xx & TILE_MASK);
+                float l0 = w0 * inv_area, l1 = w1 * inv_area, l2 = w2 * inv_area;
+                float d = l0 * z0 + l1 * z1 + l2 * z2;
+                if (d < depth[i]) {
+                    depth[i] = d;
+                    pixels[i] = flat ? colors[0] : lerp_argb(colors, l0, l1, l2);
+                    drawn++;
+                }
+            }
+            w0 += dx0;
+            w1 += dx1;
+            w2 += dx2;
+        }
+
+        row0 += dy[0];
+        row1 += dy[1];
+        row2 += dy[2];
+    }
+    return drawn;
+}
+
+void framebuffer_fill_triangle(Framebuffer* fb, const float x[3], const float y[3], const float z[3],
+                               const uint32_t color[3]) {
+    float area = edge(x[0], y[0], x[1], y[1], x[2], y[2]);
+    if (fabsf(area) < 1e-8f) return;
+
+    // Both windings are filled: make the edge functions positive inside
+    int i1 = 1, i2 = 2;
+    if (area < 0) {
+        i1 = 2;
+        i2 = 1;
+        area = -area;
+    }
+    float x0 = x[0], y0 = y[0], x1 = x[i1], y1 = y[i1], x2 = x[i2], y2 = y[i2];
+    uint32_t c[3] = {color[0], color[i1], color[i2]};
+    float zs[3] = {z[0], z[i1], z[i2]};
+    int flat = c[0] == c[1] && c[1] == c[2];
+
+    // Pixel centers inside the bounding box, clamped to the viewport
+    const Viewport* vp = &fb->viewport;
+    int min_x = (int)fmaxf((float)vp->x, ceilf(fminf(x0, fminf(x1, x2)) - 0.5f));
+    int max_x = (int)fminf(vp->x + vp->width - 1.0f, floorf(fmaxf(x0, fmaxf(x1, x2)) - 0.5f));
+    int min_y = (int)fmaxf((float)vp->y, ceilf(fminf(y0, fminf(y1, y2)) - 0.5f));
+    int max_y = (int)fminf(vp->y + vp->height - 1.0f, floorf(fmaxf(y0, fmaxf(y1, y2)) - 0.5f));
+    if (min_x > max_x || min_y > max_y) return;
+
+    float inv_area = 1.0f / area;
+    size_t drawn = 0;
+
+    // Edge function increments along x and y
+    float dx[3] = {-(y2 - y1), -(y0 - y2), -(y1 - y0)};
+    float dy[3] = {x2 - x1, x0 - x2, x1 - x0};
+
+    if (!spans_tiles(min_x, max_x, min_y, max_y)) {
+        float px = min_x + 0.5f, py = min_y + 0.5f;
+        float e[3] = {edge(x1, y1, x2, y2, px, py), edge(x2, y2, x0, y0, px, py), edge(x0, y0, x1, y1, px, py)};
+        drawn = fill_block(fb, min_x, max_x, min_y, max_y, e, dx, dy, inv_area, zs, c, flat);
+    } else {
+        for (int ty = min_y >> FRAMEBUFFER_TILE_SHIFT; ty <= max_y >> FRAMEBUFFER_TILE_SHIFT; ty++) {
+            int y_start = ty << FRAMEBUFFER_TILE_SHIFT;
+            int y_end = (y_start | TILE_MASK) < max_y ? (y_start | TILE_MASK) : max_y;
+            if (y_start < min_y) y_start = min_y;
+
+            for (int tx = min_x >> FRAMEBUFFER_TILE_SHIFT; tx <= max_x >> FRAMEBUFFER_TILE_SHIFT; tx++) {
+                int x_start = tx << FRAMEBUFFER_TILE_SHIFT;
+                int x_end = (x_start | TILE_MASK) < max_x ? (x_start | TILE_MASK) : max_x;
+                if (x_start < min_x) x_start = min_x;
+
+                float px = x_start + 0.5f, py = y_start + 0.5f;
+                float e[3] = {edge(x1, y1, x2, y2, px, py), edge(x2, y2, x0, y0, px, py), edge(x0, y0, x1, y1, px, py)};
+                if (!block_outside(e, dx, dy, x_end - x_start, y_end - y_start))
+                    drawn += fill_block(fb, x_start, x_end, y_start, y_end, e, dx, dy, inv_area, zs, c, flat);
+            }
+        }
+    }
+    fb->pixels_drawn += drawn;
+}
+
+// Pixels per texture_sample call, sharing one mip level
+#define TEXTURE_SPAN 4
+
+// Per-triangle constants of a textured fill: affine depth, q = 1/w, s = u/w, t = v/w and their gradients
+typedef struct TexturedSetup {
+    float dx[3], dy[3];
+    float inv_area;
+    float zs[3], q[3], s[3], t[3];
+    float dqdx, dqdy, dsdx, dsdy, dtdx, dtdy;
+    const Texture* tex;
+    TextureFilter filter;
+} TexturedSetup;
+
+// fill_block for textured triangles: covered pixels are sampled TEXTURE_SPAN at a time along each row
+static inline size_t sample_block(Framebuffer* fb, int x_start, int x_end, int y_start, int y_end, const float e[3],
+                                  const TexturedSetup* setup) {
+    // Local copy, so that the depth and color stores cannot alias it
+    TexturedSetup ts = *setup;
+    const float* zs = ts.zs;
+    const float* q = ts.q;
+    const float* s = ts.s;
+    const float* t = ts.t;
+    float inv_area = ts.inv_area;
+    float row0 = e[0], row1 = e[1], row2 = e[2];
+    uint32_t* color = fb->color;
+    float* depth_tiles = fb->depth;
+    size_t band = (size_t)fb->tiles_x * FRAMEBUFFER_TILE_PIXELS;
+    size_t drawn = 0;
+    touch_tiles(fb, x_start, x_end, y_start, y_end);
+
+    for (int yy = y_start; yy <= y_end; yy++) {
+        float w0 = row0, w1 = row1, w2 = row2;
+        size_t row = (size_t)(yy >> FRAMEBUFFER_TILE_SHIFT) * band + TILE_OFFSET(0, yy);
+        uint32_t* pixels = color + row;
+        float* depth = depth_tiles + row;
+
+        for (int xx = x_start; xx <= x_end; xx += TEXTURE_SPAN) {
+            float su[TEXTURE_SPAN], sv[TEXTURE_SPAN], sd[TEXTURE_SPAN];
+            int si[TEXTURE_SPAN];
+            float first_w = 0.0f;
+            int n = 0;
+
+            for (int k = 0; k < TEXTURE_SPAN && xx + k <= x_end; k++) {
+                if (w0 >= 0 && w1 >= 0 && w2 >= 0) {
+                    int i = ((xx + k) >> FRAMEBUFFER_TILE_SHIFT) * FRAMEBUFFER_TILE_PIXELS + ((xx + k) & TILE_MASK);
+                    float l0 = w0 * inv_area, l1 = w1 * inv_area, l2 = w2 * inv_area;
+                    float d = l0 * zs[0] + l1 * zs[1] + l2 * zs[2];
+                    if (d < depth[i]) {
+                        float pw = 1.0f / (l0 * q[0] + l1 * q[1] + l2 * q[2]);
+                        if (n == 0) first_w = pw;
+                        su[n] = (l0 * s[0] + l1 * s[1] + l2 * s[2]) * pw;
+                        sv[n] = (l0 * t[0] + l1 * t[1] + l2 * t[2]) * pw;
+                        sd[n] = d;
+                        si[n++] = i;
+                    }
+                }
+                w0 += ts.dx[0];
+                w1 += ts.dx[1];
+                w2 += ts.dx[2];
+            }
+            if (n == 0) continue;
+
+            // d(s/q) = (ds - u dq) / q
+            int level = texture_select_level(ts.tex,
+                (ts.dsdx - su[0] * ts.dqdx) * first_w, (ts.dtdx - sv[0] * ts.dqdx) * first_w,
+                (ts.dsdy - su[0] * ts.dqdy) * first_w, (ts.dtdy - sv[0] * ts.dqdy) * first_w);
+
+            uint32_t texels[TEXTURE_SPAN];
+            texture_sample(ts.tex, su, sv, n, level, ts.filter, texels);
+            for (int k = 0; k < n; k++) {
+                pixels[si[k]] = texels[k];
+                depth[si[k]] = sd[k];
+            }
+            drawn += n;
+        }
+
+        row0 += ts.dy[0];
+        row1 += ts.dy[1];
+        row2 += ts.dy[2];
+    }
+    return drawn;
+}
+
+void framebuffer_fill_triangle_textured(Framebuffer* fb, const float x[3], const float y[3], const float z[3],
+                                        const float inv_w[3], const float u[3], const float v[3],
+                                        const Texture* tex, TextureFilter filter) {
+    float area = edge(x[0], y[0], x[1], y[1], x[2], y[2]);
+    if (fabsf(area) < 1e-8f) return;
+
+    int order[3] = {0, 1, 2};
+    if (area < 0) {
+        order[1] = 2;
+        order[2] = 1;
+        area = -area;
+    }
+    float x0 = x[0], y0 = y[0], x1 = x[order[1]], y1 = y[order[1]], x2 = x[order[2]], y2 = y[order[2]];
+
+    TexturedSetup ts = {
+        .dx = {-(y2 - y1), -(y0 - y2), -(y1 - y0)},
+        .dy = {x2 - x1, x0 - x2, x1 - x0},
+        .inv_area = 1.0f / area,
+        .tex = tex,
+        .filter = filter
+    };
+    for (int k = 0; k < 3; k++) {
+        int o = order[k];
+        ts.zs[k] = z[o];
+        ts.q[k] = inv_w[o];
+        ts.s[k] = u[o] * inv_w[o];
+        ts.t[k] = v[o] * inv_w[o];
+    }
+
+    const Viewport* vp = &fb->viewport;
+    int min_x = (int)fmaxf((float)vp->x, ceilf(fminf(x0, fminf(x1, x2)) - 0.5f));
+    int max_x = (int)fminf(vp->x + vp->width - 1.0f, floorf(fmaxf(x0, fmaxf(x1, x2)) - 0.5f));
+    int min_y = (int)fmaxf((float)vp->y, ceilf(fminf(y0, fminf(y1, y2)) - 0.5f));
+    int max_y = (int)fminf(vp->y + vp->height - 1.0f, floorf(fmaxf(y0, fmaxf(y1, y2)) - 0.5f));
+    if (min_x > max_x || min_y > max_y) return;
+
+    // Screen-space gradients of q, s, t, for the UV derivatives
+    const float* dx = ts.dx;
+    const float* dy = ts.dy;
+    ts.dqdx = (dx[0] * ts.q[0] + dx[1] * ts.q[1] + dx[2] * ts.q[2]) * ts.inv_area;
+    ts.dqdy = (dy[0] * ts.q[0] + dy[1] * ts.q[1] + dy[2] * ts.q[2]) * ts.inv_area;
+    ts.dsdx = (dx[0] * ts.s[0] + dx[1] * ts.s[1] + dx[2] * ts.s[2]) * ts.inv_area;
+    ts.dsdy = (dy[0] * ts.s[0] + dy[1] * ts.s[1] + dy[2] * ts.s[2]) * ts.inv_area;
+    ts.dtdx = (dx[0] * ts.t[0] + dx[1] * ts.t[1] + dx[2] * ts.t[2]) * ts.inv_area;
+    ts.dtdy = (dy[0] * ts.t[0] + dy[1] * ts.t[1] + dy[2] * ts.t[2]) * ts.inv_area;
+
+    size_t drawn = 0;
+    if (!spans_tiles(min_x, max_x, min_y, max_y)) {
+        float px = min_x + 0.5f, py = min_y + 0.5f;
+        float e[3] = {edge(x1, y1, x2, y2, px, py), edge(x2, y2, x0, y0, px, py), edge(x0, y0, x1, y1, px, py)};
+        drawn = sample_block(fb, min_x, max_x, min_y, max_y, e, &ts);
+    } else {
+        for (int ty = min_y >> FRAMEBUFFER_TILE_SHIFT; ty <= max_y >> FRAMEBUFFER_TILE_SHIFT; ty++) {
+            int y_start = ty << FRAMEBUFFER_TILE_SHIFT;
+            int y_end = (y_start | TILE_MASK) < max_y ? (y_start | TILE_MASK) : max_y;
+            if (y_start < min_y) y_start = min_y;
+
+            for (int tx = min_x >> FRAMEBUFFER_TILE_SHIFT; tx <= max_x >> FRAMEBUFFER_TILE_SHIFT; tx++) {
+                int x_start = tx << FRAMEBUFFER_TILE_SHIFT;
+                int x_end = (x_start | TILE_MASK) < max_x ? (x_start | TILE_MASK) : max_x;
+                if (x_start < min_x) x_start = min_x;
+
+                float px = x_start + 0.5f, py = y_start + 0.5f;
+                float e[3] = {edge(x1, y1, x2, y2, px, py), edge(x2, y2, x0, y0, px, py), edge(x0, y0, x1, y1, px, py)};
+                if (!block_outside(e, dx, dy, x_end - x_start, y_end - y_start))
+                    drawn += sample_block(fb, x_start, x_end, y_start, y_end, e, &ts);
+            }
+        }
+    }
+    fb->pixels_drawn += drawn;
+}
+
+void framebuffer_destroy(Framebuffer* fb) {
+    if (fb->tile_flags) memory_free(MEMORY_RENDER, fb->tile_flags);
+    if (fb->depth) memory_free(MEMORY_RENDER, fb->depth);
+    if (fb->color) memory_free(MEMORY_RENDER, fb->color);
+    if (fb->pixels) memory_free(MEMORY_RENDER, fb->pixels);
+    memory_free(MEMORY_RENDER, fb);
+}
@@ -0,0 +1,123 @@
+#include <stdlib.h>
+
+#include "core/jobs.h"
+#include "core/memory.h"
+
+// Batches per participating thread, smooths out uneven batch costs
+#define BATCHES_PER_THREAD 4
+
+// Claims batches of the current task until none is left
+static void run_batches(JobSystem* jobs) {
+    for (;;) {
+        int start = SDL_AtomicAdd(&jobs->next, jobs->batch);
+        if (start >= jobs->count) return;
+
+        int end = start + jobs->batch;
+        if (end > jobs->count) end = jobs->count;
+        jobs->fn(jobs->ctx, start, end);
+    }
+}
+
+static int worker_main(void* data) {
+    JobSystem* jobs = data;
+    int seen = 0;
+
+    SDL_LockMutex(jobs->lock);
+    for (;;) {
+        while (!jobs->quit && jobs->generation == seen)
+            SDL_CondWait(jobs->wake, jobs->lock);
+        if (jobs->quit) break;
+        seen = jobs->generation;
+        SDL_UnlockMutex(jobs->lock);
+
+        run_batches(jobs);
+
+        SDL_LockMutex(jobs->lock);
+        if (--jobs->active == 0)
+            SDL_CondSignal(jobs->done);
+    }
+    SDL_UnlockMutex(jobs->lock);
+
+    return 0;
+}
+
+JobSystem* jobs_create(int thread_count) {
+    if (thread_count < 0)
+        thread_count = SDL_GetCPUCount() - 1;
+    if (thread_count < 0)
+        thread_count = 0;
+
+    JobSystem* jobs = memory_calloc(MEMORY_THREADS, 1, sizeof(JobSystem));
+    if (!jobs) return NULL;
+
+    jobs->lock = SDL_CreateMutex();
+    jobs->wake = SDL_CreateCond();
+    jobs->done = SDL_CreateCond();
+    jobs->threads = memory_calloc(MEMORY_THREADS, thread_count > 0 ? thread_count : 1, sizeof(SDL_Thread*));
+    if (!jobs->lock || !jobs->wake || !jobs->done || !jobs->threads) {
+        jobs_destroy(jobs);
+        return NULL;
+    }
+
+    for (int i = 0; i < thread_count; i++) {
+        jobs->threads[i] = SDL_CreateThread(worker_main, "job worker", jobs);
+        if (!jobs->threads[i]) {
+            jobs_destroy(jobs);
+            return NULL;
+        }
+        jobs->thread_count++;
+    }
+
+    return jobs;
+}
+
+void jobs_parallel_for(JobSystem* jobs, int count, int min_batch, JobFunction fn, void* ctx) {
+    if (count <= 0) return;
+    if (min_batch < 1) min_batch = 1;
+
+    if (!jobs || jobs->thread_count == 0 || count <= min_batch) {
+        fn(ctx, 0, count);
+        return;
+    }
+
+    int batch = count / ((jobs->thread_count + 1) * BATCHES_PER_THREAD);
+    if (batch < min_batch) batch = min_batch;
+
+    SDL_LockMutex(jobs->lock);
+    jobs->fn = fn;
+    jobs->ctx = ctx;
+    jobs->count = count;
+    jobs->batch = batch;
+    SDL_AtomicSet(&jobs->next, 0);
+    jobs->active = jobs->thread_count;
+    jobs->generation++;
+    SDL_CondBroadcast(jobs->wake);
+    SDL_UnlockMutex(jobs->lock);
+
+    run_batches(jobs);
+
+    SDL_LockMutex(jobs->lock);
+    while (jobs->active > 0)
+        SDL_CondWait(jobs->done, jobs->lock);
+    SDL_UnlockMutex(jobs->lock);
+}
+
+void jobs_destroy(JobSystem* jobs) {
+    if (!jobs) return;
+
+    if (jobs->lock) {
+        SDL_LockMutex(jobs->lock);
+        jobs->quit = 1;
+        if (jobs->wake) SDL_CondBroadcast(jobs->wake);
+        SDL_UnlockMutex(jobs->lock);
+    }
+
+    for (int i = 0; i < jobs->thread_count; i++)
+        SDL_WaitThread(jobs->threads[i], NULL);
+
+    if (jobs->done) SDL_DestroyCond(jobs->done);
+    if (jobs->wake) SDL_DestroyCond(jobs->wake);
+    if (jobs->lock) SDL_DestroyMutex(jobs->lock);
+    memory_free(MEMORY_THREADS, jobs->threads);
+    memory_free(MEMORY_THREADS, jobs);
+}
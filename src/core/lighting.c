@@ -0,0 +1,36 @@
+#include <math.h>
+
+#include "core/lighting.h"
+
+int lighting_add(Lighting* lighting, Light light) {
+    if (lighting->count >= LIGHTING_MAX_LIGHTS) return -1;
+
+    lighting->lights[lighting->count] = light;
+    return lighting->count++;
+}
+
+Vector3 lighting_evaluate(const Lighting* lighting, Vector3 position, Vector3 normal) {
+    Vector3 acc = lighting->ambient;
+
+    for (int i = 0; i < lighting->count; i++) {
+        const Light* light = &lighting->lights[i];
+        float factor;
+
+        if (light->type == LIGHT_DIRECTIONAL) {
+            Vector3 dir = normalize(light->direction);
+            factor = fmaxf(0.0f, -dot(normal, dir));
+        } else {
+            Vector3 d = subtract(light->position, position);
+            float dist = norm(d);
+            if (dist <= 0.0f) continue;
+            float attenuation = fmaxf(0.0f, 1.0f - dist / light->range);
+            factor = fmaxf(0.0f, dot(normal, d) / dist) * attenuation;
+        }
+
+        acc.x += light->color.x * factor;
+        acc.y += light->color.y * factor;
+        acc.z += light->color.z * factor;
+    }
+
+    return (Vector3){fminf(acc.x, 1.0f), fminf(acc.y, 1.0f), fminf(acc.z, 1.0f)};
+}
@@ -0,0 +1,111 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <SDL.h>
+
+#include "core/memory.h"
+
+static const char* TAG_NAMES[MEMORY_TAGS] = {
+    "engine", "mesh", "scene", "render", "texture", "terrain",
+    "surface", "skinning", "particles", "assets", "threads", "arena", "capture", "replay"
+};
+
+static MemoryStats stats;
+static SDL_SpinLock lock;
+
+static int in_frame;
+static SDL_threadID frame_thread;
+#ifdef MEMORY_STRICT
+static int strict = 1;
+#else
+static int strict;
+#endif
+
+static void record(MemoryTag tag, size_t bytes, int allocations, int frees) {
+    SDL_AtomicLock(&lock);
+    stats.total[tag].bytes += bytes;
+    stats.total[tag].allocations += allocations;
+    stats.total[tag].frees += frees;
+
+    int counted = in_frame && SDL_ThreadID() == frame_thread;
+    if (counted) {
+        stats.frame[tag].bytes += bytes;
+        stats.frame[tag].allocations += allocations;
+        stats.frame[tag].frees += frees;
+    }
+    int forbidden = counted && strict && allocations;
+    SDL_AtomicUnlock(&lock);
+
+    if (forbidden) {
+        fprintf(stderr, "memory: %zu bytes allocated by %s during a frame\n", bytes, TAG_NAMES[tag]);
+        abort();
+    }
+}
+
+void* memory_alloc(MemoryTag tag, size_t size) {
+    record(tag, size, 1, 0);
+    return malloc(size);
+}
+
+void* memory_calloc(MemoryTag tag, size_t count, size_t size) {
+    record(tag, count * size, 1, 0);
+    return calloc(count, size);
+}
+
+void* memory_realloc(MemoryTag tag, void* ptr, size_t size) {
+    record(tag, size, 1, 0);
+    return realloc(ptr, size);
+}
+
+void* memory_aligned_alloc(MemoryTag tag, size_t alignment, size_t size) {
+    size = (size + alignment - 1) / alignment * alignment;
+    record(tag, size, 1, 0);
+    return aligned_alloc(alignment, size);
+}
+
+void memory_free(MemoryTag tag, void* ptr) {
+    if (!ptr) return;
+    record(tag, 0, 0, 1);
+    free(ptr);
+}
+
+void memory_frame_begin(void) {
+    SDL_AtomicLock(&lock);
+    for (int t = 0; t < MEMORY_TAGS; t++)
+        stats.frame[t] = (MemoryCounters){0};
+    frame_thread = SDL_ThreadID();
+    in_frame = 1;
+    SDL_AtomicUnlock(&lock);
+}
+
+void memory_frame_end(void) {
+    SDL_AtomicLock(&lock);
+    in_frame = 0;
+    SDL_AtomicUnlock(&lock);
+}
+
+void memory_set_strict(int enabled) {
+    SDL_AtomicLock(&lock);
+    strict = enabled;
+    SDL_AtomicUnlock(&lock);
+}
+
+MemoryStats memory_stats(void) {
+    SDL_AtomicLock(&lock);
+    MemoryStats copy = stats;
+    SDL_AtomicUnlock(&lock);
+    return copy;
+}
+
+MemoryCounters memory_sum(const MemoryCounters counters[MEMORY_TAGS]) {
+    MemoryCounters sum = {0};
+    for (int t = 0; t < MEMORY_TAGS; t++) {
+        sum.bytes += counters[t].bytes;
+        sum.allocations += counters[t].allocations;
+        sum.frees += counters[t].frees;
+    }
+    return sum;
+}
+
+const char* memory_tag_name(MemoryTag tag) {
+    return tag >= 0 && tag < MEMORY_TAGS ? TAG_NAMES[tag] : "unknown";
+}
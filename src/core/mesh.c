@@ -1,16 +1,26 @@
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
 #include "core/mesh.h"
+#include "core/memory.h"
 
 Mesh* mesh_generate(const Vector4* vertices, int vertex_count,
                    const Triangle* triangles, int triangle_count) {
-    Mesh* mesh = malloc(sizeof(Mesh));
+    Mesh* mesh = memory_alloc(MEMORY_MESH, sizeof(Mesh));
     if (!mesh) return NULL;
     
     mesh->vertex_count = vertex_count;
     mesh->triangle_count = triangle_count;
+    mesh->positions = NULL;
+    mesh->normals = NULL;
+    mesh->uvs = NULL;
+    mesh->triangles16 = NULL;
+    mesh->shared = 0;
 
     // allocate internal storage
-    mesh->vertices = malloc(sizeof(Vector4) * vertex_count);
-    mesh->triangles = malloc(sizeof(Triangle) * triangle_count);
+    mesh->vertices = memory_alloc(MEMORY_MESH, sizeof(Vector4) * vertex_count);
+    mesh->triangles = memory_alloc(MEMORY_MESH, sizeof(Triangle) * triangle_count);
 
     // copy input data
     for (int i = 0; i < vertex_count; i++) {
@@ -23,25 +33,481 @@ Mesh* mesh_generate(const Vector4* vertices, int vertex_count,
     return mesh;
 }
 
+// Copy of n elements, NULL for a NULL source
+static void* copy_stream(const void* src, size_t size, int n) {
+    if (!src) return NULL;
+    void* dst = memory_alloc(MEMORY_MESH, size * (n > 0 ? n : 1));
+    if (dst) memcpy(dst, src, size * n);
+    return dst;
+}
+
 Mesh* mesh_copy(const Mesh* src) {
-    Mesh* dst = malloc(sizeof(Mesh));
+    Mesh* dst = memory_alloc(MEMORY_MESH, sizeof(Mesh));
+    if (!dst) return NULL;
+
+    dst->vertex_count = src->vertex_count;
+    dst->vertices = copy_stream(src->vertices, sizeof(Vector4), src->vertex_count);
+    dst->positions = copy_stream(src->positions, sizeof(Vector3), src->vertex_count);
+    dst->normals = copy_stream(src->normals, sizeof(Vector4), src->vertex_count);
+    dst->uvs = copy_stream(src->uvs, sizeof(TexCoord), src->vertex_count);
+
+    dst->triangle_count = src->triangle_count;
+    dst->triangles = copy_stream(src->triangles, sizeof(Triangle), src->triangle_count);
+    dst->triangles16 = copy_stream(src->triangles16, sizeof(Triangle16), src->triangle_count);
+    dst->shared = 0;
+
+    return dst;
+}
+
+Mesh* mesh_create_clipped(const Mesh* src) {
+    Mesh* dst = memory_calloc(MEMORY_MESH, 1, sizeof(Mesh));
     if (!dst) return NULL;
 
     dst->vertex_count = src->vertex_count;
-    dst->vertices = malloc(sizeof(Vector4) * src->vertex_count);
-    for (int i = 0; i < src->vertex_count; i++)
-        dst->vertices[i] = src->vertices[i];
+    dst->vertices = memory_calloc(MEMORY_MESH, src->vertex_count > 0 ? src->vertex_count : 1, sizeof(Vector4));
+    if (!dst->vertices) {
+        memory_free(MEMORY_MESH, dst);
+        return NULL;
+    }
+    dst->uvs = src->uvs;
 
     dst->triangle_count = src->triangle_count;
-    dst->triangles = malloc(sizeof(Triangle) * src->triangle_count);
-    for (int i = 0; i < src->triangle_count; i++)
-        dst->triangles[i] = src->triangles[i];
+    dst->triangles = src->triangles;
+    dst->triangles16 = src->triangles16;
+    dst->shared = 1;
 
     return dst;
 }
 
+int mesh_compact(Mesh* mesh) {
+    int n = mesh->vertex_count, t = mesh->triangle_count;
+    int narrow = mesh->triangles && n <= MESH_INDEX16_MAX_VERTICES;
+
+    Vector3* positions = NULL;
+    Triangle16* triangles16 = NULL;
+    if (mesh->vertices && !(positions = memory_alloc(MEMORY_MESH, sizeof(Vector3) * (n > 0 ? n : 1))))
+        return 0;
+    if (narrow && !(triangles16 = memory_alloc(MEMORY_MESH, sizeof(Triangle16) * (t > 0 ? t : 1)))) {
+        memory_free(MEMORY_MESH, positions);
+        return 0;
+    }
+
+    if (positions) {
+        for (int i = 0; i < n; i++)
+            positions[i] = (Vector3){mesh->vertices[i].x, mesh->vertices[i].y, mesh->vertices[i].z};
+        memory_free(MEMORY_MESH, mesh->vertices);
+        mesh->vertices = NULL;
+        mesh->positions = positions;
+    }
+    if (triangles16) {
+        for (int f = 0; f < t; f++)
+            for (int k = 0; k < 3; k++)
+                triangles16[f].vert[k] = (uint16_t)mesh->triangles[f].vert[k];
+        memory_free(MEMORY_MESH, mesh->triangles);
+        mesh->triangles = NULL;
+        mesh->triangles16 = triangles16;
+    }
+    return 1;
+}
+
+size_t mesh_geometry_bytes(const Mesh* mesh) {
+    size_t position = mesh->positions ? sizeof(Vector3) : sizeof(Vector4);
+    size_t triangle = mesh->triangles16 ? sizeof(Triangle16) : sizeof(Triangle);
+    return position * mesh->vertex_count + triangle * mesh->triangle_count;
+}
+
+Bounds mesh_bounds(const Mesh* mesh) {
+    if (mesh->vertex_count == 0)
+        return (Bounds){NULL_VECTOR3, NULL_VECTOR3};
+
+    Vector3 first = mesh_position(mesh, 0);
+    Bounds b = {first, first};
+
+    for (int i = 1; i < mesh->vertex_count; i++) {
+        Vector3 v = mesh_position(mesh, i);
+        b.min.x = fminf(b.min.x, v.x); b.max.x = fmaxf(b.max.x, v.x);
+        b.min.y = fminf(b.min.y, v.y); b.max.y = fmaxf(b.max.y, v.y);
+        b.min.z = fminf(b.min.z, v.z); b.max.z = fmaxf(b.max.z, v.z);
+    }
+
+    return b;
+}
+
+/* **************************** NORMALS ****************************** */
+
+// Smallest number of triangles / vertices worth handing to another thread
+#define NORMALS_MIN_BATCH 4096
+
+typedef struct NormalJob {
+    const Mesh* mesh;
+    Vector3* face_normals;  // one per triangle, length = 2 * area
+    const int* offsets;     // vertex -> range of its triangles in `faces`
+    const int* faces;
+    Vector4* normals;
+} NormalJob;
+
+static void face_normals_range(void* ctx, int start, int end) {
+    const NormalJob* job = ctx;
+
+    for (int t = start; t < end; t++) {
+        Triangle tri = mesh_triangle(job->mesh, t);
+        Vector3 p0 = mesh_position(job->mesh, tri.vert[0]);
+        Vector3 p1 = mesh_position(job->mesh, tri.vert[1]);
+        Vector3 p2 = mesh_position(job->mesh, tri.vert[2]);
+        Vector3 a = {p1.x - p0.x, p1.y - p0.y, p1.z - p0.z};
+        Vector3 b = {p2.x - p0.x, p2.y - p0.y, p2.z - p0.z};
+        job->face_normals[t] = cross(a, b);
+    }
+}
+
+// Gathers instead of scattering, so no two threads write the same vertex
+static void vertex_normals_range(void* ctx, int start, int end) {
+    const NormalJob* job = ctx;
+
+    for (int i = start; i < end; i++) {
+        Vector3 sum = NULL_VECTOR3;
+        for (int k = job->offsets[i]; k < job->offsets[i + 1]; k++) {
+            Vector3 n = job->face_normals[job->faces[k]];
+            sum.x += n.x;
+            sum.y += n.y;
+            sum.z += n.z;
+        }
+
+        float len = norm(sum);
+        job->normals[i] = len > 0.0f ? (Vector4){sum.x / len, sum.y / len, sum.z / len, 0.0f}
+                                     : NULL_VECTOR4;
+    }
+}
+
+int mesh_compute_normals(Mesh* mesh, JobSystem* jobs) {
+    int n = mesh->vertex_count, t = mesh->triangle_count;
+
+    Vector4* normals = mesh->normals ? mesh->normals : memory_alloc(MEMORY_MESH, sizeof(Vector4) * (n > 0 ? n : 1));
+    Vector3* face_normals = memory_alloc(MEMORY_MESH, sizeof(Vector3) * (t > 0 ? t : 1));
+    int* offsets = memory_calloc(MEMORY_MESH, n + 1, sizeof(int));
+    int* faces = memory_alloc(MEMORY_MESH, sizeof(int) * 3 * (t > 0 ? t : 1));
+    int* cursor = memory_alloc(MEMORY_MESH, sizeof(int) * (n > 0 ? n : 1));
+    if (!normals || !face_normals || !offsets || !faces || !cursor) {
+        if (normals != mesh->normals) memory_free(MEMORY_MESH, normals);
+        memory_free(MEMORY_MESH, face_normals);
+        memory_free(MEMORY_MESH, offsets);
+        memory_free(MEMORY_MESH, faces);
+        memory_free(MEMORY_MESH, cursor);
+        return 0;
+    }
+
+    // Vertex -> triangles adjacency (counting sort)
+    for (int f = 0; f < t; f++)
+        for (int k = 0; k < 3; k++)
+            offsets[mesh_triangle(mesh, f).vert[k] + 1]++;
+    for (int i = 0; i < n; i++)
+        offsets[i + 1] += offsets[i];
+    memcpy(cursor, offsets, sizeof(int) * n);
+    for (int f = 0; f < t; f++)
+        for (int k = 0; k < 3; k++)
+            faces[cursor[mesh_triangle(mesh, f).vert[k]]++] = f;
+    memory_free(MEMORY_MESH, cursor);
+
+    NormalJob job = {
+        .mesh = mesh, .face_normals = face_normals,
+        .offsets = offsets, .faces = faces, .normals = normals
+    };
+    jobs_parallel_for(jobs, t, NORMALS_MIN_BATCH, face_normals_range, &job);
+    jobs_parallel_for(jobs, n, NORMALS_MIN_BATCH, vertex_normals_range, &job);
+
+    mesh->normals = normals;
+    memory_free(MEMORY_MESH, face_normals);
+    memory_free(MEMORY_MESH, offsets);
+    memory_free(MEMORY_MESH, faces);
+    return 1;
+}
+
+/* **************************** UVS ****************************** */
+
+int mesh_set_uvs(Mesh* mesh, const TexCoord* uvs) {
+    TexCoord* copy = mesh->uvs ? mesh->uvs : memory_alloc(MEMORY_MESH, sizeof(TexCoord) * (mesh->vertex_count > 0 ? mesh->vertex_count : 1));
+    if (!copy) return 0;
+
+    memcpy(copy, uvs, sizeof(TexCoord) * mesh->vertex_count);
+    mesh->uvs = copy;
+    return 1;
+}
+
+/* **************************** WELDING ****************************** */
+
+// Smallest number of vertices / triangles worth handing to another thread
+#define WELD_MIN_BATCH 4096
+
+// Grid cell size when welding exact matches only
+#define WELD_EXACT_CELL 1e-5
+
+// Cell coordinates beyond this are clamped (keeps the int64 conversion defined)
+#define WELD_MAX_CELL 1e15
+
+// Vertex copied next to its bucket neighbours, so a bucket scan reads contiguous memory
+typedef struct WeldEntry {
+    float x, y, z;
+    int index;
+} WeldEntry;
+
+typedef struct WeldJob {
+    const Mesh* mesh;
+    double inv_cell;
+    float epsilon;
+    uint32_t mask;          // hash table size - 1
+    uint32_t* buckets;      // bucket of each vertex
+    const int* offsets;     // bucket -> range of its vertices in `sorted`
+    const WeldEntry* sorted;    // vertices grouped by bucket, ascending inside a bucket
+    int* rep;               // vertex -> first earlier vertex within reach (itself if none)
+
+    const int* remap;       // old vertex -> welded vertex
+    const Vector4* welded;  // welded positions
+    Triangle* triangles;    // remapped triangles
+    uint8_t* degenerate;    // 1 for zero-area triangles
+} WeldJob;
+
+static inline int64_t weld_cell(float x, double inv_cell) {
+    double c = floor(x * inv_cell);
+    return (int64_t)fmin(WELD_MAX_CELL, fmax(-WELD_MAX_CELL, c));
+}
+
+static inline uint32_t weld_hash(int64_t x, int64_t y, int64_t z) {
+    uint64_t h = (uint64_t)x * 73856093u ^ (uint64_t)y * 19349663u ^ (uint64_t)z * 83492791u;
+    return (uint32_t)(h ^ (h >> 32));
+}
+
+static inline int weld_match(const Mesh* mesh, Vector4 p, int a, const WeldEntry* q, float epsilon2) {
+    float dx = p.x - q->x, dy = p.y - q->y, dz = p.z - q->z;
+    if (dx * dx + dy * dy + dz * dz > epsilon2) return 0;
+
+    if (mesh->uvs) {
+        int b = q->index;
+        float du = mesh->uvs[a].u - mesh->uvs[b].u, dv = mesh->uvs[a].v - mesh->uvs[b].v;
+        if (du * du + dv * dv > epsilon2) return 0;
+    }
+    return 1;
+}
+
+static void weld_hash_range(void* ctx, int start, int end) {
+    WeldJob* job = ctx;
+
+    for (int i = start; i < end; i++) {
+        Vector4 v = job->mesh->vertices[i];
+        job->buckets[i] = weld_hash(weld_cell(v.x, job->inv_cell), weld_cell(v.y, job->inv_cell),
+                                    weld_cell(v.z, job->inv_cell)) & job->mask;
+    }
+}
+
+// Read-only on the grid, each thread writes its own range of `rep`
+static void weld_search_range(void* ctx, int start, int end) {
+    WeldJob* job = ctx;
+    float e = job->epsilon;
+
+    for (int i = start; i < end; i++) {
+        Vector4 v = job->mesh->vertices[i];
+        int best = i;
+
+        // Cells are 2 * epsilon wide: the epsilon box around v spans at most 2 per axis
+        int64_t x0 = weld_cell(v.x - e, job->inv_cell), x1 = weld_cell(v.x + e, job->inv_cell);
+        int64_t y0 = weld_cell(v.y - e, job->inv_cell), y1 = weld_cell(v.y + e, job->inv_cell);
+        int64_t z0 = weld_cell(v.z - e, job->inv_cell), z1 = weld_cell(v.z + e, job->inv_cell);
+
+        for (int64_t cz = z0; cz <= z1; cz++)
+            for (int64_t cy = y0; cy <= y1; cy++)
+                for (int64_t cx = x0; cx <= x1; cx++) {
+                    uint32_t b = weld_hash(cx, cy, cz) & job->mask;
+                    for (int k = job->offsets[b]; k < job->offsets[b + 1]; k++) {
+                        const WeldEntry* entry = &job->sorted[k];
+                        if (entry->index >= best) break;
+                        if (weld_match(job->mesh, v, i, entry, job->epsilon * job->epsilon)) {
+                            best = entry->index;
+                            break;
+                        }
+                    }
+                }
+
+        job->rep[i] = best;
+    }
+}
+
+static void weld_triangles_range(void* ctx, int start, int end) {
+    WeldJob* job = ctx;
+    const Vector4* v = job->welded;
+
+    for (int t = start; t < end; t++) {
+        const int* old = job->mesh->triangles[t].vert;
+        int a = job->remap[old[0]], b = job->remap[old[1]], c = job->remap[old[2]];
+
+        // Smallest index first, winding kept
+        Triangle tri = {{a, b, c}};
+        if (b < a && b < c) tri = (Triangle){{b, c, a}};
+        else if (c < a && c < b) tri = (Triangle){{c, a, b}};
+        job->triangles[t] = tri;
+
+        Vector3 e1 = {v[b].x - v[a].x, v[b].y - v[a].y, v[b].z - v[a].z};
+        Vector3 e2 = {v[c].x - v[a].x, v[c].y - v[a].y, v[c].z - v[a].z};
+        Vector3 n = cross(e1, e2);
+        job->degenerate[t] = a == b || b == c || a == c || (n.x == 0.0f && n.y == 0.0f && n.z == 0.0f);
+    }
+}
+
+static inline uint32_t triangle_hash(Triangle t) {
+    return weld_hash(t.vert[0], t.vert[1], t.vert[2]);
+}
+
+// Smallest power of two >= 2 * count
+static uint32_t weld_table_size(int count) {
+    uint32_t size = 1;
+    while (size < 2u * (uint32_t)count) size <<= 1;
+    return size;
+}
+
+int mesh_weld(Mesh* mesh, float epsilon, JobSystem* jobs, MeshWeldStats* stats) {
+    if (!mesh->vertices || !mesh->triangles) return 0;
+
+    int n = mesh->vertex_count, t = mesh->triangle_count;
+    uint32_t grid_size = weld_table_size(n), tri_size = weld_table_size(t);
+
+    uint32_t* buckets = memory_alloc(MEMORY_MESH, sizeof(uint32_t) * (n > 0 ? n : 1));
+    int* offsets = memory_calloc(MEMORY_MESH, grid_size + 1, sizeof(int));
+    WeldEntry* sorted = memory_alloc(MEMORY_MESH, sizeof(WeldEntry) * (n > 0 ? n : 1));
+    int* rep = memory_alloc(MEMORY_MESH, sizeof(int) * (n > 0 ? n : 1));
+    int* remap = memory_alloc(MEMORY_MESH, sizeof(int) * (n > 0 ? n : 1));
+    Triangle* triangles = memory_alloc(MEMORY_MESH, sizeof(Triangle) * (t > 0 ? t : 1));
+    uint8_t* degenerate = memory_alloc(MEMORY_MESH, t > 0 ? t : 1);
+    int* seen = memory_alloc(MEMORY_MESH, sizeof(int) * tri_size);
+    Vector4* vertices = NULL;
+    TexCoord* uvs = NULL;
+    Vector4* normals = NULL;
+    int ok = buckets && offsets && sorted && rep && remap && triangles && degenerate && seen;
+
+    WeldJob job = {
+        .mesh = mesh,
+        .inv_cell = 1.0 / (epsilon > 0.0f ? 2.0 * epsilon : WELD_EXACT_CELL),
+        .epsilon = epsilon > 0.0f ? epsilon : 0.0f,
+        .mask = grid_size - 1,
+        .buckets = buckets, .offsets = offsets, .sorted = sorted, .rep = rep
+    };
+
+    int count = 0;
+    if (ok) {
+        jobs_parallel_for(jobs, n, WELD_MIN_BATCH, weld_hash_range, &job);
+
+        // Counting sort by bucket, stable so buckets list vertices in ascending order
+        for (int i = 0; i < n; i++)
+            offsets[buckets[i] + 1]++;
+        for (uint32_t b = 0; b < grid_size; b++)
+            offsets[b + 1] += offsets[b];
+        for (int i = 0; i < n; i++) {
+            Vector4 v = mesh->vertices[i];
+            sorted[offsets[buckets[i]]++] = (WeldEntry){v.x, v.y, v.z, i};
+        }
+        for (uint32_t b = grid_size; b > 0; b--)
+            offsets[b] = offsets[b - 1];
+        offsets[0] = 0;
+
+        jobs_parallel_for(jobs, n, WELD_MIN_BATCH, weld_search_range, &job);
+
+        // rep[i] <= i: resolving in order collapses chains onto their first vertex
+        for (int i = 0; i < n; i++) {
+            rep[i] = rep[rep[i]];
+            remap[i] = rep[i] == i ? count++ : remap[rep[i]];
+        }
+
+        vertices = memory_alloc(MEMORY_MESH, sizeof(Vector4) * (count > 0 ? count : 1));
+        if (mesh->uvs) uvs = memory_alloc(MEMORY_MESH, sizeof(TexCoord) * (count > 0 ? count : 1));
+        if (mesh->normals) normals = memory_alloc(MEMORY_MESH, sizeof(Vector4) * (count > 0 ? count : 1));
+        ok = vertices && (!mesh->uvs || uvs) && (!mesh->normals || normals);
+    }
+
+    int kept = 0, dropped_degenerate = 0, dropped_duplicates = 0;
+    if (ok) {
+        for (int i = 0; i < n; i++) {
+            if (rep[i] != i) continue;
+            vertices[remap[i]] = mesh->vertices[i];
+            if (uvs) uvs[remap[i]] = mesh->uvs[i];
+        }
+
+        job.remap = remap;
+        job.welded = vertices;
+        job.triangles = triangles;
+        job.degenerate = degenerate;
+        jobs_parallel_for(jobs, t, WELD_MIN_BATCH, weld_triangles_range, &job);
+
+        // Open addressing set of the kept triangles, first occurrence wins
+        memset(seen, 0xFF, sizeof(int) * tri_size);
+        for (int f = 0; f < t; f++) {
+            if (degenerate[f]) {
+                dropped_degenerate++;
+                continue;
+            }
+
+            Triangle tri = triangles[f];
+            uint32_t slot = triangle_hash(tri) & (tri_size - 1);
+            int duplicate = 0;
+            while (seen[slot] >= 0) {
+                const int* other = triangles[seen[slot]].vert;
+                if (other[0] == tri.vert[0] && other[1] == tri.vert[1] && other[2] == tri.vert[2]) {
+                    duplicate = 1;
+                    break;
+                }
+                slot = (slot + 1) & (tri_size - 1);
+            }
+            if (duplicate) {
+                dropped_duplicates++;
+                continue;
+            }
+
+            // kept <= f: compacting in place only overwrites visited entries
+            triangles[kept] = tri;
+            seen[slot] = kept++;
+        }
+    }
+
+    memory_free(MEMORY_MESH, buckets);
+    memory_free(MEMORY_MESH, offsets);
+    memory_free(MEMORY_MESH, sorted);
+    memory_free(MEMORY_MESH, rep);
+    memory_free(MEMORY_MESH, remap);
+    memory_free(MEMORY_MESH, degenerate);
+    memory_free(MEMORY_MESH, seen);
+    if (!ok) {
+        memory_free(MEMORY_MESH, triangles);
+        memory_free(MEMORY_MESH, vertices);
+        memory_free(MEMORY_MESH, uvs);
+        memory_free(MEMORY_MESH, normals);
+        return 0;
+    }
+
+    if (stats)
+        *stats = (MeshWeldStats){
+            .vertices_before = n, .vertices_after = count,
+            .triangles_before = t, .triangles_after = kept,
+            .degenerate = dropped_degenerate, .duplicates = dropped_duplicates
+        };
+
+    memory_free(MEMORY_MESH, mesh->vertices);
+    memory_free(MEMORY_MESH, mesh->triangles);
+    memory_free(MEMORY_MESH, mesh->uvs);
+    memory_free(MEMORY_MESH, mesh->normals);
+    mesh->vertices = vertices;
+    mesh->vertex_count = count;
+    mesh->triangles = triangles;
+    mesh->triangle_count = kept;
+    mesh->uvs = uvs;
+    mesh->normals = normals;
+
+    return normals ? mesh_compute_normals(mesh, jobs) : 1;
+}
+
 void mesh_destroy(Mesh* mesh) {
-    if (mesh->vertices) free(mesh->vertices);
-    if (mesh->triangles) free(mesh->triangles);
-    free(mesh);
+    if (mesh->vertices) memory_free(MEMORY_MESH, mesh->vertices);
+    if (mesh->positions) memory_free(MEMORY_MESH, mesh->positions);
+    if (mesh->normals) memory_free(MEMORY_MESH, mesh->normals);
+    if (!mesh->shared) {
+        memory_free(MEMORY_MESH, mesh->uvs);
+        memory_free(MEMORY_MESH, mesh->triangles);
+        memory_free(MEMORY_MESH, mesh->triangles16);
+    }
+    memory_free(MEMORY_MESH, mesh);
 }
\ No newline at end of file
@@ -0,0 +1,170 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "core/obj.h"
+#include "core/memory.h"
+
+/**
+ * @brief Growing vertex and triangle arrays of the mesh being parsed
+ */
+typedef struct ObjBuilder {
+    Vector4* vertices;
+    int vertex_count;
+    int vertex_capacity;
+
+    Triangle* triangles;
+    int triangle_count;
+    int triangle_capacity;
+} ObjBuilder;
+
+static inline int is_blank(char c) {
+    return c == ' ' || c == '\t';
+}
+
+static inline int is_line_end(char c) {
+    return c == '\n' || c == '\r' || c == '\0' || c == '#';
+}
+
+static const char* skip_blanks(const char* p) {
+    while (is_blank(*p)) p++;
+    return p;
+}
+
+static const char* next_line(const char* p) {
+    while (*p && *p != '\n') p++;
+    return *p ? p + 1 : p;
+}
+
+// Room for one more element, doubling the array
+static int reserve(void** data, int* capacity, int count, size_t size) {
+    if (count < *capacity) return 1;
+
+    int grown = *capacity > 0 ? *capacity * 2 : 1024;
+    void* resized = memory_realloc(MEMORY_MESH, *data, size * grown);
+    if (!resized) return 0;
+    *data = resized;
+    *capacity = grown;
+    return 1;
+}
+
+/* **************************** STATEMENTS ****************************** */
+
+// v x y z [w]: w is ignored
+static int parse_vertex(ObjBuilder* b, const char* p) {
+    Vector4 v = {0.0f, 0.0f, 0.0f, 1.0f};
+    for (int i = 0; i < 3; i++) {
+        char* end;
+        v.v[i] = strtof(p, &end);
+        if (end == p) return 0;
+        p = end;
+    }
+
+    if (!reserve((void**)&b->vertices, &b->vertex_capacity, b->vertex_count, sizeof(Vector4))) return 0;
+    b->vertices[b->vertex_count++] = v;
+    return 1;
+}
+
+// f c0 c1 c2 ...: a fan of triangles around c0
+static int parse_face(ObjBuilder* b, const char* p) {
+    int corners = 0, first = 0, previous = 0;
+
+    for (p = skip_blanks(p); !is_line_end(*p); p = skip_blanks(p)) {
+        char* end;
+        long index = strtol(p, &end, 10);
+        if (end == p || index == 0) return 0;
+
+        // Negative indices are relative to the positions read so far
+        long vertex = index > 0 ? index - 1 : b->vertex_count + index;
+        if (vertex < 0 || vertex > 0x7FFFFFFF) return 0;
+
+        // Texture and normal indices
+        for (p = end; *p == '/' || (*p >= '0' && *p <= '9') || *p == '-'; p++);
+        if (!is_blank(*p) && !is_line_end(*p)) return 0;
+
+        if (corners == 0) first = (int)vertex;
+        else if (corners >= 2) {
+            if (!reserve((void**)&b->triangles, &b->triangle_capacity, b->triangle_count, sizeof(Triangle)))
+                return 0;
+            b->triangles[b->triangle_count++] = (Triangle){{first, previous, (int)vertex}};
+        }
+        previous = (int)vertex;
+        corners++;
+    }
+
+    return corners >= 3;
+}
+
+/* **************************** LOADING ****************************** */
+
+Mesh* obj_parse(const char* text) {
+    ObjBuilder b = {0};
+    int ok = 1;
+
+    for (const char* p = text; ok && *p; p = next_line(p)) {
+        p = skip_blanks(p);
+        if (p[0] == 'v' && is_blank(p[1])) ok = parse_vertex(&b, p + 1);
+        else if (p[0] == 'f' && is_blank(p[1])) ok = parse_face(&b, p + 1);
+    }
+
+    // Positive indices may point past the positions read when the face came
+    ok = ok && b.triangle_count > 0;
+    for (int t = 0; ok && t < b.triangle_count; t++)
+        for (int k = 0; k < 3; k++)
+            ok &= b.triangles[t].vert[k] < b.vertex_count;
+
+    Mesh* mesh = ok ? memory_calloc(MEMORY_MESH, 1, sizeof(Mesh)) : NULL;
+    if (!mesh) {
+        memory_free(MEMORY_MESH, b.vertices);
+        memory_free(MEMORY_MESH, b.triangles);
+        return NULL;
+    }
+
+    // Trim the doubling slack (shrinking cannot fail in practice, the larger block is kept if it does)
+    Vector4* vertices = memory_realloc(MEMORY_MESH, b.vertices, sizeof(Vector4) * b.vertex_count);
+    Triangle* triangles = memory_realloc(MEMORY_MESH, b.triangles, sizeof(Triangle) * b.triangle_count);
+    mesh->vertices = vertices ? vertices : b.vertices;
+    mesh->vertex_count = b.vertex_count;
+    mesh->triangles = triangles ? triangles : b.triangles;
+    mesh->triangle_count = b.triangle_count;
+    return mesh;
+}
+
+Mesh* obj_load(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return NULL;
+
+    long size = -1;
+    if (fseek(file, 0, SEEK_END) == 0) size = ftell(file);
+    char* text = size >= 0 && fseek(file, 0, SEEK_SET) == 0 ? memory_alloc(MEMORY_MESH, (size_t)size + 1) : NULL;
+    int ok = text && fread(text, 1, (size_t)size, file) == (size_t)size;
+    fclose(file);
+
+    Mesh* mesh = NULL;
+    if (ok) {
+        text[size] = '\0';
+        mesh = obj_parse(text);
+    }
+    memory_free(MEMORY_MESH, text);
+    return mesh;
+}
+
+int obj_save(const char* path, const Mesh* mesh) {
+    if (!mesh->vertices || !mesh->triangles) return 0;
+
+    FILE* file = fopen(path, "w");
+    if (!file) return 0;
+
+    // %.9g prints every float exactly
+    int ok = 1;
+    for (int i = 0; ok && i < mesh->vertex_count; i++) {
+        const Vector4* v = &mesh->vertices[i];
+        ok = fprintf(file, "v %.9g %.9g %.9g\n", v->x, v->y, v->z) > 0;
+    }
+    for (int t = 0; ok && t < mesh->triangle_count; t++) {
+        const int* vert = mesh->triangles[t].vert;
+        ok = fprintf(file, "f %d %d %d\n", vert[0] + 1, vert[1] + 1, vert[2] + 1) > 0;
+    }
+
+    ok &= fclose(file) == 0;
+    return ok;
+}
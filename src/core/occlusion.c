@@ -0,0 +1,253 @@
+#include <math.h>
+#include <stdlib.h>
+
+#include "core/occlusion.h"
+#include "core/memory.h"
+
+#define W_EPSILON 1e-6f
+
+// Largest texel footprint scanned when refining an ambiguous test
+#define REFINE_MAX_TEXELS 16
+
+static int level_width(const OcclusionCuller* c, int level) {
+    int w = c->width;
+    for (int l = 0; l < level; l++) w = (w + 1) / 2;
+    return w;
+}
+
+static int level_height(const OcclusionCuller* c, int level) {
+    int h = c->height;
+    for (int l = 0; l < level; l++) h = (h + 1) / 2;
+    return h;
+}
+
+OcclusionCuller* occlusion_create(int width, int height, int max_occluders) {
+    OcclusionCuller* c = memory_calloc(MEMORY_SCENE, 1, sizeof(OcclusionCuller));
+    if (!c) return NULL;
+
+    c->width = width;
+    c->height = height;
+    c->max_occluders = max_occluders;
+
+    int w = width, h = height;
+    c->levels = 0;
+    while (c->levels < OCCLUSION_MAX_LEVELS) {
+        c->min_depth[c->levels] = memory_alloc(MEMORY_SCENE, sizeof(float) * w * h);
+        c->max_depth[c->levels] = memory_alloc(MEMORY_SCENE, sizeof(float) * w * h);
+        if (!c->min_depth[c->levels] || !c->max_depth[c->levels]) {
+            c->levels++;
+            occlusion_destroy(c);
+            return NULL;
+        }
+        c->levels++;
+
+        if (w == 1 && h == 1) break;
+        w = (w + 1) / 2;
+        h = (h + 1) / 2;
+    }
+
+    return c;
+}
+
+void occlusion_begin(OcclusionCuller* c) {
+    int count = c->width * c->height;
+    for (int i = 0; i < count; i++)
+        c->min_depth[0][i] = 1.0f;
+
+    c->stats = (OcclusionStats){0};
+}
+
+/* **************************** OCCLUDER RASTER ****************************** */
+
+typedef struct ScreenVertex {
+    float x, y, z;
+} ScreenVertex;
+
+static ScreenVertex to_screen(const OcclusionCuller* c, Vector4 v) {
+    float inv_w = 1.0f / v.w;
+    return (ScreenVertex){
+        (v.x * inv_w + 1) * 0.5f * c->width,
+        (1 - v.y * inv_w) * 0.5f * c->height,
+        fminf(fmaxf((v.z * inv_w + 1) * 0.5f, 0.0f), 1.0f)
+    };
+}
+
+static float edge(ScreenVertex a, ScreenVertex b, float px, float py) {
+    return (b.x - a.x) * (py - a.y) - (b.y - a.y) * (px - a.x);
+}
+
+// Pixel-center coverage, keeps the nearest depth
+static void raster_triangle(OcclusionCuller* c, ScreenVertex a, ScreenVertex b, ScreenVertex d) {
+    float area = edge(a, b, d.x, d.y);
+    if (fabsf(area) < 1e-8f) return;
+
+    int x0 = (int)fmaxf(floorf(fminf(a.x, fminf(b.x, d.x))), 0.0f);
+    int y0 = (int)fmaxf(floorf(fminf(a.y, fminf(b.y, d.y))), 0.0f);
+    int x1 = (int)fminf(ceilf(fmaxf(a.x, fmaxf(b.x, d.x))), (float)(c->width - 1));
+    int y1 = (int)fminf(ceilf(fmaxf(a.y, fmaxf(b.y, d.y))), (float)(c->height - 1));
+
+    float inv_area = 1.0f / area;
+    float* depth = c->min_depth[0];
+
+    for (int y = y0; y <= y1; y++) {
+        float py = y + 0.5f;
+        for (int x = x0; x <= x1; x++) {
+            float px = x + 0.5f;
+
+            // Barycentrics, sign-normalized so both windings are filled
+            float w0 = edge(b, d, px, py) * inv_area;
+            float w1 = edge(d, a, px, py) * inv_area;
+            float w2 = edge(a, b, px, py) * inv_area;
+            if (w0 < 0 || w1 < 0 || w2 < 0) continue;
+
+            float z = w0 * a.z + w1 * b.z + w2 * d.z;
+            float* dst = &depth[y * c->width + x];
+            if (z < *dst) *dst = z;
+        }
+    }
+}
+
+int occlusion_reserve(OcclusionCuller* c, int max_vertices) {
+    if (max_vertices <= c->clip_capacity) return 1;
+
+    Vector4* clip = memory_realloc(MEMORY_SCENE, c->clip, sizeof(Vector4) * max_vertices);
+    if (!clip) return 0;
+    c->clip = clip;
+    c->clip_capacity = max_vertices;
+    return 1;
+}
+
+void occlusion_add_occluder(OcclusionCuller* c, const Mesh* mesh, const Matrix* mvp) {
+    if (mesh->vertex_count > c->clip_capacity) return;
+
+    if (mesh->positions)
+        matrix_transform_points(mvp, mesh->positions, c->clip, mesh->vertex_count);
+    else
+        matrix_transform_array(mvp, mesh->vertices, c->clip, mesh->vertex_count);
+
+    for (int i = 0; i < mesh->triangle_count; i++) {
+        Triangle t = mesh_triangle(mesh, i);
+        Vector4 a = c->clip[t.vert[0]];
+        Vector4 b = c->clip[t.vert[1]];
+        Vector4 d = c->clip[t.vert[2]];
+
+        // Occluders are optional: dropping a triangle only loses culling
+        if (a.w <= W_EPSILON || b.w <= W_EPSILON || d.w <= W_EPSILON)
+            continue;
+
+        raster_triangle(c, to_screen(c, a), to_screen(c, b), to_screen(c, d));
+    }
+
+    c->stats.occluders++;
+}
+
+/* **************************** PYRAMID ****************************** */
+
+void occlusion_build_pyramid(OcclusionCuller* c) {
+    int count = c->width * c->height;
+    for (int i = 0; i < count; i++)
+        c->max_depth[0][i] = c->min_depth[0][i];
+
+    for (int l = 1; l < c->levels; l++) {
+        int src_w = level_width(c, l - 1), src_h = level_height(c, l - 1);
+        int dst_w = level_width(c, l), dst_h = level_height(c, l);
+        const float* src_min = c->min_depth[l - 1];
+        const float* src_max = c->max_depth[l - 1];
+
+        for (int y = 0; y < dst_h; y++) {
+            int sy0 = 2 * y;
+            int sy1 = sy0 + 1 < src_h ? sy0 + 1 : sy0;
+            for (int x = 0; x < dst_w; x++) {
+                int sx0 = 2 * x;
+                int sx1 = sx0 + 1 < src_w ? sx0 + 1 : sx0;
+
+                int i00 = sy0 * src_w + sx0, i01 = sy0 * src_w + sx1;
+                int i10 = sy1 * src_w + sx0, i11 = sy1 * src_w + sx1;
+
+                c->min_depth[l][y * dst_w + x] =
+                    fminf(fminf(src_min[i00], src_min[i01]), fminf(src_min[i10], src_min[i11]));
+                c->max_depth[l][y * dst_w + x] =
+                    fmaxf(fmaxf(src_max[i00], src_max[i01]), fmaxf(src_max[i10], src_max[i11]));
+            }
+        }
+    }
+}
+
+/* **************************** VISIBILITY TEST ****************************** */
+
+int occlusion_test(OcclusionCuller* c, Bounds bounds, const Matrix* mvp) {
+    c->stats.tested++;
+
+    float min_x = INFINITY, min_y = INFINITY, min_z = INFINITY;
+    float max_x = -INFINITY, max_y = -INFINITY, max_z = -INFINITY;
+
+    for (int i = 0; i < 8; i++) {
+        Vector4 corner = {
+            (i & 1) ? bounds.max.x : bounds.min.x,
+            (i & 2) ? bounds.max.y : bounds.min.y,
+            (i & 4) ? bounds.max.z : bounds.min.z,
+            1.0f
+        };
+        Vector4 clip = transform(*mvp, corner);
+
+        // Box crosses the eye plane: no reliable screen rectangle
+        if (clip.w <= W_EPSILON) return 1;
+
+        float inv_w = 1.0f / clip.w;
+        float x = clip.x * inv_w, y = clip.y * inv_w, z = clip.z * inv_w;
+        min_x = fminf(min_x, x); max_x = fmaxf(max_x, x);
+        min_y = fminf(min_y, y); max_y = fmaxf(max_y, y);
+        min_z = fminf(min_z, z); max_z = fmaxf(max_z, z);
+    }
+
+    if (max_x < -1 || min_x > 1 || max_y < -1 || min_y > 1 || min_z > 1 || max_z < -1) {
+        c->stats.frustum_culled++;
+        return 0;
+    }
+
+    // Screen rectangle in level 0 texels (y flipped like the renderer)
+    int x0 = (int)fmaxf(floorf((min_x + 1) * 0.5f * c->width), 0.0f);
+    int x1 = (int)fminf(floorf((max_x + 1) * 0.5f * c->width), (float)(c->width - 1));
+    int y0 = (int)fmaxf(floorf((1 - max_y) * 0.5f * c->height), 0.0f);
+    int y1 = (int)fminf(floorf((1 - min_y) * 0.5f * c->height), (float)(c->height - 1));
+    float nearest = fmaxf((min_z + 1) * 0.5f, 0.0f);
+
+    // Coarsest useful level: rectangle covers at most 2x2 texels
+    int level = 0;
+    while (level < c->levels - 1 &&
+           ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1))
+        level++;
+
+    // Walk down while the answer is ambiguous and the footprint stays small
+    for (; level >= 0; level--) {
+        int tx0 = x0 >> level, tx1 = x1 >> level;
+        int ty0 = y0 >> level, ty1 = y1 >> level;
+        if ((tx1 - tx0 + 1) * (ty1 - ty0 + 1) > REFINE_MAX_TEXELS) break;
+
+        int w = level_width(c, level);
+        float region_min = 1.0f, region_max = 0.0f;
+        for (int y = ty0; y <= ty1; y++) {
+            for (int x = tx0; x <= tx1; x++) {
+                region_min = fminf(region_min, c->min_depth[level][y * w + x]);
+                region_max = fmaxf(region_max, c->max_depth[level][y * w + x]);
+            }
+        }
+
+        if (nearest > region_max) {
+            c->stats.occluded++;
+            return 0;
+        }
+        if (nearest <= region_min) return 1; // in front of every occluder
+    }
+
+    return 1;
+}
+
+void occlusion_destroy(OcclusionCuller* c) {
+    for (int l = 0; l < c->levels; l++) {
+        memory_free(MEMORY_SCENE, c->min_depth[l]);
+        memory_free(MEMORY_SCENE, c->max_depth[l]);
+    }
+    memory_free(MEMORY_SCENE, c->clip);
+    memory_free(MEMORY_SCENE, c);
+}
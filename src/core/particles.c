@@ -0,0 +1,339 @@
+#include <math.h>
+#include <string.h>
+
+#include "core/particles.h"
+#include "core/memory.h"
+
+#define PARTICLE_ALIGN 16
+
+// Float streams of ParticleStreams, in declaration order
+#define PARTICLE_FLOATS 7
+
+static void float_streams(ParticleStreams* s, float** out[PARTICLE_FLOATS]) {
+    out[0] = &s->x;
+    out[1] = &s->y;
+    out[2] = &s->z;
+    out[3] = &s->vx;
+    out[4] = &s->vy;
+    out[5] = &s->vz;
+    out[6] = &s->life;
+}
+
+static int streams_alloc(ParticleStreams* s, int capacity) {
+    float** floats[PARTICLE_FLOATS];
+    float_streams(s, floats);
+    for (int k = 0; k < PARTICLE_FLOATS; k++) {
+        *floats[k] = memory_aligned_alloc(MEMORY_PARTICLES, PARTICLE_ALIGN, sizeof(float) * capacity);
+        if (!*floats[k]) return 0;
+    }
+    s->color = memory_aligned_alloc(MEMORY_PARTICLES, PARTICLE_ALIGN, sizeof(uint32_t) * capacity);
+    return s->color != NULL;
+}
+
+static void streams_free(ParticleStreams* s) {
+    float** floats[PARTICLE_FLOATS];
+    float_streams(s, floats);
+    for (int k = 0; k < PARTICLE_FLOATS; k++)
+        memory_free(MEMORY_PARTICLES, *floats[k]);
+    memory_free(MEMORY_PARTICLES, s->color);
+}
+
+static inline int chunk_count(int capacity) {
+    return (capacity + PARTICLE_CHUNK - 1) / PARTICLE_CHUNK;
+}
+
+ParticleSystem* particles_create(int capacity) {
+    if (capacity <= 0) return NULL;
+
+    ParticleSystem* ps = memory_calloc(MEMORY_PARTICLES, 1, sizeof(ParticleSystem));
+    if (!ps) return NULL;
+
+    ps->capacity = capacity;
+    int padded = (capacity + 3) & ~3; // whole SIMD registers
+    ps->chunk_alive = memory_alloc(MEMORY_PARTICLES, sizeof(int) * chunk_count(capacity));
+    if (!ps->chunk_alive || !streams_alloc(&ps->live, padded)) {
+        particles_destroy(ps);
+        return NULL;
+    }
+    return ps;
+}
+
+int particles_spawn(ParticleSystem* ps, Vector3 position, Vector3 velocity, float life, uint32_t color) {
+    if (ps->count == ps->capacity) return 0;
+
+    ParticleStreams* s = &ps->live;
+    int i = ps->count++;
+    s->x[i] = position.x;
+    s->y[i] = position.y;
+    s->z[i] = position.z;
+    s->vx[i] = velocity.x;
+    s->vy[i] = velocity.y;
+    s->vz[i] = velocity.z;
+    s->life[i] = life;
+    s->color[i] = color;
+    return 1;
+}
+
+/* **************************** UPDATE ****************************** */
+
+typedef struct ParticleJob {
+    ParticleSystem* ps;
+    float dt;
+    Vector3 step;   // gravity * dt
+} ParticleJob;
+
+static inline int chunk_end(const ParticleSystem* ps, int chunk) {
+    int end = (chunk + 1) * PARTICLE_CHUNK;
+    return end < ps->count ? end : ps->count;
+}
+
+// Integrates particle i and stores it at o <= i; returns 1 if it survives
+static inline int integrate_one(ParticleStreams* s, int i, int o, float dt, Vector3 step) {
+    float vx = s->vx[i] + step.x;
+    float vy = s->vy[i] + step.y;
+    float vz = s->vz[i] + step.z;
+    float life = s->life[i] - dt;
+
+    // Always stored: a dead particle is overwritten by the next survivor
+    s->x[o] = s->x[i] + vx * dt;
+    s->y[o] = s->y[i] + vy * dt;
+    s->z[o] = s->z[i] + vz * dt;
+    s->vx[o] = vx;
+    s->vy[o] = vy;
+    s->vz[o] = vz;
+    s->life[o] = life;
+    s->color[o] = s->color[i];
+    return life > 0.0f;
+}
+
+// Integrates one chunk and packs its survivors, in order, at its start
+static int integrate_chunk_scalar(ParticleSystem* ps, int chunk, float dt, Vector3 step) {
+    int o = chunk * PARTICLE_CHUNK;
+    for (int i = o; i < chunk_end(ps, chunk); i++)
+        o += integrate_one(&ps->live, i, o, dt, step);
+    return o - chunk * PARTICLE_CHUNK;
+}
+
+static void move_particles(ParticleStreams* s, int dst, int src, int count) {
+    float** floats[PARTICLE_FLOATS];
+    float_streams(s, floats);
+    for (int k = 0; k < PARTICLE_FLOATS; k++)
+        memcpy(*floats[k] + dst, *floats[k] + src, sizeof(float) * count);
+    memcpy(s->color + dst, s->color + src, sizeof(uint32_t) * count);
+}
+
+/*
+ * Chunk c holds chunk_alive[c] survivors at its start. The holes below
+ * the new count are filled with the survivors above it, taken from the
+ * last chunks: only as many particles move as died.
+ */
+static void fill_holes(ParticleSystem* ps, int chunks) {
+    int alive = 0;
+    for (int c = 0; c < chunks; c++)
+        alive += ps->chunk_alive[c];
+
+    int src_chunk = chunks - 1;
+    int src_end = src_chunk * PARTICLE_CHUNK + ps->chunk_alive[src_chunk];
+    for (int c = 0; c * PARTICLE_CHUNK < alive; c++) {
+        int hole = c * PARTICLE_CHUNK + ps->chunk_alive[c];
+        int hole_end = chunk_end(ps, c) < alive ? chunk_end(ps, c) : alive;
+
+        while (hole < hole_end) {
+            // Survivors of the source chunk that are above the new count
+            int src_start = src_chunk * PARTICLE_CHUNK > alive ? src_chunk * PARTICLE_CHUNK : alive;
+            if (src_end <= src_start) {
+                src_chunk--;
+                src_end = src_chunk * PARTICLE_CHUNK + ps->chunk_alive[src_chunk];
+                continue;
+            }
+            int n = hole_end - hole < src_end - src_start ? hole_end - hole : src_end - src_start;
+            move_particles(&ps->live, hole, src_end - n, n);
+            hole += n;
+            src_end -= n;
+        }
+    }
+    ps->count = alive;
+}
+
+void particles_update_scalar(ParticleSystem* ps, float dt, Vector3 gravity) {
+    if (ps->count == 0) return;
+
+    Vector3 step = {gravity.x * dt, gravity.y * dt, gravity.z * dt};
+    int chunks = chunk_count(ps->count);
+    for (int c = 0; c < chunks; c++)
+        ps->chunk_alive[c] = integrate_chunk_scalar(ps, c, dt, step);
+    fill_holes(ps, chunks);
+}
+
+#if MATH_SIMD
+/*
+ * 4 particles per step, written back in place at the survivor count o <= i.
+ * Groups where all 4 survive (nearly all of them) are stored whole; the
+ * others are scattered lane by lane, a dead lane being overwritten by the
+ * next survivor, without branching on which lanes died.
+ */
+static int integrate_chunk(ParticleSystem* ps, int chunk, float dt_s, Vector3 step) {
+    ParticleStreams* s = &ps->live;
+    int i = chunk * PARTICLE_CHUNK, end = chunk_end(ps, chunk);
+    int o = i;
+    f32x4 dt = f32x4_set1(dt_s), zero = f32x4_zero();
+    f32x4 sx = f32x4_set1(step.x), sy = f32x4_set1(step.y), sz = f32x4_set1(step.z);
+
+    for (; i + 4 <= end; i += 4) {
+        f32x4 vx = f32x4_add(f32x4_load(s->vx + i), sx);
+        f32x4 vy = f32x4_add(f32x4_load(s->vy + i), sy);
+        f32x4 vz = f32x4_add(f32x4_load(s->vz + i), sz);
+        f32x4 x = f32x4_add(f32x4_load(s->x + i), f32x4_mul(vx, dt));
+        f32x4 y = f32x4_add(f32x4_load(s->y + i), f32x4_mul(vy, dt));
+        f32x4 z = f32x4_add(f32x4_load(s->z + i), f32x4_mul(vz, dt));
+        f32x4 life = f32x4_sub(f32x4_load(s->life + i), dt);
+        int mask = f32x4_movemask(f32x4_cmplt(zero, life));
+
+        if (mask == 0xF) {
+            f32x4_storeu(s->x + o, x);
+            f32x4_storeu(s->y + o, y);
+            f32x4_storeu(s->z + o, z);
+            f32x4_storeu(s->vx + o, vx);
+            f32x4_storeu(s->vy + o, vy);
+            f32x4_storeu(s->vz + o, vz);
+            f32x4_storeu(s->life + o, life);
+            memmove(s->color + o, s->color + i, sizeof(uint32_t) * 4);
+            o += 4;
+            continue;
+        }
+
+        _Alignas(16) float lanes[PARTICLE_FLOATS][4];
+        f32x4_store(lanes[0], x);
+        f32x4_store(lanes[1], y);
+        f32x4_store(lanes[2], z);
+        f32x4_store(lanes[3], vx);
+        f32x4_store(lanes[4], vy);
+        f32x4_store(lanes[5], vz);
+        f32x4_store(lanes[6], life);
+        for (int k = 0; k < 4; k++) {
+            s->x[o] = lanes[0][k];
+            s->y[o] = lanes[1][k];
+            s->z[o] = lanes[2][k];
+            s->vx[o] = lanes[3][k];
+            s->vy[o] = lanes[4][k];
+            s->vz[o] = lanes[5][k];
+            s->life[o] = lanes[6][k];
+            s->color[o] = s->color[i + k];
+            o += (mask >> k) & 1;
+        }
+    }
+
+    for (; i < end; i++)
+        o += integrate_one(s, i, o, dt_s, step);
+    return o - chunk * PARTICLE_CHUNK;
+}
+#else
+#define integrate_chunk integrate_chunk_scalar
+#endif
+
+static void integrate_range(void* ctx, int start, int end) {
+    const ParticleJob* job = ctx;
+    for (int c = start; c < end; c++)
+        job->ps->chunk_alive[c] = integrate_chunk(job->ps, c, job->dt, job->step);
+}
+
+void particles_update(ParticleSystem* ps, float dt, Vector3 gravity, JobSystem* jobs) {
+    if (ps->count == 0) return;
+
+    ParticleJob job = {ps, dt, {gravity.x * dt, gravity.y * dt, gravity.z * dt}};
+    int chunks = chunk_count(ps->count);
+    jobs_parallel_for(jobs, chunks, 1, integrate_range, &job);
+    fill_holes(ps, chunks);
+}
+
+/* **************************** DRAW ****************************** */
+
+int particles_draw(Framebuffer* fb, const ParticleSystem* ps, const Camera cam, const Projection proj, float size) {
+    Viewport vp = fb->viewport;
+    if (vp.width <= 0 || vp.height <= 0) return 0;
+
+    Matrix view = view_matrix(cam), projection = projection_matrix(proj), m;
+    matrix_multiply(&m, &projection, &view);
+
+    float half_w = 0.5f * vp.width, half_h = 0.5f * vp.height;
+    // Pixel half-edge of a particle at w = 1; a point covers the pixel its center falls in
+    float radius = 0.5f * size * projection.m[1][1] * half_h;
+    float left_edge = (float)vp.x, right_edge = (float)(vp.x + vp.width);
+    float top_edge = (float)vp.y, bottom_edge = (float)(vp.y + vp.height);
+    const ParticleStreams* s = &ps->live;
+    int drawn = 0;
+
+    for (int i = 0; i < ps->count; i += 4) {
+        // Pixel rectangles [x0, x1) x [y0, y1) of 4 particles, and which of them to draw
+        _Alignas(16) int32_t x0[4], y0[4], x1[4], y1[4];
+        _Alignas(16) float depth[4];
+        int n = ps->count - i < 4 ? ps->count - i : 4;
+        int mask = 0;
+#if MATH_SIMD
+        // Padding lanes past count project garbage and are masked out
+        f32x4 x = f32x4_load(s->x + i), y = f32x4_load(s->y + i), z = f32x4_load(s->z + i);
+        f32x4 clip[4];
+        for (int r = 0; r < 4; r++)
+            clip[r] = f32x4_madd(x, f32x4_set1(m.m[r][0]),
+                      f32x4_madd(y, f32x4_set1(m.m[r][1]),
+                      f32x4_madd(z, f32x4_set1(m.m[r][2]), f32x4_set1(m.m[r][3]))));
+
+        f32x4 zero = f32x4_zero(), one = f32x4_set1(1.0f), half = f32x4_set1(0.5f);
+        f32x4 inv_w = f32x4_div(one, clip[3]);
+        f32x4 sx = f32x4_madd(f32x4_add(f32x4_mul(clip[0], inv_w), one), f32x4_set1(half_w), f32x4_set1(left_edge));
+        f32x4 sy = f32x4_madd(f32x4_sub(one, f32x4_mul(clip[1], inv_w)), f32x4_set1(half_h), f32x4_set1(top_edge));
+        f32x4 d = f32x4_mul(f32x4_add(f32x4_mul(clip[2], inv_w), one), half);
+        f32x4 r = size > 0.0f ? f32x4_mul(f32x4_set1(radius), inv_w) : half;
+        f32x4 left = f32x4_sub(sx, r), right = f32x4_add(sx, r);
+        f32x4 top = f32x4_sub(sy, r), bottom = f32x4_add(sy, r);
+
+        // In front of the camera, within the near / far range, overlapping the viewport
+        f32x4 keep = f32x4_and(f32x4_cmplt(zero, clip[3]), f32x4_and(f32x4_cmple(zero, d), f32x4_cmple(d, one)));
+        keep = f32x4_and(keep, f32x4_and(f32x4_cmplt(left, f32x4_set1(right_edge)), f32x4_cmplt(f32x4_set1(left_edge), right)));
+        keep = f32x4_and(keep, f32x4_and(f32x4_cmplt(top, f32x4_set1(bottom_edge)), f32x4_cmplt(f32x4_set1(top_edge), bottom)));
+        mask = f32x4_movemask(keep) & ((1 << n) - 1);
+
+        // Clamped to the viewport first, so that the conversions cannot overflow
+        i32x4_storeu(x0, f32x4_floor_i32x4(f32x4_add(f32x4_max(left, f32x4_set1(left_edge - 1.0f)), half)));
+        i32x4_storeu(y0, f32x4_floor_i32x4(f32x4_add(f32x4_max(top, f32x4_set1(top_edge - 1.0f)), half)));
+        i32x4_storeu(x1, f32x4_floor_i32x4(f32x4_add(f32x4_min(right, f32x4_set1(right_edge)), half)));
+        i32x4_storeu(y1, f32x4_floor_i32x4(f32x4_add(f32x4_min(bottom, f32x4_set1(bottom_edge)), half)));
+        f32x4_store(depth, d);
+#else
+        for (int k = 0; k < n; k++) {
+            Vector4 clip = matrix_transform(&m, (Vector4){s->x[i + k], s->y[i + k], s->z[i + k], 1.0f});
+            float sx = left_edge + (clip.x / clip.w + 1) * half_w;
+            float sy = top_edge + (1 - clip.y / clip.w) * half_h;
+            float r = size > 0.0f ? radius / clip.w : 0.5f;
+            depth[k] = (clip.z / clip.w + 1) * 0.5f;
+
+            int keep = clip.w > 0.0f && depth[k] >= 0.0f && depth[k] <= 1.0f && sx - r < right_edge &&
+                       left_edge < sx + r && sy - r < bottom_edge && top_edge < sy + r;
+            if (!keep) continue;
+            mask |= 1 << k;
+            x0[k] = (int)floorf(fmaxf(sx - r, left_edge - 1.0f) + 0.5f);
+            y0[k] = (int)floorf(fmaxf(sy - r, top_edge - 1.0f) + 0.5f);
+            x1[k] = (int)floorf(fminf(sx + r, right_edge) + 0.5f);
+            y1[k] = (int)floorf(fminf(sy + r, bottom_edge) + 0.5f);
+        }
+#endif
+
+        for (; mask; mask &= mask - 1) {
+            int k = __builtin_ctz(mask);
+            // At least one pixel
+            int x_end = x1[k] > x0[k] ? x1[k] : x0[k] + 1;
+            int y_end = y1[k] > y0[k] ? y1[k] : y0[k] + 1;
+            framebuffer_fill_rect(fb, x0[k], y0[k], x_end, y_end, depth[k], s->color[i + k]);
+            drawn++;
+        }
+    }
+    return drawn;
+}
+
+void particles_destroy(ParticleSystem* ps) {
+    if (!ps) return;
+
+    streams_free(&ps->live);
+    memory_free(MEMORY_PARTICLES, ps->chunk_alive);
+    memory_free(MEMORY_PARTICLES, ps);
+}
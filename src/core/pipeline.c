@@ -3,7 +3,7 @@
 #include "core/pipeline.h"
 
 /* **************************** INIT -> MODEL ****************************** */
-static Matrix model_matrix(Transform transform) {
+Matrix model_matrix(Transform transform) {
     Vector3 trans_v = transform.translation;
     Vector3 scale_v = transform.scale;
     Vector3 rot_v = transform.rotation;
@@ -22,6 +22,25 @@ static Matrix model_matrix(Transform transform) {
     return trs;
 }
 
+Bounds world_bounds(Bounds bounds, const Transform transformations) {
+    Matrix model = model_matrix(transformations);
+    Vector3 center, half;
+    for (int a = 0; a < 3; a++) {
+        center.v[a] = 0.5f * (bounds.min.v[a] + bounds.max.v[a]);
+        half.v[a] = 0.5f * (bounds.max.v[a] - bounds.min.v[a]);
+    }
+
+    Bounds out;
+    for (int row = 0; row < 3; row++) {
+        const float* m = model.m[row];
+        float c = m[0] * center.x + m[1] * center.y + m[2] * center.z + m[3];
+        float e = fabsf(m[0]) * half.x + fabsf(m[1]) * half.y + fabsf(m[2]) * half.z;
+        out.min.v[row] = c - e;
+        out.max.v[row] = c + e;
+    }
+    return out;
+}
+
 /* **************************** WORLD --> VIEW ****************************** */
 
 // lookAt/Gram–Schmidt camera rotation
@@ -40,7 +59,7 @@ static CameraAxes get_camera(const Vector3 pos, const Vector3 target, const Vect
 }
 
 // world -> camera (inverse of camera -> world)
-static Matrix view_matrix(const Camera camera) {
+Matrix view_matrix(const Camera camera) {
     CameraAxes cam = get_camera(camera.pos, camera.target, camera.up);
 
     return (Matrix) {{
@@ -54,7 +73,7 @@ static Matrix view_matrix(const Camera camera) {
 /* **************************** PROJECTION ****************************** */
 
 // Perspective projection
-static Matrix projection_matrix(Projection proj) {
+Matrix projection_matrix(Projection proj) {
     float tan_fov = tanf(proj.fov / 2);
     float a = 1.0f / (proj.aspect_ratio * tan_fov);
     float b = (proj.far + proj.near) / (proj.near - proj.far);
@@ -70,13 +89,351 @@ static Matrix projection_matrix(Projection proj) {
 
 /* ****************************  MODEL + VIEW + PROJ ****************************** */
 
-void update_mesh(Mesh* figure, Mesh* clipped, const Transform transformations, const Camera cam, const Projection proj) {
+static Matrix mvp_matrix(const Transform transformations, const Camera cam, const Projection proj) {
     Matrix m = model_matrix(transformations);
     Matrix v = view_matrix(cam);
     Matrix p = projection_matrix(proj);
-    
-    Matrix mvp = multiply(p, multiply(v, m));
 
-    for (size_t i = 0; i < figure->vertex_count; i++)
-        clipped->vertices[i] = transform(mvp, figure->vertices[i]);
+    Matrix mvp;
+    matrix_multiply(&mvp, &v, &m);
+    matrix_multiply(&mvp, &p, &mvp);
+    return mvp;
+}
+
+void update_mesh(const Mesh* figure, Mesh* clipped, const Transform transformations, const Camera cam, const Projection proj) {
+    Matrix mvp = mvp_matrix(transformations, cam, proj);
+
+    if (figure->positions)
+        matrix_transform_points(&mvp, figure->positions, clipped->vertices, figure->vertex_count);
+    else
+        matrix_transform_array(&mvp, figure->vertices, clipped->vertices, figure->vertex_count);
+}
+
+/* ****************************  MODEL + VIEW + PROJ + LIGHTING ****************************** */
+
+// Normals go through the inverse transpose of the model matrix (non-uniform scale)
+static Matrix normal_matrix(const Matrix* model) {
+    Matrix n;
+    if (!matrix_inverse(&n, model)) return *model;
+    matrix_transpose(&n, &n);
+    return n;
+}
+
+#if MATH_SIMD
+
+// Broadcast light parameters: v is the unit direction towards the light
+// (directional) or the light position (point)
+typedef struct LitLight {
+    int point;
+    f32x4 v[3];
+    f32x4 color[3];
+    f32x4 inv_range;
+} LitLight;
+
+// Broadcast matrix entries and lights, prepared once per call
+typedef struct LitConstants {
+    f32x4 mvp_col[4];
+    f32x4 model[3][4];
+    f32x4 normal[3][3];
+    f32x4 ambient[3];
+    f32x4 base[3];
+    LitLight lights[LIGHTING_MAX_LIGHTS];
+    int light_count;
+} LitConstants;
+
+static inline f32x4 clip_position(const f32x4 mvp_col[4], f32x4 p) {
+    f32x4 r = f32x4_mul(mvp_col[0], f32x4_splat(p, 0));
+    r = f32x4_madd(mvp_col[1], f32x4_splat(p, 1), r);
+    r = f32x4_madd(mvp_col[2], f32x4_splat(p, 2), r);
+    return f32x4_madd(mvp_col[3], f32x4_splat(p, 3), r);
+}
+
+static inline f32x4 row_dot3(const f32x4 row[3], f32x4 x, f32x4 y, f32x4 z) {
+    return f32x4_madd(row[0], x, f32x4_madd(row[1], y, f32x4_mul(row[2], z)));
+}
+
+/*
+ * Transforms and lights 4 vertices: positions and normals are transposed to
+ * x/y/z registers so each lane is one vertex for the whole lighting math.
+ */
+static void lit_block(const LitConstants* k, f32x4 p0, f32x4 p1, f32x4 p2, f32x4 p3, const Vector4* nrm,
+                      Vector4* out, uint32_t* colors, uint32_t alpha, int count) {
+    f32x4 clip[4] = {
+        clip_position(k->mvp_col, p0), clip_position(k->mvp_col, p1),
+        clip_position(k->mvp_col, p2), clip_position(k->mvp_col, p3)
+    };
+
+    // World-space positions, one vertex per lane
+    F32X4_TRANSPOSE(p0, p1, p2, p3);
+    f32x4 wx = f32x4_madd(k->model[0][3], p3, row_dot3(k->model[0], p0, p1, p2));
+    f32x4 wy = f32x4_madd(k->model[1][3], p3, row_dot3(k->model[1], p0, p1, p2));
+    f32x4 wz = f32x4_madd(k->model[2][3], p3, row_dot3(k->model[2], p0, p1, p2));
+
+    // World-space unit normals
+    f32x4 n0 = f32x4_loadu(nrm[0].v), n1 = f32x4_loadu(nrm[1].v);
+    f32x4 n2 = f32x4_loadu(nrm[2].v), n3 = f32x4_loadu(nrm[3].v);
+    F32X4_TRANSPOSE(n0, n1, n2, n3);
+    f32x4 nx = row_dot3(k->normal[0], n0, n1, n2);
+    f32x4 ny = row_dot3(k->normal[1], n0, n1, n2);
+    f32x4 nz = row_dot3(k->normal[2], n0, n1, n2);
+    f32x4 len2 = f32x4_max(f32x4_madd(nx, nx, f32x4_madd(ny, ny, f32x4_mul(nz, nz))), f32x4_set1(1e-20f));
+    f32x4 inv_len = f32x4_rsqrt(len2);
+    nx = f32x4_mul(nx, inv_len);
+    ny = f32x4_mul(ny, inv_len);
+    nz = f32x4_mul(nz, inv_len);
+
+    f32x4 r = k->ambient[0], g = k->ambient[1], b = k->ambient[2];
+    f32x4 zero = f32x4_zero();
+
+    for (int l = 0; l < k->light_count; l++) {
+        const LitLight* light = &k->lights[l];
+        f32x4 factor;
+
+        if (!light->point) {
+            f32x4 ndl = row_dot3(light->v, nx, ny, nz);
+            factor = f32x4_max(ndl, zero);
+        } else {
+            f32x4 dx = f32x4_sub(light->v[0], wx);
+            f32x4 dy = f32x4_sub(light->v[1], wy);
+            f32x4 dz = f32x4_sub(light->v[2], wz);
+            f32x4 d2 = f32x4_max(f32x4_madd(dx, dx, f32x4_madd(dy, dy, f32x4_mul(dz, dz))), f32x4_set1(1e-20f));
+            f32x4 inv_dist = f32x4_rsqrt(d2);
+            f32x4 ndl = f32x4_mul(f32x4_madd(nx, dx, f32x4_madd(ny, dy, f32x4_mul(nz, dz))), inv_dist);
+            f32x4 dist = f32x4_mul(d2, inv_dist);
+            f32x4 attenuation = f32x4_max(f32x4_sub(f32x4_set1(1.0f), f32x4_mul(dist, light->inv_range)), zero);
+            factor = f32x4_mul(f32x4_max(ndl, zero), attenuation);
+        }
+
+        r = f32x4_madd(light->color[0], factor, r);
+        g = f32x4_madd(light->color[1], factor, g);
+        b = f32x4_madd(light->color[2], factor, b);
+    }
+
+    // base * min(intensity, 1), rounded to 8 bits
+    f32x4 one = f32x4_set1(1.0f), half = f32x4_set1(0.5f);
+    r = f32x4_madd(f32x4_min(r, one), k->base[0], half);
+    g = f32x4_madd(f32x4_min(g, one), k->base[1], half);
+    b = f32x4_madd(f32x4_min(b, one), k->base[2], half);
+
+    if (count == 4) {
+        for (int i = 0; i < 4; i++)
+            f32x4_storeu(out[i].v, clip[i]);
+        f32x4_store_argb(colors, r, g, b, alpha);
+        return;
+    }
+
+    uint32_t packed[4];
+    f32x4_store_argb(packed, r, g, b, alpha);
+    for (int i = 0; i < count; i++) {
+        f32x4_storeu(out[i].v, clip[i]);
+        colors[i] = packed[i];
+    }
+}
+
+// Lights vertices [0, n) from Vector4 positions
+static void lit_vertices(const LitConstants* k, const Vector4* in, const Vector4* nrm,
+                         Vector4* out, uint32_t* colors, uint32_t alpha, int n) {
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+        lit_block(k, f32x4_loadu(in[i].v), f32x4_loadu(in[i + 1].v), f32x4_loadu(in[i + 2].v),
+                  f32x4_loadu(in[i + 3].v), &nrm[i], &out[i], &colors[i], alpha, 4);
+
+    // Tail, padded with copies of the last vertex (only n - i results are written)
+    if (i < n) {
+        Vector4 p[4], pad[4];
+        for (int j = 0; j < 4; j++) {
+            p[j] = in[i + j < n ? i + j : n - 1];
+            pad[j] = nrm[i + j < n ? i + j : n - 1];
+        }
+        lit_block(k, f32x4_loadu(p[0].v), f32x4_loadu(p[1].v), f32x4_loadu(p[2].v), f32x4_loadu(p[3].v),
+                  pad, &out[i], &colors[i], alpha, n - i);
+    }
+}
+
+// Lights vertices [0, n) from Vector3 positions: 4 points are 3 registers, w = 1 is inserted
+static void lit_points(const LitConstants* k, const Vector3* in, const Vector4* nrm,
+                       Vector4* out, uint32_t* colors, uint32_t alpha, int n) {
+    f32x4 one = f32x4_set1(1.0f);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const float* p = &in[i].x;
+        f32x4 a = f32x4_loadu(p), b = f32x4_loadu(p + 4), c = f32x4_loadu(p + 8);
+        // (x0 y0 z0 x1) (y1 z1 x2 y2) (z2 x3 y3 z3) -> (xj yj zj 1)
+        f32x4 p0 = f32x4_shuffle(a, f32x4_shuffle(a, one, 2, 2, 0, 0), 0, 1, 0, 2);
+        f32x4 p1 = f32x4_shuffle(f32x4_shuffle(a, b, 3, 3, 0, 0), f32x4_shuffle(b, one, 1, 1, 0, 0), 0, 2, 0, 2);
+        f32x4 p2 = f32x4_shuffle(f32x4_shuffle(b, c, 2, 3, 0, 0), f32x4_shuffle(c, one, 0, 0, 0, 0), 0, 1, 0, 2);
+        f32x4 p3 = f32x4_shuffle(c, f32x4_shuffle(c, one, 3, 3, 0, 0), 1, 2, 0, 2);
+        lit_block(k, p0, p1, p2, p3, &nrm[i], &out[i], &colors[i], alpha, 4);
+    }
+
+    if (i < n) {
+        Vector4 p[4], pad[4];
+        for (int j = 0; j < 4; j++) {
+            Vector3 q = in[i + j < n ? i + j : n - 1];
+            p[j] = (Vector4){q.x, q.y, q.z, 1.0f};
+            pad[j] = nrm[i + j < n ? i + j : n - 1];
+        }
+        lit_block(k, f32x4_loadu(p[0].v), f32x4_loadu(p[1].v), f32x4_loadu(p[2].v), f32x4_loadu(p[3].v),
+                  pad, &out[i], &colors[i], alpha, n - i);
+    }
+}
+
+#else
+
+static inline void lit_vertex(const Matrix* model, const Matrix* normal, const Matrix* mvp, const Lighting* lighting,
+                              uint32_t base, Vector4 p, Vector4 n, Vector4* out, uint32_t* color) {
+    Vector4 wp = matrix_transform(model, p);
+    Vector4 wn = matrix_transform(normal, n);
+    Vector3 world_pos = {wp.x, wp.y, wp.z};
+    Vector3 world_normal = normalize(((Vector3){wn.x, wn.y, wn.z}));
+
+    *out = matrix_transform(mvp, p);
+    *color = lighting_shade_argb(base, lighting_evaluate(lighting, world_pos, world_normal));
+}
+
+#endif
+
+// Lights the vertices of figure and writes them transformed by mvp (clip space, or world space with the model matrix)
+static void lit_mesh(const Mesh* figure, Vector4* out, uint32_t* colors, uint32_t base, const Matrix* model,
+                     Matrix mvp, const Lighting* lighting) {
+    Matrix normal = normal_matrix(model);
+    int n = figure->vertex_count;
+
+#if MATH_SIMD
+    LitConstants k;
+    for (int c = 0; c < 4; c++) {
+        _Alignas(16) float col[4] = {mvp.m[0][c], mvp.m[1][c], mvp.m[2][c], mvp.m[3][c]};
+        k.mvp_col[c] = f32x4_load(col);
+    }
+    for (int row = 0; row < 3; row++) {
+        for (int c = 0; c < 4; c++)
+            k.model[row][c] = f32x4_set1(model->m[row][c]);
+        for (int c = 0; c < 3; c++)
+            k.normal[row][c] = f32x4_set1(normal.m[row][c]);
+    }
+    k.ambient[0] = f32x4_set1(lighting->ambient.x);
+    k.ambient[1] = f32x4_set1(lighting->ambient.y);
+    k.ambient[2] = f32x4_set1(lighting->ambient.z);
+    k.base[0] = f32x4_set1((float)((base >> 16) & 0xFF));
+    k.base[1] = f32x4_set1((float)((base >> 8) & 0xFF));
+    k.base[2] = f32x4_set1((float)(base & 0xFF));
+    uint32_t alpha = base & 0xFF000000u;
+
+    k.light_count = lighting->count;
+    for (int l = 0; l < lighting->count; l++) {
+        const Light* light = &lighting->lights[l];
+        LitLight* lit = &k.lights[l];
+        Vector3 v = light->position;
+        if (light->type == LIGHT_DIRECTIONAL) {
+            Vector3 dir = normalize(light->direction);
+            v = (Vector3){-dir.x, -dir.y, -dir.z};
+        }
+        lit->point = light->type == LIGHT_POINT;
+        lit->v[0] = f32x4_set1(v.x);
+        lit->v[1] = f32x4_set1(v.y);
+        lit->v[2] = f32x4_set1(v.z);
+        lit->color[0] = f32x4_set1(light->color.x);
+        lit->color[1] = f32x4_set1(light->color.y);
+        lit->color[2] = f32x4_set1(light->color.z);
+        lit->inv_range = f32x4_set1(1.0f / light->range);
+    }
+
+    if (figure->positions)
+        lit_points(&k, figure->positions, figure->normals, out, colors, alpha, n);
+    else
+        lit_vertices(&k, figure->vertices, figure->normals, out, colors, alpha, n);
+#else
+    if (figure->positions) {
+        for (int i = 0; i < n; i++) {
+            Vector3 p = figure->positions[i];
+            lit_vertex(model, &normal, &mvp, lighting, base, (Vector4){p.x, p.y, p.z, 1.0f}, figure->normals[i],
+                       &out[i], &colors[i]);
+        }
+    } else {
+        for (int i = 0; i < n; i++)
+            lit_vertex(model, &normal, &mvp, lighting, base, figure->vertices[i], figure->normals[i],
+                       &out[i], &colors[i]);
+    }
+#endif
+}
+
+void update_mesh_lit(const Mesh* figure, Mesh* clipped, uint32_t* colors, uint32_t base,
+                     const Transform transformations, const Camera cam, const Projection proj,
+                     const Lighting* lighting) {
+    Matrix model = model_matrix(transformations);
+    lit_mesh(figure, clipped->vertices, colors, base, &model, mvp_matrix(transformations, cam, proj), lighting);
+}
+
+/* ****************************  SKINNING + MVP ****************************** */
+
+void update_skinned_mesh(const SkinnedMesh* skin, const Matrix* palette, Mesh* clipped,
+                         const Transform transformations, const Camera cam, const Projection proj,
+                         JobSystem* jobs) {
+    Matrix mvp = mvp_matrix(transformations, cam, proj);
+
+    Matrix clip_palette[SKIN_MAX_JOINTS];
+    for (int j = 0; j < skin->joint_count; j++)
+        matrix_multiply(&clip_palette[j], &mvp, &palette[j]);
+
+    skin_vertices(skin, clip_palette, clipped->vertices, jobs);
+}
+
+/* ****************************  MULTI-VIEW ****************************** */
+
+// Views whose matrices are prepared per parallel loop
+#define VIEW_BATCH 16
+
+// Smallest vertex range worth a job of its own
+#define VIEW_MIN_BATCH 1024
+
+void update_mesh_world(const Mesh* figure, Vector4* world, const Transform transformations) {
+    Matrix model = model_matrix(transformations);
+
+    if (figure->positions)
+        matrix_transform_points(&model, figure->positions, world, figure->vertex_count);
+    else
+        matrix_transform_array(&model, figure->vertices, world, figure->vertex_count);
+}
+
+void update_mesh_world_lit(const Mesh* figure, Vector4* world, uint32_t* colors, uint32_t base,
+                           const Transform transformations, const Lighting* lighting) {
+    Matrix model = model_matrix(transformations);
+    lit_mesh(figure, world, colors, base, &model, model, lighting);
+}
+
+typedef struct ViewJob {
+    const Vector4* world;
+    int vertex_count;
+    Matrix view_proj[VIEW_BATCH];
+    Mesh* const* clipped;
+} ViewJob;
+
+// Indices run over views * vertices, view major: a range may span the end of one view and the start of the next
+static void views_range(void* ctx, int start, int end) {
+    const ViewJob* job = ctx;
+    int n = job->vertex_count;
+
+    while (start < end) {
+        int v = start / n, i = start % n;
+        int count = (end - start < n - i) ? end - start : n - i;
+        matrix_transform_array(&job->view_proj[v], job->world + i, job->clipped[v]->vertices + i, count);
+        start += count;
+    }
+}
+
+void update_mesh_views(const Vector4* world, int vertex_count, const View* views, int view_count,
+                       Mesh* const* clipped, JobSystem* jobs) {
+    if (vertex_count <= 0) return;
+
+    ViewJob job = { .world = world, .vertex_count = vertex_count };
+    for (int first = 0; first < view_count; first += VIEW_BATCH) {
+        int count = view_count - first < VIEW_BATCH ? view_count - first : VIEW_BATCH;
+        for (int v = 0; v < count; v++) {
+            Matrix view = view_matrix(views[first + v].camera);
+            Matrix proj = projection_matrix(views[first + v].projection);
+            matrix_multiply(&job.view_proj[v], &proj, &view);
+        }
+        job.clipped = clipped + first;
+        jobs_parallel_for(jobs, count * vertex_count, VIEW_MIN_BATCH, views_range, &job);
+    }
 }
@@ -0,0 +1,146 @@
+#include <stdlib.h>
+
+#include "core/render_queue.h"
+#include "core/memory.h"
+
+#define DEPTH_MAX ((1u << RENDER_KEY_DEPTH_BITS) - 1)
+
+static inline int is_wireframe(const Draw* draw) {
+    return draw->shading == SHADE_WIREFRAME || draw->vertex_colors == NULL;
+}
+
+uint64_t render_key(const Draw* draw, int layer, float depth) {
+    uint64_t pass = draw->backend == RENDER_SOFTWARE ? 0 : 1;
+    if (layer < 0) layer = 0;
+    if (layer >= RENDER_LAYERS) layer = RENDER_LAYERS - 1;
+
+    // Software draws have no SDL state: only their texture groups them, then depth (near first for the depth test)
+    uint32_t material = 0;
+    if (draw->shading == SHADE_TEXTURED && draw->texture)
+        material = (uint32_t)((uintptr_t)draw->texture >> 4);
+    else if (pass)
+        material = color_to_argb(draw->color);
+
+    if (!(depth > 0.0f)) depth = 0.0f;
+    if (depth > 1.0f) depth = 1.0f;
+    // SDL has no depth test: filled draws go far to near (painter), wireframes keep their submission order
+    if (pass) depth = is_wireframe(draw) ? 0.0f : 1.0f - depth;
+
+    return pass << RENDER_KEY_PASS_SHIFT |
+           (uint64_t)layer << RENDER_KEY_LAYER_SHIFT |
+           (uint64_t)(draw->shading & 3) << RENDER_KEY_SHADING_SHIFT |
+           (uint64_t)material << RENDER_KEY_MATERIAL_SHIFT |
+           (uint64_t)(depth * DEPTH_MAX);
+}
+
+RenderQueue* render_queue_create(int capacity) {
+    RenderQueue* queue = memory_alloc(MEMORY_RENDER, sizeof(RenderQueue));
+    if (!queue) return NULL;
+
+    queue->capacity = capacity > 0 ? capacity : 1;
+    queue->draws = memory_alloc(MEMORY_RENDER, sizeof(Draw*) * queue->capacity);
+    queue->keys = memory_alloc(MEMORY_RENDER, sizeof(SortKey) * queue->capacity);
+    queue->scratch = memory_alloc(MEMORY_RENDER, sizeof(SortKey) * queue->capacity);
+    if (!queue->draws || !queue->keys || !queue->scratch) {
+        render_queue_destroy(queue);
+        return NULL;
+    }
+
+    render_queue_reset(queue);
+    return queue;
+}
+
+void render_queue_reset(RenderQueue* queue) {
+    queue->count = 0;
+    queue->sorted = queue->keys;
+    queue->stats = (RenderQueueStats){0};
+}
+
+int render_queue_reserve(RenderQueue* queue, int count) {
+    if (count <= queue->capacity) return 1;
+
+    int capacity = queue->capacity;
+    while (capacity < count)
+        capacity *= 2;
+
+    const Draw** draws = memory_realloc(MEMORY_RENDER, queue->draws, sizeof(Draw*) * capacity);
+    if (!draws) return 0;
+    queue->draws = draws;
+
+    SortKey* keys = memory_realloc(MEMORY_RENDER, queue->keys, sizeof(SortKey) * capacity);
+    if (!keys) return 0;
+    queue->keys = keys;
+
+    SortKey* scratch = memory_realloc(MEMORY_RENDER, queue->scratch, sizeof(SortKey) * capacity);
+    if (!scratch) return 0;
+    queue->scratch = scratch;
+
+    queue->capacity = capacity;
+    queue->sorted = queue->keys;
+    return 1;
+}
+
+int render_queue_push(RenderQueue* queue, const Draw* draw, int layer, float depth) {
+    if (queue->count == queue->capacity && !render_queue_reserve(queue, queue->count + 1)) return 0;
+
+    queue->draws[queue->count] = draw;
+    queue->keys[queue->count] = (SortKey){render_key(draw, layer, depth), queue->count};
+    queue->count++;
+    queue->stats.draws++;
+    return 1;
+}
+
+static int count_state_changes(const SortKey* items, int count) {
+    int changes = 0;
+    uint64_t state = 0;
+    for (int i = 0; i < count; i++) {
+        uint64_t s = items[i].key >> RENDER_KEY_DEPTH_BITS;
+        changes += i == 0 || s != state;
+        state = s;
+    }
+    return changes;
+}
+
+void render_queue_sort(RenderQueue* queue) {
+    queue->stats.submitted_state_changes = count_state_changes(queue->keys, queue->count);
+    queue->sorted = radix_sort(queue->keys, queue->scratch, queue->count);
+    queue->stats.state_changes = count_state_changes(queue->sorted, queue->count);
+}
+
+int render_queue_execute(RenderQueue* queue, RenderBackend backend, SDL_Renderer* sdl_renderer, Framebuffer* fb,
+                         int screen_w, int screen_h) {
+    uint64_t pass = backend == RENDER_SOFTWARE ? 0 : 1;
+    int executed = 0, color_set = 0;
+    Color color = {0};
+
+    for (int i = 0; i < queue->count; i++) {
+        const SortKey* item = &queue->sorted[i];
+        if (item->key >> RENDER_KEY_PASS_SHIFT != pass) continue;
+
+        const Draw* draw = queue->draws[item->index];
+        if (backend == RENDER_SOFTWARE) {
+            draw_mesh_software(fb, draw);
+        } else if (is_wireframe(draw)) {
+            Color c = draw->color;
+            if (!color_set || c.r != color.r || c.g != color.g || c.b != color.b || c.a != color.a) {
+                SDL_SetRenderDrawColor(sdl_renderer, c.r, c.g, c.b, c.a);
+                queue->stats.color_sets++;
+                color = c;
+                color_set = 1;
+            }
+            draw_mesh_edges(sdl_renderer, draw, screen_w, screen_h);
+        } else {
+            draw_mesh(sdl_renderer, draw, screen_w, screen_h);
+        }
+        executed++;
+    }
+
+    return executed;
+}
+
+void render_queue_destroy(RenderQueue* queue) {
+    memory_free(MEMORY_RENDER, queue->draws);
+    memory_free(MEMORY_RENDER, queue->keys);
+    memory_free(MEMORY_RENDER, queue->scratch);
+    memory_free(MEMORY_RENDER, queue);
+}
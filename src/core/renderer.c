@@ -2,32 +2,229 @@
 
 #include "core/renderer.h"
 
-static Pixel get_pixel_pos(Vector4 v_clip, int screen_w, int screen_h) {
+// NDC [-1, 1] mapped onto a viewport, the whole screen for the SDL backend
+static Pixel get_pixel_pos(Vector4 v_clip, Viewport vp) {
     Pixel pos;
 
-    pos.x = ((v_clip.x / v_clip.w) + 1) * 0.5 * screen_w;
-    pos.y = (1 - (v_clip.y / v_clip.w)) * 0.5 * screen_h; // 1 - y_ndc to flip Y axis
+    pos.x = vp.x + ((v_clip.x / v_clip.w) + 1) * 0.5 * vp.width;
+    pos.y = vp.y + (1 - (v_clip.y / v_clip.w)) * 0.5 * vp.height; // 1 - y_ndc to flip Y axis
     pos.z_depth = ((v_clip.z / v_clip.w) + 1) * 0.5; // [-1, 1] -> [0, 1] depth
 
     return pos;
 }
 
+// Sub-pixel screen position and [0, 1] depth, for filled triangles
+static void project_vertex(Vector4 v_clip, Viewport vp, float* x, float* y, float* z) {
+    *x = vp.x + ((v_clip.x / v_clip.w) + 1) * 0.5f * vp.width;
+    *y = vp.y + (1 - (v_clip.y / v_clip.w)) * 0.5f * vp.height;
+    *z = ((v_clip.z / v_clip.w) + 1) * 0.5f;
+}
+
+static inline Viewport screen_viewport(size_t screen_w, size_t screen_h) {
+    return (Viewport){0, 0, (int)screen_w, (int)screen_h};
+}
+
+static inline int is_filled(const Draw* figure) {
+    return figure->shading != SHADE_WIREFRAME && figure->vertex_colors != NULL;
+}
+
+static inline int is_textured(const Draw* figure) {
+    return figure->shading == SHADE_TEXTURED && figure->texture != NULL && figure->clipped_mesh->uvs != NULL;
+}
+
+// Average of the three vertex colors, used by SHADE_FLAT
+static inline uint32_t average_argb(uint32_t a, uint32_t b, uint32_t c) {
+    uint32_t out = a & 0xFF000000u;
+    for (int shift = 0; shift <= 16; shift += 8)
+        out |= ((((a >> shift) & 0xFF) + ((b >> shift) & 0xFF) + ((c >> shift) & 0xFF)) / 3) << shift;
+    return out;
+}
+
+static inline int batch_size(const Mesh* mesh, int start) {
+    int left = mesh->triangle_count - start;
+    return left < MESH_TRIANGLE_BATCH ? left : MESH_TRIANGLE_BATCH;
+}
+
+// Triangles [start, start + count) of the draw order: index order, or figure->triangle_order
+static inline const Triangle* draw_triangle_batch(const Draw* figure, int start, int count, Triangle* scratch) {
+    const Mesh* mesh = figure->clipped_mesh;
+    if (!figure->triangle_order) return mesh_triangle_batch(mesh, start, count, scratch);
+
+    const int* order = figure->triangle_order + start;
+    for (int t = 0; t < count; t++)
+        scratch[t] = mesh_triangle(mesh, order[t]);
+    return scratch;
+}
+
+static inline SDL_Color argb_to_sdl(uint32_t c) {
+    return (SDL_Color){(c >> 16) & 0xFF, (c >> 8) & 0xFF, c & 0xFF, c >> 24};
+}
+
+// Triangles per SDL_RenderGeometry call
+#define GEOMETRY_BATCH 256
+
+static void draw_mesh_filled(SDL_Renderer* sdl_renderer, const Draw* figure, int screen_w, int screen_h) {
+    const Mesh* mesh = figure->clipped_mesh;
+    Viewport screen = screen_viewport(screen_w, screen_h);
+    SDL_Vertex batch[GEOMETRY_BATCH * 3];
+    Triangle scratch[MESH_TRIANGLE_BATCH];
+    int count = 0;
+
+    for (int start = 0; start < mesh->triangle_count; start += MESH_TRIANGLE_BATCH) {
+        int n = batch_size(mesh, start);
+        const Triangle* triangles = draw_triangle_batch(figure, start, n, scratch);
+
+        for (int i = 0; i < n; i++) {
+            const int* idx = triangles[i].vert;
+            Vector4 c0 = mesh->vertices[idx[0]], c1 = mesh->vertices[idx[1]], c2 = mesh->vertices[idx[2]];
+            if (c0.w <= 0 || c1.w <= 0 || c2.w <= 0)
+                continue;
+
+            uint32_t colors[3] = {figure->vertex_colors[idx[0]], figure->vertex_colors[idx[1]], figure->vertex_colors[idx[2]]};
+            if (figure->shading == SHADE_FLAT)
+                colors[0] = colors[1] = colors[2] = average_argb(colors[0], colors[1], colors[2]);
+
+            Vector4 clip[3] = {c0, c1, c2};
+            for (int k = 0; k < 3; k++) {
+                float z;
+                SDL_Vertex* v = &batch[count * 3 + k];
+                project_vertex(clip[k], screen, &v->position.x, &v->position.y, &z);
+                v->color = argb_to_sdl(colors[k]);
+                v->tex_coord = (SDL_FPoint){0.0f, 0.0f};
+            }
+
+            if (++count == GEOMETRY_BATCH) {
+                SDL_RenderGeometry(sdl_renderer, NULL, batch, count * 3, NULL, 0);
+                count = 0;
+            }
+        }
+    }
+
+    if (count > 0)
+        SDL_RenderGeometry(sdl_renderer, NULL, batch, count * 3, NULL, 0);
+}
+
 void draw_mesh(SDL_Renderer* sdl_renderer, const Draw* figure, const size_t screen_w, const size_t screen_h) {
+    if (is_filled(figure)) {
+        draw_mesh_filled(sdl_renderer, figure, screen_w, screen_h);
+        return;
+    }
+
     SDL_SetRenderDrawColor(sdl_renderer, figure->color.r, figure->color.g, figure->color.b, figure->color.a);
+    draw_mesh_edges(sdl_renderer, figure, screen_w, screen_h);
+}
+
+void draw_mesh_edges(SDL_Renderer* sdl_renderer, const Draw* figure, const size_t screen_w, const size_t screen_h) {
+    const Mesh* mesh = figure->clipped_mesh;
+    Viewport screen = screen_viewport(screen_w, screen_h);
+    Triangle scratch[MESH_TRIANGLE_BATCH];
 
     // Loop over triangles
-    for (int i = 0; i < figure->clipped_mesh->triangle_count; i += 1) {
-        int i0 = figure->clipped_mesh->triangles[i].vert[0];
-        int i1 = figure->clipped_mesh->triangles[i].vert[1];
-        int i2 = figure->clipped_mesh->triangles[i].vert[2];
+    for (int start = 0; start < mesh->triangle_count; start += MESH_TRIANGLE_BATCH) {
+        int n = batch_size(mesh, start);
+        const Triangle* triangles = draw_triangle_batch(figure, start, n, scratch);
 
-        Pixel v0 = get_pixel_pos(figure->clipped_mesh->vertices[i0], screen_w, screen_h);
-        Pixel v1 = get_pixel_pos(figure->clipped_mesh->vertices[i1], screen_w, screen_h);
-        Pixel v2 = get_pixel_pos(figure->clipped_mesh->vertices[i2], screen_w, screen_h);
+        for (int i = 0; i < n; i++) {
+            Pixel v0 = get_pixel_pos(mesh->vertices[triangles[i].vert[0]], screen);
+            Pixel v1 = get_pixel_pos(mesh->vertices[triangles[i].vert[1]], screen);
+            Pixel v2 = get_pixel_pos(mesh->vertices[triangles[i].vert[2]], screen);
 
-        // Draw triangle edges
-        SDL_RenderDrawLine(sdl_renderer, v0.x, v0.y, v1.x, v1.y);
-        SDL_RenderDrawLine(sdl_renderer, v1.x, v1.y, v2.x, v2.y);
-        SDL_RenderDrawLine(sdl_renderer, v2.x, v2.y, v0.x, v0.y);
+            // Draw triangle edges
+            SDL_RenderDrawLine(sdl_renderer, v0.x, v0.y, v1.x, v1.y);
+            SDL_RenderDrawLine(sdl_renderer, v1.x, v1.y, v2.x, v2.y);
+            SDL_RenderDrawLine(sdl_renderer, v2.x, v2.y, v0.x, v0.y);
+        }
     }
-}
\ No newline at end of file
+}
+
+static void draw_mesh_software_filled(Framebuffer* fb, const Draw* figure) {
+    const Mesh* mesh = figure->clipped_mesh;
+    Triangle scratch[MESH_TRIANGLE_BATCH];
+
+    for (int start = 0; start < mesh->triangle_count; start += MESH_TRIANGLE_BATCH) {
+        int n = batch_size(mesh, start);
+        const Triangle* triangles = draw_triangle_batch(figure, start, n, scratch);
+
+        for (int i = 0; i < n; i++) {
+            const int* idx = triangles[i].vert;
+            Vector4 clip[3] = {mesh->vertices[idx[0]], mesh->vertices[idx[1]], mesh->vertices[idx[2]]};
+            if (clip[0].w <= 0 || clip[1].w <= 0 || clip[2].w <= 0)
+                continue;
+
+            float x[3], y[3], z[3];
+            for (int k = 0; k < 3; k++)
+                project_vertex(clip[k], fb->viewport, &x[k], &y[k], &z[k]);
+
+            uint32_t colors[3] = {figure->vertex_colors[idx[0]], figure->vertex_colors[idx[1]], figure->vertex_colors[idx[2]]};
+            if (figure->shading == SHADE_FLAT)
+                colors[0] = colors[1] = colors[2] = average_argb(colors[0], colors[1], colors[2]);
+
+            framebuffer_fill_triangle(fb, x, y, z, colors);
+        }
+    }
+}
+
+static void draw_mesh_software_textured(Framebuffer* fb, const Draw* figure) {
+    const Mesh* mesh = figure->clipped_mesh;
+    Triangle scratch[MESH_TRIANGLE_BATCH];
+
+    for (int start = 0; start < mesh->triangle_count; start += MESH_TRIANGLE_BATCH) {
+        int n = batch_size(mesh, start);
+        const Triangle* triangles = draw_triangle_batch(figure, start, n, scratch);
+
+        for (int i = 0; i < n; i++) {
+            const int* idx = triangles[i].vert;
+            Vector4 clip[3] = {mesh->vertices[idx[0]], mesh->vertices[idx[1]], mesh->vertices[idx[2]]};
+            if (clip[0].w <= 0 || clip[1].w <= 0 || clip[2].w <= 0)
+                continue;
+
+            float x[3], y[3], z[3], inv_w[3], u[3], v[3];
+            for (int k = 0; k < 3; k++) {
+                project_vertex(clip[k], fb->viewport, &x[k], &y[k], &z[k]);
+                inv_w[k] = 1.0f / clip[k].w;
+                u[k] = mesh->uvs[idx[k]].u;
+                v[k] = mesh->uvs[idx[k]].v;
+            }
+
+            framebuffer_fill_triangle_textured(fb, x, y, z, inv_w, u, v, figure->texture, figure->filter);
+        }
+    }
+}
+
+void draw_mesh_software(Framebuffer* fb, const Draw* figure) {
+    if (is_textured(figure)) {
+        draw_mesh_software_textured(fb, figure);
+        return;
+    }
+    if (is_filled(figure)) {
+        draw_mesh_software_filled(fb, figure);
+        return;
+    }
+
+    const Mesh* mesh = figure->clipped_mesh;
+    uint32_t color = color_to_argb(figure->color);
+    Triangle scratch[MESH_TRIANGLE_BATCH];
+
+    for (int start = 0; start < mesh->triangle_count; start += MESH_TRIANGLE_BATCH) {
+        int n = batch_size(mesh, start);
+        const Triangle* triangles = draw_triangle_batch(figure, start, n, scratch);
+
+        for (int i = 0; i < n; i++) {
+            Vector4 c0 = mesh->vertices[triangles[i].vert[0]];
+            Vector4 c1 = mesh->vertices[triangles[i].vert[1]];
+            Vector4 c2 = mesh->vertices[triangles[i].vert[2]];
+
+            // No near-plane clipping yet: skip what cannot be projected
+            if (c0.w <= 0 || c1.w <= 0 || c2.w <= 0)
+                continue;
+
+            Pixel v0 = get_pixel_pos(c0, fb->viewport);
+            Pixel v1 = get_pixel_pos(c1, fb->viewport);
+            Pixel v2 = get_pixel_pos(c2, fb->viewport);
+
+            framebuffer_draw_line(fb, v0.x, v0.y, v1.x, v1.y, color);
+            framebuffer_draw_line(fb, v1.x, v1.y, v2.x, v2.y, color);
+            framebuffer_draw_line(fb, v2.x, v2.y, v0.x, v0.y, color);
+        }
+    }
+}
@@ -0,0 +1,401 @@
+#include <string.h>
+#include <SDL.h>
+
+#include "core/replay.h"
+#include "core/memory.h"
+
+#define REPLAY_MAGIC "3DRP"
+
+// Record tags
+#define RECORD_MESH  1
+#define RECORD_FRAME 2
+#define RECORD_END   3
+
+// Frame record fields present since the previous frame
+#define CHANGED_TRANSFORM  (1 << 0)
+#define CHANGED_CAMERA     (1 << 1)
+#define CHANGED_PROJECTION (1 << 2)
+#define CHANGED_DRAW       (1 << 3)
+#define CHANGED_LIGHTING   (1 << 4)
+#define CHANGED_ALL        0x1F
+
+/* **************************** RECORDING ****************************** */
+
+static int write_bytes(FILE* file, const void* data, size_t size) {
+    return fwrite(data, 1, size, file) == size;
+}
+
+static int write_u8(FILE* file, uint8_t value) {
+    return write_bytes(file, &value, 1);
+}
+
+static int write_i32(FILE* file, int32_t value) {
+    return write_bytes(file, &value, sizeof(value));
+}
+
+Recorder* recorder_open(const char* path, int screen_w, int screen_h, Color background) {
+    Recorder* rec = memory_calloc(MEMORY_REPLAY, 1, sizeof(Recorder));
+    if (!rec) return NULL;
+
+    rec->file = fopen(path, "wb");
+    if (!rec->file) {
+        memory_free(MEMORY_REPLAY, rec);
+        return NULL;
+    }
+
+    if (!write_bytes(rec->file, REPLAY_MAGIC, 4) || !write_i32(rec->file, REPLAY_VERSION) ||
+        !write_i32(rec->file, screen_w) || !write_i32(rec->file, screen_h) ||
+        !write_i32(rec->file, (int32_t)color_to_argb(background))) {
+        fclose(rec->file);
+        memory_free(MEMORY_REPLAY, rec);
+        return NULL;
+    }
+
+    return rec;
+}
+
+// Geometry in the full formats (Vector4 positions, int indices), whatever the mesh holds
+static int write_geometry(FILE* file, const Mesh* mesh) {
+    if (mesh->vertices && mesh->triangles)
+        return write_bytes(file, mesh->vertices, sizeof(Vector4) * mesh->vertex_count) &&
+               write_bytes(file, mesh->triangles, sizeof(Triangle) * mesh->triangle_count);
+
+    int ok = 1;
+    for (int i = 0; ok && i < mesh->vertex_count; i++) {
+        Vector3 p = mesh_position(mesh, i);
+        Vector4 v = {p.x, p.y, p.z, 1.0f};
+        ok = write_bytes(file, &v, sizeof(v));
+    }
+    for (int t = 0; ok && t < mesh->triangle_count; t++) {
+        Triangle tri = mesh_triangle(mesh, t);
+        ok = write_bytes(file, &tri, sizeof(tri));
+    }
+    return ok;
+}
+
+// Id of a mesh, writing its geometry the first time; -1 on failure
+static int mesh_id(Recorder* rec, const Mesh* mesh) {
+    for (int i = 0; i < rec->mesh_count; i++)
+        if (rec->meshes[i] == mesh) return i;
+    if (rec->mesh_count == REPLAY_MAX_MESHES) return -1;
+
+    int id = rec->mesh_count;
+    int ok = write_u8(rec->file, RECORD_MESH) && write_i32(rec->file, id) &&
+             write_i32(rec->file, mesh->vertex_count) && write_i32(rec->file, mesh->triangle_count) &&
+             write_geometry(rec->file, mesh);
+    if (!ok) return -1;
+
+    rec->meshes[rec->mesh_count++] = mesh;
+    return id;
+}
+
+int recorder_frame(Recorder* rec, float dt, const Mesh* mesh, const Draw* draw, Transform transform,
+                   Camera cam, Projection proj, const Lighting* lighting) {
+    int id = mesh_id(rec, mesh);
+    if (id < 0) return 0;
+
+    ReplayFrame frame = rec->last;
+    frame.dt = dt;
+    frame.mesh = id;
+    frame.transform = transform;
+    frame.camera = cam;
+    frame.projection = proj;
+    frame.color = color_to_argb(draw->color);
+    frame.backend = draw->backend;
+    frame.shading = draw->shading;
+    frame.lighting = *lighting;
+
+    uint8_t changed = CHANGED_ALL;
+    if (rec->frame_count > 0) {
+        const ReplayFrame* last = &rec->last;
+        changed = 0;
+        if (memcmp(&frame.transform, &last->transform, sizeof(Transform))) changed |= CHANGED_TRANSFORM;
+        if (memcmp(&frame.camera, &last->camera, sizeof(Camera))) changed |= CHANGED_CAMERA;
+        if (memcmp(&frame.projection, &last->projection, sizeof(Projection))) changed |= CHANGED_PROJECTION;
+        if (frame.mesh != last->mesh || frame.color != last->color ||
+            frame.backend != last->backend || frame.shading != last->shading) changed |= CHANGED_DRAW;
+        if (memcmp(&frame.lighting, &last->lighting, sizeof(Lighting))) changed |= CHANGED_LIGHTING;
+    }
+
+    FILE* f = rec->file;
+    int ok = write_u8(f, RECORD_FRAME) && write_u8(f, changed) && write_bytes(f, &dt, sizeof(dt));
+    if (ok && (changed & CHANGED_TRANSFORM)) ok = write_bytes(f, &frame.transform, sizeof(Transform));
+    if (ok && (changed & CHANGED_CAMERA)) ok = write_bytes(f, &frame.camera, sizeof(Camera));
+    if (ok && (changed & CHANGED_PROJECTION)) ok = write_bytes(f, &frame.projection, sizeof(Projection));
+    if (ok && (changed & CHANGED_DRAW))
+        ok = write_i32(f, frame.mesh) && write_bytes(f, &frame.color, sizeof(uint32_t)) &&
+             write_u8(f, (uint8_t)frame.backend) && write_u8(f, (uint8_t)frame.shading);
+    if (ok && (changed & CHANGED_LIGHTING)) ok = write_bytes(f, &frame.lighting, sizeof(Lighting));
+    if (!ok) return 0;
+
+    rec->last = frame;
+    rec->frame_count++;
+    return 1;
+}
+
+int recorder_close(Recorder* rec) {
+    int ok = write_u8(rec->file, RECORD_END) && write_i32(rec->file, rec->frame_count);
+    ok &= fclose(rec->file) == 0;
+    memory_free(MEMORY_REPLAY, rec);
+    return ok;
+}
+
+/* **************************** LOADING ****************************** */
+
+static int read_bytes(FILE* file, void* data, size_t size) {
+    return fread(data, 1, size, file) == size;
+}
+
+static int read_i32(FILE* file, int32_t* value) {
+    return read_bytes(file, value, sizeof(*value));
+}
+
+static Mesh* read_mesh(FILE* file) {
+    int32_t vertex_count, triangle_count;
+    if (!read_i32(file, &vertex_count) || !read_i32(file, &triangle_count) ||
+        vertex_count < 0 || triangle_count < 0)
+        return NULL;
+
+    Vector4* vertices = memory_alloc(MEMORY_REPLAY, sizeof(Vector4) * (vertex_count > 0 ? vertex_count : 1));
+    Triangle* triangles = memory_alloc(MEMORY_REPLAY, sizeof(Triangle) * (triangle_count > 0 ? triangle_count : 1));
+    Mesh* mesh = NULL;
+
+    if (vertices && triangles &&
+        read_bytes(file, vertices, sizeof(Vector4) * vertex_count) &&
+        read_bytes(file, triangles, sizeof(Triangle) * triangle_count)) {
+        int valid = 1;
+        for (int t = 0; t < triangle_count; t++)
+            for (int k = 0; k < 3; k++)
+                valid &= triangles[t].vert[k] >= 0 && triangles[t].vert[k] < vertex_count;
+        if (valid)
+            mesh = mesh_generate(vertices, vertex_count, triangles, triangle_count);
+    }
+
+    memory_free(MEMORY_REPLAY, vertices);
+    memory_free(MEMORY_REPLAY, triangles);
+    return mesh;
+}
+
+static int read_frame(FILE* file, const Replay* replay, const ReplayFrame* last, ReplayFrame* frame) {
+    uint8_t changed;
+    *frame = *last;
+    if (!read_bytes(file, &changed, 1) || !read_bytes(file, &frame->dt, sizeof(float)))
+        return 0;
+
+    // The first frame must carry everything
+    if (replay->frame_count == 0 && changed != CHANGED_ALL)
+        return 0;
+
+    if ((changed & CHANGED_TRANSFORM) && !read_bytes(file, &frame->transform, sizeof(Transform))) return 0;
+    if ((changed & CHANGED_CAMERA) && !read_bytes(file, &frame->camera, sizeof(Camera))) return 0;
+    if ((changed & CHANGED_PROJECTION) && !read_bytes(file, &frame->projection, sizeof(Projection))) return 0;
+    if (changed & CHANGED_DRAW) {
+        int32_t mesh;
+        uint8_t backend, shading;
+        if (!read_i32(file, &mesh) || !read_bytes(file, &frame->color, sizeof(uint32_t)) ||
+            !read_bytes(file, &backend, 1) || !read_bytes(file, &shading, 1))
+            return 0;
+        if (mesh < 0 || mesh >= replay->mesh_count) return 0;
+        frame->mesh = mesh;
+        frame->backend = (RenderBackend)backend;
+        frame->shading = (ShadeMode)shading;
+    }
+    if ((changed & CHANGED_LIGHTING) && !read_bytes(file, &frame->lighting, sizeof(Lighting))) return 0;
+    if (frame->lighting.count < 0 || frame->lighting.count > LIGHTING_MAX_LIGHTS) return 0;
+
+    return 1;
+}
+
+Replay* replay_load(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return NULL;
+
+    char magic[4];
+    int32_t version, w, h, background;
+    if (!read_bytes(file, magic, 4) || memcmp(magic, REPLAY_MAGIC, 4) ||
+        !read_i32(file, &version) || version != REPLAY_VERSION ||
+        !read_i32(file, &w) || !read_i32(file, &h) || w <= 0 || h <= 0 ||
+        !read_i32(file, &background)) {
+        fclose(file);
+        return NULL;
+    }
+
+    Replay* replay = memory_calloc(MEMORY_REPLAY, 1, sizeof(Replay));
+    if (!replay) {
+        fclose(file);
+        return NULL;
+    }
+    replay->screen_w = w;
+    replay->screen_h = h;
+    replay->background = (uint32_t)background;
+    replay->meshes = memory_alloc(MEMORY_REPLAY, sizeof(Mesh*) * REPLAY_MAX_MESHES);
+
+    int capacity = 0, ok = replay->meshes != NULL, done = 0;
+    ReplayFrame last;
+    memset(&last, 0, sizeof(last));
+
+    while (ok && !done) {
+        uint8_t tag;
+        if (!read_bytes(file, &tag, 1)) {
+            ok = 0;
+            break;
+        }
+
+        if (tag == RECORD_MESH) {
+            int32_t id;
+            Mesh* mesh = NULL;
+            ok = read_i32(file, &id) && id == replay->mesh_count && id < REPLAY_MAX_MESHES &&
+                 (mesh = read_mesh(file)) != NULL;
+            if (ok) replay->meshes[replay->mesh_count++] = mesh;
+        } else if (tag == RECORD_FRAME) {
+            if (replay->frame_count == capacity) {
+                capacity = capacity ? capacity * 2 : 256;
+                ReplayFrame* frames = memory_realloc(MEMORY_REPLAY, replay->frames, sizeof(ReplayFrame) * capacity);
+                if (!frames) {
+                    ok = 0;
+                    break;
+                }
+                replay->frames = frames;
+            }
+            ok = read_frame(file, replay, &last, &replay->frames[replay->frame_count]);
+            if (ok) last = replay->frames[replay->frame_count++];
+        } else if (tag == RECORD_END) {
+            int32_t count;
+            ok = read_i32(file, &count) && count == replay->frame_count;
+            done = 1;
+        } else {
+            ok = 0;
+        }
+    }
+    fclose(file);
+
+    // Lit shading modes need normals
+    for (int i = 0; ok && i < replay->mesh_count; i++)
+        ok = mesh_compute_normals(replay->meshes[i], NULL);
+
+    if (!ok) {
+        replay_destroy(replay);
+        return NULL;
+    }
+    return replay;
+}
+
+/* **************************** REPLAY ****************************** */
+
+uint32_t framebuffer_checksum(const Framebuffer* fb) {
+    uint32_t hash = 2166136261u;
+    for (int y = 0; y < fb->height; y++) {
+        const uint8_t* row = (const uint8_t*)(fb->pixels + (size_t)y * fb->pitch);
+        for (size_t i = 0; i < sizeof(uint32_t) * (size_t)fb->width; i++) {
+            hash ^= row[i];
+            hash *= 16777619u;
+        }
+    }
+    return hash;
+}
+
+static int compare_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Nearest-rank percentile of sorted values
+static double percentile(const double* sorted, int count, double p) {
+    int rank = (int)(p / 100.0 * count + 0.999999);
+    if (rank < 1) rank = 1;
+    if (rank > count) rank = count;
+    return sorted[rank - 1];
+}
+
+static Color argb_to_color(uint32_t c) {
+    return (Color){(c >> 16) & 0xFF, (c >> 8) & 0xFF, c & 0xFF, c >> 24};
+}
+
+int replay_run(const Replay* replay, ReplayReport* report) {
+    memset(report, 0, sizeof(*report));
+    int n = replay->frame_count;
+
+    Framebuffer* fb = framebuffer_create(replay->screen_w, replay->screen_h);
+    Mesh** clipped = memory_calloc(MEMORY_REPLAY, replay->mesh_count > 0 ? replay->mesh_count : 1, sizeof(Mesh*));
+    uint32_t** colors = memory_calloc(MEMORY_REPLAY, replay->mesh_count > 0 ? replay->mesh_count : 1, sizeof(uint32_t*));
+    report->frame_ms = memory_alloc(MEMORY_REPLAY, sizeof(double) * (n > 0 ? n : 1));
+    report->checksums = memory_alloc(MEMORY_REPLAY, sizeof(uint32_t) * (n > 0 ? n : 1));
+    double* sorted = memory_alloc(MEMORY_REPLAY, sizeof(double) * (n > 0 ? n : 1));
+
+    int ok = fb && clipped && colors && report->frame_ms && report->checksums && sorted;
+    for (int i = 0; ok && i < replay->mesh_count; i++) {
+        clipped[i] = mesh_create_clipped(replay->meshes[i]);
+        colors[i] = memory_alloc(MEMORY_REPLAY, sizeof(uint32_t) * (replay->meshes[i]->vertex_count > 0 ? replay->meshes[i]->vertex_count : 1));
+        ok = clipped[i] && colors[i];
+    }
+
+    for (int f = 0; ok && f < n; f++) {
+        const ReplayFrame* frame = &replay->frames[f];
+        const Mesh* mesh = replay->meshes[frame->mesh];
+        Draw draw = {
+            .clipped_mesh = clipped[frame->mesh],
+            .color = argb_to_color(frame->color),
+            .backend = RENDER_SOFTWARE,
+            .shading = frame->shading,
+            .vertex_colors = colors[frame->mesh]
+        };
+        int filled = frame->shading != SHADE_WIREFRAME;
+
+        Uint64 t0 = SDL_GetPerformanceCounter();
+        if (filled)
+            update_mesh_lit(mesh, draw.clipped_mesh, draw.vertex_colors, frame->color,
+                            frame->transform, frame->camera, frame->projection, &frame->lighting);
+        else
+            update_mesh(mesh, draw.clipped_mesh, frame->transform, frame->camera, frame->projection);
+
+        framebuffer_clear(fb, replay->background);
+        if (filled) framebuffer_clear_depth(fb);
+        draw_mesh_software(fb, &draw);
+        framebuffer_resolve(fb);
+        Uint64 t1 = SDL_GetPerformanceCounter();
+
+        report->frame_ms[f] = (double)((t1 - t0) * 1000) / (double)SDL_GetPerformanceFrequency();
+        report->checksums[f] = framebuffer_checksum(fb);
+        report->total_ms += report->frame_ms[f];
+        report->session_ms += frame->dt * 1000.0;
+    }
+
+    if (ok) {
+        report->frame_count = n;
+        if (n > 0) {
+            memcpy(sorted, report->frame_ms, sizeof(double) * n);
+            qsort(sorted, n, sizeof(double), compare_double);
+            report->p50_ms = percentile(sorted, n, 50.0);
+            report->p90_ms = percentile(sorted, n, 90.0);
+            report->p99_ms = percentile(sorted, n, 99.0);
+            report->max_ms = sorted[n - 1];
+        }
+    } else {
+        replay_report_free(report);
+    }
+
+    for (int i = 0; clipped && i < replay->mesh_count; i++)
+        if (clipped[i]) mesh_destroy(clipped[i]);
+    for (int i = 0; colors && i < replay->mesh_count; i++)
+        memory_free(MEMORY_REPLAY, colors[i]);
+    memory_free(MEMORY_REPLAY, clipped);
+    memory_free(MEMORY_REPLAY, colors);
+    memory_free(MEMORY_REPLAY, sorted);
+    if (fb) framebuffer_destroy(fb);
+    return ok;
+}
+
+void replay_report_free(ReplayReport* report) {
+    memory_free(MEMORY_REPLAY, report->frame_ms);
+    memory_free(MEMORY_REPLAY, report->checksums);
+    report->frame_ms = NULL;
+    report->checksums = NULL;
+}
+
+void replay_destroy(Replay* replay) {
+    for (int i = 0; i < replay->mesh_count; i++)
+        mesh_destroy(replay->meshes[i]);
+    memory_free(MEMORY_REPLAY, replay->meshes);
+    memory_free(MEMORY_REPLAY, replay->frames);
+    memory_free(MEMORY_REPLAY, replay);
+}
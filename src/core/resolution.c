@@ -0,0 +1,51 @@
+#include <math.h>
+
+#include "core/resolution.h"
+
+#define RESOLUTION_SMOOTHING 0.2f
+
+// Relative scale change below which the scale is kept
+#define RESOLUTION_DEAD_BAND 0.05f
+
+ResolutionController resolution_controller(float target_ms, float min_scale, float max_scale) {
+    return (ResolutionController){
+        .target_ms = target_ms,
+        .min_scale = min_scale,
+        .max_scale = max_scale,
+        .smoothing = RESOLUTION_SMOOTHING,
+        .scale = max_scale,
+        .smoothed_ms = 0.0f
+    };
+}
+
+float resolution_update(ResolutionController* rc, float raster_ms) {
+    if (rc->smoothed_ms <= 0.0f)
+        rc->smoothed_ms = raster_ms;
+    else
+        rc->smoothed_ms += rc->smoothing * (raster_ms - rc->smoothed_ms);
+
+    if (rc->smoothed_ms <= 0.0f || rc->target_ms <= 0.0f)
+        return rc->scale;
+
+    // Time scales with scale^2: the scale that lands on the budget
+    float wanted = rc->scale * sqrtf(rc->target_ms / rc->smoothed_ms);
+    wanted = fminf(rc->max_scale, fmaxf(rc->min_scale, wanted));
+
+    if (fabsf(wanted - rc->scale) > RESOLUTION_DEAD_BAND * rc->scale) {
+        // The average was measured at the old scale, predict it at the new one
+        float ratio = wanted / rc->scale;
+        rc->smoothed_ms *= ratio * ratio;
+        rc->scale = wanted;
+    }
+
+    return rc->scale;
+}
+
+void resolution_size(const ResolutionController* rc, int full_w, int full_h, int* w, int* h) {
+    *w = (int)(full_w * rc->scale + 0.5f);
+    *h = (int)(full_h * rc->scale + 0.5f);
+    if (*w < 1) *w = 1;
+    if (*h < 1) *h = 1;
+    if (*w > full_w) *w = full_w;
+    if (*h > full_h) *h = full_h;
+}
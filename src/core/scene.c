@@ -0,0 +1,249 @@
+#include <math.h>
+
+#include "core/scene.h"
+#include "core/memory.h"
+
+// Upper bound for automatically picked occluders per frame
+#define SCENE_MAX_AUTO_OCCLUDERS 32
+
+Scene* scene_create(int capacity) {
+    Scene* scene = memory_alloc(MEMORY_SCENE, sizeof(Scene));
+    if (!scene) return NULL;
+
+    scene->count = 0;
+    scene->capacity = capacity > 0 ? capacity : 1;
+    scene->culler = NULL;
+    scene->lighting = NULL;
+    scene->objects = memory_alloc(MEMORY_SCENE, sizeof(Object) * scene->capacity);
+    if (!scene->objects) {
+        memory_free(MEMORY_SCENE, scene);
+        return NULL;
+    }
+
+    return scene;
+}
+
+int scene_add(Scene* scene, const Mesh* mesh, Color color, Transform transform, int flags) {
+    if (scene->count == scene->capacity) {
+        int capacity = scene->capacity * 2;
+        Object* objects = memory_realloc(MEMORY_SCENE, scene->objects, sizeof(Object) * capacity);
+        if (!objects) return -1;
+        scene->objects = objects;
+        scene->capacity = capacity;
+    }
+    if (scene->culler && !occlusion_reserve(scene->culler, mesh->vertex_count)) return -1;
+
+    Mesh* clipped = mesh_create_clipped(mesh);
+    if (!clipped) return -1;
+
+    uint32_t* vertex_colors = memory_alloc(MEMORY_SCENE, sizeof(uint32_t) * (mesh->vertex_count > 0 ? mesh->vertex_count : 1));
+    // Sized for the mesh here, so that frames sort without allocating
+    DepthSort* depth_sort = depth_sort_create(mesh->triangle_count);
+    if (!vertex_colors || !depth_sort) {
+        memory_free(MEMORY_SCENE, vertex_colors);
+        depth_sort_destroy(depth_sort);
+        mesh_destroy(clipped);
+        return -1;
+    }
+    // Unlit filled draws show the plain color
+    for (int i = 0; i < mesh->vertex_count; i++)
+        vertex_colors[i] = color_to_argb(color);
+
+    Object* obj = &scene->objects[scene->count];
+    obj->mesh = mesh;
+    obj->draw = (Draw){
+        .clipped_mesh = clipped,
+        .color = color,
+        .backend = RENDER_SDL,
+        .shading = SHADE_WIREFRAME,
+        .vertex_colors = vertex_colors,
+        .triangle_order = NULL
+    };
+    obj->depth_sort = depth_sort;
+    obj->transform = transform;
+    obj->bounds = mesh_bounds(mesh);
+    obj->flags = flags;
+    obj->layer = 0;
+    obj->visible = 1;
+    obj->occluding = 0;
+
+    return scene->count++;
+}
+
+int scene_set_culler(Scene* scene, OcclusionCuller* culler) {
+    if (culler)
+        for (int i = 0; i < scene->count; i++)
+            if (!occlusion_reserve(culler, scene->objects[i].mesh->vertex_count)) return 0;
+
+    scene->culler = culler;
+    return 1;
+}
+
+void scene_remove(Scene* scene, int index) {
+    if (index < 0 || index >= scene->count) return;
+
+    mesh_destroy(scene->objects[index].draw.clipped_mesh);
+    memory_free(MEMORY_SCENE, scene->objects[index].draw.vertex_colors);
+    depth_sort_destroy(scene->objects[index].depth_sort);
+    scene->objects[index] = scene->objects[--scene->count];
+}
+
+int scene_set_mesh(Scene* scene, int index, const Mesh* mesh) {
+    Object* obj = &scene->objects[index];
+    if (scene->culler && !occlusion_reserve(scene->culler, mesh->vertex_count)) return 0;
+
+    Mesh* clipped = mesh_create_clipped(mesh);
+    uint32_t* vertex_colors = memory_alloc(MEMORY_SCENE, sizeof(uint32_t) * (mesh->vertex_count > 0 ? mesh->vertex_count : 1));
+    // Last: a failed reserve leaves the order in place, a successful one may move it
+    if (!clipped || !vertex_colors || !depth_sort_reserve(obj->depth_sort, mesh->triangle_count)) {
+        memory_free(MEMORY_SCENE, vertex_colors);
+        if (clipped) mesh_destroy(clipped);
+        return 0;
+    }
+    for (int i = 0; i < mesh->vertex_count; i++)
+        vertex_colors[i] = color_to_argb(obj->draw.color);
+
+    // Nothing fails past this point. The order indexes the old triangles, and may have moved
+    mesh_destroy(obj->draw.clipped_mesh);
+    memory_free(MEMORY_SCENE, obj->draw.vertex_colors);
+    obj->mesh = mesh;
+    obj->draw.clipped_mesh = clipped;
+    obj->draw.vertex_colors = vertex_colors;
+    obj->draw.triangle_order = NULL;
+    obj->bounds = mesh_bounds(mesh);
+    return 1;
+}
+
+/* **************************** OCCLUDER SELECTION ****************************** */
+
+// Rough on-screen size: world bounding-sphere radius over camera distance
+static float occluder_score(const Object* obj, const Matrix* model, Vector3 eye) {
+    Vector3 extent = subtract(obj->bounds.max, obj->bounds.min);
+    Vector4 center = transform(*model, (Vector4){
+        (obj->bounds.min.x + obj->bounds.max.x) * 0.5f,
+        (obj->bounds.min.y + obj->bounds.max.y) * 0.5f,
+        (obj->bounds.min.z + obj->bounds.max.z) * 0.5f,
+        1.0f
+    });
+
+    Vector3 s = obj->transform.scale;
+    float max_scale = fmaxf(fabsf(s.x), fmaxf(fabsf(s.y), fabsf(s.z)));
+    float radius = 0.5f * norm(extent) * max_scale;
+    Vector3 world_center = {center.x, center.y, center.z};
+    float distance = norm(subtract(world_center, eye));
+
+    if (distance <= radius) return INFINITY;
+    return radius / distance;
+}
+
+// Keeps the `limit` best scoring objects, sorted by decreasing score
+static int pick_occluders(const Scene* scene, const Camera cam, int* picked, int limit) {
+    float scores[SCENE_MAX_AUTO_OCCLUDERS];
+    int count = 0;
+    if (limit <= 0) return 0;
+
+    for (int i = 0; i < scene->count; i++) {
+        const Object* obj = &scene->objects[i];
+        Matrix model = model_matrix(obj->transform);
+        float score = occluder_score(obj, &model, cam.pos);
+
+        if (count == limit && score <= scores[count - 1]) continue;
+
+        int j = count < limit ? count++ : count - 1;
+        while (j > 0 && scores[j - 1] < score) {
+            scores[j] = scores[j - 1];
+            picked[j] = picked[j - 1];
+            j--;
+        }
+        scores[j] = score;
+        picked[j] = i;
+    }
+
+    return count;
+}
+
+static void occlusion_pass(Scene* scene, const Camera cam, const Matrix* view_proj) {
+    OcclusionCuller* culler = scene->culler;
+    occlusion_begin(culler);
+
+    int flagged = 0;
+    for (int i = 0; i < scene->count; i++) {
+        Object* obj = &scene->objects[i];
+        obj->occluding = (obj->flags & OBJECT_OCCLUDER) != 0;
+        flagged += obj->occluding;
+    }
+
+    if (!flagged) {
+        int limit = culler->max_occluders < SCENE_MAX_AUTO_OCCLUDERS ? culler->max_occluders : SCENE_MAX_AUTO_OCCLUDERS;
+        int picked[SCENE_MAX_AUTO_OCCLUDERS];
+        int count = pick_occluders(scene, cam, picked, limit);
+        for (int i = 0; i < count; i++)
+            scene->objects[picked[i]].occluding = 1;
+    }
+
+    for (int i = 0; i < scene->count; i++) {
+        Object* obj = &scene->objects[i];
+        if (!obj->occluding) continue;
+
+        Matrix mvp = multiply(*view_proj, model_matrix(obj->transform));
+        occlusion_add_occluder(culler, obj->mesh, &mvp);
+    }
+
+    occlusion_build_pyramid(culler);
+
+    for (int i = 0; i < scene->count; i++) {
+        Object* obj = &scene->objects[i];
+        if (obj->occluding) continue;
+
+        Matrix mvp = multiply(*view_proj, model_matrix(obj->transform));
+        obj->visible = occlusion_test(culler, obj->bounds, &mvp);
+        if (!obj->visible)
+            culler->stats.vertices_skipped += obj->mesh->vertex_count;
+    }
+}
+
+/* **************************** UPDATE ****************************** */
+
+void scene_update(Scene* scene, const Camera cam, const Projection proj, JobSystem* jobs) {
+    for (int i = 0; i < scene->count; i++) {
+        scene->objects[i].visible = 1;
+        scene->objects[i].occluding = 0;
+    }
+
+    if (scene->culler) {
+        Matrix view_proj = multiply(projection_matrix(proj), view_matrix(cam));
+        occlusion_pass(scene, cam, &view_proj);
+    }
+
+    for (int i = 0; i < scene->count; i++) {
+        Object* obj = &scene->objects[i];
+        if (!obj->visible) continue;
+
+        if (obj->draw.shading != SHADE_WIREFRAME && scene->lighting && obj->mesh->normals)
+            update_mesh_lit(obj->mesh, obj->draw.clipped_mesh, obj->draw.vertex_colors, color_to_argb(obj->draw.color),
+                            obj->transform, cam, proj, scene->lighting);
+        else
+            update_mesh(obj->mesh, obj->draw.clipped_mesh, obj->transform, cam, proj);
+
+        // SDL has no depth test: filled SDL draws are painted far to near, like translucent surfaces
+        int filled_sdl = obj->draw.backend == RENDER_SDL && obj->draw.shading != SHADE_WIREFRAME;
+        obj->draw.triangle_order = filled_sdl || (obj->flags & OBJECT_DEPTH_SORT)
+            ? depth_sort_mesh(obj->depth_sort, obj->draw.clipped_mesh, DEPTH_BACK_TO_FRONT, jobs)
+            : NULL;
+    }
+}
+
+void scene_world_bounds(const Scene* scene, Bounds* boxes) {
+    for (int i = 0; i < scene->count; i++)
+        boxes[i] = world_bounds(scene->objects[i].bounds, scene->objects[i].transform);
+}
+
+void scene_destroy(Scene* scene) {
+    for (int i = 0; i < scene->count; i++) {
+        mesh_destroy(scene->objects[i].draw.clipped_mesh);
+        memory_free(MEMORY_SCENE, scene->objects[i].draw.vertex_colors);
+        depth_sort_destroy(scene->objects[i].depth_sort);
+    }
+    memory_free(MEMORY_SCENE, scene->objects);
+    memory_free(MEMORY_SCENE, scene);
+}
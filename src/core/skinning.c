@@ -0,0 +1,266 @@
+#include <string.h>
+
+#include "core/skinning.h"
+#include "core/memory.h"
+#include "core/pipeline.h"
+
+// Smallest number of vertices worth handing to another thread
+#define SKIN_MIN_BATCH 1024
+
+/* **************************** SKELETON ****************************** */
+
+Skeleton* skeleton_create(int joint_count, const int* parents, const Transform* bind_pose) {
+    if (joint_count <= 0 || joint_count > SKIN_MAX_JOINTS) return NULL;
+    for (int j = 0; j < joint_count; j++)
+        if (parents[j] >= j || parents[j] < -1) return NULL;
+
+    Skeleton* skeleton = memory_alloc(MEMORY_SKINNING, sizeof(Skeleton));
+    if (!skeleton) return NULL;
+
+    skeleton->joint_count = joint_count;
+    skeleton->parents = memory_alloc(MEMORY_SKINNING, sizeof(int) * joint_count);
+    skeleton->inverse_bind = memory_alloc(MEMORY_SKINNING, sizeof(Matrix) * joint_count);
+    if (!skeleton->parents || !skeleton->inverse_bind) {
+        skeleton_destroy(skeleton);
+        return NULL;
+    }
+    memcpy(skeleton->parents, parents, sizeof(int) * joint_count);
+
+    // Global bind matrices first, then invert them in place
+    for (int j = 0; j < joint_count; j++) {
+        Matrix local = model_matrix(bind_pose[j]);
+        if (parents[j] < 0)
+            skeleton->inverse_bind[j] = local;
+        else
+            matrix_multiply(&skeleton->inverse_bind[j], &skeleton->inverse_bind[parents[j]], &local);
+    }
+    for (int j = joint_count - 1; j >= 0; j--) {
+        if (!matrix_inverse(&skeleton->inverse_bind[j], &skeleton->inverse_bind[j])) {
+            skeleton_destroy(skeleton);
+            return NULL;
+        }
+    }
+
+    return skeleton;
+}
+
+void skeleton_pose(const Skeleton* skeleton, const Transform* local, Matrix* palette) {
+    // Parents come first, so their global matrix is ready when a child needs it
+    for (int j = 0; j < skeleton->joint_count; j++) {
+        Matrix m = model_matrix(local[j]);
+        int parent = skeleton->parents[j];
+        if (parent < 0)
+            palette[j] = m;
+        else
+            matrix_multiply(&palette[j], &palette[parent], &m);
+    }
+
+    for (int j = 0; j < skeleton->joint_count; j++)
+        matrix_multiply(&palette[j], &palette[j], &skeleton->inverse_bind[j]);
+}
+
+void skeleton_destroy(Skeleton* skeleton) {
+    if (!skeleton) return;
+    memory_free(MEMORY_SKINNING, skeleton->parents);
+    memory_free(MEMORY_SKINNING, skeleton->inverse_bind);
+    memory_free(MEMORY_SKINNING, skeleton);
+}
+
+/* **************************** ANIMATION ****************************** */
+
+AnimationClip* animation_clip_create(int joint_count, int key_count, const float* times, const Transform* poses) {
+    if (joint_count <= 0 || key_count <= 0) return NULL;
+
+    AnimationClip* clip = memory_alloc(MEMORY_SKINNING, sizeof(AnimationClip));
+    if (!clip) return NULL;
+
+    clip->joint_count = joint_count;
+    clip->key_count = key_count;
+    clip->times = memory_alloc(MEMORY_SKINNING, sizeof(float) * key_count);
+    clip->poses = memory_alloc(MEMORY_SKINNING, sizeof(Transform) * key_count * joint_count);
+    if (!clip->times || !clip->poses) {
+        animation_clip_destroy(clip);
+        return NULL;
+    }
+
+    memcpy(clip->times, times, sizeof(float) * key_count);
+    memcpy(clip->poses, poses, sizeof(Transform) * key_count * joint_count);
+    clip->duration = times[key_count - 1];
+
+    return clip;
+}
+
+static inline Vector3 lerp3(Vector3 a, Vector3 b, float t) {
+    return (Vector3){a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t};
+}
+
+void animation_sample(const AnimationClip* clip, float time, Transform* local) {
+    const Transform* first = clip->poses;
+
+    if (clip->key_count == 1 || clip->duration <= 0.0f) {
+        memcpy(local, first, sizeof(Transform) * clip->joint_count);
+        return;
+    }
+
+    time = fmodf(time, clip->duration);
+    if (time < 0.0f) time += clip->duration;
+
+    // Last key whose time is <= time
+    int lo = 0, hi = clip->key_count - 1;
+    while (hi - lo > 1) {
+        int mid = (lo + hi) / 2;
+        if (clip->times[mid] <= time) lo = mid;
+        else hi = mid;
+    }
+
+    float span = clip->times[hi] - clip->times[lo];
+    float t = span > 0.0f ? (time - clip->times[lo]) / span : 0.0f;
+
+    const Transform* a = &clip->poses[lo * clip->joint_count];
+    const Transform* b = &clip->poses[hi * clip->joint_count];
+    for (int j = 0; j < clip->joint_count; j++) {
+        local[j].translation = lerp3(a[j].translation, b[j].translation, t);
+        local[j].rotation = lerp3(a[j].rotation, b[j].rotation, t);
+        local[j].scale = lerp3(a[j].scale, b[j].scale, t);
+    }
+}
+
+void animation_clip_destroy(AnimationClip* clip) {
+    if (!clip) return;
+    memory_free(MEMORY_SKINNING, clip->times);
+    memory_free(MEMORY_SKINNING, clip->poses);
+    memory_free(MEMORY_SKINNING, clip);
+}
+
+/* **************************** SKINNED MESH ****************************** */
+
+SkinnedMesh* skinned_mesh_create(const Mesh* bind, const uint8_t* joints, const float* weights) {
+    SkinnedMesh* skin = memory_alloc(MEMORY_SKINNING, sizeof(SkinnedMesh));
+    if (!skin) return NULL;
+
+    int n = bind->vertex_count;
+    skin->vertex_count = n;
+    skin->joint_count = 0;
+
+    // One block: 3 position streams + the weight streams, then the joint streams
+    size_t float_count = (size_t)n * (3 + SKIN_MAX_INFLUENCES);
+    float* block = memory_alloc(MEMORY_SKINNING, sizeof(float) * float_count + (size_t)n * SKIN_MAX_INFLUENCES + 1);
+    if (!block) {
+        memory_free(MEMORY_SKINNING, skin);
+        return NULL;
+    }
+
+    skin->x = block;
+    skin->y = block + n;
+    skin->z = block + 2 * n;
+    uint8_t* joint_block = (uint8_t*)(block + float_count);
+    for (int k = 0; k < SKIN_MAX_INFLUENCES; k++) {
+        skin->weights[k] = block + (3 + k) * n;
+        skin->joints[k] = joint_block + k * n;
+    }
+
+    for (int i = 0; i < n; i++) {
+        Vector3 p = mesh_position(bind, i);
+        skin->x[i] = p.x;
+        skin->y[i] = p.y;
+        skin->z[i] = p.z;
+
+        float total = 0.0f;
+        for (int k = 0; k < SKIN_MAX_INFLUENCES; k++)
+            total += weights[i * SKIN_MAX_INFLUENCES + k];
+
+        for (int k = 0; k < SKIN_MAX_INFLUENCES; k++) {
+            skin->joints[k][i] = joints[i * SKIN_MAX_INFLUENCES + k];
+            if (skin->joints[k][i] >= skin->joint_count)
+                skin->joint_count = skin->joints[k][i] + 1;
+            skin->weights[k][i] = total > 0.0f ? weights[i * SKIN_MAX_INFLUENCES + k] / total
+                                               : (k == 0 ? 1.0f : 0.0f);
+        }
+    }
+
+    return skin;
+}
+
+void skinned_mesh_destroy(SkinnedMesh* skin) {
+    if (!skin) return;
+    memory_free(MEMORY_SKINNING, skin->x);
+    memory_free(MEMORY_SKINNING, skin);
+}
+
+/* **************************** SKINNING ****************************** */
+
+void skin_vertices_scalar(const SkinnedMesh* skin, const Matrix* palette, Vector4* out) {
+    for (int i = 0; i < skin->vertex_count; i++) {
+        Vector4 p = {skin->x[i], skin->y[i], skin->z[i], 1.0f};
+        Vector4 acc = NULL_VECTOR4;
+
+        for (int k = 0; k < SKIN_MAX_INFLUENCES; k++) {
+            float w = skin->weights[k][i];
+            Vector4 t = matrix_transform_scalar(&palette[skin->joints[k][i]], p);
+            acc.x += w * t.x;
+            acc.y += w * t.y;
+            acc.z += w * t.z;
+            acc.w += w * t.w;
+        }
+
+        out[i] = acc;
+    }
+}
+
+typedef struct SkinJob {
+    const SkinnedMesh* skin;
+    const Matrix* columns;  // transposed palette: m[c] is column c
+    Vector4* out;
+} SkinJob;
+
+// Blends the joint matrices column by column, then transforms the position
+static void skin_range(void* ctx, int start, int end) {
+    const SkinJob* job = ctx;
+    const SkinnedMesh* skin = job->skin;
+
+#if MATH_SIMD
+    for (int i = start; i < end; i++) {
+        f32x4 c0 = f32x4_zero(), c1 = f32x4_zero(), c2 = f32x4_zero(), c3 = f32x4_zero();
+
+        for (int k = 0; k < SKIN_MAX_INFLUENCES; k++) {
+            const Matrix* m = &job->columns[skin->joints[k][i]];
+            f32x4 w = f32x4_set1(skin->weights[k][i]);
+            c0 = f32x4_madd(f32x4_load(m->m[0]), w, c0);
+            c1 = f32x4_madd(f32x4_load(m->m[1]), w, c1);
+            c2 = f32x4_madd(f32x4_load(m->m[2]), w, c2);
+            c3 = f32x4_madd(f32x4_load(m->m[3]), w, c3);
+        }
+
+        f32x4 p = f32x4_madd(c0, f32x4_set1(skin->x[i]), c3);
+        p = f32x4_madd(c1, f32x4_set1(skin->y[i]), p);
+        p = f32x4_madd(c2, f32x4_set1(skin->z[i]), p);
+        f32x4_store(job->out[i].v, p);
+    }
+#else
+    for (int i = start; i < end; i++) {
+        float c[MATRIX_N][MATRIX_N] = {0};
+
+        for (int k = 0; k < SKIN_MAX_INFLUENCES; k++) {
+            const Matrix* m = &job->columns[skin->joints[k][i]];
+            float w = skin->weights[k][i];
+            for (int col = 0; col < MATRIX_N; col++)
+                for (int row = 0; row < MATRIX_N; row++)
+                    c[col][row] += w * m->m[col][row];
+        }
+
+        for (int row = 0; row < MATRIX_N; row++)
+            job->out[i].v[row] = c[0][row] * skin->x[i] + c[1][row] * skin->y[i]
+                               + c[2][row] * skin->z[i] + c[3][row];
+    }
+#endif
+}
+
+void skin_vertices(const SkinnedMesh* skin, const Matrix* palette, Vector4* out, JobSystem* jobs) {
+    // Each vertex may use any joint, so transpose the whole palette once
+    Matrix columns[SKIN_MAX_JOINTS];
+    for (int j = 0; j < skin->joint_count; j++)
+        matrix_transpose(&columns[j], &palette[j]);
+
+    SkinJob job = { .skin = skin, .columns = columns, .out = out };
+    jobs_parallel_for(jobs, skin->vertex_count, SKIN_MIN_BATCH, skin_range, &job);
+}
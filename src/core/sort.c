@@ -0,0 +1,143 @@
+#include <string.h>
+
+#include "core/sort.h"
+
+#define RADIX_BITS 8
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+#define RADIX_PASSES (64 / RADIX_BITS)
+
+SortKey* radix_sort(SortKey* items, SortKey* scratch, int count) {
+    // Histograms of every byte in a single read of the keys
+    int histogram[RADIX_PASSES][RADIX_BUCKETS];
+    memset(histogram, 0, sizeof(histogram));
+    for (int i = 0; i < count; i++) {
+        uint64_t key = items[i].key;
+        for (int p = 0; p < RADIX_PASSES; p++)
+            histogram[p][(key >> (p * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+    }
+
+    SortKey* src = items;
+    SortKey* dst = scratch;
+    for (int p = 0; p < RADIX_PASSES && count > 0; p++) {
+        int shift = p * RADIX_BITS;
+        int* counts = histogram[p];
+
+        // Every key has the same byte here: the pass would not move anything
+        if (counts[(src[0].key >> shift) & (RADIX_BUCKETS - 1)] == count) continue;
+
+        int offset = 0;
+        for (int b = 0; b < RADIX_BUCKETS; b++) {
+            int n = counts[b];
+            counts[b] = offset;
+            offset += n;
+        }
+        for (int i = 0; i < count; i++)
+            dst[counts[(src[i].key >> shift) & (RADIX_BUCKETS - 1)]++] = src[i];
+
+        SortKey* swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    return src;
+}
+
+/* **************************** PARALLEL ****************************** */
+
+/**
+ * @brief Shared state of the passes of radix_sort_parallel
+ *
+ * @field totals Bytes of every chunk for every pass, counted in one read of the keys
+ * @field offsets Bytes of every chunk for the current pass, then where each chunk scatters them
+ */
+typedef struct RadixContext {
+    SortKey* src;
+    SortKey* dst;
+    int count;
+    int chunks;
+    int shift;
+    int totals[RADIX_PARALLEL_CHUNKS][RADIX_PASSES][RADIX_BUCKETS];
+    int offsets[RADIX_PARALLEL_CHUNKS][RADIX_BUCKETS];
+} RadixContext;
+
+static inline int chunk_start(const RadixContext* ctx, int chunk) {
+    return (int)((long long)ctx->count * chunk / ctx->chunks);
+}
+
+static void count_totals(void* data, int start, int end) {
+    RadixContext* ctx = data;
+    for (int c = start; c < end; c++) {
+        int (*histogram)[RADIX_BUCKETS] = ctx->totals[c];
+        memset(histogram, 0, sizeof(ctx->totals[c]));
+        for (int i = chunk_start(ctx, c); i < chunk_start(ctx, c + 1); i++) {
+            uint64_t key = ctx->src[i].key;
+            for (int p = 0; p < RADIX_PASSES; p++)
+                histogram[p][(key >> (p * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+        }
+    }
+}
+
+static void count_pass(void* data, int start, int end) {
+    RadixContext* ctx = data;
+    for (int c = start; c < end; c++) {
+        int* counts = ctx->offsets[c];
+        memset(counts, 0, sizeof(ctx->offsets[c]));
+        for (int i = chunk_start(ctx, c); i < chunk_start(ctx, c + 1); i++)
+            counts[(ctx->src[i].key >> ctx->shift) & (RADIX_BUCKETS - 1)]++;
+    }
+}
+
+static void scatter_pass(void* data, int start, int end) {
+    RadixContext* ctx = data;
+    for (int c = start; c < end; c++) {
+        int* offsets = ctx->offsets[c];
+        for (int i = chunk_start(ctx, c); i < chunk_start(ctx, c + 1); i++)
+            ctx->dst[offsets[(ctx->src[i].key >> ctx->shift) & (RADIX_BUCKETS - 1)]++] = ctx->src[i];
+    }
+}
+
+SortKey* radix_sort_parallel(SortKey* items, SortKey* scratch, int count, JobSystem* jobs) {
+    if (!jobs || jobs->thread_count == 0 || count < RADIX_PARALLEL_MIN) return radix_sort(items, scratch, count);
+
+    RadixContext ctx;
+    ctx.src = items;
+    ctx.dst = scratch;
+    ctx.count = count;
+    ctx.chunks = jobs->thread_count + 1 < RADIX_PARALLEL_CHUNKS ? jobs->thread_count + 1 : RADIX_PARALLEL_CHUNKS;
+    jobs_parallel_for(jobs, ctx.chunks, 1, count_totals, &ctx);
+
+    int first = 1;
+    for (int p = 0; p < RADIX_PASSES; p++) {
+        ctx.shift = p * RADIX_BITS;
+
+        // Same skip test as radix_sort, on the totals of every chunk
+        int bucket = (int)((ctx.src[0].key >> ctx.shift) & (RADIX_BUCKETS - 1)), same = 0;
+        for (int c = 0; c < ctx.chunks; c++)
+            same += ctx.totals[c][p][bucket];
+        if (same == count) continue;
+
+        // The first pass moving anything still sees the chunks as they were counted
+        if (first)
+            for (int c = 0; c < ctx.chunks; c++)
+                memcpy(ctx.offsets[c], ctx.totals[c][p], sizeof(ctx.offsets[c]));
+        else
+            jobs_parallel_for(jobs, ctx.chunks, 1, count_pass, &ctx);
+        first = 0;
+
+        // Bucket by bucket, chunk by chunk: chunk order is kept inside a bucket (stable)
+        int offset = 0;
+        for (int b = 0; b < RADIX_BUCKETS; b++)
+            for (int c = 0; c < ctx.chunks; c++) {
+                int n = ctx.offsets[c][b];
+                ctx.offsets[c][b] = offset;
+                offset += n;
+            }
+        jobs_parallel_for(jobs, ctx.chunks, 1, scatter_pass, &ctx);
+
+        SortKey* swap = ctx.src;
+        ctx.src = ctx.dst;
+        ctx.dst = swap;
+    }
+
+    return ctx.src;
+}
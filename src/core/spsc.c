@@ -0,0 +1,64 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/spsc.h"
+#include "core/memory.h"
+
+SpscQueue* spsc_create(int capacity, int element_size) {
+    if (capacity <= 0 || element_size <= 0 || capacity > (1 << 29)) return NULL;
+
+    // Aligned so the two index lines do not share a cache line with anything else
+    SpscQueue* queue = memory_aligned_alloc(MEMORY_THREADS, SPSC_CACHE_LINE, sizeof(SpscQueue));
+    if (!queue) return NULL;
+    memset(queue, 0, sizeof(SpscQueue));
+
+    int size = 1;
+    while (size < capacity)
+        size <<= 1;
+    queue->capacity = size;
+    queue->mask = size - 1;
+    queue->wrap = 2 * size - 1;
+    queue->element_size = element_size;
+    queue->slots = memory_alloc(MEMORY_THREADS, (size_t)size * element_size);
+    if (!queue->slots) {
+        memory_free(MEMORY_THREADS, queue);
+        return NULL;
+    }
+
+    return queue;
+}
+
+int spsc_push(SpscQueue* queue, const void* element) {
+    int tail = queue->write;
+    if (((tail - queue->cached_head) & queue->wrap) == queue->capacity) {
+        queue->cached_head = SDL_AtomicGet(&queue->head);
+        if (((tail - queue->cached_head) & queue->wrap) == queue->capacity) return 0;
+    }
+
+    memcpy(queue->slots + (size_t)(tail & queue->mask) * queue->element_size, element, queue->element_size);
+    queue->write = (tail + 1) & queue->wrap;
+    SDL_AtomicSet(&queue->tail, queue->write);
+    return 1;
+}
+
+int spsc_pop(SpscQueue* queue, void* element) {
+    int head = queue->read;
+    if (head == queue->cached_tail) {
+        queue->cached_tail = SDL_AtomicGet(&queue->tail);
+        if (head == queue->cached_tail) return 0;
+    }
+
+    memcpy(element, queue->slots + (size_t)(head & queue->mask) * queue->element_size, queue->element_size);
+    queue->read = (head + 1) & queue->wrap;
+    SDL_AtomicSet(&queue->head, queue->read);
+    return 1;
+}
+
+int spsc_count(SpscQueue* queue) {
+    return (SDL_AtomicGet(&queue->tail) - SDL_AtomicGet(&queue->head)) & queue->wrap;
+}
+
+void spsc_destroy(SpscQueue* queue) {
+    memory_free(MEMORY_THREADS, queue->slots);
+    memory_free(MEMORY_THREADS, queue);
+}
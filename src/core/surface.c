@@ -0,0 +1,286 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "core/surface.h"
+#include "core/memory.h"
+
+// Below this clip w a sample is treated as behind the camera
+#define SURFACE_MIN_W 1e-4f
+
+static int clamp_segments(int max_segments) {
+    int segments = 1;
+    while (segments < max_segments && segments < SURFACE_MAX_SEGMENTS)
+        segments <<= 1;
+    return segments;
+}
+
+static Surface surface_base(SurfaceType type, int patches_u, int patches_v, int max_segments) {
+    Surface s;
+    memset(&s, 0, sizeof(s));
+    s.type = type;
+    s.patches_u = patches_u > 0 ? patches_u : 1;
+    s.patches_v = patches_v > 0 ? patches_v : 1;
+    s.max_segments = clamp_segments(max_segments);
+    return s;
+}
+
+Surface surface_sphere(float radius, int patches_u, int patches_v, int max_segments) {
+    Surface s = surface_base(SURFACE_SPHERE, patches_u, patches_v, max_segments);
+    s.radius = radius;
+    s.wrap_u = 1;
+    return s;
+}
+
+Surface surface_torus(float radius, float tube_radius, int patches_u, int patches_v, int max_segments) {
+    Surface s = surface_base(SURFACE_TORUS, patches_u, patches_v, max_segments);
+    s.radius = radius;
+    s.tube_radius = tube_radius;
+    s.wrap_u = 1;
+    s.wrap_v = 1;
+    return s;
+}
+
+Surface surface_bezier(const Vector3 control[16], int patches_u, int patches_v, int max_segments) {
+    Surface s = surface_base(SURFACE_BEZIER, patches_u, patches_v, max_segments);
+    memcpy(s.control, control, sizeof(s.control));
+    return s;
+}
+
+/* **************************** EVALUATION ****************************** */
+
+static inline void bernstein(float t, float b[4]) {
+    float s = 1.0f - t;
+    b[0] = s * s * s;
+    b[1] = 3.0f * t * s * s;
+    b[2] = 3.0f * t * t * s;
+    b[3] = t * t * t;
+}
+
+Vector3 surface_eval(const Surface* surface, float u, float v) {
+    switch (surface->type) {
+        case SURFACE_SPHERE: {
+            float theta = 2.0f * (float)M_PI * u, phi = (float)M_PI * v;
+            float r = surface->radius;
+            return (Vector3){r * sinf(phi) * cosf(theta), r * cosf(phi), r * sinf(phi) * sinf(theta)};
+        }
+        case SURFACE_TORUS: {
+            float theta = 2.0f * (float)M_PI * u, phi = 2.0f * (float)M_PI * v;
+            float ring = surface->radius + surface->tube_radius * cosf(phi);
+            return (Vector3){ring * cosf(theta), surface->tube_radius * sinf(phi), ring * sinf(theta)};
+        }
+        case SURFACE_BEZIER: {
+            float bu[4], bv[4];
+            bernstein(u, bu);
+            bernstein(v, bv);
+            Vector3 p = NULL_VECTOR3;
+            for (int j = 0; j < 4; j++)
+                for (int i = 0; i < 4; i++) {
+                    float w = bu[i] * bv[j];
+                    Vector3 c = surface->control[j * 4 + i];
+                    p.x += w * c.x;
+                    p.y += w * c.y;
+                    p.z += w * c.z;
+                }
+            return p;
+        }
+    }
+    return NULL_VECTOR3;
+}
+
+// Point at an integer lattice position: patch (i, j) spans [i * M, (i + 1) * M]
+static inline Vector4 lattice_point(const Surface* surface, int gu, int gv) {
+    int size_u = surface->patches_u * surface->max_segments;
+    int size_v = surface->patches_v * surface->max_segments;
+    if (surface->wrap_u && gu == size_u) gu = 0;
+    if (surface->wrap_v && gv == size_v) gv = 0;
+
+    Vector3 p = surface_eval(surface, (float)gu / size_u, (float)gv / size_v);
+    return (Vector4){p.x, p.y, p.z, 1.0f};
+}
+
+/* **************************** TESSELLATION ****************************** */
+
+Tessellation* tessellation_create(const Surface* surface) {
+    Tessellation* tess = memory_calloc(MEMORY_SURFACE, 1, sizeof(Tessellation));
+    if (!tess) return NULL;
+
+    int patches = surface->patches_u * surface->patches_v;
+    int m = surface->max_segments;
+    tess->vertex_capacity = patches * (m + 1) * (m + 1);
+    tess->triangle_capacity = patches * m * m * 2;
+
+    tess->mesh = memory_calloc(MEMORY_SURFACE, 1, sizeof(Mesh));
+    tess->levels = memory_alloc(MEMORY_SURFACE, sizeof(int) * patches);
+    if (tess->mesh) {
+        tess->mesh->vertices = memory_alloc(MEMORY_SURFACE, sizeof(Vector4) * tess->vertex_capacity);
+        tess->mesh->triangles = memory_alloc(MEMORY_SURFACE, sizeof(Triangle) * tess->triangle_capacity);
+    }
+    if (!tess->mesh || !tess->levels || !tess->mesh->vertices || !tess->mesh->triangles) {
+        tessellation_destroy(tess);
+        return NULL;
+    }
+
+    return tess;
+}
+
+// Segments of the neighbour across an edge, 0 when there is none
+static int neighbour_level(const Surface* surface, const int* levels, int i, int j) {
+    if (i < 0 || i >= surface->patches_u) {
+        if (!surface->wrap_u) return 0;
+        i = (i + surface->patches_u) % surface->patches_u;
+    }
+    if (j < 0 || j >= surface->patches_v) {
+        if (!surface->wrap_v) return 0;
+        j = (j + surface->patches_v) % surface->patches_v;
+    }
+    return levels[j * surface->patches_u + i];
+}
+
+// Vertex k of an n-segment edge that a coarser neighbour splits in e: on the neighbour's segment
+static Vector4 snapped_point(const Surface* surface, int gu0, int gv0, int du, int dv, int k, int n, int e) {
+    int ratio = n / e;
+    int k0 = k / ratio * ratio;
+    if (k0 == k)
+        return lattice_point(surface, gu0 + k * du, gv0 + k * dv);
+
+    int k1 = k0 + ratio;
+    Vector4 a = lattice_point(surface, gu0 + k0 * du, gv0 + k0 * dv);
+    Vector4 b = lattice_point(surface, gu0 + k1 * du, gv0 + k1 * dv);
+    float t = (float)(k - k0) / ratio;
+    return (Vector4){a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t, 1.0f};
+}
+
+static void build_mesh(const Surface* surface, Tessellation* tess) {
+    Mesh* mesh = tess->mesh;
+    int m = surface->max_segments;
+    int vertex_count = 0, triangle_count = 0;
+
+    for (int j = 0; j < surface->patches_v; j++)
+        for (int i = 0; i < surface->patches_u; i++) {
+            int n = tess->levels[j * surface->patches_u + i];
+            int step = m / n;
+            int gu0 = i * m, gv0 = j * m;
+            int base = vertex_count;
+
+            // Segments of each edge: the coarser of the two patches sharing it
+            int left = neighbour_level(surface, tess->levels, i - 1, j);
+            int right = neighbour_level(surface, tess->levels, i + 1, j);
+            int bottom = neighbour_level(surface, tess->levels, i, j - 1);
+            int top = neighbour_level(surface, tess->levels, i, j + 1);
+
+            for (int b = 0; b <= n; b++)
+                for (int a = 0; a <= n; a++) {
+                    Vector4 p;
+                    if (a == 0 && left > 0 && left < n)
+                        p = snapped_point(surface, gu0, gv0, 0, step, b, n, left);
+                    else if (a == n && right > 0 && right < n)
+                        p = snapped_point(surface, gu0 + m, gv0, 0, step, b, n, right);
+                    else if (b == 0 && bottom > 0 && bottom < n)
+                        p = snapped_point(surface, gu0, gv0, step, 0, a, n, bottom);
+                    else if (b == n && top > 0 && top < n)
+                        p = snapped_point(surface, gu0, gv0 + m, step, 0, a, n, top);
+                    else
+                        p = lattice_point(surface, gu0 + a * step, gv0 + b * step);
+                    mesh->vertices[vertex_count++] = p;
+                }
+
+            for (int b = 0; b < n; b++)
+                for (int a = 0; a < n; a++) {
+                    int q = base + b * (n + 1) + a;
+                    mesh->triangles[triangle_count++] = (Triangle){{q, q + 1, q + n + 1}};
+                    mesh->triangles[triangle_count++] = (Triangle){{q + 1, q + n + 2, q + n + 1}};
+                }
+        }
+
+    mesh->vertex_count = vertex_count;
+    mesh->triangle_count = triangle_count;
+}
+
+// Segments for one patch: projected length of its 3x3 sample grid over target_px
+static int patch_level(const Surface* surface, int i, int j, const Matrix* mvp,
+                       int screen_w, int screen_h, float target_px) {
+    int m = surface->max_segments;
+    float sx[3][3], sy[3][3];
+    int outside[6] = {1, 1, 1, 1, 1, 1};
+    int behind = 0;
+
+    for (int b = 0; b < 3; b++)
+        for (int a = 0; a < 3; a++) {
+            Vector4 c = matrix_transform(mvp, lattice_point(surface, i * m + a * m / 2, j * m + b * m / 2));
+            outside[0] &= c.x < -c.w;
+            outside[1] &= c.x > c.w;
+            outside[2] &= c.y < -c.w;
+            outside[3] &= c.y > c.w;
+            outside[4] &= c.z < -c.w;
+            outside[5] &= c.z > c.w;
+            if (c.w < SURFACE_MIN_W) {
+                behind++;
+                continue;
+            }
+            sx[b][a] = (c.x / c.w + 1.0f) * 0.5f * screen_w;
+            sy[b][a] = (1.0f - c.y / c.w) * 0.5f * screen_h;
+        }
+
+    for (int p = 0; p < 6; p++)
+        if (outside[p]) return 1;
+    // Crossing the camera plane: no reliable projection, stay fine
+    if (behind) return m;
+
+    float length = 0.0f;
+    for (int k = 0; k < 3; k++) {
+        float along_u = 0.0f, along_v = 0.0f;
+        for (int s = 0; s < 2; s++) {
+            along_u += hypotf(sx[k][s + 1] - sx[k][s], sy[k][s + 1] - sy[k][s]);
+            along_v += hypotf(sx[s + 1][k] - sx[s][k], sy[s + 1][k] - sy[s][k]);
+        }
+        length = fmaxf(length, fmaxf(along_u, along_v));
+    }
+
+    int n = 1;
+    while (n < m && n * target_px < length)
+        n <<= 1;
+    return n;
+}
+
+int surface_tessellate(const Surface* surface, Tessellation* tess, Transform transform, Camera cam,
+                       Projection proj, int screen_w, int screen_h, float target_px) {
+    Matrix mvp = multiply(multiply(projection_matrix(proj), view_matrix(cam)), model_matrix(transform));
+
+    if (tess->valid && screen_w == tess->screen_w && screen_h == tess->screen_h &&
+        target_px == tess->target_px && !memcmp(&mvp, &tess->mvp, sizeof(Matrix)))
+        return 0;
+
+    for (int j = 0; j < surface->patches_v; j++)
+        for (int i = 0; i < surface->patches_u; i++)
+            tess->levels[j * surface->patches_u + i] = patch_level(surface, i, j, &mvp, screen_w, screen_h,
+                                                                   target_px > 0.0f ? target_px : 1.0f);
+    build_mesh(surface, tess);
+
+    tess->mvp = mvp;
+    tess->screen_w = screen_w;
+    tess->screen_h = screen_h;
+    tess->target_px = target_px;
+    tess->valid = 1;
+    return 1;
+}
+
+void surface_tessellate_uniform(const Surface* surface, Tessellation* tess, int segments) {
+    int n = clamp_segments(segments);
+    if (n > surface->max_segments) n = surface->max_segments;
+
+    for (int p = 0; p < surface->patches_u * surface->patches_v; p++)
+        tess->levels[p] = n;
+    build_mesh(surface, tess);
+    tess->valid = 0;
+}
+
+void tessellation_destroy(Tessellation* tess) {
+    if (tess->mesh) {
+        memory_free(MEMORY_SURFACE, tess->mesh->vertices);
+        memory_free(MEMORY_SURFACE, tess->mesh->triangles);
+        memory_free(MEMORY_SURFACE, tess->mesh);
+    }
+    memory_free(MEMORY_SURFACE, tess->levels);
+    memory_free(MEMORY_SURFACE, tess);
+}
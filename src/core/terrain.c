@@ -0,0 +1,429 @@
+#include <string.h>
+#include <math.h>
+
+#include "core/terrain.h"
+#include "core/memory.h"
+
+#define TERRAIN_MAGIC "3DTR"
+
+// magic, version, cells, chunks_x, chunks_z, levels, spacing
+#define TERRAIN_HEADER_BYTES (7 * 4)
+
+static inline int level_side(const Terrain* terrain, int level) {
+    return (terrain->cells >> level) + 1;
+}
+
+static inline int resident_index(const Terrain* terrain, int cx, int cz, int level) {
+    return (level * terrain->chunks_z + cz) * terrain->chunks_x + cx;
+}
+
+// Byte offset of a chunk: levels are stored one after the other, chunks row-major
+static long chunk_offset(const Terrain* terrain, int cx, int cz, int level) {
+    long chunks = (long)terrain->chunks_x * terrain->chunks_z;
+    long offset = TERRAIN_HEADER_BYTES;
+    for (int l = 0; l < level; l++)
+        offset += chunks * level_side(terrain, l) * level_side(terrain, l) * (long)sizeof(float);
+    return offset + ((long)cz * terrain->chunks_x + cx) * level_side(terrain, level) * level_side(terrain, level) * (long)sizeof(float);
+}
+
+static int max_levels(int cells) {
+    int levels = 1;
+    while ((cells >> levels) > 0 && levels < TERRAIN_MAX_LEVELS) levels++;
+    return levels;
+}
+
+/* **************************** FILE ****************************** */
+
+int terrain_build_file(const char* path, int cells, int chunks_x, int chunks_z, int levels, float spacing,
+                       TerrainHeightFn height, void* ctx) {
+    if (cells <= 0 || (cells & (cells - 1)) || chunks_x <= 0 || chunks_z <= 0 ||
+        levels <= 0 || levels > max_levels(cells))
+        return 0;
+
+    FILE* file = fopen(path, "wb");
+    if (!file) return 0;
+
+    int32_t header[5] = {TERRAIN_VERSION, cells, chunks_x, chunks_z, levels};
+    int ok = fwrite(TERRAIN_MAGIC, 1, 4, file) == 4 && fwrite(header, sizeof(int32_t), 5, file) == 5 &&
+             fwrite(&spacing, sizeof(float), 1, file) == 1;
+
+    float* samples = memory_alloc(MEMORY_TERRAIN, sizeof(float) * (cells + 1) * (cells + 1));
+    ok &= samples != NULL;
+
+    for (int l = 0; ok && l < levels; l++) {
+        int side = (cells >> l) + 1;
+        for (int cz = 0; ok && cz < chunks_z; cz++)
+            for (int cx = 0; ok && cx < chunks_x; cx++) {
+                for (int j = 0; j < side; j++)
+                    for (int i = 0; i < side; i++)
+                        samples[j * side + i] = height(ctx, cx * cells + (i << l), cz * cells + (j << l));
+                ok = fwrite(samples, sizeof(float), side * side, file) == (size_t)(side * side);
+            }
+    }
+
+    memory_free(MEMORY_TERRAIN, samples);
+    ok &= fclose(file) == 0;
+    return ok;
+}
+
+/* **************************** I/O THREAD ****************************** */
+
+static int io_main(void* data) {
+    Terrain* terrain = data;
+
+    SDL_LockMutex(terrain->lock);
+    for (;;) {
+        while (!terrain->quit && terrain->queue_count == 0)
+            SDL_CondWait(terrain->wake, terrain->lock);
+        if (terrain->quit) break;
+
+        int s = terrain->queue[terrain->queue_head];
+        terrain->queue_head = (terrain->queue_head + 1) % terrain->slot_count;
+        terrain->queue_count--;
+        TerrainChunk* chunk = &terrain->slots[s];
+        int cx = chunk->cx, cz = chunk->cz, level = chunk->level;
+        SDL_UnlockMutex(terrain->lock);
+
+        // A loading slot is never evicted: read without the lock
+        int side = level_side(terrain, level);
+        int ok = fseek(terrain->file, chunk_offset(terrain, cx, cz, level), SEEK_SET) == 0 &&
+                 fread(chunk->heights, sizeof(float), side * side, terrain->file) == (size_t)(side * side);
+
+        SDL_LockMutex(terrain->lock);
+        if (ok) {
+            double ms = (double)((SDL_GetPerformanceCounter() - chunk->requested) * 1000) /
+                        (double)SDL_GetPerformanceFrequency();
+            chunk->state = CHUNK_READY;
+            terrain->stats.loads++;
+            terrain->stats.total_load_ms += ms;
+            if (ms > terrain->stats.max_load_ms) terrain->stats.max_load_ms = ms;
+        } else {
+            terrain->resident[resident_index(terrain, cx, cz, level)] = -1;
+            chunk->state = CHUNK_EMPTY;
+            chunk->cx = chunk->cz = chunk->level = -1;
+            terrain->stats.errors++;
+        }
+    }
+    SDL_UnlockMutex(terrain->lock);
+
+    return 0;
+}
+
+/* **************************** OPEN / CLOSE ****************************** */
+
+// Two triangles per quad of a (side - 1)^2 grid, row-major vertices
+static Triangle* grid_topology(int side) {
+    int quads = side - 1;
+    Triangle* triangles = memory_alloc(MEMORY_TERRAIN, sizeof(Triangle) * quads * quads * 2);
+    if (!triangles) return NULL;
+
+    int t = 0;
+    for (int j = 0; j < quads; j++)
+        for (int i = 0; i < quads; i++) {
+            int q = j * side + i;
+            triangles[t++] = (Triangle){{q, q + side, q + 1}};
+            triangles[t++] = (Triangle){{q + 1, q + side, q + side + 1}};
+        }
+    return triangles;
+}
+
+Terrain* terrain_open(const char* path, int cache_chunks, float view_distance, float lod_distance) {
+    if (cache_chunks <= 0) return NULL;
+
+    FILE* file = fopen(path, "rb");
+    if (!file) return NULL;
+
+    char magic[4];
+    int32_t header[5];
+    float spacing;
+    if (fread(magic, 1, 4, file) != 4 || memcmp(magic, TERRAIN_MAGIC, 4) ||
+        fread(header, sizeof(int32_t), 5, file) != 5 || fread(&spacing, sizeof(float), 1, file) != 1 ||
+        header[0] != TERRAIN_VERSION || header[1] <= 0 || (header[1] & (header[1] - 1)) ||
+        header[2] <= 0 || header[3] <= 0 || header[4] <= 0 || header[4] > max_levels(header[1])) {
+        fclose(file);
+        return NULL;
+    }
+
+    Terrain* terrain = memory_calloc(MEMORY_TERRAIN, 1, sizeof(Terrain));
+    if (!terrain) {
+        fclose(file);
+        return NULL;
+    }
+
+    terrain->file = file;
+    terrain->cells = header[1];
+    terrain->chunks_x = header[2];
+    terrain->chunks_z = header[3];
+    terrain->levels = header[4];
+    terrain->spacing = spacing;
+    terrain->view_distance = view_distance;
+    terrain->lod_distance = lod_distance;
+    terrain->slot_count = cache_chunks;
+
+    int side = level_side(terrain, 0);
+    int resident_count = terrain->chunks_x * terrain->chunks_z * terrain->levels;
+    terrain->slots = memory_calloc(MEMORY_TERRAIN, cache_chunks, sizeof(TerrainChunk));
+    terrain->resident = memory_alloc(MEMORY_TERRAIN, sizeof(int) * resident_count);
+    terrain->queue = memory_alloc(MEMORY_TERRAIN, sizeof(int) * cache_chunks);
+    terrain->visible = memory_alloc(MEMORY_TERRAIN, sizeof(TerrainVisible) * cache_chunks);
+    terrain->vertices = memory_alloc(MEMORY_TERRAIN, sizeof(Vector4) * side * side);
+    terrain->clipped = memory_alloc(MEMORY_TERRAIN, sizeof(Vector4) * side * side);
+    terrain->lock = SDL_CreateMutex();
+    terrain->wake = SDL_CreateCond();
+
+    int ok = terrain->slots && terrain->resident && terrain->queue && terrain->visible &&
+             terrain->vertices && terrain->clipped && terrain->lock && terrain->wake;
+    for (int i = 0; ok && i < cache_chunks; i++) {
+        TerrainChunk* chunk = &terrain->slots[i];
+        chunk->cx = chunk->cz = chunk->level = -1;
+        chunk->heights = memory_alloc(MEMORY_TERRAIN, sizeof(float) * side * side);
+        ok = chunk->heights != NULL;
+    }
+    for (int l = 0; ok && l < terrain->levels; l++) {
+        terrain->topology[l] = grid_topology(level_side(terrain, l));
+        ok = terrain->topology[l] != NULL;
+    }
+    if (!ok) {
+        terrain_close(terrain);
+        return NULL;
+    }
+
+    for (int i = 0; i < resident_count; i++)
+        terrain->resident[i] = -1;
+
+    long grid_w = (long)terrain->chunks_x * terrain->cells + 1;
+    long grid_h = (long)terrain->chunks_z * terrain->cells + 1;
+    terrain->stats.cache_bytes = sizeof(float) * side * side * (size_t)cache_chunks;
+    for (int l = 0; l < terrain->levels; l++) {
+        int quads = level_side(terrain, l) - 1;
+        terrain->stats.topology_bytes += sizeof(Triangle) * quads * quads * 2;
+    }
+    terrain->stats.mesh_bytes = sizeof(Vector4) * grid_w * grid_h +
+                                sizeof(Triangle) * (grid_w - 1) * (grid_h - 1) * 2;
+
+    terrain->io_thread = SDL_CreateThread(io_main, "terrain_io", terrain);
+    if (!terrain->io_thread) {
+        terrain_close(terrain);
+        return NULL;
+    }
+
+    return terrain;
+}
+
+void terrain_close(Terrain* terrain) {
+    if (terrain->io_thread) {
+        SDL_LockMutex(terrain->lock);
+        terrain->quit = 1;
+        SDL_CondSignal(terrain->wake);
+        SDL_UnlockMutex(terrain->lock);
+        SDL_WaitThread(terrain->io_thread, NULL);
+    }
+
+    for (int i = 0; terrain->slots && i < terrain->slot_count; i++)
+        memory_free(MEMORY_TERRAIN, terrain->slots[i].heights);
+    for (int l = 0; l < TERRAIN_MAX_LEVELS; l++)
+        memory_free(MEMORY_TERRAIN, terrain->topology[l]);
+    memory_free(MEMORY_TERRAIN, terrain->slots);
+    memory_free(MEMORY_TERRAIN, terrain->resident);
+    memory_free(MEMORY_TERRAIN, terrain->queue);
+    memory_free(MEMORY_TERRAIN, terrain->visible);
+    memory_free(MEMORY_TERRAIN, terrain->vertices);
+    memory_free(MEMORY_TERRAIN, terrain->clipped);
+    if (terrain->wake) SDL_DestroyCond(terrain->wake);
+    if (terrain->lock) SDL_DestroyMutex(terrain->lock);
+    fclose(terrain->file);
+    memory_free(MEMORY_TERRAIN, terrain);
+}
+
+/* **************************** SELECTION ****************************** */
+
+typedef struct WantedChunk {
+    int cx, cz, level;
+    float distance;
+} WantedChunk;
+
+static inline int chunk_level(const Terrain* terrain, float distance) {
+    int level = 0;
+    while (level + 1 < terrain->levels && distance > terrain->lod_distance * (float)(1 << level))
+        level++;
+    return level;
+}
+
+static int compare_wanted(const void* a, const void* b) {
+    float x = ((const WantedChunk*)a)->distance, y = ((const WantedChunk*)b)->distance;
+    return (x > y) - (x < y);
+}
+
+// Empty slot, else the least recently drawn ready one not used this frame; -1 if none
+static int find_victim(const Terrain* terrain) {
+    int victim = -1;
+    for (int i = 0; i < terrain->slot_count; i++) {
+        const TerrainChunk* chunk = &terrain->slots[i];
+        if (chunk->state == CHUNK_EMPTY) return i;
+        if (chunk->state == CHUNK_READY && chunk->last_used < terrain->frame &&
+            (victim < 0 || chunk->last_used < terrain->slots[victim].last_used))
+            victim = i;
+    }
+    return victim;
+}
+
+// Nearest resident level of a chunk to the wanted one, -1 if none
+static int find_fallback(const Terrain* terrain, int cx, int cz, int level) {
+    for (int d = 1; d < terrain->levels; d++) {
+        int candidates[2] = {level - d, level + d};
+        for (int k = 0; k < 2; k++) {
+            int l = candidates[k];
+            if (l < 0 || l >= terrain->levels) continue;
+            int s = terrain->resident[resident_index(terrain, cx, cz, l)];
+            if (s >= 0 && terrain->slots[s].state == CHUNK_READY) return s;
+        }
+    }
+    return -1;
+}
+
+void terrain_update(Terrain* terrain, Vector3 eye, Arena* scratch) {
+    float chunk_size = terrain->cells * terrain->spacing;
+    // Chunks up to one chunk beyond the view distance are loaded ahead, not drawn
+    float reach = terrain->view_distance + chunk_size;
+    int x0 = (int)floorf((eye.x - reach) / chunk_size);
+    int x1 = (int)floorf((eye.x + reach) / chunk_size);
+    int z0 = (int)floorf((eye.z - reach) / chunk_size);
+    int z1 = (int)floorf((eye.z + reach) / chunk_size);
+    if (x0 < 0) x0 = 0;
+    if (z0 < 0) z0 = 0;
+    if (x1 >= terrain->chunks_x) x1 = terrain->chunks_x - 1;
+    if (z1 >= terrain->chunks_z) z1 = terrain->chunks_z - 1;
+
+    int capacity = x1 >= x0 && z1 >= z0 ? (x1 - x0 + 1) * (z1 - z0 + 1) : 0;
+    size_t wanted_bytes = sizeof(WantedChunk) * (capacity > 0 ? capacity : 1);
+    WantedChunk* wanted = scratch ? arena_alloc(scratch, wanted_bytes) : NULL;
+    int heap = wanted == NULL;
+    if (heap) wanted = memory_alloc(MEMORY_TERRAIN, wanted_bytes);
+    int count = 0;
+
+    for (int cz = z0; wanted && cz <= z1; cz++)
+        for (int cx = x0; cx <= x1; cx++) {
+            // xz distance from the eye to the chunk rectangle
+            float dx = fmaxf(0.0f, fmaxf(cx * chunk_size - eye.x, eye.x - (cx + 1) * chunk_size));
+            float dz = fmaxf(0.0f, fmaxf(cz * chunk_size - eye.z, eye.z - (cz + 1) * chunk_size));
+            float d = sqrtf(dx * dx + dz * dz);
+            if (d <= reach)
+                wanted[count++] = (WantedChunk){cx, cz, chunk_level(terrain, d), d};
+        }
+
+    qsort(wanted, count, sizeof(WantedChunk), compare_wanted);
+    if (count > terrain->slot_count) count = terrain->slot_count;
+
+    TerrainStats* stats = &terrain->stats;
+    stats->visible = stats->fallbacks = stats->missing = stats->requested = 0;
+    terrain->visible_count = 0;
+    terrain->frame++;
+
+    // Held only for bookkeeping: the I/O thread reads without it
+    SDL_LockMutex(terrain->lock);
+    Uint64 now = SDL_GetPerformanceCounter();
+
+    // Chunks already in place are protected from eviction by this frame's requests
+    for (int w = 0; w < count; w++) {
+        int s = terrain->resident[resident_index(terrain, wanted[w].cx, wanted[w].cz, wanted[w].level)];
+        if (s >= 0) terrain->slots[s].last_used = terrain->frame;
+    }
+
+    for (int w = 0; w < count; w++) {
+        const WantedChunk* c = &wanted[w];
+        int* entry = &terrain->resident[resident_index(terrain, c->cx, c->cz, c->level)];
+
+        if (*entry < 0) {
+            int s = find_victim(terrain);
+            if (s >= 0) {
+                TerrainChunk* chunk = &terrain->slots[s];
+                if (chunk->state == CHUNK_READY) {
+                    terrain->resident[resident_index(terrain, chunk->cx, chunk->cz, chunk->level)] = -1;
+                    stats->evictions++;
+                }
+                *chunk = (TerrainChunk){c->cx, c->cz, c->level, CHUNK_LOADING, chunk->heights, terrain->frame, now};
+                *entry = s;
+
+                terrain->queue[(terrain->queue_head + terrain->queue_count) % terrain->slot_count] = s;
+                terrain->queue_count++;
+                stats->requested++;
+            }
+        }
+
+        if (c->distance > terrain->view_distance) continue;
+
+        int s = *entry;
+        if (s >= 0 && terrain->slots[s].state == CHUNK_READY) {
+            terrain->slots[s].last_used = terrain->frame;
+        } else {
+            s = find_fallback(terrain, c->cx, c->cz, c->level);
+            if (s < 0) {
+                stats->missing++;
+                continue;
+            }
+            terrain->slots[s].last_used = terrain->frame;
+            stats->fallbacks++;
+        }
+
+        terrain->visible[terrain->visible_count++] = (TerrainVisible){s, c->level, c->distance};
+    }
+
+    if (stats->requested > 0) SDL_CondSignal(terrain->wake);
+    SDL_UnlockMutex(terrain->lock);
+
+    stats->visible = terrain->visible_count;
+    stats->frames++;
+    if (stats->missing > 0) stats->hitches++;
+    if (heap) memory_free(MEMORY_TERRAIN, wanted);
+}
+
+/* **************************** RENDER ****************************** */
+
+void terrain_render(Terrain* terrain, Framebuffer* fb, Camera cam, Projection proj, Color color) {
+    terrain->stats.vertices = terrain->stats.triangles = 0;
+
+    for (int v = 0; v < terrain->visible_count; v++) {
+        // Ready slots only change in terrain_update, on this thread
+        const TerrainChunk* chunk = &terrain->slots[terrain->visible[v].slot];
+        int side = level_side(terrain, chunk->level);
+        float step = (float)(1 << chunk->level) * terrain->spacing;
+        float x0 = chunk->cx * terrain->cells * terrain->spacing;
+        float z0 = chunk->cz * terrain->cells * terrain->spacing;
+
+        for (int j = 0; j < side; j++)
+            for (int i = 0; i < side; i++)
+                terrain->vertices[j * side + i] = (Vector4){x0 + i * step, chunk->heights[j * side + i], z0 + j * step, 1.0f};
+
+        int quads = side - 1;
+        Mesh source = {
+            .vertices = terrain->vertices, .vertex_count = side * side,
+            .triangles = terrain->topology[chunk->level], .triangle_count = quads * quads * 2
+        };
+        Mesh clipped = source;
+        clipped.vertices = terrain->clipped;
+
+        update_mesh(&source, &clipped, NO_TRANSFORM, cam, proj);
+        terrain->stats.vertices += source.vertex_count;
+        terrain->stats.triangles += source.triangle_count;
+
+        Draw draw = {
+            .clipped_mesh = &clipped,
+            .color = color,
+            .backend = RENDER_SOFTWARE,
+            .shading = SHADE_WIREFRAME
+        };
+        draw_mesh_software(fb, &draw);
+    }
+}
+
+const float* terrain_chunk_heights(Terrain* terrain, int cx, int cz, int level) {
+    if (cx < 0 || cz < 0 || cx >= terrain->chunks_x || cz >= terrain->chunks_z || level < 0 || level >= terrain->levels)
+        return NULL;
+
+    SDL_LockMutex(terrain->lock);
+    int s = terrain->resident[resident_index(terrain, cx, cz, level)];
+    int ready = s >= 0 && terrain->slots[s].state == CHUNK_READY;
+    SDL_UnlockMutex(terrain->lock);
+
+    return ready ? terrain->slots[s].heights : NULL;
+}
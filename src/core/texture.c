@@ -0,0 +1,314 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/texture.h"
+#include "core/memory.h"
+#include "math/simd.h"
+
+// log2 of a power of two, -1 otherwise
+static int log2_exact(int n) {
+    if (n <= 0 || (n & (n - 1))) return -1;
+
+    int l = 0;
+    while ((1 << l) < n) l++;
+    return l;
+}
+
+/* **************************** LAYOUTS ****************************** */
+
+// Moves bit i of the low 16 bits to bit 2i
+static inline uint32_t spread_bits(uint32_t x) {
+    x &= 0x0000FFFFu;
+    x = (x | (x << 8)) & 0x00FF00FFu;
+    x = (x | (x << 4)) & 0x0F0F0F0Fu;
+    x = (x | (x << 2)) & 0x33333333u;
+    x = (x | (x << 1)) & 0x55555555u;
+    return x;
+}
+
+// Index of texel (x, y) in a level, x and y already wrapped
+static inline uint32_t texel_offset(TextureLayout layout, const TextureLevel* l, uint32_t x, uint32_t y) {
+    int lw = l->log2_width, lh = l->log2_height;
+
+    if (layout == TEXTURE_TILED) {
+        // 4x4 tiles (narrower on levels smaller than 4 texels)
+        int tw = lw < 2 ? lw : 2, th = lh < 2 ? lh : 2;
+        uint32_t tile = ((y >> th) << (lw - tw)) | (x >> tw);
+        return (tile << (tw + th)) | ((y & ((1u << th) - 1)) << tw) | (x & ((1u << tw) - 1));
+    }
+
+    if (layout == TEXTURE_MORTON) {
+        // Interleave the bits both axes have, the extra bits of the longer axis go on top
+        int s = lw < lh ? lw : lh;
+        uint32_t mask = (1u << s) - 1;
+        uint32_t low = spread_bits(x & mask) | (spread_bits(y & mask) << 1);
+        return low | (((x | y) >> s) << (2 * s));
+    }
+
+    return (y << lw) | x;
+}
+
+static inline uint32_t level_fetch(TextureLayout layout, const TextureLevel* l, int x, int y) {
+    uint32_t tx = (uint32_t)x & (uint32_t)(l->width - 1);
+    uint32_t ty = (uint32_t)y & (uint32_t)(l->height - 1);
+    return l->texels[texel_offset(layout, l, tx, ty)];
+}
+
+/* **************************** CREATION ****************************** */
+
+// Rounded per-channel average of four ARGB texels
+static inline uint32_t average_argb(uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
+    uint32_t out = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        uint32_t sum = ((a >> shift) & 0xFF) + ((b >> shift) & 0xFF) +
+                       ((c >> shift) & 0xFF) + ((d >> shift) & 0xFF) + 2;
+        out |= (sum >> 2) << shift;
+    }
+    return out;
+}
+
+// 2x2 box filter of a row-major level; a side of 1 texel is reused
+static void downsample(const uint32_t* src, int sw, int sh, uint32_t* dst, int dw, int dh) {
+    for (int y = 0; y < dh; y++) {
+        int y0 = 2 * y, y1 = sh > 1 ? 2 * y + 1 : 2 * y;
+        for (int x = 0; x < dw; x++) {
+            int x0 = 2 * x, x1 = sw > 1 ? 2 * x + 1 : 2 * x;
+            dst[y * dw + x] = average_argb(src[y0 * sw + x0], src[y0 * sw + x1],
+                                           src[y1 * sw + x0], src[y1 * sw + x1]);
+        }
+    }
+}
+
+Texture* texture_create(const uint32_t* argb, int width, int height, TextureLayout layout) {
+    int lw = log2_exact(width), lh = log2_exact(height);
+    if (lw < 0 || lh < 0 || lw >= TEXTURE_MAX_LEVELS || lh >= TEXTURE_MAX_LEVELS) return NULL;
+
+    Texture* tex = memory_alloc(MEMORY_TEXTURE, sizeof(Texture));
+    if (!tex) return NULL;
+
+    tex->layout = layout;
+    tex->level_count = (lw > lh ? lw : lh) + 1;
+
+    size_t total = 0;
+    for (int i = 0; i < tex->level_count; i++) {
+        TextureLevel* l = &tex->levels[i];
+        l->log2_width = lw > i ? lw - i : 0;
+        l->log2_height = lh > i ? lh - i : 0;
+        l->width = 1 << l->log2_width;
+        l->height = 1 << l->log2_height;
+        total += (size_t)l->width * l->height;
+    }
+
+    size_t texels = (size_t)width * height;
+    tex->storage = memory_alloc(MEMORY_TEXTURE, sizeof(uint32_t) * total);
+    uint32_t* current = memory_alloc(MEMORY_TEXTURE, sizeof(uint32_t) * texels);
+    uint32_t* next = memory_alloc(MEMORY_TEXTURE, sizeof(uint32_t) * texels);
+    if (!tex->storage || !current || !next) {
+        memory_free(MEMORY_TEXTURE, current);
+        memory_free(MEMORY_TEXTURE, next);
+        memory_free(MEMORY_TEXTURE, tex->storage);
+        memory_free(MEMORY_TEXTURE, tex);
+        return NULL;
+    }
+    memcpy(current, argb, sizeof(uint32_t) * texels);
+
+    // Filter in row-major order, then scatter each level to the texture layout
+    uint32_t* dst = tex->storage;
+    for (int i = 0; i < tex->level_count; i++) {
+        TextureLevel* l = &tex->levels[i];
+        l->texels = dst;
+        dst += (size_t)l->width * l->height;
+
+        for (int y = 0; y < l->height; y++)
+            for (int x = 0; x < l->width; x++)
+                l->texels[texel_offset(layout, l, x, y)] = current[y * l->width + x];
+
+        if (i + 1 < tex->level_count) {
+            const TextureLevel* n = &tex->levels[i + 1];
+            downsample(current, l->width, l->height, next, n->width, n->height);
+            uint32_t* swap = current;
+            current = next;
+            next = swap;
+        }
+    }
+
+    memory_free(MEMORY_TEXTURE, current);
+    memory_free(MEMORY_TEXTURE, next);
+    return tex;
+}
+
+uint32_t texture_fetch(const Texture* tex, int level, int x, int y) {
+    return level_fetch(tex->layout, &tex->levels[level], x, y);
+}
+
+int texture_select_level(const Texture* tex, float dudx, float dvdx, float dudy, float dvdy) {
+    const TextureLevel* base = &tex->levels[0];
+    float ux = dudx * base->width, vx = dvdx * base->height;
+    float uy = dudy * base->width, vy = dvdy * base->height;
+    float rho2 = fmaxf(ux * ux + vx * vx, uy * uy + vy * vy);
+
+    if (!(rho2 > 1.0f)) return 0; // magnified (or NaN)
+
+    int level = (int)(0.5f * log2f(rho2)); // log2(rho)
+    return level < tex->level_count - 1 ? level : tex->level_count - 1;
+}
+
+/* **************************** SAMPLING ****************************** */
+
+static inline float channel(uint32_t c, int shift) {
+    return (float)((c >> shift) & 0xFF);
+}
+
+void texture_sample_scalar(const Texture* tex, const float* u, const float* v, int count, int level,
+                           TextureFilter filter, uint32_t* out) {
+    const TextureLevel* l = &tex->levels[level];
+
+    for (int i = 0; i < count; i++) {
+        float x = u[i] * l->width, y = v[i] * l->height;
+
+        if (filter == TEXTURE_NEAREST) {
+            out[i] = level_fetch(tex->layout, l, (int)floorf(x), (int)floorf(y));
+            continue;
+        }
+
+        // The four texel centers around (x, y)
+        x -= 0.5f;
+        y -= 0.5f;
+        float fx = floorf(x), fy = floorf(y);
+        float ax = x - fx, ay = y - fy;
+        int x0 = (int)fx, y0 = (int)fy;
+
+        uint32_t c00 = level_fetch(tex->layout, l, x0, y0), c10 = level_fetch(tex->layout, l, x0 + 1, y0);
+        uint32_t c01 = level_fetch(tex->layout, l, x0, y0 + 1), c11 = level_fetch(tex->layout, l, x0 + 1, y0 + 1);
+
+        uint32_t px = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            float top = (channel(c10, shift) - channel(c00, shift)) * ax + channel(c00, shift);
+            float bottom = (channel(c11, shift) - channel(c01, shift)) * ax + channel(c01, shift);
+            float value = (bottom - top) * ay + top;
+            px |= (uint32_t)(value + 0.5f) << shift;
+        }
+        out[i] = px;
+    }
+}
+
+#if MATH_SIMD
+
+static inline i32x4 spread_bits4(i32x4 x) {
+    x = i32x4_and(x, i32x4_set1(0x0000FFFF));
+    x = i32x4_and(i32x4_or(x, i32x4_shl(x, 8)), i32x4_set1(0x00FF00FF));
+    x = i32x4_and(i32x4_or(x, i32x4_shl(x, 4)), i32x4_set1(0x0F0F0F0F));
+    x = i32x4_and(i32x4_or(x, i32x4_shl(x, 2)), i32x4_set1(0x33333333));
+    x = i32x4_and(i32x4_or(x, i32x4_shl(x, 1)), i32x4_set1(0x55555555));
+    return x;
+}
+
+// texel_offset for 4 lanes
+static inline i32x4 texel_offset4(TextureLayout layout, const TextureLevel* l, i32x4 x, i32x4 y) {
+    int lw = l->log2_width, lh = l->log2_height;
+
+    if (layout == TEXTURE_TILED) {
+        int tw = lw < 2 ? lw : 2, th = lh < 2 ? lh : 2;
+        i32x4 tile = i32x4_or(i32x4_shl(i32x4_shr(y, th), lw - tw), i32x4_shr(x, tw));
+        i32x4 inner = i32x4_or(i32x4_shl(i32x4_and(y, i32x4_set1((1 << th) - 1)), tw),
+                               i32x4_and(x, i32x4_set1((1 << tw) - 1)));
+        return i32x4_or(i32x4_shl(tile, tw + th), inner);
+    }
+
+    if (layout == TEXTURE_MORTON) {
+        int s = lw < lh ? lw : lh;
+        i32x4 mask = i32x4_set1((1 << s) - 1);
+        i32x4 low = i32x4_or(spread_bits4(i32x4_and(x, mask)), i32x4_shl(spread_bits4(i32x4_and(y, mask)), 1));
+        return i32x4_or(low, i32x4_shl(i32x4_shr(i32x4_or(x, y), s), 2 * s));
+    }
+
+    return i32x4_or(i32x4_shl(y, lw), x);
+}
+
+// No gather instruction on SSE2 / NEON: four scalar loads
+static inline i32x4 gather4(const uint32_t* texels, i32x4 offsets) {
+    int32_t idx[4];
+    i32x4_storeu(idx, offsets);
+    uint32_t t[4] = {texels[idx[0]], texels[idx[1]], texels[idx[2]], texels[idx[3]]};
+    return i32x4_loadu(t);
+}
+
+static inline f32x4 channel4(i32x4 texels, int shift) {
+    return i32x4_to_f32x4(i32x4_and(i32x4_shr(texels, shift), i32x4_set1(0xFF)));
+}
+
+static void sample4(TextureLayout layout, const TextureLevel* l, f32x4 u, f32x4 v,
+                    TextureFilter filter, uint32_t* out) {
+    i32x4 wmask = i32x4_set1(l->width - 1), hmask = i32x4_set1(l->height - 1);
+    f32x4 x = f32x4_mul(u, f32x4_set1((float)l->width));
+    f32x4 y = f32x4_mul(v, f32x4_set1((float)l->height));
+
+    if (filter == TEXTURE_NEAREST) {
+        i32x4 tx = i32x4_and(f32x4_floor_i32x4(x), wmask);
+        i32x4 ty = i32x4_and(f32x4_floor_i32x4(y), hmask);
+        i32x4_storeu(out, gather4(l->texels, texel_offset4(layout, l, tx, ty)));
+        return;
+    }
+
+    f32x4 half = f32x4_set1(0.5f);
+    x = f32x4_sub(x, half);
+    y = f32x4_sub(y, half);
+    i32x4 x0 = f32x4_floor_i32x4(x), y0 = f32x4_floor_i32x4(y);
+    f32x4 ax = f32x4_sub(x, i32x4_to_f32x4(x0)), ay = f32x4_sub(y, i32x4_to_f32x4(y0));
+
+    i32x4 one = i32x4_set1(1);
+    i32x4 x1 = i32x4_and(i32x4_add(x0, one), wmask), y1 = i32x4_and(i32x4_add(y0, one), hmask);
+    x0 = i32x4_and(x0, wmask);
+    y0 = i32x4_and(y0, hmask);
+
+    i32x4 c00 = gather4(l->texels, texel_offset4(layout, l, x0, y0));
+    i32x4 c10 = gather4(l->texels, texel_offset4(layout, l, x1, y0));
+    i32x4 c01 = gather4(l->texels, texel_offset4(layout, l, x0, y1));
+    i32x4 c11 = gather4(l->texels, texel_offset4(layout, l, x1, y1));
+
+    // One channel of the four samples per iteration
+    i32x4 px = i32x4_set1(0);
+    for (int shift = 0; shift < 32; shift += 8) {
+        f32x4 a = channel4(c00, shift), b = channel4(c10, shift);
+        f32x4 c = channel4(c01, shift), d = channel4(c11, shift);
+        f32x4 top = f32x4_madd(f32x4_sub(b, a), ax, a);
+        f32x4 bottom = f32x4_madd(f32x4_sub(d, c), ax, c);
+        f32x4 value = f32x4_madd(f32x4_sub(bottom, top), ay, top);
+        px = i32x4_or(px, i32x4_shl(f32x4_to_i32x4(f32x4_add(value, half)), shift));
+    }
+    i32x4_storeu(out, px);
+}
+
+#endif
+
+void texture_sample(const Texture* tex, const float* u, const float* v, int count, int level,
+                    TextureFilter filter, uint32_t* out) {
+#if MATH_SIMD
+    const TextureLevel* l = &tex->levels[level];
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+        sample4(tex->layout, l, f32x4_loadu(&u[i]), f32x4_loadu(&v[i]), filter, &out[i]);
+
+    // Tail, padded with (0, 0)
+    if (i < count) {
+        float tu[4] = {0}, tv[4] = {0};
+        uint32_t texels[4];
+        for (int j = 0; j < count - i; j++) {
+            tu[j] = u[i + j];
+            tv[j] = v[i + j];
+        }
+        sample4(tex->layout, l, f32x4_loadu(tu), f32x4_loadu(tv), filter, texels);
+        for (int j = 0; j < count - i; j++)
+            out[i + j] = texels[j];
+    }
+#else
+    texture_sample_scalar(tex, u, v, count, level, filter, out);
+#endif
+}
+
+void texture_destroy(Texture* tex) {
+    if (tex->storage) memory_free(MEMORY_TEXTURE, tex->storage);
+    memory_free(MEMORY_TEXTURE, tex);
+}
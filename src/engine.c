@@ -1,37 +1,92 @@
 #include "engine.h"
+#include "core/memory.h"
 
 #define FOV (M_PI / 3)
 #define NEAR_PLANE 0.1f
 #define FAR_PLANE 100.0f
 
+#define AMBIENT 0.15f
+#define KEY_LIGHT_DIRECTION (Vector3){0.3f, -0.5f, -1.0f}
+
+// Initial draws per frame, the queue grows with the scene
+#define RENDER_QUEUE_CAPACITY 256
+
+// Per-frame scratch memory (terrain chunk requests)
+#define ENGINE_SCRATCH_BYTES (256 << 10)
+
 Engine* engine_init(const char* title, const int w, const int h, Color background) {
-    Engine* engine = malloc(sizeof(Engine));
+    // Zeroed: engine_destroy releases whatever was created when a step fails
+    Engine* engine = memory_calloc(MEMORY_ENGINE, 1, sizeof(Engine));
     if (!engine) return NULL;
 
-    engine->draw = malloc(sizeof(Draw));
-    if (!engine->draw) return NULL;
+    engine->draw = memory_calloc(MEMORY_ENGINE, 1, sizeof(Draw));
+    if (!engine->draw) {
+        memory_free(MEMORY_ENGINE, engine);
+        return NULL;
+    }
 
     engine->background = background;
     engine->screen_w = w;
     engine->screen_h = h;
+
+    engine->projection = (Projection){
+        .fov          = FOV,
+        .aspect_ratio = engine->screen_w / engine->screen_h,
+        .near         = NEAR_PLANE,
+        .far          = FAR_PLANE
+    };
+
+    engine->lighting = (Lighting){ .ambient = {AMBIENT, AMBIENT, AMBIENT} };
+    lighting_add(&engine->lighting, (Light){
+        .type = LIGHT_DIRECTIONAL,
+        .direction = KEY_LIGHT_DIRECTION,
+        .color = {1.0f, 1.0f, 1.0f}
+    });
     
     if (SDL_Init(SDL_INIT_VIDEO) != 0) {
         printf("SDL_Init Error: %s\n", SDL_GetError());
+        engine_destroy(engine);
         return NULL;
     }
 
     engine->window = SDL_CreateWindow(title, 0, 0, w, h, SDL_WINDOW_SHOWN);
     if (engine->window == NULL) {
         printf("SDL_CreateWindow Error: %s\n", SDL_GetError());
-        SDL_Quit();
+        engine_destroy(engine);
         return NULL;
     }
 
     engine->sdl_renderer = SDL_CreateRenderer(engine->window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
     if (engine->sdl_renderer == NULL) {
-        SDL_DestroyWindow(engine->window);
         printf("SDL_CreateRenderer Error: %s\n", SDL_GetError());
-        SDL_Quit();
+        engine_destroy(engine);
+        return NULL;
+    }
+
+    engine->framebuffer = framebuffer_create(w, h);
+    engine->framebuffer_texture = SDL_CreateTexture(engine->sdl_renderer, SDL_PIXELFORMAT_ARGB8888,
+                                                    SDL_TEXTUREACCESS_STREAMING, w, h);
+    if (engine->framebuffer == NULL || engine->framebuffer_texture == NULL) {
+        printf("Framebuffer Error: %s\n", SDL_GetError());
+        engine_destroy(engine);
+        return NULL;
+    }
+
+    engine->resolution_stats = (ResolutionStats){ .scale = 1.0f, .width = w, .height = h };
+
+    engine->jobs = jobs_create(-1);
+    if (engine->jobs == NULL) {
+        printf("Job system Error: %s\n", SDL_GetError());
+        engine_destroy(engine);
+        return NULL;
+    }
+
+    engine->render_queue = render_queue_create(RENDER_QUEUE_CAPACITY);
+    engine->scratch = arena_create(ENGINE_SCRATCH_BYTES);
+    engine->stats = frame_stats_create(FRAME_STATS_WINDOW);
+    if (engine->render_queue == NULL || engine->scratch == NULL || engine->stats == NULL) {
+        printf("Frame memory Error: out of memory\n");
+        engine_destroy(engine);
         return NULL;
     }
 
@@ -40,39 +95,225 @@ Engine* engine_init(const char* title, const int w, const int h, Color backgroun
 
 void draw_init(Engine* engine, const Mesh* mesh, Color color, Camera cam) {
     engine->figure = mesh;
-    engine->draw->clipped_mesh = mesh_copy(mesh);
+    engine->draw->clipped_mesh = mesh_create_clipped(mesh);
     engine->draw->color = color;
-    
-    engine->projection = (Projection){
-        .fov          = FOV,
-        .aspect_ratio = engine->screen_w / engine->screen_h,
-        .near         = NEAR_PLANE,
-        .far          = FAR_PLANE
-    };
+    engine->draw->backend = RENDER_SDL;
+    engine->draw->shading = SHADE_WIREFRAME;
+    engine->draw->texture = NULL;
+    engine->draw->filter = TEXTURE_BILINEAR;
+
+    // Shading needs normals and a color per vertex
+    if (!engine->figure->normals)
+        mesh_compute_normals(engine->figure, engine->jobs);
+    engine->draw->vertex_colors = memory_alloc(MEMORY_ENGINE, sizeof(uint32_t) * mesh->vertex_count);
+    if (engine->draw->vertex_colors)
+        for (int i = 0; i < mesh->vertex_count; i++)
+            engine->draw->vertex_colors[i] = color_to_argb(color);
 
     engine->camera = cam;
 }
 
+/* **************************** FRAME ****************************** */
+
+// Everything from here to end_frame is counted by memory_stats (and must not allocate in strict mode)
+// and by engine->stats, starting with the update stage
+static void start_frame(Engine* engine) {
+    arena_reset(engine->scratch);
+    memory_frame_begin();
+    frame_stats_begin(engine->stats);
+    engine->framebuffer->pixels_drawn = 0;
+}
+
+// Internal render rectangle of the frame, bound as the SDL target with dynamic resolution
+static SDL_Rect begin_frame(Engine* engine) {
+    SDL_Rect view = {0, 0, engine->screen_w, engine->screen_h};
+
+    if (engine->dynamic_resolution) {
+        resolution_size(&engine->resolution, engine->screen_w, engine->screen_h, &view.w, &view.h);
+        SDL_SetRenderTarget(engine->sdl_renderer, engine->render_target);
+    }
+    framebuffer_resize(engine->framebuffer, view.w, view.h);
+
+    return view;
+}
+
+// Tiles resolved straight into the locked texture, then one SDL_RenderCopy for the whole frame
+static void present_framebuffer(Engine* engine, SDL_Rect view) {
+    void* pixels;
+    int pitch;
+
+    if (SDL_LockTexture(engine->framebuffer_texture, &view, &pixels, &pitch) == 0) {
+        framebuffer_resolve_to(engine->framebuffer, pixels, pitch / (int)sizeof(uint32_t), view.w, view.h);
+        SDL_UnlockTexture(engine->framebuffer_texture);
+    }
+    SDL_RenderCopy(engine->sdl_renderer, engine->framebuffer_texture, &view,
+                   engine->dynamic_resolution ? &view : NULL);
+}
+
+// Upscales the internal frame into the window in one blit, then adapts the scale
+static void end_frame(Engine* engine, SDL_Rect view) {
+    EngineFrameStats* stats = engine->stats;
+    float raster_ms = (float)frame_stats_stage(stats, FRAME_RASTER_MS);
+    float scale = (float)view.w / engine->screen_w;
+
+    if (engine->dynamic_resolution) {
+        SDL_SetRenderTarget(engine->sdl_renderer, NULL);
+        SDL_RenderCopy(engine->sdl_renderer, engine->render_target, &view, NULL);
+        resolution_update(&engine->resolution, raster_ms);
+    }
+
+    engine->resolution_stats = (ResolutionStats){
+        .scale = scale,
+        .width = view.w,
+        .height = view.h,
+        .raster_ms = raster_ms,
+        .saved_ms = raster_ms / (scale * scale) - raster_ms
+    };
+
+    SDL_RenderPresent(engine->sdl_renderer);
+    frame_stats_stage(stats, FRAME_PRESENT_MS);
+    memory_frame_end();
+
+    frame_stats_add_frame(stats, engine->framebuffer->pixels_drawn);
+    frame_stats_end(stats);
+}
+
+int engine_set_dynamic_resolution(Engine* engine, float target_ms, float min_scale, float max_scale) {
+    if (target_ms <= 0.0f) {
+        engine->dynamic_resolution = 0;
+        return 1;
+    }
+
+    if (!engine->render_target) {
+        engine->render_target = SDL_CreateTexture(engine->sdl_renderer, SDL_PIXELFORMAT_ARGB8888,
+                                                  SDL_TEXTUREACCESS_TARGET, engine->screen_w, engine->screen_h);
+        if (!engine->render_target) return 0;
+    }
+
+    engine->resolution = resolution_controller(target_ms, min_scale, max_scale);
+    engine->dynamic_resolution = 1;
+    return 1;
+}
+
 void update_step(Engine* engine, Transform draw_transform) {
+    if (engine->commands) command_drain(engine->commands, NULL, &engine->camera);
+    start_frame(engine);
+
+    Draw* draw = engine->draw;
+    int lit = draw->shading != SHADE_WIREFRAME && draw->vertex_colors && engine->figure->normals;
+
+    if (lit)
+        update_mesh_lit(engine->figure, draw->clipped_mesh, draw->vertex_colors, color_to_argb(draw->color),
+                        draw_transform, engine->camera, engine->projection, &engine->lighting);
+    else
+        update_mesh(engine->figure, draw->clipped_mesh, draw_transform, engine->camera, engine->projection);
+    frame_stats_add_draw(engine->stats, draw, engine->figure->vertex_count);
+
+    frame_stats_stage(engine->stats, FRAME_UPDATE_MS);
+    SDL_Rect view = begin_frame(engine);
+
+    if (engine->draw->backend == RENDER_SOFTWARE) {
+        framebuffer_clear(engine->framebuffer, color_to_argb(engine->background));
+        if (draw->shading != SHADE_WIREFRAME) framebuffer_clear_depth(engine->framebuffer);
+        draw_mesh_software(engine->framebuffer, engine->draw);
+        present_framebuffer(engine, view);
+        end_frame(engine, view);
+        return;
+    }
+
     SDL_SetRenderDrawColor(engine->sdl_renderer, 
         engine->background.r, engine->background.g, engine->background.b, engine->background.a); // background color
     SDL_RenderClear(engine->sdl_renderer);
-    SDL_SetRenderDrawColor(engine->sdl_renderer, 
-        engine->draw->color.r, engine->draw->color.g, engine->draw->color.b, engine->draw->color.a); // draw color
 
-    update_mesh(engine->figure, engine->draw->clipped_mesh, draw_transform, engine->camera, engine->projection);
-    draw_mesh(engine->sdl_renderer, engine->draw, engine->screen_w, engine->screen_h);
+    draw_mesh(engine->sdl_renderer, engine->draw, view.w, view.h); // sets the draw color
     
-    SDL_RenderPresent(engine->sdl_renderer);
+    end_frame(engine, view);
+}
+
+// Camera distance of the object origin over the far plane: [0, 1] for anything in the frustum
+static float view_depth(const Engine* engine, const Object* obj) {
+    return norm3(subtract3(obj->transform.translation, engine->camera.pos)) / engine->projection.far;
+}
+
+void update_scene(Engine* engine, Scene* scene) {
+    // Object adds allocate, and so may the queue growing with the scene: both before the frame
+    if (engine->commands) command_drain(engine->commands, scene, &engine->camera);
+    RenderQueue* queue = engine->render_queue;
+    render_queue_reserve(queue, scene->count);
+
+    start_frame(engine);
+    scene_update(scene, engine->camera, engine->projection, engine->jobs);
+    render_queue_reset(queue);
+
+    int software = 0, filled = 0;
+    for (int i = 0; i < scene->count; i++) {
+        const Object* obj = &scene->objects[i];
+        if (!obj->visible) continue;
+
+        int soft = obj->draw.backend == RENDER_SOFTWARE;
+        software |= soft;
+        filled |= soft && obj->draw.shading != SHADE_WIREFRAME;
+        render_queue_push(queue, &obj->draw, obj->layer, view_depth(engine, obj));
+    }
+    render_queue_sort(queue);
+
+    frame_stats_add_scene(engine->stats, scene);
+    frame_stats_stage(engine->stats, FRAME_UPDATE_MS);
+    SDL_Rect view = begin_frame(engine);
+
+    // Software draws cover the whole target, so they go first
+    if (software) {
+        framebuffer_clear(engine->framebuffer, color_to_argb(engine->background));
+        if (filled) framebuffer_clear_depth(engine->framebuffer);
+        render_queue_execute(queue, RENDER_SOFTWARE, engine->sdl_renderer, engine->framebuffer, view.w, view.h);
+        present_framebuffer(engine, view);
+    } else {
+        SDL_SetRenderDrawColor(engine->sdl_renderer,
+            engine->background.r, engine->background.g, engine->background.b, engine->background.a); // background color
+        SDL_RenderClear(engine->sdl_renderer);
+    }
+
+    render_queue_execute(queue, RENDER_SDL, engine->sdl_renderer, engine->framebuffer, view.w, view.h);
+
+    end_frame(engine, view);
+}
+
+void update_terrain(Engine* engine, Terrain* terrain, Color color) {
+    start_frame(engine);
+    terrain_update(terrain, engine->camera.pos, engine->scratch);
+
+    frame_stats_stage(engine->stats, FRAME_UPDATE_MS);
+    SDL_Rect view = begin_frame(engine);
+
+    // Chunks are transformed as they are drawn: all of it is raster time
+    framebuffer_clear(engine->framebuffer, color_to_argb(engine->background));
+    terrain_render(terrain, engine->framebuffer, engine->camera, engine->projection, color);
+    present_framebuffer(engine, view);
+
+    EngineFrameStats* stats = engine->stats;
+    frame_stats_add(stats, FRAME_VERTICES, terrain->stats.vertices);
+    frame_stats_add(stats, FRAME_TRIANGLES, terrain->stats.triangles);
+    frame_stats_add(stats, FRAME_LINES, 3.0 * terrain->stats.triangles);
+    frame_stats_add(stats, FRAME_DRAWS, terrain->stats.visible);
+
+    end_frame(engine, view);
 }
 
 void engine_destroy(Engine* engine) {
-    SDL_DestroyRenderer(engine->sdl_renderer);
-    SDL_DestroyWindow(engine->window);
+    if (engine->render_queue) render_queue_destroy(engine->render_queue);
+    if (engine->scratch) arena_destroy(engine->scratch);
+    if (engine->stats) frame_stats_destroy(engine->stats);
+    if (engine->jobs) jobs_destroy(engine->jobs);
+    if (engine->render_target) SDL_DestroyTexture(engine->render_target);
+    if (engine->framebuffer_texture) SDL_DestroyTexture(engine->framebuffer_texture);
+    if (engine->framebuffer) framebuffer_destroy(engine->framebuffer);
+    if (engine->sdl_renderer) SDL_DestroyRenderer(engine->sdl_renderer);
+    if (engine->window) SDL_DestroyWindow(engine->window);
     SDL_Quit();
 
-    mesh_destroy(engine->figure);
-    mesh_destroy(engine->draw->clipped_mesh);
-    free(engine->draw);
-    free(engine);
+    if (engine->figure) mesh_destroy(engine->figure);
+    if (engine->draw->clipped_mesh) mesh_destroy(engine->draw->clipped_mesh);
+    memory_free(MEMORY_ENGINE, engine->draw->vertex_colors);
+    memory_free(MEMORY_ENGINE, engine->draw);
+    memory_free(MEMORY_ENGINE, engine);
 }
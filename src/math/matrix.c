@@ -3,26 +3,299 @@
 
 #include "math/matrix.h"
 
-Vector4 transform(Matrix M, Vector4 v)
+/* **************************** SCALAR REFERENCE ****************************** */
+
+Vector4 matrix_transform_scalar(const Matrix* M, Vector4 v)
 {
     Vector4 result;
-    result.x = dot(array_to_vect(M.m[0]), v);
-    result.y = dot(array_to_vect(M.m[1]), v);
-    result.z = dot(array_to_vect(M.m[2]), v);
-    result.w = dot(array_to_vect(M.m[3]), v);
+    result.x = dot4_scalar(array_to_vect(M->m[0]), v);
+    result.y = dot4_scalar(array_to_vect(M->m[1]), v);
+    result.z = dot4_scalar(array_to_vect(M->m[2]), v);
+    result.w = dot4_scalar(array_to_vect(M->m[3]), v);
     return result;
 }
 
-Matrix multiply(Matrix A, Matrix B) {
+void matrix_transform_array_scalar(const Matrix* M, const Vector4* in, Vector4* out, int count) {
+    for (int i = 0; i < count; i++)
+        out[i] = matrix_transform_scalar(M, in[i]);
+}
+
+void matrix_transform_points_scalar(const Matrix* M, const Vector3* in, Vector4* out, int count) {
+    for (int i = 0; i < count; i++) {
+        Vector3 p = in[i];
+        out[i] = (Vector4){
+            M->m[0][0] * p.x + M->m[0][1] * p.y + M->m[0][2] * p.z + M->m[0][3],
+            M->m[1][0] * p.x + M->m[1][1] * p.y + M->m[1][2] * p.z + M->m[1][3],
+            M->m[2][0] * p.x + M->m[2][1] * p.y + M->m[2][2] * p.z + M->m[2][3],
+            M->m[3][0] * p.x + M->m[3][1] * p.y + M->m[3][2] * p.z + M->m[3][3]
+        };
+    }
+}
+
+void matrix_multiply_scalar(Matrix* out, const Matrix* A, const Matrix* B) {
     Matrix C;
     for (size_t i = 0; i < MATRIX_N; i++) {
         for (size_t j = 0; j < MATRIX_N; j++) {
-            C.m[i][j] = dot(array_to_vect(A.m[i]), extract_column(&B, j));
+            C.m[i][j] = dot4_scalar(array_to_vect(A->m[i]), extract_column(B, j));
         }
     }
-    return C;
+    *out = C;
+}
+
+void matrix_transpose_scalar(Matrix* out, const Matrix* M) {
+    Matrix T;
+    for (size_t i = 0; i < MATRIX_N; i++)
+        for (size_t j = 0; j < MATRIX_N; j++)
+            T.m[i][j] = M->m[j][i];
+    *out = T;
+}
+
+// Cofactor expansion using the 2x2 minors of the top and bottom row pairs
+int matrix_inverse_scalar(Matrix* out, const Matrix* M) {
+    const float (*a)[MATRIX_N] = M->m;
+
+    float s0 = a[0][0] * a[1][1] - a[1][0] * a[0][1];
+    float s1 = a[0][0] * a[1][2] - a[1][0] * a[0][2];
+    float s2 = a[0][0] * a[1][3] - a[1][0] * a[0][3];
+    float s3 = a[0][1] * a[1][2] - a[1][1] * a[0][2];
+    float s4 = a[0][1] * a[1][3] - a[1][1] * a[0][3];
+    float s5 = a[0][2] * a[1][3] - a[1][2] * a[0][3];
+
+    float c5 = a[2][2] * a[3][3] - a[3][2] * a[2][3];
+    float c4 = a[2][1] * a[3][3] - a[3][1] * a[2][3];
+    float c3 = a[2][1] * a[3][2] - a[3][1] * a[2][2];
+    float c2 = a[2][0] * a[3][3] - a[3][0] * a[2][3];
+    float c1 = a[2][0] * a[3][2] - a[3][0] * a[2][2];
+    float c0 = a[2][0] * a[3][1] - a[3][0] * a[2][1];
+
+    float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    if (det == 0.0f) return 0;
+    float inv_det = 1.0f / det;
+
+    Matrix inv = {{
+        { ( a[1][1] * c5 - a[1][2] * c4 + a[1][3] * c3) * inv_det,
+          (-a[0][1] * c5 + a[0][2] * c4 - a[0][3] * c3) * inv_det,
+          ( a[3][1] * s5 - a[3][2] * s4 + a[3][3] * s3) * inv_det,
+          (-a[2][1] * s5 + a[2][2] * s4 - a[2][3] * s3) * inv_det },
+        { (-a[1][0] * c5 + a[1][2] * c2 - a[1][3] * c1) * inv_det,
+          ( a[0][0] * c5 - a[0][2] * c2 + a[0][3] * c1) * inv_det,
+          (-a[3][0] * s5 + a[3][2] * s2 - a[3][3] * s1) * inv_det,
+          ( a[2][0] * s5 - a[2][2] * s2 + a[2][3] * s1) * inv_det },
+        { ( a[1][0] * c4 - a[1][1] * c2 + a[1][3] * c0) * inv_det,
+          (-a[0][0] * c4 + a[0][1] * c2 - a[0][3] * c0) * inv_det,
+          ( a[3][0] * s4 - a[3][1] * s2 + a[3][3] * s0) * inv_det,
+          (-a[2][0] * s4 + a[2][1] * s2 - a[2][3] * s0) * inv_det },
+        { (-a[1][0] * c3 + a[1][1] * c1 - a[1][2] * c0) * inv_det,
+          ( a[0][0] * c3 - a[0][1] * c1 + a[0][2] * c0) * inv_det,
+          (-a[3][0] * s3 + a[3][1] * s1 - a[3][2] * s0) * inv_det,
+          ( a[2][0] * s3 - a[2][1] * s1 + a[2][2] * s0) * inv_det }
+    }};
+
+    *out = inv;
+    return 1;
+}
+
+/* **************************** SIMD ****************************** */
+
+#if MATH_SIMD
+
+Vector4 matrix_transform_simd(const Matrix* M, Vector4 v) {
+    f32x4 c0 = f32x4_load(M->m[0]);
+    f32x4 c1 = f32x4_load(M->m[1]);
+    f32x4 c2 = f32x4_load(M->m[2]);
+    f32x4 c3 = f32x4_load(M->m[3]);
+    F32X4_TRANSPOSE(c0, c1, c2, c3); // rows -> columns
+
+    f32x4 r = f32x4_mul(c0, f32x4_splat(v.simd, 0));
+    r = f32x4_madd(c1, f32x4_splat(v.simd, 1), r);
+    r = f32x4_madd(c2, f32x4_splat(v.simd, 2), r);
+    r = f32x4_madd(c3, f32x4_splat(v.simd, 3), r);
+
+    return (Vector4){ .simd = r };
+}
+
+void matrix_transform_array_simd(const Matrix* M, const Vector4* in, Vector4* out, int count) {
+    f32x4 c0 = f32x4_load(M->m[0]);
+    f32x4 c1 = f32x4_load(M->m[1]);
+    f32x4 c2 = f32x4_load(M->m[2]);
+    f32x4 c3 = f32x4_load(M->m[3]);
+    F32X4_TRANSPOSE(c0, c1, c2, c3);
+
+    for (int i = 0; i < count; i++) {
+        f32x4 v = f32x4_load(in[i].v);
+        f32x4 r = f32x4_mul(c0, f32x4_splat(v, 0));
+        r = f32x4_madd(c1, f32x4_splat(v, 1), r);
+        r = f32x4_madd(c2, f32x4_splat(v, 2), r);
+        r = f32x4_madd(c3, f32x4_splat(v, 3), r);
+        f32x4_store(out[i].v, r);
+    }
+}
+
+// Same operation order as matrix_transform_array (c3 * 1 is exact), so results are identical
+static inline f32x4 transform_point(f32x4 c0, f32x4 c1, f32x4 c2, f32x4 c3, f32x4 x, f32x4 y, f32x4 z) {
+    return f32x4_add(f32x4_madd(c2, z, f32x4_madd(c1, y, f32x4_mul(c0, x))), c3);
+}
+
+void matrix_transform_points_simd(const Matrix* M, const Vector3* in, Vector4* out, int count) {
+    f32x4 c0 = f32x4_load(M->m[0]);
+    f32x4 c1 = f32x4_load(M->m[1]);
+    f32x4 c2 = f32x4_load(M->m[2]);
+    f32x4 c3 = f32x4_load(M->m[3]);
+    F32X4_TRANSPOSE(c0, c1, c2, c3);
+
+    // 4 points are 3 full registers: (x0 y0 z0 x1) (y1 z1 x2 y2) (z2 x3 y3 z3)
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const float* p = &in[i].x;
+        f32x4 a = f32x4_loadu(p), b = f32x4_loadu(p + 4), c = f32x4_loadu(p + 8);
+        f32x4_store(out[i].v, transform_point(c0, c1, c2, c3, f32x4_splat(a, 0), f32x4_splat(a, 1), f32x4_splat(a, 2)));
+        f32x4_store(out[i + 1].v, transform_point(c0, c1, c2, c3, f32x4_splat(a, 3), f32x4_splat(b, 0), f32x4_splat(b, 1)));
+        f32x4_store(out[i + 2].v, transform_point(c0, c1, c2, c3, f32x4_splat(b, 2), f32x4_splat(b, 3), f32x4_splat(c, 0)));
+        f32x4_store(out[i + 3].v, transform_point(c0, c1, c2, c3, f32x4_splat(c, 1), f32x4_splat(c, 2), f32x4_splat(c, 3)));
+    }
+    for (; i < count; i++)
+        f32x4_store(out[i].v, transform_point(c0, c1, c2, c3, f32x4_set1(in[i].x), f32x4_set1(in[i].y),
+                                              f32x4_set1(in[i].z)));
+}
+
+// Row i of A * B is the combination of the rows of B weighted by A[i][*]
+static inline f32x4 combine_rows(f32x4 a, f32x4 b0, f32x4 b1, f32x4 b2, f32x4 b3) {
+    f32x4 r = f32x4_mul(b0, f32x4_splat(a, 0));
+    r = f32x4_madd(b1, f32x4_splat(a, 1), r);
+    r = f32x4_madd(b2, f32x4_splat(a, 2), r);
+    return f32x4_madd(b3, f32x4_splat(a, 3), r);
+}
+
+void matrix_multiply_simd(Matrix* out, const Matrix* A, const Matrix* B) {
+    f32x4 b0 = f32x4_load(B->m[0]);
+    f32x4 b1 = f32x4_load(B->m[1]);
+    f32x4 b2 = f32x4_load(B->m[2]);
+    f32x4 b3 = f32x4_load(B->m[3]);
+
+    f32x4 r0 = combine_rows(f32x4_load(A->m[0]), b0, b1, b2, b3);
+    f32x4 r1 = combine_rows(f32x4_load(A->m[1]), b0, b1, b2, b3);
+    f32x4 r2 = combine_rows(f32x4_load(A->m[2]), b0, b1, b2, b3);
+    f32x4 r3 = combine_rows(f32x4_load(A->m[3]), b0, b1, b2, b3);
+
+    f32x4_store(out->m[0], r0);
+    f32x4_store(out->m[1], r1);
+    f32x4_store(out->m[2], r2);
+    f32x4_store(out->m[3], r3);
+}
+
+void matrix_transpose_simd(Matrix* out, const Matrix* M) {
+    f32x4 r0 = f32x4_load(M->m[0]);
+    f32x4 r1 = f32x4_load(M->m[1]);
+    f32x4 r2 = f32x4_load(M->m[2]);
+    f32x4 r3 = f32x4_load(M->m[3]);
+    F32X4_TRANSPOSE(r0, r1, r2, r3);
+
+    f32x4_store(out->m[0], r0);
+    f32x4_store(out->m[1], r1);
+    f32x4_store(out->m[2], r2);
+    f32x4_store(out->m[3], r3);
+}
+
+/*
+ * Block-wise inverse: M = [A B; C D] with 2x2 blocks stored as (a00, a01, a10, a11).
+ * Uses the adjugates of the blocks, so no division happens before the final
+ * scale by 1/det(M).
+ */
+
+// A * B
+static inline f32x4 mat2_mul(f32x4 a, f32x4 b) {
+    return f32x4_add(f32x4_mul(a, f32x4_swizzle(b, 0, 3, 0, 3)),
+                     f32x4_mul(f32x4_swizzle(a, 1, 0, 3, 2), f32x4_swizzle(b, 2, 1, 2, 1)));
+}
+
+// adj(A) * B
+static inline f32x4 mat2_adj_mul(f32x4 a, f32x4 b) {
+    return f32x4_sub(f32x4_mul(f32x4_swizzle(a, 3, 3, 0, 0), b),
+                     f32x4_mul(f32x4_swizzle(a, 1, 1, 2, 2), f32x4_swizzle(b, 2, 3, 0, 1)));
+}
+
+// A * adj(B)
+static inline f32x4 mat2_mul_adj(f32x4 a, f32x4 b) {
+    return f32x4_sub(f32x4_mul(a, f32x4_swizzle(b, 3, 0, 3, 0)),
+                     f32x4_mul(f32x4_swizzle(a, 1, 0, 3, 2), f32x4_swizzle(b, 2, 1, 2, 1)));
 }
 
+int matrix_inverse_simd(Matrix* out, const Matrix* M) {
+    f32x4 r0 = f32x4_load(M->m[0]);
+    f32x4 r1 = f32x4_load(M->m[1]);
+    f32x4 r2 = f32x4_load(M->m[2]);
+    f32x4 r3 = f32x4_load(M->m[3]);
+
+    f32x4 A = f32x4_shuffle(r0, r1, 0, 1, 0, 1);
+    f32x4 B = f32x4_shuffle(r0, r1, 2, 3, 2, 3);
+    f32x4 C = f32x4_shuffle(r2, r3, 0, 1, 0, 1);
+    f32x4 D = f32x4_shuffle(r2, r3, 2, 3, 2, 3);
+
+    // (|A|, |B|, |C|, |D|)
+    f32x4 det_sub = f32x4_sub(
+        f32x4_mul(f32x4_shuffle(r0, r2, 0, 2, 0, 2), f32x4_shuffle(r1, r3, 1, 3, 1, 3)),
+        f32x4_mul(f32x4_shuffle(r0, r2, 1, 3, 1, 3), f32x4_shuffle(r1, r3, 0, 2, 0, 2)));
+    f32x4 det_a = f32x4_splat(det_sub, 0);
+    f32x4 det_b = f32x4_splat(det_sub, 1);
+    f32x4 det_c = f32x4_splat(det_sub, 2);
+    f32x4 det_d = f32x4_splat(det_sub, 3);
+
+    f32x4 d_c = mat2_adj_mul(D, C);
+    f32x4 a_b = mat2_adj_mul(A, B);
+
+    f32x4 X = f32x4_sub(f32x4_mul(det_d, A), mat2_mul(B, d_c));
+    f32x4 W = f32x4_sub(f32x4_mul(det_a, D), mat2_mul(C, a_b));
+    f32x4 Y = f32x4_sub(f32x4_mul(det_b, C), mat2_mul_adj(D, a_b));
+    f32x4 Z = f32x4_sub(f32x4_mul(det_c, B), mat2_mul_adj(A, d_c));
+
+    // |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+    float trace = f32x4_hsum(f32x4_mul(a_b, f32x4_swizzle(d_c, 0, 2, 1, 3)));
+    float det = f32x4_lane(det_sub, 0) * f32x4_lane(det_sub, 3)
+              + f32x4_lane(det_sub, 1) * f32x4_lane(det_sub, 2) - trace;
+    if (det == 0.0f) return 0;
+
+    _Alignas(16) static const float adj_sign[4] = {1.0f, -1.0f, -1.0f, 1.0f};
+    f32x4 rcp_det = f32x4_div(f32x4_load(adj_sign), f32x4_set1(det));
+    X = f32x4_mul(X, rcp_det);
+    Y = f32x4_mul(Y, rcp_det);
+    Z = f32x4_mul(Z, rcp_det);
+    W = f32x4_mul(W, rcp_det);
+
+    f32x4_store(out->m[0], f32x4_shuffle(X, Y, 3, 1, 3, 1));
+    f32x4_store(out->m[1], f32x4_shuffle(X, Y, 2, 0, 2, 0));
+    f32x4_store(out->m[2], f32x4_shuffle(Z, W, 3, 1, 3, 1));
+    f32x4_store(out->m[3], f32x4_shuffle(Z, W, 2, 0, 2, 0));
+    return 1;
+}
+
+#else
+
+Vector4 matrix_transform_simd(const Matrix* M, Vector4 v) {
+    return matrix_transform_scalar(M, v);
+}
+
+void matrix_transform_array_simd(const Matrix* M, const Vector4* in, Vector4* out, int count) {
+    matrix_transform_array_scalar(M, in, out, count);
+}
+
+void matrix_transform_points_simd(const Matrix* M, const Vector3* in, Vector4* out, int count) {
+    matrix_transform_points_scalar(M, in, out, count);
+}
+
+void matrix_multiply_simd(Matrix* out, const Matrix* A, const Matrix* B) {
+    matrix_multiply_scalar(out, A, B);
+}
+
+void matrix_transpose_simd(Matrix* out, const Matrix* M) {
+    matrix_transpose_scalar(out, M);
+}
+
+int matrix_inverse_simd(Matrix* out, const Matrix* M) {
+    return matrix_inverse_scalar(out, M);
+}
+
+#endif
+
 Vector4 extract_column(const Matrix *M, size_t j) {
     assert(j < MATRIX_N);
     return (Vector4){ M->m[0][j], M->m[1][j], M->m[2][j], M->m[3][j] };
@@ -0,0 +1,183 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <SDL.h>
+
+#include "core/assets.h"
+#include "core/obj.h"
+#include "core/scene.h"
+
+// GRID x GRID height field reloaded RELOADS times while frames are drawn
+#define GRID 256
+#define RELOADS 6
+#define RELOAD_EVERY 40
+#define WARMUP_FRAMES 20
+
+// Frames are paced like a 60 Hz vsync: the loader runs in what is left of each frame
+#define FRAME_MS (1000.0 / 60.0)
+#define SCREEN_W 800
+#define SCREEN_H 600
+
+#define ASSET_PATH "perf_assets.obj"
+#define VERSION_PATH "perf_assets_%d.obj"
+
+// Sync reads the prepared versions, async then renames them over the watched file
+typedef enum { RELOAD_NONE, RELOAD_SYNC, RELOAD_ASYNC } ReloadMode;
+
+static const char* MODE_NAMES[] = {"no reload", "sync (main)", "async (loader)"};
+
+typedef struct FrameTimes {
+    int frames;
+    double total_ms;
+    double max_ms;
+} FrameTimes;
+
+static inline double get_time_ms(Uint64 start, Uint64 end) {
+    return (double)((end - start) * 1000) / (double)SDL_GetPerformanceFrequency();
+}
+
+// Waves whose phase changes with the version, so that every file differs
+static Mesh* create_terrain(int version) {
+    int side = GRID + 1;
+    Vector4* vertices = malloc(sizeof(Vector4) * side * side);
+    Triangle* triangles = malloc(sizeof(Triangle) * 2 * GRID * GRID);
+    for (int z = 0; z < side; z++)
+        for (int x = 0; x < side; x++) {
+            float y = 0.5f * sinf(0.1f * x + version) * cosf(0.07f * z - version);
+            vertices[z * side + x] = (Vector4){(x - GRID / 2) * 0.1f, y, (z - GRID / 2) * 0.1f, 1.0f};
+        }
+    for (int z = 0, t = 0; z < GRID; z++)
+        for (int x = 0; x < GRID; x++) {
+            int i = z * side + x;
+            triangles[t++] = (Triangle){{i, i + side, i + 1}};
+            triangles[t++] = (Triangle){{i + 1, i + side, i + side + 1}};
+        }
+    Mesh* mesh = mesh_generate(vertices, side * side, triangles, 2 * GRID * GRID);
+    free(vertices);
+    free(triangles);
+    return mesh;
+}
+
+static void version_path(char* path, int version) {
+    snprintf(path, ASSETS_PATH_MAX, VERSION_PATH, version);
+}
+
+// The artist saving: a prepared version renamed over the watched file (outside the timed frame)
+static void publish_version(int version) {
+    char path[ASSETS_PATH_MAX];
+    version_path(path, version);
+    rename(path, ASSET_PATH);
+}
+
+static void record(FrameTimes* times, double ms) {
+    times->frames++;
+    times->total_ms += ms;
+    if (ms > times->max_ms) times->max_ms = ms;
+}
+
+static void draw_frame(Scene* scene, Framebuffer* fb, Camera cam, Projection proj) {
+    scene_update(scene, cam, proj, NULL);
+    framebuffer_clear(fb, 0xFF000000u);
+    draw_mesh_software(fb, &scene->objects[0].draw);
+}
+
+int main(void) {
+    printf("\n=== Asset hot reload (%dx%d grid, %d reloads, %d CPU) ===\n", GRID, GRID, RELOADS, SDL_GetCPUCount());
+
+    char path[ASSETS_PATH_MAX];
+    for (int v = 0; v <= RELOADS; v++) {
+        Mesh* mesh = create_terrain(v);
+        version_path(path, v);
+        obj_save(path, mesh);
+        if (v == 0) obj_save(ASSET_PATH, mesh);
+        mesh_destroy(mesh);
+    }
+
+    Camera cam = {{0.0f, 8.0f, 16.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}};
+    Projection proj = {M_PI / 3, (float)SCREEN_W / SCREEN_H, 0.1f, 100.0f};
+    Framebuffer* fb = framebuffer_create(SCREEN_W, SCREEN_H);
+
+    // Hitch: longest frame over the steady average; reload frame: longest frame that published a version
+    printf("%-16s %8s %10s %10s %10s %14s\n", "reload", "frames", "avg ms", "max ms", "hitch ms", "reload frame");
+    double steady_ms = 0.0;
+    for (ReloadMode mode = RELOAD_NONE; mode <= RELOAD_ASYNC; mode++) {
+        Assets* assets = assets_create(1, 1);
+        int handle = assets_add_mesh(assets, ASSET_PATH);
+        Uint64 frame = 0;
+        while (!assets_mesh(assets, handle)) {
+            assets_update(assets, frame++);
+            SDL_Delay(1);
+        }
+
+        Mesh* owned = NULL;
+        Scene* scene = scene_create(1);
+        int object = scene_add(scene, assets_mesh(assets, handle), (Color){255, 255, 255, 255}, NO_TRANSFORM, 0);
+        scene->objects[object].draw.backend = RENDER_SOFTWARE;
+
+        // A reload is saved RELOAD_EVERY frames after the previous one was published
+        FrameTimes times = {0};
+        int reloads = 0, waiting = 0, countdown = WARMUP_FRAMES;
+        Uint64 saved = 0;
+        double latency_ms = 0.0, max_latency_ms = 0.0, reload_frame_ms = 0.0;
+        for (int f = 0; mode == RELOAD_NONE ? f < WARMUP_FRAMES + RELOADS * RELOAD_EVERY : reloads < RELOADS || waiting;
+             f++) {
+            int due = mode != RELOAD_NONE && !waiting && reloads < RELOADS && countdown-- <= 0;
+            if (due && mode == RELOAD_ASYNC) {
+                publish_version(++reloads);
+                saved = SDL_GetPerformanceCounter();
+                waiting = 1;
+            }
+
+            Uint64 start = SDL_GetPerformanceCounter();
+            int swapped = due && mode == RELOAD_SYNC;
+            if (mode == RELOAD_ASYNC) {
+                assets_update(assets, frame++);
+                const Mesh* mesh = assets_mesh(assets, handle);
+                if (scene->objects[object].mesh != mesh) {
+                    scene_set_mesh(scene, object, mesh);
+                    double ms = get_time_ms(saved, start);
+                    latency_ms += ms / RELOADS;
+                    if (ms > max_latency_ms) max_latency_ms = ms;
+                    waiting = 0;
+                    swapped = 1;
+                    countdown = RELOAD_EVERY;
+                }
+            } else if (due) {
+                // Same work as the loader, on the frame
+                version_path(path, ++reloads);
+                Mesh* mesh = obj_load(path);
+                mesh_compute_normals(mesh, NULL);
+                scene_set_mesh(scene, object, mesh);
+                if (owned) mesh_destroy(owned);
+                owned = mesh;
+                countdown = RELOAD_EVERY;
+            }
+            draw_frame(scene, fb, cam, proj);
+            double ms = get_time_ms(start, SDL_GetPerformanceCounter());
+            if (f >= WARMUP_FRAMES) record(&times, ms);
+            if (swapped && ms > reload_frame_ms) reload_frame_ms = ms;
+            if (ms < FRAME_MS) SDL_Delay((Uint32)(FRAME_MS - ms));
+        }
+
+        double avg = times.total_ms / times.frames;
+        if (mode == RELOAD_NONE) steady_ms = avg;
+        printf("%-16s %8d %10.3f %10.3f %10.3f %11.3f ms\n", MODE_NAMES[mode], times.frames, avg, times.max_ms,
+               times.max_ms - steady_ms, reload_frame_ms);
+        if (mode == RELOAD_ASYNC)
+            printf("  loader %.2f ms per load (max %.2f), saved to published %.1f ms (max %.1f), assets_update max %.3f ms\n",
+                   assets->stats.total_load_ms / assets->stats.loads, assets->stats.max_load_ms, latency_ms,
+                   max_latency_ms, assets->stats.max_update_ms);
+
+        scene_destroy(scene);
+        assets_destroy(assets);
+        if (owned) mesh_destroy(owned);
+    }
+
+    framebuffer_destroy(fb);
+    for (int v = 0; v <= RELOADS; v++) {
+        version_path(path, v);
+        remove(path);
+    }
+    remove(ASSET_PATH);
+    return 0;
+}
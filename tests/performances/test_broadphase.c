@@ -0,0 +1,122 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <SDL.h>
+
+#include "core/broadphase.h"
+#include "core/pipeline.h"
+
+// Same object density at every count: about one neighbour per object
+#define DENSITY 0.02f
+#define MAX_SPEED 0.05f
+#define FRAMES 60
+
+static inline double get_time_ms(Uint64 start, Uint64 end) {
+    return (double)((end - start) * 1000) / (double)SDL_GetPerformanceFrequency();
+}
+
+static float random_float(float lo, float hi) {
+    return lo + (hi - lo) * (float)rand() / RAND_MAX;
+}
+
+typedef struct Body {
+    Transform transform;
+    Vector3 velocity;
+    Vector3 spin;
+} Body;
+
+// Moves every body a little, bouncing off the walls of a side^3 box
+static void step(Body* bodies, int count, float side) {
+    for (int i = 0; i < count; i++) {
+        Body* b = &bodies[i];
+        for (int a = 0; a < 3; a++) {
+            b->transform.translation.v[a] += b->velocity.v[a];
+            if (b->transform.translation.v[a] < 0.0f || b->transform.translation.v[a] > side)
+                b->velocity.v[a] = -b->velocity.v[a];
+            b->transform.rotation.v[a] += b->spin.v[a];
+        }
+    }
+}
+
+static int brute_force(const Bounds* boxes, int count) {
+    int pairs = 0;
+    for (int i = 0; i < count; i++)
+        for (int j = i + 1; j < count; j++) {
+            const Bounds* a = &boxes[i];
+            const Bounds* b = &boxes[j];
+            pairs += a->min.x <= b->max.x && b->min.x <= a->max.x && a->min.y <= b->max.y && b->min.y <= a->max.y &&
+                     a->min.z <= b->max.z && b->min.z <= a->max.z;
+        }
+    return pairs;
+}
+
+static void run(int count, int brute) {
+    Bounds cube = {{{-0.5f, -0.5f, -0.5f}}, {{0.5f, 0.5f, 0.5f}}};
+    float side = cbrtf(count / DENSITY);
+    Body* bodies = malloc(sizeof(Body) * count);
+    Bounds* boxes = malloc(sizeof(Bounds) * count);
+    for (int i = 0; i < count; i++) {
+        Transform t = NO_TRANSFORM;
+        t.translation = (Vector3){random_float(0, side), random_float(0, side), random_float(0, side)};
+        t.scale = (Vector3){random_float(0.5f, 2.0f), random_float(0.5f, 2.0f), random_float(0.5f, 2.0f)};
+        bodies[i] = (Body){t,
+                           {random_float(-MAX_SPEED, MAX_SPEED), random_float(-MAX_SPEED, MAX_SPEED),
+                            random_float(-MAX_SPEED, MAX_SPEED)},
+                           {random_float(-0.02f, 0.02f), random_float(-0.02f, 0.02f), 0.0f}};
+    }
+
+    Broadphase* incremental = broadphase_create(count);
+    Broadphase* rebuild = broadphase_create(count);
+    double bounds_ms = 0.0, sap_ms = 0.0, rebuild_ms = 0.0;
+    double swaps = 0.0, tests = 0.0, pairs = 0.0;
+
+    for (int f = 0; f < FRAMES; f++) {
+        step(bodies, count, side);
+
+        Uint64 t0 = SDL_GetPerformanceCounter();
+        for (int i = 0; i < count; i++)
+            boxes[i] = world_bounds(cube, bodies[i].transform);
+        Uint64 t1 = SDL_GetPerformanceCounter();
+        broadphase_update(incremental, boxes, count);
+        Uint64 t2 = SDL_GetPerformanceCounter();
+        // A new count forces the radix sort: what a sort from scratch every frame costs
+        rebuild->count = 0;
+        broadphase_update(rebuild, boxes, count);
+        Uint64 t3 = SDL_GetPerformanceCounter();
+
+        // The first frame builds the list in both
+        if (f == 0) continue;
+        bounds_ms += get_time_ms(t0, t1) / (FRAMES - 1);
+        sap_ms += get_time_ms(t1, t2) / (FRAMES - 1);
+        rebuild_ms += get_time_ms(t2, t3) / (FRAMES - 1);
+        swaps += (double)incremental->stats.swaps / (FRAMES - 1);
+        tests += (double)incremental->stats.tests / (FRAMES - 1);
+        pairs += (double)incremental->pair_count / (FRAMES - 1);
+    }
+
+    printf("%-8d %10.3f %12.3f %12.3f %12.0f %12.0f %10.0f", count, bounds_ms, sap_ms, rebuild_ms, swaps, tests, pairs);
+    if (brute) {
+        Uint64 t0 = SDL_GetPerformanceCounter();
+        int brute_pairs = brute_force(boxes, count);
+        double brute_ms = get_time_ms(t0, SDL_GetPerformanceCounter());
+        printf(" %12.1f %s\n", brute_ms, brute_pairs == incremental->pair_count ? "(same pairs)" : "(PAIRS DIFFER)");
+    } else {
+        printf(" %12s\n", "skipped");
+    }
+
+    broadphase_destroy(incremental);
+    broadphase_destroy(rebuild);
+    free(bodies);
+    free(boxes);
+}
+
+int main(void) {
+    printf("\n=== Sweep-and-prune broadphase (%d frames of moving boxes) ===\n", FRAMES);
+    printf("%-8s %10s %12s %12s %12s %12s %10s %12s\n", "objects", "bounds ms", "sap ms", "re-sort ms", "swaps",
+           "tests", "pairs", "brute ms");
+
+    srand(46);
+    run(10000, 1);
+    run(100000, 0);
+    return 0;
+}
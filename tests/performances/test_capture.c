@@ -0,0 +1,147 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <SDL.h>
+
+#include "core/capture.h"
+#include "core/pipeline.h"
+#include "core/renderer.h"
+#include "../test_fixtures.h"
+
+#define FRAMES 200
+#define FB_W 640
+#define FB_H 360
+#define FPS 60
+#define SUBDIVISIONS 60
+#define BLOCK_RING 8
+#define DROP_RING 2
+#define CAPTURE_FILE "perf_capture.y4m"
+
+static inline double get_time_ms(Uint64 start, Uint64 end) {
+    return (double)((end - start) * 1000) / (double)SDL_GetPerformanceFrequency();
+}
+
+static int compare_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+typedef enum Mode {
+    MODE_NONE,
+    MODE_SYNC,
+    MODE_BLOCK,
+    MODE_DROP
+} Mode;
+
+typedef struct Run {
+    double mean_ms;
+    double p99_ms;
+    double max_ms;
+    double capture_ms;      // capture call on the frame loop, per frame
+    double max_capture_ms;
+    double total_ms;        // frame loop, capture_close included
+    CaptureStats stats;
+} Run;
+
+static Run run(Mode mode, const Mesh* mesh, Framebuffer* fb, const Lighting* lighting) {
+    Run result = {0};
+    Camera cam = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, -1.0f}, {0.0f, 1.0f, 0.0f}};
+    Projection proj = {M_PI / 3, (float)FB_W / FB_H, 0.1f, 100.0f};
+    Mesh* clipped = mesh_create_clipped(mesh);
+    Draw draw = {.clipped_mesh = clipped, .backend = RENDER_SOFTWARE, .shading = SHADE_GOURAUD,
+                 .vertex_colors = malloc(sizeof(uint32_t) * mesh->vertex_count)};
+    double* frame_ms = malloc(sizeof(double) * FRAMES);
+
+    Capture* capture = NULL;
+    FILE* file = NULL;
+    uint8_t* encoded = NULL;
+    if (mode == MODE_BLOCK || mode == MODE_DROP)
+        capture = capture_open(CAPTURE_FILE, CAPTURE_Y4M, FB_W, FB_H, mode == MODE_BLOCK ? BLOCK_RING : DROP_RING,
+                               mode == MODE_BLOCK ? CAPTURE_BLOCK : CAPTURE_DROP, FPS);
+    if (mode == MODE_SYNC) {
+        // What capture replaces: encode and write on the frame loop, one write per frame
+        file = fopen(CAPTURE_FILE, "wb");
+        if (file) setvbuf(file, NULL, _IONBF, 0);
+        encoded = malloc(capture_frame_bytes(CAPTURE_Y4M, FB_W, FB_H));
+        if (file) fprintf(file, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C444\n", FB_W, FB_H, FPS);
+    }
+
+    Uint64 begin = SDL_GetPerformanceCounter();
+    for (int f = 0; f < FRAMES; f++) {
+        Transform transform = NO_TRANSFORM;
+        transform.translation = (Vector3){0.0f, 0.0f, -2.5f};
+        transform.rotation = (Vector3){0.6f, 0.02f * f, 0.0f};
+
+        Uint64 t0 = SDL_GetPerformanceCounter();
+        update_mesh_lit(mesh, clipped, draw.vertex_colors, 0xFFFFFFFFu, transform, cam, proj, lighting);
+        framebuffer_clear(fb, 0xFF000000u);
+        framebuffer_clear_depth(fb);
+        draw_mesh_software(fb, &draw);
+
+        Uint64 t1 = SDL_GetPerformanceCounter();
+        if (capture) capture_frame(capture, fb);
+        if (file) {
+            framebuffer_resolve(fb);
+            size_t bytes = capture_encode(CAPTURE_Y4M, fb->pixels, FB_W, FB_H, fb->pitch, encoded);
+            fwrite(encoded, 1, bytes, file);
+        }
+        Uint64 t2 = SDL_GetPerformanceCounter();
+        frame_ms[f] = get_time_ms(t0, t2);
+        result.capture_ms += get_time_ms(t1, t2) / FRAMES;
+        result.max_capture_ms = fmax(result.max_capture_ms, get_time_ms(t1, t2));
+        result.mean_ms += frame_ms[f] / FRAMES;
+    }
+
+    // Frames still queued are written before the total is taken
+    if (capture) capture_close(capture, &result.stats);
+    if (file) fclose(file);
+    result.total_ms = get_time_ms(begin, SDL_GetPerformanceCounter());
+
+    qsort(frame_ms, FRAMES, sizeof(double), compare_double);
+    result.p99_ms = frame_ms[(int)(0.99 * (FRAMES - 1))];
+    result.max_ms = frame_ms[FRAMES - 1];
+
+    remove(CAPTURE_FILE);
+    free(encoded);
+    free(frame_ms);
+    free(draw.vertex_colors);
+    mesh_destroy(clipped);
+    return result;
+}
+
+int main(void) {
+    Framebuffer* fb = framebuffer_create(FB_W, FB_H);
+    Mesh* mesh = create_grid_mesh(SUBDIVISIONS, 2.0f);
+    Lighting lighting = {.ambient = {0.1f, 0.1f, 0.1f}};
+    lighting_add(&lighting, (Light){.type = LIGHT_DIRECTIONAL, .direction = {0.3f, -1.0f, -0.5f}, .color = {1, 1, 1}});
+
+    printf("\n=== Frame capture (%d frames, %dx%d Y4M, %.2f MB per frame) ===\n", FRAMES, FB_W, FB_H,
+           capture_frame_bytes(CAPTURE_Y4M, FB_W, FB_H) / 1048576.0);
+    printf("%d CPU(s): the writer thread %s\n", SDL_GetCPUCount(),
+           SDL_GetCPUCount() > 1 ? "runs beside the frame loop" : "shares the core with the frame loop");
+    printf("%-16s | %9s %9s %9s | %19s | %10s\n", "mode", "frame", "p99", "max", "capture (max)", "total");
+
+    const char* names[] = {"no capture", "synchronous", "async block", "async drop"};
+    for (Mode mode = MODE_NONE; mode <= MODE_DROP; mode++) {
+        Run r = run(mode, mesh, fb, &lighting);
+        char label[32];
+        snprintf(label, sizeof(label), "%s", names[mode]);
+        if (mode == MODE_BLOCK) snprintf(label, sizeof(label), "%s (%d)", names[mode], BLOCK_RING);
+        if (mode == MODE_DROP) snprintf(label, sizeof(label), "%s (%d)", names[mode], DROP_RING);
+        printf("%-16s | %6.3f ms %6.3f ms %6.3f ms | %6.3f (%6.3f) ms | %7.1f ms\n", label, r.mean_ms, r.p99_ms,
+               r.max_ms, r.capture_ms, r.max_capture_ms, r.total_ms);
+        if (mode >= MODE_BLOCK) {
+            CaptureStats c = r.stats;
+            printf("%-16s | captured %d, dropped %d, max queued %d | copy %.3f ms/frame (max %.3f), "
+                   "blocked %.3f ms/frame (max %.3f)\n", "", c.captured, c.dropped, c.max_queued,
+                   c.copy_ms / FRAMES, c.max_copy_ms, c.blocked_ms / FRAMES, c.max_blocked_ms);
+            printf("%-16s | writer: %d frames, %.1f MB in %d writes, encode %.1f ms, write %.1f ms (%.0f MB/s)\n",
+                   "", c.written, c.bytes_written / 1048576.0, c.writes, c.encode_ms, c.write_ms,
+                   c.write_ms > 0.0 ? c.bytes_written / 1048576.0 / (c.write_ms / 1000.0) : 0.0);
+        }
+    }
+
+    mesh_destroy(mesh);
+    framebuffer_destroy(fb);
+    return 0;
+}
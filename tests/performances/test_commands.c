@@ -0,0 +1,204 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <SDL.h>
+
+#include "core/commands.h"
+#include "../test_fixtures.h"
+
+#define RING_OPS 2000000
+#define RING_CAPACITY 1024
+
+#define OBJECTS 256
+#define QUEUE_FRAMES 2000
+#define LATENCY_FRAMES 500
+#define ALLOCATION_FRAMES 4000
+#define ALLOCATIONS (ALLOCATION_FRAMES * OBJECTS)
+
+static inline double get_time_ms(Uint64 start, Uint64 end) {
+    return (double)((end - start) * 1000) / (double)SDL_GetPerformanceFrequency();
+}
+
+static int compare_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/* **************************** RING THROUGHPUT ****************************** */
+
+// Same ring behind a mutex: what the lock-free indices replace
+typedef struct LockedRing {
+    SpscQueue* ring;
+    SDL_mutex* lock;
+} LockedRing;
+
+typedef struct RingRun {
+    SpscQueue* ring;
+    LockedRing* locked;
+} RingRun;
+
+static int ring_push(RingRun* run, const Command* command) {
+    if (!run->locked) return spsc_push(run->ring, command);
+    SDL_LockMutex(run->locked->lock);
+    int ok = spsc_push(run->locked->ring, command);
+    SDL_UnlockMutex(run->locked->lock);
+    return ok;
+}
+
+static int ring_pop(RingRun* run, Command* command) {
+    if (!run->locked) return spsc_pop(run->ring, command);
+    SDL_LockMutex(run->locked->lock);
+    int ok = spsc_pop(run->locked->ring, command);
+    SDL_UnlockMutex(run->locked->lock);
+    return ok;
+}
+
+static int ring_producer(void* data) {
+    RingRun* run = data;
+    for (int i = 0; i < RING_OPS; i++) {
+        Command command = {COMMAND_TRANSFORM, i, NULL};
+        while (!ring_push(run, &command))
+            SDL_Delay(0);
+    }
+    return 0;
+}
+
+// Milliseconds to move RING_OPS commands from a producer thread to this one
+static double ring_throughput(int locked) {
+    LockedRing lock = {spsc_create(RING_CAPACITY, sizeof(Command)), SDL_CreateMutex()};
+    RingRun run = {lock.ring, locked ? &lock : NULL};
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    SDL_Thread* thread = SDL_CreateThread(ring_producer, "producer", &run);
+    int received = 0, in_order = 1;
+    Command command;
+    while (received < RING_OPS) {
+        if (ring_pop(&run, &command)) {
+            in_order &= command.object == received;
+            received++;
+        } else {
+            SDL_Delay(0);
+        }
+    }
+    SDL_WaitThread(thread, NULL);
+    double ms = get_time_ms(start, SDL_GetPerformanceCounter());
+
+    if (!in_order) printf("Commands out of order!\n");
+    SDL_DestroyMutex(lock.lock);
+    spsc_destroy(lock.ring);
+    return ms;
+}
+
+/* **************************** COMMAND QUEUE ****************************** */
+
+typedef struct Simulation {
+    CommandQueue* queue;
+    int frames;
+    int paced;              // one frame per millisecond instead of as fast as possible
+    Uint64* sent;           // performance counter when each frame ended
+} Simulation;
+
+static int simulate(void* data) {
+    Simulation* sim = data;
+    CommandQueue* queue = sim->queue;
+
+    for (int f = 0; f < sim->frames; f++) {
+        if (sim->paced) SDL_Delay(1);
+        while (!command_begin_frame(queue))
+            SDL_Delay(0);
+        for (int i = 0; i < OBJECTS; i++) {
+            Transform t = NO_TRANSFORM;
+            t.translation = (Vector3){(float)f, (float)i, 0.0f};
+            while (!command_push_transform(queue, i, t))
+                SDL_Delay(0);
+        }
+        // Written before the frame is published, read after it is drained
+        if (sim->sent) sim->sent[f] = SDL_GetPerformanceCounter();
+        while (!command_end_frame(queue))
+            SDL_Delay(0);
+    }
+    return 0;
+}
+
+// Drains on this thread until every frame is applied, timing each frame from end to apply
+static double run_queue(Simulation* sim, Scene* scene, double* latency_ms) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    SDL_Thread* thread = SDL_CreateThread(simulate, "simulation", sim);
+    int applied = 0;
+    while (applied < sim->frames) {
+        command_drain(sim->queue, scene, NULL);
+        Uint64 now = SDL_GetPerformanceCounter();
+        for (; applied < sim->queue->stats.frames_applied; applied++)
+            if (latency_ms) latency_ms[applied] = get_time_ms(sim->sent[applied], now);
+        SDL_Delay(0);
+    }
+    SDL_WaitThread(thread, NULL);
+    return get_time_ms(start, SDL_GetPerformanceCounter());
+}
+
+int main(void) {
+    printf("\n=== SPSC command queue (%d CPU(s)) ===\n", SDL_GetCPUCount());
+
+    double lock_free = ring_throughput(0);
+    double locked = ring_throughput(1);
+    printf("Ring, %d commands across threads:\n", RING_OPS);
+    printf("  %-12s %8.1f ms  %7.1f M commands/s\n", "lock-free", lock_free, RING_OPS / lock_free / 1000.0);
+    printf("  %-12s %8.1f ms  %7.1f M commands/s  (%.2fx)\n", "mutex", locked, RING_OPS / locked / 1000.0,
+           locked / lock_free);
+
+    // Payload allocation: frame arena against one malloc / free per command
+    Arena* arena = arena_create(sizeof(Transform) * 2 * OBJECTS);
+    Transform** blocks = malloc(sizeof(Transform*) * OBJECTS);
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    for (int f = 0; f < ALLOCATION_FRAMES; f++) {
+        arena_reset(arena);
+        for (int i = 0; i < OBJECTS; i++) {
+            blocks[i] = arena_alloc(arena, sizeof(Transform));
+            blocks[i]->translation.x = (float)i;
+        }
+    }
+    Uint64 t1 = SDL_GetPerformanceCounter();
+    for (int f = 0; f < ALLOCATION_FRAMES; f++) {
+        for (int i = 0; i < OBJECTS; i++) {
+            blocks[i] = malloc(sizeof(Transform));
+            blocks[i]->translation.x = (float)i;
+        }
+        for (int i = 0; i < OBJECTS; i++)
+            free(blocks[i]);
+    }
+    Uint64 t2 = SDL_GetPerformanceCounter();
+    printf("Payloads, %d allocations: arena %.2f ns, malloc/free %.2f ns each\n", ALLOCATIONS,
+           get_time_ms(t0, t1) * 1e6 / ALLOCATIONS, get_time_ms(t1, t2) * 1e6 / ALLOCATIONS);
+    free(blocks);
+    arena_destroy(arena);
+
+    // Whole queue: frames of OBJECTS transforms applied to a scene
+    Vector4 vertices[3] = {{0, 0, 0, 1}, {1, 0, 0, 1}, {0, 1, 0, 1}};
+    Triangle triangles[1] = {{0, 1, 2}};
+    Mesh* mesh = mesh_generate(vertices, 3, triangles, 1);
+    // OBJECTS copies of the triangle at the origin
+    Scene* scene = create_grid_scene(mesh, OBJECTS, 1, 0.0f, 1.0f);
+
+    Simulation sim = {command_queue_create(4 * OBJECTS, sizeof(Transform) * 2 * OBJECTS), QUEUE_FRAMES, 0, NULL};
+    double ms = run_queue(&sim, scene, NULL);
+    CommandStats s = sim.queue->stats;
+    printf("Queue, %d frames of %d transforms: %.1f ms, %.1f M commands/s, %.2f us per frame\n", QUEUE_FRAMES,
+           OBJECTS, ms, s.applied / ms / 1000.0, ms * 1000.0 / QUEUE_FRAMES);
+    printf("  retries: %d ring full, %d stalls on a busy arena\n", s.ring_full, s.stalls);
+    command_queue_destroy(sim.queue);
+
+    // Latency at a 1 kHz simulation rate: frame end to applied on the render thread
+    double* latency = malloc(sizeof(double) * LATENCY_FRAMES);
+    Uint64* sent = malloc(sizeof(Uint64) * LATENCY_FRAMES);
+    sim = (Simulation){command_queue_create(4 * OBJECTS, sizeof(Transform) * 2 * OBJECTS), LATENCY_FRAMES, 1, sent};
+    run_queue(&sim, scene, latency);
+    qsort(latency, LATENCY_FRAMES, sizeof(double), compare_double);
+    printf("Latency, %d paced frames: p50 %.3f ms, p99 %.3f ms, max %.3f ms\n", LATENCY_FRAMES,
+           latency[LATENCY_FRAMES / 2], latency[(int)(0.99 * (LATENCY_FRAMES - 1))], latency[LATENCY_FRAMES - 1]);
+    command_queue_destroy(sim.queue);
+
+    free(latency);
+    free(sent);
+    scene_destroy(scene);
+    mesh_destroy(mesh);
+    return 0;
+}
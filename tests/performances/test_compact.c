@@ -0,0 +1,102 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <SDL.h>
+
+#include "core/pipeline.h"
+#include "core/renderer.h"
+#include "../test_fixtures.h"
+
+// Grid sizes: 256 x 256 vertices is the largest grid with 16-bit indices
+static const int SUBDIVISIONS[] = {50, 100, 255, 400};
+#define SIZES (int)(sizeof(SUBDIVISIONS) / sizeof(SUBDIVISIONS[0]))
+
+#define ITERATIONS 100
+#define FB_W 320
+#define FB_H 240
+
+static inline double get_time_ms(Uint64 start, Uint64 end) {
+    return (double)((end - start) * 1000) / (double)SDL_GetPerformanceFrequency();
+}
+
+typedef struct Timing {
+    double transform_ms;
+    double lit_ms;
+    double raster_ms;
+} Timing;
+
+static Timing measure(const Mesh* mesh, Framebuffer* fb, const Lighting* lighting) {
+    Transform transform = NO_TRANSFORM;
+    transform.translation = (Vector3){0.0f, 0.0f, -3.0f};
+    transform.rotation = (Vector3){0.6f, 0.3f, 0.0f};
+    Camera cam = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, -1.0f}, {0.0f, 1.0f, 0.0f}};
+    Projection proj = {M_PI / 4.0f, (float)FB_W / FB_H, 0.1f, 100.0f};
+
+    Mesh* clipped = mesh_create_clipped(mesh);
+    uint32_t* colors = malloc(sizeof(uint32_t) * mesh->vertex_count);
+    Draw draw = {.clipped_mesh = clipped, .color = {255, 255, 255, 255}, .backend = RENDER_SOFTWARE};
+    Timing best = {1e30, 1e30, 1e30};
+
+    for (int i = 0; i < ITERATIONS; i++) {
+        Uint64 t0 = SDL_GetPerformanceCounter();
+        update_mesh(mesh, clipped, transform, cam, proj);
+        Uint64 t1 = SDL_GetPerformanceCounter();
+        update_mesh_lit(mesh, clipped, colors, 0xFFFFFFFFu, transform, cam, proj, lighting);
+        Uint64 t2 = SDL_GetPerformanceCounter();
+        framebuffer_clear(fb, 0xFF000000u);
+        draw_mesh_software(fb, &draw);
+        Uint64 t3 = SDL_GetPerformanceCounter();
+
+        best.transform_ms = fmin(best.transform_ms, get_time_ms(t0, t1));
+        best.lit_ms = fmin(best.lit_ms, get_time_ms(t1, t2));
+        best.raster_ms = fmin(best.raster_ms, get_time_ms(t2, t3));
+    }
+
+    free(colors);
+    mesh_destroy(clipped);
+    return best;
+}
+
+// Bytes streamed per frame: positions read and clip vertices written by the transform, indices read by the raster
+static size_t frame_bytes(const Mesh* mesh) {
+    return mesh_geometry_bytes(mesh) + sizeof(Vector4) * mesh->vertex_count;
+}
+
+int main(void) {
+    Framebuffer* fb = framebuffer_create(FB_W, FB_H);
+    Lighting lighting = {.ambient = {0.1f, 0.1f, 0.1f}};
+    lighting_add(&lighting, (Light){.type = LIGHT_DIRECTIONAL, .direction = {0.3f, -1.0f, -0.5f}, .color = {1, 1, 1}});
+    lighting_add(&lighting, (Light){.type = LIGHT_POINT, .position = {1, 1, -4}, .color = {1, 0.5f, 0.2f}, .range = 5});
+
+    printf("\n=== Compact vertex and index formats (best of %d) ===\n", ITERATIONS);
+    printf("%-8s %7s %6s | %10s %10s | %-12s | %11s %11s %11s\n", "grid", "verts", "index", "geometry", "per frame",
+           "positions", "update", "update_lit", "raster");
+
+    for (int s = 0; s < SIZES; s++) {
+        Mesh* full = create_grid_mesh(SUBDIVISIONS[s], 2.0f);
+        Mesh* compact = mesh_copy(full);
+        mesh_compact(compact);
+
+        Timing a = measure(full, fb, &lighting);
+        Timing b = measure(compact, fb, &lighting);
+
+        char grid[16];
+        snprintf(grid, sizeof(grid), "%dx%d", SUBDIVISIONS[s], SUBDIVISIONS[s]);
+        printf("%-8s %7d %6s | %7.2f MB %7.2f MB | %-12s | %8.3f ms %8.3f ms %8.3f ms\n", grid, full->vertex_count,
+               "32-bit", mesh_geometry_bytes(full) / 1048576.0, frame_bytes(full) / 1048576.0, "Vector4",
+               a.transform_ms, a.lit_ms, a.raster_ms);
+        printf("%-8s %7s %6s | %7.2f MB %7.2f MB | %-12s | %8.3f ms %8.3f ms %8.3f ms\n", "", "",
+               compact->triangles16 ? "16-bit" : "32-bit", mesh_geometry_bytes(compact) / 1048576.0,
+               frame_bytes(compact) / 1048576.0, "Vector3", b.transform_ms, b.lit_ms, b.raster_ms);
+        printf("%-8s %7s %6s | %9.0f%% %9.0f%% | %-12s | %10.2fx %10.2fx %10.2fx\n", "", "", "saved",
+               100.0 * (1.0 - (double)mesh_geometry_bytes(compact) / mesh_geometry_bytes(full)),
+               100.0 * (1.0 - (double)frame_bytes(compact) / frame_bytes(full)), "speedup",
+               a.transform_ms / b.transform_ms, a.lit_ms / b.lit_ms, a.raster_ms / b.raster_ms);
+
+        mesh_destroy(full);
+        mesh_destroy(compact);
+    }
+
+    framebuffer_destroy(fb);
+    return 0;
+}
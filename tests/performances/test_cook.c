@@ -0,0 +1,119 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <SDL.h>
+
+#include "core/cook.h"
+
+// Startup of a scene of MESHES triangle-soup meshes (16x16 to 47x47 quads) imported with every pass
+#define MESHES 300
+#define MIN_QUADS 16
+#define MAX_QUADS 48
+#define SOURCE_DIR "perf_cook_src"
+#define CACHE_DIR "perf_cook_cache"
+
+typedef enum { STARTUP_NO_CACHE, STARTUP_COLD, STARTUP_WARM } StartupMode;
+
+static const char* MODE_NAMES[] = {"no cache", "cold cache", "warm cache"};
+
+static inline double get_time_ms(Uint64 start, Uint64 end) {
+    return (double)((end - start) * 1000) / (double)SDL_GetPerformanceFrequency();
+}
+
+static void source_path(char* path, size_t size, int i) {
+    snprintf(path, size, "%s/mesh_%03d.obj", SOURCE_DIR, i);
+}
+
+// n x n quads of a height field, each with its own 4 corners, as an exporter writing polygons would
+static void write_soup(const char* path, int n, int seed) {
+    FILE* file = fopen(path, "w");
+    float h[MAX_QUADS + 1][MAX_QUADS + 1];
+    for (int z = 0; z <= n; z++)
+        for (int x = 0; x <= n; x++)
+            h[z][x] = 0.05f * ((x * 7 + z * 13 + seed) % 17);
+    for (int z = 0; z < n; z++)
+        for (int x = 0; x < n; x++) {
+            fprintf(file, "v %d %g %d\nv %d %g %d\n", x, h[z][x], z, x, h[z + 1][x], z + 1);
+            fprintf(file, "v %d %g %d\nv %d %g %d\n", x + 1, h[z + 1][x + 1], z + 1, x + 1, h[z][x + 1], z);
+            fprintf(file, "f -4 -3 -2 -1\n");
+        }
+    fclose(file);
+}
+
+// Bytes of the files of a directory
+static double directory_mb(const char* name) {
+    DIR* dir = opendir(name);
+    char path[512];
+    double bytes = 0.0;
+    for (struct dirent* entry; dir && (entry = readdir(dir));) {
+        struct stat info;
+        snprintf(path, sizeof(path), "%s/%s", name, entry->d_name);
+        if (entry->d_name[0] != '.' && stat(path, &info) == 0) bytes += (double)info.st_size;
+    }
+    if (dir) closedir(dir);
+    return bytes / (1024.0 * 1024.0);
+}
+
+static void remove_directory(const char* name) {
+    DIR* dir = opendir(name);
+    char path[512];
+    for (struct dirent* entry; dir && (entry = readdir(dir));) {
+        if (entry->d_name[0] == '.') continue;
+        snprintf(path, sizeof(path), "%s/%s", name, entry->d_name);
+        remove(path);
+    }
+    if (dir) closedir(dir);
+    rmdir(name);
+}
+
+int main(void) {
+    printf("\n=== Cooked asset cache (%d meshes, %dx%d to %dx%d quads) ===\n", MESHES, MIN_QUADS, MIN_QUADS,
+           MAX_QUADS - 1, MAX_QUADS - 1);
+
+    remove_directory(SOURCE_DIR);
+    remove_directory(CACHE_DIR);
+    mkdir(SOURCE_DIR, 0755);
+    char path[512];
+    for (int i = 0; i < MESHES; i++) {
+        source_path(path, sizeof(path), i);
+        write_soup(path, MIN_QUADS + i % (MAX_QUADS - MIN_QUADS), i);
+    }
+
+    // What every launch redoes without a cache: triangulation, welding, normals, bounds, compaction
+    CookOptions options = {1e-4f, 1, 1};
+    Mesh* meshes[MESHES];
+    long vertices = 0, triangles = 0;
+    double base = 0.0;
+
+    printf("%-12s %10s %10s %10s %10s %10s %10s %8s\n", "startup", "total ms", "us/mesh", "read+hash", "import",
+           "cooked rd", "cook wr", "speedup");
+    for (StartupMode mode = STARTUP_NO_CACHE; mode <= STARTUP_WARM; mode++) {
+        CookStats stats = {0};
+        vertices = triangles = 0;
+        Uint64 start = SDL_GetPerformanceCounter();
+        for (int i = 0; i < MESHES; i++) {
+            source_path(path, sizeof(path), i);
+            meshes[i] = cook_load_mesh(path, &options, mode == STARTUP_NO_CACHE ? NULL : CACHE_DIR, NULL, &stats);
+        }
+        double ms = get_time_ms(start, SDL_GetPerformanceCounter());
+
+        for (int i = 0; i < MESHES; i++) {
+            vertices += meshes[i]->vertex_count;
+            triangles += meshes[i]->triangle_count;
+            mesh_destroy(meshes[i]);
+        }
+        if (mode == STARTUP_NO_CACHE) base = ms;
+        printf("%-12s %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f %7.1fx   (%d hits)\n", MODE_NAMES[mode], ms,
+               1000.0 * ms / MESHES, stats.read_ms, stats.import_ms, stats.cache_ms, stats.write_ms, base / ms,
+               stats.hits);
+    }
+
+    printf("%ld vertices, %ld triangles after welding; sources %.1f MB, cooked %.1f MB (files in the OS cache)\n",
+           vertices, triangles, directory_mb(SOURCE_DIR), directory_mb(CACHE_DIR));
+
+    remove_directory(SOURCE_DIR);
+    remove_directory(CACHE_DIR);
+    return 0;
+}
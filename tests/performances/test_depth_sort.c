@@ -0,0 +1,108 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <SDL.h>
+
+#include "core/depth_sort.h"
+#include "core/pipeline.h"
+#include "../test_fixtures.h"
+
+// Same 200x200 grid as the performance suite (80,000 triangles), seen at an angle
+#define SUBDIVISIONS 200
+#define ITERATIONS 200
+
+static inline double get_time_ms(Uint64 start, Uint64 end) {
+    return (double)((end - start) * 1000) / (double)SDL_GetPerformanceFrequency();
+}
+
+// What a painter's sort usually looks like: float depths and a comparison sort
+typedef struct DepthEntry {
+    float depth;
+    int index;
+} DepthEntry;
+
+static int compare_far_first(const void* a, const void* b) {
+    float x = ((const DepthEntry*)a)->depth, y = ((const DepthEntry*)b)->depth;
+    return (x < y) - (x > y);
+}
+
+static void qsort_mesh(const Mesh* clipped, DepthEntry* entries, int* order) {
+    for (int t = 0; t < clipped->triangle_count; t++) {
+        Triangle tri = mesh_triangle(clipped, t);
+        float depth = clipped->vertices[tri.vert[0]].w + clipped->vertices[tri.vert[1]].w +
+                      clipped->vertices[tri.vert[2]].w;
+        entries[t] = (DepthEntry){depth, t};
+    }
+    qsort(entries, clipped->triangle_count, sizeof(DepthEntry), compare_far_first);
+    for (int t = 0; t < clipped->triangle_count; t++)
+        order[t] = entries[t].index;
+}
+
+// Both orders visit the same depths (qsort is not stable, ties may differ)
+static int same_depths(const Mesh* clipped, const int* a, const int* b) {
+    for (int t = 0; t < clipped->triangle_count; t++) {
+        Triangle x = mesh_triangle(clipped, a[t]), y = mesh_triangle(clipped, b[t]);
+        float dx = clipped->vertices[x.vert[0]].w + clipped->vertices[x.vert[1]].w + clipped->vertices[x.vert[2]].w;
+        float dy = clipped->vertices[y.vert[0]].w + clipped->vertices[y.vert[1]].w + clipped->vertices[y.vert[2]].w;
+        if (dx != dy) return 0;
+    }
+    return 1;
+}
+
+int main(void) {
+    Mesh* grid = create_grid_mesh(SUBDIVISIONS, 2.0f);
+    Mesh* clipped = mesh_create_clipped(grid);
+    Transform tilted = NO_TRANSFORM;
+    tilted.translation = (Vector3){0.0f, 0.0f, -2.5f};
+    tilted.rotation = (Vector3){0.7f, 0.4f, 0.0f};
+    Camera cam = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, -1.0f}, {0.0f, 1.0f, 0.0f}};
+    Projection proj = {M_PI / 3, 1.0f, 0.1f, 100.0f};
+    update_mesh(grid, clipped, tilted, cam, proj);
+
+    JobSystem* jobs = jobs_create(-1);
+    int n = clipped->triangle_count;
+    printf("\n=== Triangle depth sort (%dx%d grid, %d triangles, %d workers + caller) ===\n", SUBDIVISIONS,
+           SUBDIVISIONS, n, jobs->thread_count);
+
+    DepthEntry* entries = malloc(sizeof(DepthEntry) * n);
+    int* reference = malloc(sizeof(int) * n);
+    DepthSort* sort = depth_sort_create(n);
+
+    // Keys included in every time: each frame recomputes them from update_mesh
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < ITERATIONS; i++)
+        qsort_mesh(clipped, entries, reference);
+    double qsort_ms = get_time_ms(start, SDL_GetPerformanceCounter()) / ITERATIONS;
+
+    printf("%-28s %10s %10s %8s\n", "sort", "ms/frame", "ns/tri", "speedup");
+    printf("%-28s %10.3f %10.1f %7.1fx\n", "qsort back to front", qsort_ms, 1e6 * qsort_ms / n, 1.0);
+
+    struct {
+        const char* name;
+        DepthOrder order;
+        JobSystem* jobs;
+    } runs[] = {
+        {"radix back to front", DEPTH_BACK_TO_FRONT, NULL},
+        {"radix front to back", DEPTH_FRONT_TO_BACK, NULL},
+        {"radix back to front, jobs", DEPTH_BACK_TO_FRONT, jobs},
+        {"radix front to back, jobs", DEPTH_FRONT_TO_BACK, jobs},
+    };
+    int matches = 1;
+    for (int r = 0; r < (int)(sizeof(runs) / sizeof(runs[0])); r++) {
+        start = SDL_GetPerformanceCounter();
+        for (int i = 0; i < ITERATIONS; i++)
+            depth_sort_mesh(sort, clipped, runs[r].order, runs[r].jobs);
+        double ms = get_time_ms(start, SDL_GetPerformanceCounter()) / ITERATIONS;
+        if (runs[r].order == DEPTH_BACK_TO_FRONT) matches &= same_depths(clipped, sort->order, reference);
+        printf("%-28s %10.3f %10.1f %7.1fx\n", runs[r].name, ms, 1e6 * ms / n, qsort_ms / ms);
+    }
+    printf("Radix back-to-front depths match qsort: %s\n", matches ? "yes" : "NO");
+
+    depth_sort_destroy(sort);
+    jobs_destroy(jobs);
+    free(entries);
+    free(reference);
+    mesh_destroy(clipped);
+    mesh_destroy(grid);
+    return 0;
+}
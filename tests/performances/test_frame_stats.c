@@ -0,0 +1,95 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <SDL.h>
+
+#include "core/scene.h"
+#include "core/frame_stats.h"
+#include "../test_fixtures.h"
+
+// GRID x GRID cubes in front of the camera, drawn as engine update_scene frames
+#define GRID 32
+#define SPACING 2.5f
+#define FRAMES 100
+#define COLLECT_FRAMES 2000
+
+// Collection must stay under this share of the frame time
+#define BUDGET_PERCENT 1.0
+
+#define SCREEN_W 640
+#define SCREEN_H 480
+
+static inline double get_time_ms(Uint64 start, Uint64 end) {
+    return (double)((end - start) * 1000) / (double)SDL_GetPerformanceFrequency();
+}
+
+// What the engine adds to a frame: start_frame, update_scene and end_frame make the same calls
+static void collect_frame(EngineFrameStats* stats, const Scene* scene, const Framebuffer* fb) {
+    frame_stats_begin(stats);
+    frame_stats_add_scene(stats, scene);
+    frame_stats_stage(stats, FRAME_UPDATE_MS);
+    frame_stats_stage(stats, FRAME_RASTER_MS);
+    frame_stats_stage(stats, FRAME_PRESENT_MS);
+    frame_stats_add_frame(stats, fb->pixels_drawn);
+    frame_stats_end(stats);
+}
+
+int main(void) {
+    printf("\n=== Frame statistics (%d objects) ===\n", GRID * GRID);
+
+    Mesh* cube = create_cube_mesh();
+    Scene* scene = create_grid_scene(cube, GRID, GRID, SPACING, 0.8f);
+    for (int i = 0; i < scene->count; i++)
+        scene->objects[i].draw.backend = RENDER_SOFTWARE;
+    Camera cam = {{0.0f, 4.0f, 6.0f}, {0.0f, 0.0f, -GRID * SPACING / 2}, {0.0f, 1.0f, 0.0f}};
+    Projection proj = {M_PI / 3, (float)SCREEN_W / SCREEN_H, 0.1f, 200.0f};
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, SCREEN_W, SCREEN_H, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer* sdl = SDL_CreateSoftwareRenderer(surface);
+    Framebuffer* fb = framebuffer_create(SCREEN_W, SCREEN_H);
+    RenderQueue* queue = render_queue_create(GRID * GRID);
+    EngineFrameStats* stats = frame_stats_create(FRAME_STATS_WINDOW);
+    FILE* csv = tmpfile();
+    frame_stats_set_csv(stats, csv);
+
+    // Frame work without collection: culling, transform, sorted software wireframes
+    double frame_ms = 0.0;
+    for (int f = 0; f < FRAMES; f++) {
+        Uint64 start = SDL_GetPerformanceCounter();
+        scene_update(scene, cam, proj, NULL);
+        render_queue_reset(queue);
+        for (int i = 0; i < scene->count; i++)
+            if (scene->objects[i].visible) render_queue_push(queue, &scene->objects[i].draw, 0, 0.5f);
+        render_queue_sort(queue);
+        framebuffer_clear(fb, 0xFF000000u);
+        render_queue_execute(queue, RENDER_SOFTWARE, sdl, fb, SCREEN_W, SCREEN_H);
+        frame_ms += get_time_ms(start, SDL_GetPerformanceCounter()) / FRAMES;
+    }
+
+    // Collection alone, CSV row included
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int f = 0; f < COLLECT_FRAMES; f++)
+        collect_frame(stats, scene, fb);
+    double collect_ms = get_time_ms(start, SDL_GetPerformanceCounter()) / COLLECT_FRAMES;
+
+    FrameSummary lines = frame_stats_summary(stats, FRAME_LINES);
+    double percent = 100.0 * collect_ms / frame_ms;
+    printf("Frame %.3f ms (%d draws, %.0f lines, %zu pixels)\n", frame_ms, queue->count, lines.avg,
+           fb->pixels_drawn / FRAMES);
+    printf("Collection %.2f us per frame: %.3f%% of the frame (budget %.1f%%)\n", collect_ms * 1000.0, percent,
+           BUDGET_PERCENT);
+
+    fclose(csv);
+    frame_stats_destroy(stats);
+    render_queue_destroy(queue);
+    framebuffer_destroy(fb);
+    SDL_DestroyRenderer(sdl);
+    SDL_FreeSurface(surface);
+    scene_destroy(scene);
+    mesh_destroy(cube);
+
+    if (percent >= BUDGET_PERCENT) {
+        printf("Frame statistics exceed their budget\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,141 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <SDL.h>
+
+#include "core/pipeline.h"
+#include "core/renderer.h"
+#include "../test_fixtures.h"
+
+// Engine-sized target, frames per measurement
+#define SCREEN_W 800
+#define SCREEN_H 600
+#define FRAMES 200
+
+// Sparse scene: one small cube; full scene: a wall of GRID x GRID cubes filling the view
+#define GRID 12
+#define BACKGROUND 0xFF000000u
+
+static inline double get_time_ms(Uint64 start, Uint64 end) {
+    return (double)((end - start) * 1000) / (double)SDL_GetPerformanceFrequency();
+}
+
+typedef struct DrawSet {
+    const char* name;
+    Draw* draws;
+    int count;
+} DrawSet;
+
+// count cubes on a grid facing the camera, lit and drawn with the given shading
+static DrawSet create_draw_set(const char* name, const Mesh* cube, int grid, float spacing, float z, ShadeMode shading) {
+    Camera cam = {{0.0f, 0.0f, 5.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}};
+    Projection proj = {M_PI / 3, (float)SCREEN_W / SCREEN_H, 0.1f, 100.0f};
+    Lighting lighting = {.ambient = {0.2f, 0.2f, 0.2f}};
+    lighting_add(&lighting, (Light){.type = LIGHT_DIRECTIONAL, .direction = {0.3f, -0.5f, -1.0f}, .color = {1, 1, 1}});
+
+    DrawSet scene = {name, malloc(sizeof(Draw) * grid * grid), grid * grid};
+    for (int i = 0; i < scene.count; i++) {
+        Transform t = NO_TRANSFORM;
+        t.translation = (Vector3){((i % grid) - (grid - 1) / 2.0f) * spacing, ((i / grid) - (grid - 1) / 2.0f) * spacing, z};
+        t.rotation = (Vector3){0.5f, 0.7f, 0.0f};
+        Draw* draw = &scene.draws[i];
+        *draw = (Draw){.clipped_mesh = mesh_create_clipped(cube), .color = {200, 80, 40, 255},
+                       .backend = RENDER_SOFTWARE, .shading = shading};
+        draw->vertex_colors = malloc(sizeof(uint32_t) * cube->vertex_count);
+        update_mesh_lit(cube, draw->clipped_mesh, draw->vertex_colors, color_to_argb(draw->color), t, cam, proj,
+                        &lighting);
+    }
+    return scene;
+}
+
+static void destroy_draw_set(DrawSet* scene) {
+    for (int i = 0; i < scene->count; i++) {
+        mesh_destroy(scene->draws[i].clipped_mesh);
+        free(scene->draws[i].vertex_colors);
+    }
+    free(scene->draws);
+}
+
+// Into the streaming texture, as the engine presents a frame
+static void present(Framebuffer* fb, SDL_Texture* texture) {
+    void* pixels;
+    int pitch;
+    if (SDL_LockTexture(texture, NULL, &pixels, &pitch) == 0) {
+        framebuffer_resolve_to(fb, pixels, pitch / (int)sizeof(uint32_t), fb->width, fb->height);
+        SDL_UnlockTexture(texture);
+    }
+}
+
+static int count_color_tiles(const Framebuffer* fb) {
+    int count = 0;
+    for (int i = 0; i < fb->tiles_x * fb->tiles_y; i++)
+        count += (fb->tile_flags[i] & FRAMEBUFFER_TILE_COLOR) != 0;
+    return count;
+}
+
+static void run_draw_set(const DrawSet* scene, Framebuffer* fb, SDL_Texture* texture) {
+    double clear_ms = 0.0, draw_ms = 0.0, present_ms = 0.0;
+    size_t fills_before = fb->tiles_filled;
+    int color_tiles = 0;
+
+    for (int f = 0; f < FRAMES; f++) {
+        Uint64 t0 = SDL_GetPerformanceCounter();
+        framebuffer_clear(fb, BACKGROUND);
+        framebuffer_clear_depth(fb);
+        Uint64 t1 = SDL_GetPerformanceCounter();
+        for (int i = 0; i < scene->count; i++)
+            draw_mesh_software(fb, &scene->draws[i]);
+        Uint64 t2 = SDL_GetPerformanceCounter();
+        present(fb, texture);
+        Uint64 t3 = SDL_GetPerformanceCounter();
+        color_tiles = count_color_tiles(fb);
+
+        clear_ms += get_time_ms(t0, t1) / FRAMES;
+        draw_ms += get_time_ms(t1, t2) / FRAMES;
+        present_ms += get_time_ms(t2, t3) / FRAMES;
+    }
+
+    /*
+     * Memory traffic spent on clears and on reading the color buffer for the
+     * upload. Linear: both buffers written in full, colors read in full.
+     * Tiled: tiles filled on first touch, drawn color tiles read by the resolve.
+     */
+    double tile_mb = FRAMEBUFFER_TILE_PIXELS * sizeof(uint32_t) / 1048576.0;
+    double fills = (double)(fb->tiles_filled - fills_before) / FRAMES;
+    double linear_mb = 3.0 * SCREEN_W * SCREEN_H * sizeof(uint32_t) / 1048576.0;
+    double tiled_mb = (fills + color_tiles) * tile_mb;
+
+    printf("%-12s clear %6.3f ms | draw %6.3f ms | present %6.3f ms | frame %6.3f ms\n", scene->name, clear_ms, draw_ms,
+           present_ms, clear_ms + draw_ms + present_ms);
+    printf("%-12s %5.1f%% color tiles drawn, clear + upload traffic %.2f MB (linear layout %.2f MB)\n", "",
+           100.0 * color_tiles / (fb->tiles_x * fb->tiles_y), tiled_mb, linear_mb);
+}
+
+int main(void) {
+    printf("\n=== Tiled framebuffer (%dx%d, %dx%d tiles, %d frames) ===\n", SCREEN_W, SCREEN_H, FRAMEBUFFER_TILE,
+           FRAMEBUFFER_TILE, FRAMES);
+
+    Mesh* cube = create_cube_mesh();
+    mesh_compute_normals(cube, NULL);
+    Framebuffer* fb = framebuffer_create(SCREEN_W, SCREEN_H);
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, SCREEN_W, SCREEN_H, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer* sdl = SDL_CreateSoftwareRenderer(surface);
+    SDL_Texture* texture = SDL_CreateTexture(sdl, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, SCREEN_W,
+                                             SCREEN_H);
+
+    DrawSet scenes[3] = {
+        create_draw_set("Sparse flat", cube, 1, 0.0f, -4.0f, SHADE_FLAT),
+        create_draw_set("Sparse wire", cube, 1, 0.0f, -4.0f, SHADE_WIREFRAME),
+        create_draw_set("Full flat", cube, GRID, 1.6f, -10.0f, SHADE_FLAT),
+    };
+    for (int s = 0; s < 3; s++) {
+        run_draw_set(&scenes[s], fb, texture);
+        destroy_draw_set(&scenes[s]);
+    }
+
+    SDL_DestroyTexture(texture);
+    SDL_DestroyRenderer(sdl);
+    SDL_FreeSurface(surface);
+    framebuffer_destroy(fb);
+    mesh_destroy(cube);
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <SDL.h>
+
+#include "math/matrix.h"
+
+#define COUNT 4096
+#define REPEAT 500
+
+static Vector4 vectors_a[COUNT];
+static Vector4 vectors_b[COUNT];
+static Vector4 vectors_out[COUNT];
+static Matrix matrices_a[COUNT / 16];
+static Matrix matrices_b[COUNT / 16];
+static Matrix matrices_out[COUNT / 16];
+
+static volatile float sink; // keeps results alive
+
+static inline double get_time_ns(Uint64 start, Uint64 end) {
+    return (double)(end - start) * 1e9 / (double)SDL_GetPerformanceFrequency();
+}
+
+static float random_float(void) {
+    return (float)rand() / RAND_MAX * 2.0f - 1.0f;
+}
+
+static void fill_inputs(void) {
+    srand(42);
+    for (int i = 0; i < COUNT; i++) {
+        vectors_a[i] = (Vector4){random_float(), random_float(), random_float(), 1.0f};
+        vectors_b[i] = (Vector4){random_float(), random_float(), random_float(), 1.0f};
+    }
+    // Diagonally dominant, hence invertible
+    for (int i = 0; i < COUNT / 16; i++) {
+        for (int r = 0; r < MATRIX_N; r++) {
+            for (int c = 0; c < MATRIX_N; c++) {
+                matrices_a[i].m[r][c] = random_float() + (r == c ? 4.0f : 0.0f);
+                matrices_b[i].m[r][c] = random_float() + (r == c ? 4.0f : 0.0f);
+            }
+        }
+    }
+}
+
+// Times REPEAT passes of `body` over `n` elements, returns ns per element
+#define BENCH(n, body) ({                                       \
+        Uint64 t0_ = SDL_GetPerformanceCounter();               \
+        for (int r_ = 0; r_ < REPEAT; r_++)                     \
+            for (int i = 0; i < (n); i++) { body; }             \
+        Uint64 t1_ = SDL_GetPerformanceCounter();               \
+        get_time_ns(t0_, t1_) / ((double)(n) * REPEAT);         \
+    })
+
+static void print_row(const char* name, double scalar_ns, double simd_ns) {
+    printf("%-24s %10.2f %10.2f %9.2fx\n", name, scalar_ns, simd_ns, scalar_ns / simd_ns);
+}
+
+int main() {
+    printf("=== MATH MICROBENCHMARKS (%s backend) ===\n\n", MATH_BACKEND);
+    fill_inputs();
+
+    const int m = COUNT / 16;
+    float acc = 0.0f;
+
+    printf("%-24s %10s %10s %10s\n", "function", "scalar ns", "simd ns", "speedup");
+
+    double s, v;
+
+    s = BENCH(COUNT, vectors_out[i] = add4_scalar(vectors_a[i], vectors_b[i]));
+    v = BENCH(COUNT, vectors_out[i] = add4(vectors_a[i], vectors_b[i]));
+    print_row("add4", s, v);
+
+    s = BENCH(COUNT, acc += dot4_scalar(vectors_a[i], vectors_b[i]));
+    v = BENCH(COUNT, acc += dot4(vectors_a[i], vectors_b[i]));
+    print_row("dot4", s, v);
+
+    s = BENCH(COUNT, vectors_out[i] = cross4_scalar(vectors_a[i], vectors_b[i]));
+    v = BENCH(COUNT, vectors_out[i] = cross4(vectors_a[i], vectors_b[i]));
+    print_row("cross4", s, v);
+
+    s = BENCH(COUNT, vectors_out[i] = normalize4_scalar(vectors_a[i]));
+    v = BENCH(COUNT, vectors_out[i] = normalize4(vectors_a[i]));
+    print_row("normalize4", s, v);
+
+    v = BENCH(COUNT, vectors_out[i] = normalize4_fast(vectors_a[i]));
+    print_row("normalize4_fast", s, v);
+
+    s = BENCH(m, matrix_multiply_scalar(&matrices_out[i], &matrices_a[i], &matrices_b[i]));
+    v = BENCH(m, matrix_multiply_simd(&matrices_out[i], &matrices_a[i], &matrices_b[i]));
+    print_row("matrix_multiply", s, v);
+
+    s = BENCH(COUNT, vectors_out[i] = matrix_transform_scalar(&matrices_a[i & (m - 1)], vectors_a[i]));
+    v = BENCH(COUNT, vectors_out[i] = matrix_transform_simd(&matrices_a[i & (m - 1)], vectors_a[i]));
+    print_row("matrix_transform", s, v);
+
+    s = BENCH(1, matrix_transform_array_scalar(&matrices_a[0], vectors_a, vectors_out, COUNT)) / COUNT;
+    v = BENCH(1, matrix_transform_array_simd(&matrices_a[0], vectors_a, vectors_out, COUNT)) / COUNT;
+    print_row("matrix_transform_array", s, v);
+
+    s = BENCH(m, matrix_transpose_scalar(&matrices_out[i], &matrices_a[i]));
+    v = BENCH(m, matrix_transpose_simd(&matrices_out[i], &matrices_a[i]));
+    print_row("matrix_transpose", s, v);
+
+    s = BENCH(m, matrix_inverse_scalar(&matrices_out[i], &matrices_a[i]));
+    v = BENCH(m, matrix_inverse_simd(&matrices_out[i], &matrices_a[i]));
+    print_row("matrix_inverse", s, v);
+
+    sink = acc + vectors_out[COUNT - 1].x + matrices_out[m - 1].m[3][3];
+    printf("\n(matrix_transform_array is per vector)\n");
+
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <SDL.h>
+
+#include "core/pipeline.h"
+#include "core/renderer.h"
+#include "../test_fixtures.h"
+
+// Output split into a grid of views, terrain-like lit mesh seen by every camera
+#define SCREEN_W 800
+#define SCREEN_H 600
+#define GRID_SUBDIVISIONS 159   // 160 x 160 vertices
+#define GRID_SIZE 16.0f
+#define FRAMES 100
+#define MAX_VIEWS 9
+#define BACKGROUND 0xFF000000u
+#define BASE_COLOR 0xFF60A040u
+
+typedef enum { VIEWS_NAIVE, VIEWS_SHARED, VIEWS_SHARED_THREADS } ViewMode;
+
+static inline double get_time_ms(Uint64 start, Uint64 end) {
+    return (double)((end - start) * 1000) / (double)SDL_GetPerformanceFrequency();
+}
+
+// count views tiled over the screen, cameras spread on a circle around the mesh
+static void create_views(View* views, int count) {
+    int side = (int)ceilf(sqrtf((float)count));
+    int w = SCREEN_W / side, h = SCREEN_H / side;
+    for (int v = 0; v < count; v++) {
+        float a = v * 2.0f * (float)M_PI / count;
+        Camera cam = {{12.0f * cosf(a), 6.0f, 12.0f * sinf(a)}, {0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}};
+        Projection proj = {M_PI / 3, (float)w / h, 0.1f, 100.0f};
+        views[v] = (View){cam, proj, {(v % side) * w, (v / side) * h, w, h}};
+    }
+}
+
+// Vertex work of one frame: every view from scratch, or world space once and a projection per view
+static void transform_views(ViewMode mode, const Mesh* grid, const View* views, int count, Vector4* world,
+                            Draw* draws, Mesh* const* clipped, const Lighting* lighting, JobSystem* jobs) {
+    if (mode == VIEWS_NAIVE) {
+        for (int v = 0; v < count; v++)
+            update_mesh_lit(grid, clipped[v], draws[v].vertex_colors, BASE_COLOR, NO_TRANSFORM, views[v].camera,
+                            views[v].projection, lighting);
+        return;
+    }
+
+    // Views share the colors of the first draw
+    update_mesh_world_lit(grid, world, draws[0].vertex_colors, BASE_COLOR, NO_TRANSFORM, lighting);
+    update_mesh_views(world, grid->vertex_count, views, count, clipped, mode == VIEWS_SHARED_THREADS ? jobs : NULL);
+}
+
+// Average vertex ms per frame, and raster ms per frame (every view into its viewport) when fb is set
+static double run(ViewMode mode, int count, const Mesh* grid, Vector4* world, Draw* draws, Mesh* const* clipped,
+                  const Lighting* lighting, JobSystem* jobs, Framebuffer* fb, double* raster_ms) {
+    View views[MAX_VIEWS];
+    create_views(views, count);
+    double vertex_ms = 0.0;
+    *raster_ms = 0.0;
+
+    for (int f = 0; f < FRAMES; f++) {
+        Uint64 t0 = SDL_GetPerformanceCounter();
+        transform_views(mode, grid, views, count, world, draws, clipped, lighting, jobs);
+        Uint64 t1 = SDL_GetPerformanceCounter();
+        vertex_ms += get_time_ms(t0, t1) / FRAMES;
+
+        if (!fb) continue;
+        framebuffer_clear(fb, BACKGROUND);
+        framebuffer_clear_depth(fb);
+        for (int v = 0; v < count; v++) {
+            Draw draw = draws[v];
+            if (mode != VIEWS_NAIVE) draw.vertex_colors = draws[0].vertex_colors;
+            framebuffer_set_viewport(fb, views[v].viewport);
+            draw_mesh_software(fb, &draw);
+        }
+        framebuffer_resolve(fb);
+        *raster_ms += get_time_ms(t1, SDL_GetPerformanceCounter()) / FRAMES;
+    }
+    return vertex_ms;
+}
+
+int main(void) {
+    printf("\n=== Multi-view rendering (%s backend, %dx%d) ===\n", MATH_BACKEND, SCREEN_W, SCREEN_H);
+
+    Mesh* grid = create_grid_mesh(GRID_SUBDIVISIONS, GRID_SIZE);
+    Framebuffer* fb = framebuffer_create(SCREEN_W, SCREEN_H);
+    JobSystem* jobs = jobs_create(-1);
+    Vector4* world = malloc(sizeof(Vector4) * grid->vertex_count);
+
+    Lighting lighting = {.ambient = {0.15f, 0.15f, 0.15f}};
+    lighting_add(&lighting, (Light){.type = LIGHT_DIRECTIONAL, .direction = {0.3f, -0.5f, -1.0f}, .color = {1, 1, 1}});
+    lighting_add(&lighting, (Light){.type = LIGHT_POINT, .position = {2, 2, 2}, .color = {1, 0.6f, 0.2f}, .range = 8});
+    lighting_add(&lighting, (Light){.type = LIGHT_POINT, .position = {-3, 1, -2}, .color = {0.2f, 0.4f, 1}, .range = 6});
+
+    Draw draws[MAX_VIEWS];
+    Mesh* clipped[MAX_VIEWS];
+    for (int v = 0; v < MAX_VIEWS; v++) {
+        clipped[v] = mesh_create_clipped(grid);
+        draws[v] = (Draw){.clipped_mesh = clipped[v], .color = {96, 160, 64, 255}, .backend = RENDER_SOFTWARE,
+                          .shading = SHADE_GOURAUD, .vertex_colors = malloc(sizeof(uint32_t) * grid->vertex_count)};
+    }
+
+    printf("Mesh: %d vertices, %d triangles, %d lights\n", grid->vertex_count, grid->triangle_count, lighting.count);
+    printf("Job system: %d worker threads + caller\n\n", jobs->thread_count);
+
+    double raster_ms;
+    run(VIEWS_NAIVE, 1, grid, world, draws, clipped, &lighting, jobs, NULL, &raster_ms); // warm up
+
+    printf("%-6s %14s %14s %14s %9s %14s\n", "views", "naive ms", "shared ms", "threads ms", "speedup", "raster ms");
+    const int counts[3] = {1, 4, 9};
+    for (int i = 0; i < 3; i++) {
+        int n = counts[i];
+        double naive = run(VIEWS_NAIVE, n, grid, world, draws, clipped, &lighting, jobs, NULL, &raster_ms);
+        double shared = run(VIEWS_SHARED, n, grid, world, draws, clipped, &lighting, jobs, NULL, &raster_ms);
+        double threads = run(VIEWS_SHARED_THREADS, n, grid, world, draws, clipped, &lighting, jobs, NULL, &raster_ms);
+        run(VIEWS_SHARED, n, grid, world, draws, clipped, &lighting, jobs, fb, &raster_ms);
+        printf("%-6d %14.3f %14.3f %14.3f %8.2fx %14.3f\n", n, naive, shared, threads, naive / shared, raster_ms);
+    }
+
+    for (int v = 0; v < MAX_VIEWS; v++) {
+        mesh_destroy(clipped[v]);
+        free(draws[v].vertex_colors);
+    }
+    free(world);
+    jobs_destroy(jobs);
+    framebuffer_destroy(fb);
+    mesh_destroy(grid);
+    return 0;
+}
@@ -0,0 +1,154 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <SDL.h>
+
+#include "core/scene.h"
+
+// City block: GRID x GRID buildings, each a subdivided box
+#define GRID 40
+#define BLOCK_SPACING 3.0f
+#define BUILDING_SUBDIVISIONS 8
+#define FRAMES 50
+
+#define HIZ_WIDTH 256
+#define HIZ_HEIGHT 144
+#define AUTO_OCCLUDERS 16
+
+static inline double get_time_ms(Uint64 start, Uint64 end) {
+    return (double)((end - start) * 1000) / (double)SDL_GetPerformanceFrequency();
+}
+
+// Unit box whose 6 faces are n x n quad grids
+static Mesh* create_building_mesh(int n) {
+    int face_vertices = (n + 1) * (n + 1);
+    int vertex_count = 6 * face_vertices;
+    int triangle_count = 6 * n * n * 2;
+
+    Vector4* vertices = malloc(sizeof(Vector4) * vertex_count);
+    Triangle* triangles = malloc(sizeof(Triangle) * triangle_count);
+
+    int v = 0, t = 0;
+    for (int face = 0; face < 6; face++) {
+        int axis = face / 2;
+        float side = (face % 2) ? 1.0f : -1.0f;
+        int base = v;
+
+        for (int i = 0; i <= n; i++) {
+            for (int j = 0; j <= n; j++) {
+                float a = (float)i / n * 2.0f - 1.0f;
+                float b = (float)j / n * 2.0f - 1.0f;
+                Vector4 p = {0, 0, 0, 1.0f};
+                p.v[axis] = side;
+                p.v[(axis + 1) % 3] = a;
+                p.v[(axis + 2) % 3] = b;
+                vertices[v++] = p;
+            }
+        }
+
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                int q = base + i * (n + 1) + j;
+                triangles[t++] = (Triangle){{q, q + 1, q + n + 1}};
+                triangles[t++] = (Triangle){{q + 1, q + n + 2, q + n + 1}};
+            }
+        }
+    }
+
+    Mesh* mesh = mesh_generate(vertices, vertex_count, triangles, triangle_count);
+    free(vertices);
+    free(triangles);
+    return mesh;
+}
+
+static Scene* create_city(const Mesh* building) {
+    Scene* scene = scene_create(GRID * GRID);
+    srand(42);
+
+    for (int i = 0; i < GRID; i++) {
+        for (int j = 0; j < GRID; j++) {
+            float height = 2.0f + (rand() % 100) / 100.0f * 6.0f;
+            Transform t = NO_TRANSFORM;
+            t.translation = (Vector3){i * BLOCK_SPACING, height, -j * BLOCK_SPACING};
+            t.scale = (Vector3){1.0f, height, 1.0f};
+            scene_add(scene, building, (Color){200, 200, 200, 255}, t, 0);
+        }
+    }
+
+    return scene;
+}
+
+// Street-level camera walking down the street between rows 0 and 1
+static Camera camera_at(int frame) {
+    float z = 2.0f - frame * 0.2f;
+    return (Camera){
+        .pos    = {1.5f, 1.7f, z},
+        .target = {1.5f + 0.6f, 1.7f, z - 1.0f},
+        .up     = {0.0f, 1.0f, 0.0f}
+    };
+}
+
+static double run_frames(Scene* scene, Projection proj, OcclusionStats* total) {
+    *total = (OcclusionStats){0};
+    double elapsed = 0.0;
+
+    for (int f = 0; f < FRAMES; f++) {
+        Uint64 t0 = SDL_GetPerformanceCounter();
+        scene_update(scene, camera_at(f), proj, NULL);
+        Uint64 t1 = SDL_GetPerformanceCounter();
+        elapsed += get_time_ms(t0, t1);
+
+        if (scene->culler) {
+            OcclusionStats s = scene->culler->stats;
+            total->tested += s.tested;
+            total->occluders += s.occluders;
+            total->frustum_culled += s.frustum_culled;
+            total->occluded += s.occluded;
+            total->vertices_skipped += s.vertices_skipped;
+        }
+    }
+
+    return elapsed / FRAMES;
+}
+
+int main() {
+    printf("=== OCCLUSION CULLING PERFORMANCE TESTS ===\n\n");
+
+    Mesh* building = create_building_mesh(BUILDING_SUBDIVISIONS);
+    Scene* city = create_city(building);
+
+    Projection proj = {
+        .fov = M_PI / 3.0f,
+        .aspect_ratio = 16.0f / 9.0f,
+        .near = 0.1f,
+        .far = 200.0f
+    };
+
+    long total_vertices = (long)city->count * building->vertex_count;
+    printf("City block: %d buildings, %d vertices each (%ld vertices per frame)\n\n",
+           city->count, building->vertex_count, total_vertices);
+
+    // Warm up
+    OcclusionStats stats;
+    run_frames(city, proj, &stats);
+
+    double no_cull_ms = run_frames(city, proj, &stats);
+
+    scene_set_culler(city, occlusion_create(HIZ_WIDTH, HIZ_HEIGHT, AUTO_OCCLUDERS));
+    double cull_ms = run_frames(city, proj, &stats);
+
+    printf("📊 scene_update without culling: %.3f ms/frame\n", no_cull_ms);
+    printf("📊 scene_update with HiZ culling: %.3f ms/frame (%.2fx)\n", cull_ms, no_cull_ms / cull_ms);
+    printf("   Occluders/frame:        %.1f\n", (double)stats.occluders / FRAMES);
+    printf("   Tested/frame:           %.1f\n", (double)stats.tested / FRAMES);
+    printf("   Frustum culled/frame:   %.1f\n", (double)stats.frustum_culled / FRAMES);
+    printf("   Occluded/frame:         %.1f\n", (double)stats.occluded / FRAMES);
+    printf("   Vertices skipped/frame: %.0f (%.1f%%)\n",
+           (double)stats.vertices_skipped / FRAMES,
+           100.0 * stats.vertices_skipped / FRAMES / total_vertices);
+
+    occlusion_destroy(city->culler);
+    scene_destroy(city);
+    mesh_destroy(building);
+
+    return 0;
+}
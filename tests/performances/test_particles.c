@@ -0,0 +1,152 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <SDL.h>
+
+#include "core/particles.h"
+
+// Fountain of 1M particles kept full: dead ones are respawned between updates
+#define PARTICLES 1000000
+#define FRAMES 60
+#define DT (1.0f / 60.0f)
+#define SCREEN_W 800
+#define SCREEN_H 600
+#define BACKGROUND 0xFF000000u
+
+static const Vector3 GRAVITY = {0.0f, -9.81f, 0.0f};
+
+typedef enum { UPDATE_AOS, UPDATE_SCALAR, UPDATE_SIMD, UPDATE_SIMD_THREADS } UpdateMode;
+
+static const char* MODE_NAMES[] = {"AoS, swap-remove", "SoA scalar", "SoA SIMD", "SoA SIMD + jobs"};
+
+// Array of structures baseline: one struct per particle, dead ones replaced by the last one
+typedef struct AosParticle {
+    Vector3 position;
+    Vector3 velocity;
+    float life;
+    uint32_t color;
+} AosParticle;
+
+static inline double get_time_ms(Uint64 start, Uint64 end) {
+    return (double)((end - start) * 1000) / (double)SDL_GetPerformanceFrequency();
+}
+
+static float random_float(float lo, float hi) {
+    return lo + (hi - lo) * (float)rand() / RAND_MAX;
+}
+
+static void emit(Vector3* position, Vector3* velocity, float* life) {
+    *position = (Vector3){random_float(-0.2f, 0.2f), 0.0f, random_float(-0.2f, 0.2f)};
+    *velocity = (Vector3){random_float(-2, 2), random_float(6, 10), random_float(-2, 2)};
+    *life = random_float(0.5f, 2.0f);
+}
+
+static void refill(ParticleSystem* ps) {
+    Vector3 p, v;
+    float life;
+    while (ps->count < ps->capacity) {
+        emit(&p, &v, &life);
+        particles_spawn(ps, p, v, life, 0xFFFFC040u);
+    }
+}
+
+static int update_aos(AosParticle* particles, int count) {
+    for (int i = 0; i < count;) {
+        AosParticle* p = &particles[i];
+        p->velocity.x += GRAVITY.x * DT;
+        p->velocity.y += GRAVITY.y * DT;
+        p->velocity.z += GRAVITY.z * DT;
+        p->position.x += p->velocity.x * DT;
+        p->position.y += p->velocity.y * DT;
+        p->position.z += p->velocity.z * DT;
+        p->life -= DT;
+        if (p->life > 0.0f) i++;
+        else particles[i] = particles[--count];
+    }
+    return count;
+}
+
+// Average update ms per frame
+static double run(UpdateMode mode, ParticleSystem* ps, AosParticle* aos, JobSystem* jobs, double* died) {
+    double ms = 0.0;
+    *died = 0.0;
+    int count = PARTICLES;
+
+    // Same particles for every mode
+    srand(47);
+    for (int i = 0; i < PARTICLES; i++) {
+        emit(&aos[i].position, &aos[i].velocity, &aos[i].life);
+        aos[i].color = 0xFFFFC040u;
+    }
+    ps->count = 0;
+    srand(47);
+    refill(ps);
+
+    for (int f = 0; f < FRAMES; f++) {
+        if (mode == UPDATE_AOS) {
+            for (; count < PARTICLES; count++)
+                emit(&aos[count].position, &aos[count].velocity, &aos[count].life);
+        } else {
+            refill(ps);
+        }
+
+        Uint64 t0 = SDL_GetPerformanceCounter();
+        switch (mode) {
+        case UPDATE_AOS:          count = update_aos(aos, PARTICLES); break;
+        case UPDATE_SCALAR:       particles_update_scalar(ps, DT, GRAVITY); count = ps->count; break;
+        case UPDATE_SIMD:         particles_update(ps, DT, GRAVITY, NULL); count = ps->count; break;
+        case UPDATE_SIMD_THREADS: particles_update(ps, DT, GRAVITY, jobs); count = ps->count; break;
+        }
+        ms += get_time_ms(t0, SDL_GetPerformanceCounter()) / FRAMES;
+        *died += (double)(PARTICLES - count) / FRAMES;
+    }
+    return ms;
+}
+
+int main(void) {
+    printf("\n=== Particles (%s backend, %d particles, %d frames) ===\n", MATH_BACKEND, PARTICLES, FRAMES);
+
+    ParticleSystem* ps = particles_create(PARTICLES);
+    AosParticle* aos = malloc(sizeof(AosParticle) * PARTICLES);
+    JobSystem* jobs = jobs_create(-1);
+    printf("Job system: %d worker threads + caller\n\n", jobs->thread_count);
+
+    printf("%-18s %12s %14s %12s\n", "update", "ms", "M particles/s", "died/frame");
+    double died;
+    double base = 0.0;
+    for (UpdateMode mode = UPDATE_AOS; mode <= UPDATE_SIMD_THREADS; mode++) {
+        double ms = run(mode, ps, aos, jobs, &died);
+        if (mode == UPDATE_AOS) base = ms;
+        printf("%-18s %12.3f %14.1f %12.0f   %.2fx\n", MODE_NAMES[mode], ms, PARTICLES / ms / 1000.0, died, base / ms);
+    }
+
+    // Fountain seen from the side, as points and as small squares
+    Framebuffer* fb = framebuffer_create(SCREEN_W, SCREEN_H);
+    Camera cam = {{0.0f, 3.0f, 9.0f}, {0.0f, 3.0f, 0.0f}, {0.0f, 1.0f, 0.0f}};
+    Projection proj = {M_PI / 3, (float)SCREEN_W / SCREEN_H, 0.1f, 100.0f};
+    const float sizes[2] = {0.0f, 0.02f};
+    printf("\n%-18s %12s %14s %12s\n", "draw", "ms", "M particles/s", "pixels");
+    for (int s = 0; s < 2; s++) {
+        double ms = 0.0;
+        size_t pixels = 0;
+        for (int f = 0; f < FRAMES; f++) {
+            refill(ps);
+            particles_update(ps, DT, GRAVITY, jobs);
+            framebuffer_clear(fb, BACKGROUND);
+            framebuffer_clear_depth(fb);
+            fb->pixels_drawn = 0;
+            Uint64 t0 = SDL_GetPerformanceCounter();
+            particles_draw(fb, ps, cam, proj, sizes[s]);
+            ms += get_time_ms(t0, SDL_GetPerformanceCounter()) / FRAMES;
+            pixels += fb->pixels_drawn / FRAMES;
+        }
+        printf("%-18s %12.3f %14.1f %12zu\n", s == 0 ? "points" : "squares (0.02)", ms, ps->count / ms / 1000.0,
+               pixels);
+    }
+
+    framebuffer_destroy(fb);
+    jobs_destroy(jobs);
+    free(aos);
+    particles_destroy(ps);
+    return 0;
+}
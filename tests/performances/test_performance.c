@@ -4,6 +4,7 @@
 
 #include "core/pipeline.h"
 #include "core/renderer.h"
+#include "../test_fixtures.h"
 
 // Performance measurement utilities
 typedef struct {
@@ -59,37 +60,6 @@ static inline double get_time_ms(double start, double end) {
     return (double)((end - start) * 1000) / (double)freq;
 }
 
-// Test mesh generators
-static Mesh* create_cube_mesh() {
-    Vector4 vertices[] = {
-        {-1.0f, -1.0f, -1.0f, 1.0f}, // 0
-        { 1.0f, -1.0f, -1.0f, 1.0f}, // 1
-        { 1.0f,  1.0f, -1.0f, 1.0f}, // 2
-        {-1.0f,  1.0f, -1.0f, 1.0f}, // 3
-        {-1.0f, -1.0f,  1.0f, 1.0f}, // 4
-        { 1.0f, -1.0f,  1.0f, 1.0f}, // 5
-        { 1.0f,  1.0f,  1.0f, 1.0f}, // 6
-        {-1.0f,  1.0f,  1.0f, 1.0f}  // 7
-    };
-
-    Triangle triangles[] = {
-        // Front face
-        {{0, 1, 2}}, {{2, 3, 0}},
-        // Back face
-        {{4, 6, 5}}, {{6, 4, 7}},
-        // Left face
-        {{4, 0, 3}}, {{3, 7, 4}},
-        // Right face
-        {{1, 5, 6}}, {{6, 2, 1}},
-        // Top face
-        {{3, 2, 6}}, {{6, 7, 3}},
-        // Bottom face
-        {{4, 5, 1}}, {{1, 0, 4}}
-    };
-
-    return mesh_generate(vertices, 8, triangles, 12);
-}
-
 static Mesh* create_large_mesh(int subdivisions) {
     int vertex_count = (subdivisions + 1) * (subdivisions + 1);
     int triangle_count = subdivisions * subdivisions * 2;
@@ -183,6 +153,67 @@ static PerformanceResult test_update_mesh_performance(Mesh* mesh, int iterations
     );
 
     free(samples);
+    mesh_destroy(clipped);
+    return result;
+}
+
+// Performance test for update_mesh_lit (same transform + 1 directional and 2 point lights)
+static PerformanceResult test_update_mesh_lit_performance(Mesh* mesh, int iterations) {
+    Mesh* clipped = mesh_copy(mesh);
+    uint32_t* colors = malloc(sizeof(uint32_t) * mesh->vertex_count);
+    if (!mesh->normals)
+        mesh_compute_normals(mesh, NULL);
+
+    Transform transform = {
+        .translation = {0.0f, 0.0f, -5.0f},
+        .scale = {1.0f, 1.0f, 1.0f},
+        .rotation = {0.0f, 0.0f, 0.0f}
+    };
+
+    Camera camera = {
+        .pos = {0.0f, 0.0f, 0.0f},
+        .target = {0.0f, 0.0f, -1.0f},
+        .up = {0.0f, 1.0f, 0.0f}
+    };
+
+    Projection projection = {
+        .fov = M_PI / 4.0f,  // 45 degrees
+        .aspect_ratio = 16.0f / 9.0f,
+        .near = 0.1f,
+        .far = 100.0f
+    };
+
+    Lighting lighting = { .ambient = {0.1f, 0.1f, 0.1f} };
+    lighting_add(&lighting, (Light){ .type = LIGHT_DIRECTIONAL, .direction = {0.3f, -1.0f, -0.5f}, .color = {1, 1, 1} });
+    lighting_add(&lighting, (Light){ .type = LIGHT_POINT, .position = {1, 1, -4}, .color = {1, 0.5f, 0.2f}, .range = 5 });
+    lighting_add(&lighting, (Light){ .type = LIGHT_POINT, .position = {-1, 1, -6}, .color = {0.2f, 0.5f, 1}, .range = 5 });
+
+    // Warm up
+    for (int i = 0; i < 10; i++) {
+        update_mesh_lit(mesh, clipped, colors, 0xFFFFFFFFu, transform, camera, projection, &lighting);
+    }
+
+    // Measure performance
+    double* samples = malloc(sizeof(double) * iterations);
+
+    for (int i = 0; i < iterations; i++) {
+        Uint64 t0 = SDL_GetPerformanceCounter();
+        update_mesh_lit(mesh, clipped, colors, 0xFFFFFFFFu, transform, camera, projection, &lighting);
+        Uint64 t1 = SDL_GetPerformanceCounter();
+        samples[i] = get_time_ms(t0, t1);
+    }
+
+    PerformanceResult result = compute_stats(
+        "update_mesh_lit",
+        samples,
+        iterations,
+        mesh->vertex_count,
+        mesh->triangle_count
+    );
+
+    free(samples);
+    free(colors);
+    mesh_destroy(clipped);
     return result;
 }
 
@@ -255,6 +286,96 @@ static PerformanceResult test_draw_mesh_performance(Mesh* mesh, int iterations)
     );
 
     free(samples);
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    return result;
+}
+
+// Tiles resolved into the locked streaming texture, as the engine presents a frame
+static void upload(const Framebuffer* fb, SDL_Texture* texture) {
+    void* pixels;
+    int pitch;
+    if (SDL_LockTexture(texture, NULL, &pixels, &pitch) == 0) {
+        framebuffer_resolve_to(fb, pixels, pitch / (int)sizeof(uint32_t), fb->width, fb->height);
+        SDL_UnlockTexture(texture);
+    }
+}
+
+// Performance test for draw_mesh_software (CPU raster + one texture upload)
+static PerformanceResult test_draw_mesh_software_performance(Mesh* mesh, int iterations) {
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+        printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        return (PerformanceResult){"draw_mesh_software", -1.0, 0};
+    }
+
+    SDL_Window* window = SDL_CreateWindow("Performance Test",
+                                        SDL_WINDOWPOS_UNDEFINED,
+                                        SDL_WINDOWPOS_UNDEFINED,
+                                        800, 600,
+                                        SDL_WINDOW_HIDDEN);
+
+    if (!window) {
+        printf("Window could not be created! SDL_Error: %s\n", SDL_GetError());
+        SDL_Quit();
+        return (PerformanceResult){"draw_mesh_software", -1.0, 0};
+    }
+
+    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+    if (!renderer) {
+        printf("Renderer could not be created! SDL_Error: %s\n", SDL_GetError());
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return (PerformanceResult){"draw_mesh_software", -1.0, 0};
+    }
+
+    Framebuffer* fb = framebuffer_create(800, 600);
+    SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                             SDL_TEXTUREACCESS_STREAMING, 800, 600);
+
+    Draw draw_data = {
+        .clipped_mesh = mesh,
+        .color = {255, 255, 255, 255},
+        .backend = RENDER_SOFTWARE
+    };
+
+    // Warm up
+    for (int i = 0; i < 10; i++) {
+        framebuffer_clear(fb, 0xFF000000u);
+        draw_mesh_software(fb, &draw_data);
+        upload(fb, texture);
+        SDL_RenderCopy(renderer, texture, NULL, NULL);
+        SDL_RenderPresent(renderer);
+    }
+
+    // Measure performance
+    double* samples = malloc(sizeof(double) * iterations);
+
+    for (int i = 0; i < iterations; i++) {
+        Uint64 t0 = SDL_GetPerformanceCounter();
+
+        framebuffer_clear(fb, 0xFF000000u);
+        draw_mesh_software(fb, &draw_data);
+        upload(fb, texture);
+        SDL_RenderCopy(renderer, texture, NULL, NULL);
+        SDL_RenderPresent(renderer);
+
+        Uint64 t1 = SDL_GetPerformanceCounter();
+        samples[i] = get_time_ms(t0, t1);
+    }
+
+    PerformanceResult result = compute_stats(
+        "draw_mesh_software",
+        samples,
+        iterations,
+        mesh->vertex_count,
+        mesh->triangle_count
+    );
+
+    free(samples);
+    SDL_DestroyTexture(texture);
+    framebuffer_destroy(fb);
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
     return result;
 }
 
@@ -288,7 +409,9 @@ static void print_performance_result(PerformanceResult result) {
 
 static void print_summary_perf(
     PerformanceResult update,
+    PerformanceResult update_lit,
     PerformanceResult draw,
+    PerformanceResult draw_soft,
     const char* mesh_name
 ) {
     double total = update.avg_time_ms + draw.avg_time_ms;
@@ -299,6 +422,12 @@ static void print_summary_perf(
     printf("draw_mesh:   %.3f ms (%.1f%%)\n", draw.avg_time_ms,
            draw.avg_time_ms / total * 100.0);
     printf("Total:       %.3f ms\n", total);
+    printf("draw_mesh_software: %.3f ms (%.2fx vs draw_mesh)\n", draw_soft.avg_time_ms,
+           draw.avg_time_ms / draw_soft.avg_time_ms);
+    double lighting = update_lit.avg_time_ms - update.avg_time_ms;
+    printf("update_mesh_lit: %.3f ms (lighting: %.3f ms, %.1f%% of the lit vertex pass, %.1f%% of the frame)\n",
+           update_lit.avg_time_ms, lighting, lighting / update_lit.avg_time_ms * 100.0,
+           lighting / (update_lit.avg_time_ms + draw.avg_time_ms) * 100.0);
 }
 
 int main() {
@@ -310,9 +439,15 @@ int main() {
     
     PerformanceResult cube_update = test_update_mesh_performance(cube, 10000);
     print_performance_result(cube_update);
+
+    PerformanceResult cube_update_lit = test_update_mesh_lit_performance(cube, 10000);
+    print_performance_result(cube_update_lit);
     
     PerformanceResult cube_draw = test_draw_mesh_performance(cube, 1000);
     print_performance_result(cube_draw);
+
+    PerformanceResult cube_draw_soft = test_draw_mesh_software_performance(cube, 1000);
+    print_performance_result(cube_draw_soft);
     
     mesh_destroy(cube);
     
@@ -322,9 +457,15 @@ int main() {
     
     PerformanceResult medium_update = test_update_mesh_performance(medium_mesh, 1000);
     print_performance_result(medium_update);
+
+    PerformanceResult medium_update_lit = test_update_mesh_lit_performance(medium_mesh, 1000);
+    print_performance_result(medium_update_lit);
     
     PerformanceResult medium_draw = test_draw_mesh_performance(medium_mesh, 100);
     print_performance_result(medium_draw);
+
+    PerformanceResult medium_draw_soft = test_draw_mesh_software_performance(medium_mesh, 100);
+    print_performance_result(medium_draw_soft);
     
     mesh_destroy(medium_mesh);
     
@@ -334,16 +475,22 @@ int main() {
     
     PerformanceResult large_update = test_update_mesh_performance(large_mesh, 100);
     print_performance_result(large_update);
+
+    PerformanceResult large_update_lit = test_update_mesh_lit_performance(large_mesh, 100);
+    print_performance_result(large_update_lit);
     
     PerformanceResult large_draw = test_draw_mesh_performance(large_mesh, 10);
     print_performance_result(large_draw);
+
+    PerformanceResult large_draw_soft = test_draw_mesh_software_performance(large_mesh, 10);
+    print_performance_result(large_draw_soft);
     
     mesh_destroy(large_mesh);
     
     // Summary
-    print_summary_perf(cube_update, cube_draw, "Cube mesh");
-    print_summary_perf(medium_update, medium_draw, "Medium mesh");
-    print_summary_perf(large_update, large_draw, "Large mesh");
+    print_summary_perf(cube_update, cube_update_lit, cube_draw, cube_draw_soft, "Cube mesh");
+    print_summary_perf(medium_update, medium_update_lit, medium_draw, medium_draw_soft, "Medium mesh");
+    print_summary_perf(large_update, large_update_lit, large_draw, large_draw_soft, "Large mesh");
     
     return 0;
 }
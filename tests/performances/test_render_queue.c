@@ -0,0 +1,160 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <SDL.h>
+
+#include "core/scene.h"
+#include "../test_fixtures.h"
+
+// GRID x GRID cubes in front of the camera, each with one of COLORS colors
+#define GRID 64
+#define SPACING 2.5f
+#define COLORS 32
+#define FRAMES 50
+#define SORT_FRAMES 500
+
+#define SCREEN_W 640
+#define SCREEN_H 480
+
+static inline double get_time_ms(Uint64 start, Uint64 end) {
+    return (double)((end - start) * 1000) / (double)SDL_GetPerformanceFrequency();
+}
+
+static int compare_keys(const void* a, const void* b) {
+    uint64_t x = ((const SortKey*)a)->key, y = ((const SortKey*)b)->key;
+    return (x > y) - (x < y);
+}
+
+// Each cube of the grid raised or lowered, and painted with one of COLORS colors
+static void scatter_scene(Scene* scene) {
+    srand(42);
+
+    Color palette[COLORS];
+    for (int c = 0; c < COLORS; c++)
+        palette[c] = (Color){rand() % 256, rand() % 256, rand() % 256, 255};
+
+    for (int i = 0; i < scene->count; i++) {
+        Object* obj = &scene->objects[i];
+        obj->transform.translation.y = (float)(rand() % 5) - 2.0f;
+        obj->draw.color = palette[rand() % COLORS];
+        for (int v = 0; v < obj->mesh->vertex_count; v++)
+            obj->draw.vertex_colors[v] = color_to_argb(obj->draw.color);
+    }
+}
+
+static void set_backend(Scene* scene, RenderBackend backend, ShadeMode shading) {
+    for (int i = 0; i < scene->count; i++) {
+        scene->objects[i].draw.backend = backend;
+        scene->objects[i].draw.shading = shading;
+    }
+}
+
+static float view_depth(const Object* obj, Camera cam, Projection proj) {
+    return norm3(subtract3(obj->transform.translation, cam.pos)) / proj.far;
+}
+
+// Previous update_scene draw loop: scene order, draw_mesh sets the color every time
+static void draw_unsorted(Scene* scene, SDL_Renderer* sdl, Framebuffer* fb) {
+    for (int i = 0; i < scene->count; i++) {
+        const Object* obj = &scene->objects[i];
+        if (!obj->visible) continue;
+        if (obj->draw.backend == RENDER_SOFTWARE)
+            draw_mesh_software(fb, &obj->draw);
+        else
+            draw_mesh(sdl, &obj->draw, SCREEN_W, SCREEN_H);
+    }
+}
+
+static void draw_sorted(Scene* scene, RenderQueue* queue, SDL_Renderer* sdl, Framebuffer* fb, Camera cam,
+                        Projection proj) {
+    render_queue_reset(queue);
+    for (int i = 0; i < scene->count; i++) {
+        const Object* obj = &scene->objects[i];
+        if (obj->visible) render_queue_push(queue, &obj->draw, obj->layer, view_depth(obj, cam, proj));
+    }
+    render_queue_sort(queue);
+    render_queue_execute(queue, RENDER_SOFTWARE, sdl, fb, SCREEN_W, SCREEN_H);
+    render_queue_execute(queue, RENDER_SDL, sdl, fb, SCREEN_W, SCREEN_H);
+}
+
+// Average frame times (draws only, meshes already transformed), both orders alternating frame by frame
+static void time_frames(Scene* scene, RenderQueue* queue, SDL_Renderer* sdl, Framebuffer* fb, Camera cam,
+                        Projection proj, double* unsorted_ms, double* sorted_ms) {
+    *unsorted_ms = *sorted_ms = 0.0;
+    for (int f = 0; f < 2 * FRAMES; f++) {
+        Uint64 start = SDL_GetPerformanceCounter();
+        framebuffer_clear(fb, 0xFF000000u);
+        framebuffer_clear_depth(fb);
+        if (!(f % 2))
+            draw_sorted(scene, queue, sdl, fb, cam, proj);
+        else
+            draw_unsorted(scene, sdl, fb);
+        *(f % 2 ? unsorted_ms : sorted_ms) += get_time_ms(start, SDL_GetPerformanceCounter()) / FRAMES;
+    }
+}
+
+int main(void) {
+    printf("\n=== Sorted render queue (%d objects, %d colors) ===\n", GRID * GRID, COLORS);
+
+    Mesh* cube = create_cube_mesh();
+    Scene* scene = create_grid_scene(cube, GRID, GRID, SPACING, 0.8f);
+    scatter_scene(scene);
+    Camera cam = {{0.0f, 4.0f, 6.0f}, {0.0f, 0.0f, -GRID * SPACING / 2}, {0.0f, 1.0f, 0.0f}};
+    Projection proj = {M_PI / 3, (float)SCREEN_W / SCREEN_H, 0.1f, 200.0f};
+    scene_update(scene, cam, proj, NULL);
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, SCREEN_W, SCREEN_H, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer* sdl = SDL_CreateSoftwareRenderer(surface);
+    Framebuffer* fb = framebuffer_create(SCREEN_W, SCREEN_H);
+    RenderQueue* queue = render_queue_create(64);
+
+    // State changes of one frame
+    draw_sorted(scene, queue, sdl, fb, cam, proj);
+    RenderQueueStats s = queue->stats;
+    printf("Draws %d: state changes %d in scene order, %d sorted; %d draw color calls (was %d)\n", s.draws,
+           s.submitted_state_changes, s.state_changes, s.color_sets, s.draws);
+
+    // Sort alone: radix against qsort on the same keys
+    SortKey* keys = malloc(sizeof(SortKey) * queue->count);
+    SortKey* scratch = malloc(sizeof(SortKey) * queue->count);
+    for (int i = 0, n = 0; i < scene->count; i++) {
+        const Object* obj = &scene->objects[i];
+        if (obj->visible) keys[n] = (SortKey){render_key(&obj->draw, obj->layer, view_depth(obj, cam, proj)), n}, n++;
+    }
+    double radix_ms = 0.0, qsort_ms = 0.0;
+    for (int f = 0; f < SORT_FRAMES; f++) {
+        memcpy(scratch, keys, sizeof(SortKey) * queue->count);
+        Uint64 t0 = SDL_GetPerformanceCounter();
+        radix_sort(scratch, queue->scratch, queue->count);
+        Uint64 t1 = SDL_GetPerformanceCounter();
+        memcpy(scratch, keys, sizeof(SortKey) * queue->count);
+        Uint64 t2 = SDL_GetPerformanceCounter();
+        qsort(scratch, queue->count, sizeof(SortKey), compare_keys);
+        Uint64 t3 = SDL_GetPerformanceCounter();
+        radix_ms += get_time_ms(t0, t1);
+        qsort_ms += get_time_ms(t2, t3);
+    }
+    printf("Sort %d keys: radix %.1f us, qsort %.1f us (%.1fx)\n", queue->count, radix_ms * 1000.0 / SORT_FRAMES,
+           qsort_ms * 1000.0 / SORT_FRAMES, qsort_ms / radix_ms);
+
+    // Whole draw pass, SDL wireframes then software filled (depth tested, near first when sorted)
+    double unsorted_ms, sorted_ms;
+    set_backend(scene, RENDER_SDL, SHADE_WIREFRAME);
+    time_frames(scene, queue, sdl, fb, cam, proj, &unsorted_ms, &sorted_ms);
+    printf("SDL wireframe:   %7.3f ms unsorted, %7.3f ms sorted per frame\n", unsorted_ms, sorted_ms);
+
+    set_backend(scene, RENDER_SOFTWARE, SHADE_FLAT);
+    scene_update(scene, cam, proj, NULL);
+    time_frames(scene, queue, sdl, fb, cam, proj, &unsorted_ms, &sorted_ms);
+    printf("Software flat:   %7.3f ms unsorted, %7.3f ms sorted per frame (near first)\n", unsorted_ms, sorted_ms);
+
+    free(keys);
+    free(scratch);
+    render_queue_destroy(queue);
+    framebuffer_destroy(fb);
+    SDL_DestroyRenderer(sdl);
+    SDL_FreeSurface(surface);
+    scene_destroy(scene);
+    mesh_destroy(cube);
+    return 0;
+}
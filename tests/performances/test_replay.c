@@ -0,0 +1,144 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "core/replay.h"
+#include "../test_fixtures.h"
+
+/*
+ * Headless replay runner
+ *
+ *   perf_test_replay [session.rec [checksums.txt]]
+ *
+ * Replays a session recorded with `3d_engine --record session.rec` as
+ * fast as possible and prints wall time and frame time percentiles. The
+ * per-frame framebuffer checksums are written to checksums.txt when
+ * given, so two builds can be diffed for identical output. Without a
+ * recording, a scripted session is recorded first.
+ */
+
+#define SYNTHETIC_RECORDING "replay_synthetic.rec"
+#define SCREEN_W 600
+#define SCREEN_H 600
+#define FRAME_TIME (1.0f / 60.0f)
+#define SYNTHETIC_FRAMES 600
+#define SHADING_FRAMES 50   // cube frames per shading mode
+
+// Bumpy GRID x GRID height field
+#define GRID 128
+
+static Mesh* create_terrain(void) {
+    int n = GRID + 1;
+    Vector4* vertices = malloc(sizeof(Vector4) * n * n);
+    Triangle* triangles = malloc(sizeof(Triangle) * GRID * GRID * 2);
+
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            vertices[i * n + j] = (Vector4){(i - GRID / 2) * 0.03f, 0.2f * sinf(i * 0.2f) * cosf(j * 0.15f),
+                                            (j - GRID / 2) * 0.03f, 1.0f};
+
+    int t = 0;
+    for (int i = 0; i < GRID; i++)
+        for (int j = 0; j < GRID; j++) {
+            int q = i * n + j;
+            triangles[t++] = (Triangle){{q, q + 1, q + n}};
+            triangles[t++] = (Triangle){{q + 1, q + n + 1, q + n}};
+        }
+
+    Mesh* mesh = mesh_generate(vertices, n * n, triangles, t);
+    free(vertices);
+    free(triangles);
+    return mesh;
+}
+
+// Spinning cube cycling the untextured shading modes, then an orbit over a terrain
+static int record_synthetic(const char* path) {
+    Mesh* cube = create_cube_mesh();
+    Mesh* terrain = create_terrain();
+    Recorder* rec = recorder_open(path, SCREEN_W, SCREEN_H, (Color){0, 0, 0, 255});
+    if (!cube || !terrain || !rec) return 0;
+
+    Camera cam = {{0.0f, 0.0f, 5.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}};
+    Projection proj = {M_PI / 3, 1.0f, 0.1f, 100.0f};
+    Lighting lighting = { .ambient = {0.15f, 0.15f, 0.15f} };
+    lighting_add(&lighting, (Light){ .type = LIGHT_DIRECTIONAL, .direction = {-0.4f, -1.0f, -0.6f}, .color = {1.0f, 1.0f, 1.0f} });
+    Draw draw = { .color = {255, 0, 0, 255}, .backend = RENDER_SOFTWARE, .shading = SHADE_WIREFRAME };
+    Transform transform = NO_TRANSFORM;
+
+    int ok = 1;
+    for (int f = 0; ok && f < SYNTHETIC_FRAMES; f++) {
+        const Mesh* mesh = cube;
+        draw.shading = (ShadeMode)((f / SHADING_FRAMES) % SHADE_TEXTURED);
+        transform.rotation.x = transform.rotation.y = f * 0.02f;
+
+        if (f >= SYNTHETIC_FRAMES / 2) {
+            float a = f * 0.01f;
+            mesh = terrain;
+            draw.shading = SHADE_GOURAUD;
+            transform = NO_TRANSFORM;
+            cam.pos = (Vector3){3.0f * cosf(a), 1.5f, 3.0f * sinf(a)};
+        }
+        ok = recorder_frame(rec, FRAME_TIME, mesh, &draw, transform, cam, proj, &lighting);
+    }
+
+    ok &= recorder_close(rec);
+    mesh_destroy(cube);
+    mesh_destroy(terrain);
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    const char* path = argc > 1 ? argv[1] : SYNTHETIC_RECORDING;
+
+    if (argc <= 1 && !record_synthetic(path)) {
+        printf("Could not record the synthetic session to %s\n", path);
+        return 1;
+    }
+
+    Replay* replay = replay_load(path);
+    if (!replay) {
+        printf("Could not load recording %s\n", path);
+        return 1;
+    }
+
+    ReplayReport report;
+    if (!replay_run(replay, &report)) {
+        printf("Replay failed (out of memory)\n");
+        replay_destroy(replay);
+        return 1;
+    }
+
+    // Digest of every frame checksum, to compare runs at a glance
+    uint32_t digest = 2166136261u;
+    for (int f = 0; f < report.frame_count; f++) {
+        digest ^= report.checksums[f];
+        digest *= 16777619u;
+    }
+
+    printf("\n=== Replay: %s ===\n", path);
+    printf("Frames:   %d at %dx%d, %d meshes\n", report.frame_count, replay->screen_w, replay->screen_h, replay->mesh_count);
+    printf("Session:  %.1f ms recorded\n", report.session_ms);
+    printf("Replayed: %.1f ms wall time (%.1fx real time)\n", report.total_ms,
+           report.total_ms > 0.0 ? report.session_ms / report.total_ms : 0.0);
+    if (report.frame_count > 0)
+        printf("Frame:    avg %.3f ms | p50 %.3f | p90 %.3f | p99 %.3f | max %.3f\n",
+               report.total_ms / report.frame_count, report.p50_ms, report.p90_ms, report.p99_ms, report.max_ms);
+    printf("Checksum: %08x (digest of %d frame checksums)\n", digest, report.frame_count);
+
+    if (argc > 2) {
+        FILE* out = fopen(argv[2], "w");
+        if (!out) {
+            printf("Could not write %s\n", argv[2]);
+        } else {
+            for (int f = 0; f < report.frame_count; f++)
+                fprintf(out, "%d %08x\n", f, report.checksums[f]);
+            fclose(out);
+            printf("Per-frame checksums written to %s\n", argv[2]);
+        }
+    }
+
+    if (argc <= 1) remove(path);
+    replay_report_free(&report);
+    replay_destroy(replay);
+    return 0;
+}
@@ -0,0 +1,150 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <SDL.h>
+
+#include "core/skinning.h"
+
+// Character: a RINGS x SEGMENTS tube skinned to a chain of JOINTS bones
+#define JOINTS 32
+#define RINGS 256
+#define SEGMENTS 32
+#define CHARACTER_VERTICES (RINGS * SEGMENTS)
+
+#define CLIP_KEYS 5
+#define FRAME_TIME (1.0f / 60.0f)
+
+// Vertex work per measurement is about the same for every character count
+#define VERTICES_PER_RUN (CHARACTER_VERTICES * 300L)
+
+static inline double get_time_ms(Uint64 start, Uint64 end) {
+    return (double)((end - start) * 1000) / (double)SDL_GetPerformanceFrequency();
+}
+
+typedef enum { SKIN_SCALAR, SKIN_SIMD, SKIN_SIMD_THREADS } SkinMode;
+
+static Skeleton* create_chain(void) {
+    int parents[JOINTS];
+    Transform bind[JOINTS];
+    for (int j = 0; j < JOINTS; j++) {
+        parents[j] = j - 1;
+        bind[j] = NO_TRANSFORM;
+        bind[j].translation.y = j == 0 ? 0.0f : 1.0f;
+    }
+    return skeleton_create(JOINTS, parents, bind);
+}
+
+// Side to side wave along the chain
+static AnimationClip* create_wave(void) {
+    float times[CLIP_KEYS];
+    Transform poses[CLIP_KEYS * JOINTS];
+    for (int k = 0; k < CLIP_KEYS; k++) {
+        times[k] = k * 0.5f;
+        for (int j = 0; j < JOINTS; j++) {
+            Transform t = NO_TRANSFORM;
+            t.translation.y = j == 0 ? 0.0f : 1.0f;
+            t.rotation.z = 0.15f * sinf(k * (float)M_PI / 2 + j * 0.4f);
+            t.rotation.x = 0.05f * cosf(k * (float)M_PI / 2 + j * 0.2f);
+            poses[k * JOINTS + j] = t;
+        }
+    }
+    return animation_clip_create(JOINTS, CLIP_KEYS, times, poses);
+}
+
+// Each ring is weighted to the 4 joints closest to its height
+static SkinnedMesh* create_tube(void) {
+    Vector4* vertices = malloc(sizeof(Vector4) * CHARACTER_VERTICES);
+    uint8_t* joints = malloc(CHARACTER_VERTICES * SKIN_MAX_INFLUENCES);
+    float* weights = malloc(sizeof(float) * CHARACTER_VERTICES * SKIN_MAX_INFLUENCES);
+
+    for (int r = 0; r < RINGS; r++) {
+        float y = (float)r / (RINGS - 1) * (JOINTS - 1);
+        int base = (int)y - 1;
+        if (base < 0) base = 0;
+        if (base > JOINTS - SKIN_MAX_INFLUENCES) base = JOINTS - SKIN_MAX_INFLUENCES;
+
+        for (int s = 0; s < SEGMENTS; s++) {
+            int i = r * SEGMENTS + s;
+            float a = (float)s / SEGMENTS * 2.0f * (float)M_PI;
+            vertices[i] = (Vector4){0.3f * cosf(a), y, 0.3f * sinf(a), 1.0f};
+
+            for (int k = 0; k < SKIN_MAX_INFLUENCES; k++) {
+                int j = base + k;
+                joints[i * SKIN_MAX_INFLUENCES + k] = j;
+                weights[i * SKIN_MAX_INFLUENCES + k] = 1.0f / (1.0f + 4.0f * fabsf(y - j));
+            }
+        }
+    }
+
+    Mesh* bind = mesh_generate(vertices, CHARACTER_VERTICES, (Triangle[1]){{0, 1, 2}}, 1);
+    SkinnedMesh* skin = skinned_mesh_create(bind, joints, weights);
+
+    mesh_destroy(bind);
+    free(vertices);
+    free(joints);
+    free(weights);
+    return skin;
+}
+
+// Samples, poses and skins every character, returns skinned vertices per second
+static double run(int characters, SkinMode mode, const Skeleton* skeleton, const AnimationClip* clip,
+                  const SkinnedMesh* skin, Vector4** out, JobSystem* jobs) {
+    Transform local[JOINTS];
+    Matrix palette[JOINTS];
+    int frames = (int)(VERTICES_PER_RUN / ((long)characters * CHARACTER_VERTICES));
+
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    for (int f = 0; f < frames; f++) {
+        for (int c = 0; c < characters; c++) {
+            animation_sample(clip, f * FRAME_TIME + c * 0.1f, local);
+            skeleton_pose(skeleton, local, palette);
+
+            if (mode == SKIN_SCALAR)
+                skin_vertices_scalar(skin, palette, out[c]);
+            else
+                skin_vertices(skin, palette, out[c], mode == SKIN_SIMD_THREADS ? jobs : NULL);
+        }
+    }
+    Uint64 t1 = SDL_GetPerformanceCounter();
+
+    double seconds = get_time_ms(t0, t1) / 1000.0;
+    return (double)frames * characters * CHARACTER_VERTICES / seconds;
+}
+
+int main() {
+    printf("=== SKINNING PERFORMANCE TESTS (%s backend) ===\n\n", MATH_BACKEND);
+
+    Skeleton* skeleton = create_chain();
+    AnimationClip* clip = create_wave();
+    SkinnedMesh* skin = create_tube();
+    JobSystem* jobs = jobs_create(-1);
+
+    const int counts[3] = {1, 10, 100};
+    Vector4* out[100];
+    for (int c = 0; c < 100; c++)
+        out[c] = malloc(sizeof(Vector4) * CHARACTER_VERTICES);
+
+    printf("Character: %d vertices, %d joints, %d influences per vertex\n",
+           CHARACTER_VERTICES, JOINTS, SKIN_MAX_INFLUENCES);
+    printf("Job system: %d worker threads + caller\n\n", jobs->thread_count);
+
+    // Warm up
+    run(1, SKIN_SIMD, skeleton, clip, skin, out, jobs);
+
+    printf("%-12s %14s %14s %14s %9s\n", "characters", "scalar Mv/s", "simd Mv/s", "threads Mv/s", "speedup");
+    for (int i = 0; i < 3; i++) {
+        int n = counts[i];
+        double scalar = run(n, SKIN_SCALAR, skeleton, clip, skin, out, jobs);
+        double simd = run(n, SKIN_SIMD, skeleton, clip, skin, out, jobs);
+        double threads = run(n, SKIN_SIMD_THREADS, skeleton, clip, skin, out, jobs);
+        printf("%-12d %14.2f %14.2f %14.2f %8.2fx\n", n, scalar / 1e6, simd / 1e6, threads / 1e6, threads / scalar);
+    }
+
+    for (int c = 0; c < 100; c++)
+        free(out[c]);
+    jobs_destroy(jobs);
+    skinned_mesh_destroy(skin);
+    animation_clip_destroy(clip);
+    skeleton_destroy(skeleton);
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <SDL.h>
+
+#include "core/surface.h"
+#include "core/renderer.h"
+
+// Torus of 8 x 8 patches, up to 32 x 32 quads each
+#define PATCHES 8
+#define MAX_SEGMENTS 32
+#define TARGET_PX 8.0f
+
+// Fly-in from far away to close-up, then a few frames standing still
+#define FRAMES 300
+#define STILL_FRAMES 60
+#define FAR_DISTANCE 80.0f
+#define NEAR_DISTANCE 5.0f
+#define FB_W 320
+#define FB_H 240
+
+static inline double get_time_ms(Uint64 start, Uint64 end) {
+    return (double)((end - start) * 1000) / (double)SDL_GetPerformanceFrequency();
+}
+
+typedef struct RunStats {
+    double tessellate_ms;
+    double transform_ms;
+    double raster_ms;
+    long triangles;
+    int rebuilds;
+} RunStats;
+
+static Camera camera_at(int frame) {
+    int f = frame < FRAMES ? frame : FRAMES - 1;
+    float t = (float)f / (FRAMES - 1);
+    float d = FAR_DISTANCE + (NEAR_DISTANCE - FAR_DISTANCE) * t;
+    float angle = 0.6f * t;
+    return (Camera){{d * sinf(angle), 0.4f * d, d * cosf(angle)}, {0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}};
+}
+
+static RunStats run(const Surface* surface, Tessellation* tess, int adaptive, Framebuffer* fb, Projection proj) {
+    RunStats stats = {0};
+    Transform transform = NO_TRANSFORM;
+    Mesh clipped = {0};
+    clipped.vertices = malloc(sizeof(Vector4) * tess->vertex_capacity);
+    Draw draw = {.clipped_mesh = &clipped, .color = {200, 160, 90, 255}, .backend = RENDER_SOFTWARE,
+                 .shading = SHADE_WIREFRAME};
+
+    if (!adaptive) surface_tessellate_uniform(surface, tess, MAX_SEGMENTS);
+
+    for (int f = 0; f < FRAMES + STILL_FRAMES; f++) {
+        Camera cam = camera_at(f);
+
+        Uint64 t0 = SDL_GetPerformanceCounter();
+        if (adaptive)
+            stats.rebuilds += surface_tessellate(surface, tess, transform, cam, proj, FB_W, FB_H, TARGET_PX);
+        Uint64 t1 = SDL_GetPerformanceCounter();
+        update_mesh(tess->mesh, &clipped, transform, cam, proj);
+        clipped.vertex_count = tess->mesh->vertex_count;
+        clipped.triangles = tess->mesh->triangles;
+        clipped.triangle_count = tess->mesh->triangle_count;
+        Uint64 t2 = SDL_GetPerformanceCounter();
+        framebuffer_clear(fb, 0xFF000000u);
+        draw_mesh_software(fb, &draw);
+        Uint64 t3 = SDL_GetPerformanceCounter();
+
+        stats.tessellate_ms += get_time_ms(t0, t1);
+        stats.transform_ms += get_time_ms(t1, t2);
+        stats.raster_ms += get_time_ms(t2, t3);
+        stats.triangles += tess->mesh->triangle_count;
+    }
+
+    free(clipped.vertices);
+    return stats;
+}
+
+static void print_run(const char* name, RunStats s) {
+    int frames = FRAMES + STILL_FRAMES;
+    double total = s.tessellate_ms + s.transform_ms + s.raster_ms;
+    printf("%-9s %8ld tris/frame | tessellate %.3f + transform %.3f + raster %.3f = %.3f ms/frame\n", name,
+           s.triangles / frames, s.tessellate_ms / frames, s.transform_ms / frames, s.raster_ms / frames,
+           total / frames);
+}
+
+int main(void) {
+    Surface torus = surface_torus(3.0f, 1.0f, PATCHES, PATCHES, MAX_SEGMENTS);
+    Tessellation* tess = tessellation_create(&torus);
+    Framebuffer* fb = framebuffer_create(FB_W, FB_H);
+    if (!tess || !fb) {
+        printf("Allocation failed\n");
+        return 1;
+    }
+    Projection proj = {M_PI / 3, (float)FB_W / FB_H, 0.1f, 200.0f};
+
+    RunStats fixed = run(&torus, tess, 0, fb, proj);
+    RunStats adaptive = run(&torus, tess, 1, fb, proj);
+
+    printf("\n=== Adaptive tessellation (%dx%d patches, up to %d segments, %.0f px target) ===\n", PATCHES, PATCHES,
+           MAX_SEGMENTS, TARGET_PX);
+    printf("Buffers: %d vertices, %d triangles preallocated\n", tess->vertex_capacity, tess->triangle_capacity);
+    print_run("Fixed", fixed);
+    print_run("Adaptive", adaptive);
+    printf("Adaptive rebuilt %d of %d frames (%d still frames reused) | %.1fx fewer triangles, %.2fx faster\n",
+           adaptive.rebuilds, FRAMES + STILL_FRAMES, FRAMES + STILL_FRAMES - adaptive.rebuilds,
+           (double)fixed.triangles / adaptive.triangles,
+           (fixed.tessellate_ms + fixed.transform_ms + fixed.raster_ms) /
+               (adaptive.tessellate_ms + adaptive.transform_ms + adaptive.raster_ms));
+
+    framebuffer_destroy(fb);
+    tessellation_destroy(tess);
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <SDL.h>
+
+#include "core/texture.h"
+#include "math/simd.h"
+
+// 4 MB of texels: does not fit in L2, so the access pattern matters
+#define TEX_SIZE 1024
+
+// Screen-sized grid of samples, walked row by row in spans
+#define SCREEN 512
+#define SPAN 64
+#define RUNS 8
+
+static inline double get_time_ms(Uint64 start, Uint64 end) {
+    return (double)((end - start) * 1000) / (double)SDL_GetPerformanceFrequency();
+}
+
+/*
+ * Samples a SCREEN x SCREEN view of the texture rotated by angle (radians),
+ * one texel per pixel. At 0 a row of pixels walks a row of texels; at 90
+ * degrees it walks a column, the worst case for row-major storage.
+ */
+static double run(const Texture* tex, TextureFilter filter, float angle) {
+    float c = cosf(angle) / TEX_SIZE, s = sinf(angle) / TEX_SIZE;
+    float u[SPAN], v[SPAN];
+    uint32_t out[SPAN];
+    uint32_t checksum = 0;
+
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    for (int r = 0; r < RUNS; r++) {
+        for (int y = 0; y < SCREEN; y++) {
+            for (int x0 = 0; x0 < SCREEN; x0 += SPAN) {
+                for (int i = 0; i < SPAN; i++) {
+                    float x = (float)(x0 + i);
+                    u[i] = c * x - s * y;
+                    v[i] = s * x + c * y;
+                }
+                texture_sample(tex, u, v, SPAN, 0, filter, out);
+                checksum += out[0];
+            }
+        }
+    }
+    Uint64 t1 = SDL_GetPerformanceCounter();
+
+    if (checksum == 1) printf(" "); // keep the samples alive
+    double seconds = get_time_ms(t0, t1) / 1000.0;
+    return (double)RUNS * SCREEN * SCREEN / seconds;
+}
+
+int main() {
+    printf("=== TEXTURE SAMPLING PERFORMANCE TESTS (%s backend) ===\n\n", MATH_BACKEND);
+
+    uint32_t* image = malloc(sizeof(uint32_t) * TEX_SIZE * TEX_SIZE);
+    for (int i = 0; i < TEX_SIZE * TEX_SIZE; i++)
+        image[i] = 0xFF000000u | (uint32_t)(i * 2654435761u >> 8);
+
+    const char* names[3] = {"linear", "tiled 4x4", "morton"};
+    Texture* textures[3] = {
+        texture_create(image, TEX_SIZE, TEX_SIZE, TEXTURE_LINEAR),
+        texture_create(image, TEX_SIZE, TEX_SIZE, TEXTURE_TILED),
+        texture_create(image, TEX_SIZE, TEX_SIZE, TEXTURE_MORTON)
+    };
+    const float angles[3] = {0.0f, 45.0f, 90.0f};
+
+    printf("Texture: %dx%d ARGB8888, %d samples per run\n\n", TEX_SIZE, TEX_SIZE, RUNS * SCREEN * SCREEN);
+
+    // Warm up
+    run(textures[0], TEXTURE_NEAREST, 0.0f);
+
+    for (int f = 0; f < 2; f++) {
+        TextureFilter filter = f == 0 ? TEXTURE_NEAREST : TEXTURE_BILINEAR;
+        printf("%s (Mtexels/s)\n", f == 0 ? "Nearest" : "Bilinear");
+        printf("%-12s %10s %10s %10s\n", "layout", "0 deg", "45 deg", "90 deg");
+
+        double linear_90 = 0.0;
+        for (int t = 0; t < 3; t++) {
+            double rate = 0.0;
+            printf("%-12s", names[t]);
+            for (int a = 0; a < 3; a++) {
+                rate = run(textures[t], filter, angles[a] * (float)M_PI / 180.0f);
+                printf(" %10.1f", rate / 1e6);
+            }
+            if (t == 0)
+                linear_90 = rate;
+            else
+                printf("   (90 deg: %.2fx vs linear)", rate / linear_90);
+            printf("\n");
+        }
+        printf("\n");
+    }
+
+    for (int t = 0; t < 3; t++)
+        texture_destroy(textures[t]);
+    free(image);
+
+    return 0;
+}
@@ -0,0 +1,159 @@
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "test_framework.h"
+#include "core/assets.h"
+#include "core/obj.h"
+#include "core/scene.h"
+#include "core/memory.h"
+
+#define TOTAL_TESTS 11
+
+#define ASSET_DIR "test_assets_dir"
+#define ASSET_PATH ASSET_DIR "/grid.obj"
+#define TIMEOUT_MS 5000
+
+#define WHITE (Color){255, 255, 255, 255}
+
+// n x n quads in the xz plane
+static Mesh* grid(int n, float height) {
+    Vector4 vertices[(8 + 1) * (8 + 1)];
+    Triangle triangles[8 * 8 * 2];
+    for (int z = 0; z <= n; z++)
+        for (int x = 0; x <= n; x++)
+            vertices[z * (n + 1) + x] = (Vector4){(float)x, height, (float)z, 1.0f};
+    for (int z = 0, t = 0; z < n; z++)
+        for (int x = 0; x < n; x++) {
+            int i = z * (n + 1) + x;
+            triangles[t++] = (Triangle){{i, i + n + 1, i + 1}};
+            triangles[t++] = (Triangle){{i + 1, i + n + 1, i + n + 2}};
+        }
+    return mesh_generate(vertices, (n + 1) * (n + 1), triangles, 2 * n * n);
+}
+
+static int save_grid(const char* path, int n, float height) {
+    Mesh* mesh = grid(n, height);
+    int ok = obj_save(path, mesh);
+    mesh_destroy(mesh);
+    return ok;
+}
+
+static void write_text(const char* path, const char* text) {
+    FILE* file = fopen(path, "w");
+    fputs(text, file);
+    fclose(file);
+}
+
+// Runs frames until assets_update publishes a version or the loader reports an error
+static Uint64 run_frames(Assets* assets, Uint64 frame) {
+    int errors = assets->stats.errors;
+    for (Uint32 start = SDL_GetTicks(); SDL_GetTicks() - start < TIMEOUT_MS; frame++) {
+        if (assets_update(assets, frame) > 0 || assets->stats.errors > errors) return frame + 1;
+        SDL_Delay(1);
+    }
+    return frame;
+}
+
+int main(void) {
+    TestResult results[TOTAL_TESTS];
+    mkdir(ASSET_DIR, 0755);
+
+    // ------------------------------ OBJ ------------------------------
+    Mesh* quad = obj_parse("# quad\no quad\nv 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nvt 0 0\nvn 0 0 1\n"
+                           "f 1/1/1 2/1/1 3/1/1 4/1/1\n");
+    run_test("1. Polygon split into a fan",
+             quad && quad->vertex_count == 4 && quad->triangle_count == 2 && quad->triangles[1].vert[0] == 0 &&
+                 quad->triangles[1].vert[1] == 2 && quad->triangles[1].vert[2] == 3,
+             1, &results[0]);
+
+    Mesh* relative = obj_parse("v 0 0 0\nv 1 0 0\nv 0 1 0\nf -3//1 -2//1 -1//1 # comment\n");
+    run_test("2. Negative indices count back from the last position",
+             relative && relative->triangle_count == 1 && relative->triangles[0].vert[0] == 0 &&
+                 relative->triangles[0].vert[2] == 2 && relative->vertices[2].y == 1.0f,
+             1, &results[1]);
+
+    Mesh* out_of_range = obj_parse("v 0 0 0\nv 1 0 0\nf 1 2 3\n");
+    Mesh* two_corners = obj_parse("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2\n");
+    Mesh* bad_number = obj_parse("v 0 zero 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n");
+    run_test("3. Invalid files rejected", !out_of_range && !two_corners && !bad_number && !obj_parse(""), 1,
+             &results[2]);
+
+    Mesh* saved = grid(4, 0.25f);
+    Mesh* loaded = obj_save(ASSET_PATH, saved) ? obj_load(ASSET_PATH) : NULL;
+    run_test("4. Save and load round trip",
+             loaded && loaded->vertex_count == saved->vertex_count &&
+                 loaded->triangle_count == saved->triangle_count &&
+                 !memcmp(loaded->vertices, saved->vertices, sizeof(Vector4) * saved->vertex_count) &&
+                 !memcmp(loaded->triangles, saved->triangles, sizeof(Triangle) * saved->triangle_count),
+             1, &results[3]);
+
+    // ------------------------------ Loading ------------------------------
+    Assets* assets = assets_create(4, 2);
+    int handle = assets_add_mesh(assets, ASSET_PATH);
+    int empty = assets_mesh(assets, handle) == NULL;
+    Uint64 frame = run_frames(assets, 0);
+    const Mesh* first = assets_mesh(assets, handle);
+    run_test("5. First load published by a later update",
+             empty && first && first->vertex_count == 25 && first->normals && assets->assets[handle].version == 1,
+             1, &results[4]);
+
+    // ------------------------------ Hot reload ------------------------------
+    // Save to another file renamed over the watched one, like most editors
+    save_grid(ASSET_DIR "/grid.tmp", 8, 0.5f);
+    rename(ASSET_DIR "/grid.tmp", ASSET_PATH);
+    Uint64 swapped = frame = run_frames(assets, frame) - 1;
+    const Mesh* second = assets_mesh(assets, handle);
+    run_test("6. File renamed over the watched one reloaded",
+             second && second != first && second->vertex_count == 81 && assets->stats.reloads == 1, 1,
+             &results[5]);
+
+    // Frames swapped and swapped + 1 may still draw the first version
+    assets_update(assets, swapped + 1);
+    int kept = assets->stats.retired == 0;
+    assets_update(assets, swapped + 2);
+    run_test("7. Replaced version freed after the frames in flight", kept && assets->stats.retired == 1, 1,
+             &results[6]);
+
+    // Rewritten in place
+    save_grid(ASSET_PATH, 2, 1.0f);
+    frame = run_frames(assets, swapped + 3);
+    const Mesh* third = assets_mesh(assets, handle);
+    run_test("8. File rewritten in place reloaded",
+             third && third->vertex_count == 9 && third->vertices[0].y == 1.0f && assets->assets[handle].version == 3,
+             1, &results[7]);
+
+    write_text(ASSET_PATH, "v 0 0 0\nf 1 2 3\n");
+    frame = run_frames(assets, frame);
+    run_test("9. Broken file keeps the previous version",
+             assets->stats.errors == 1 && assets_mesh(assets, handle) == third && assets->assets[handle].version == 3,
+             1, &results[8]);
+
+    memory_frame_begin();
+    assets_update(assets, frame++);
+    memory_frame_end();
+    run_test("10. Updates do not allocate", memory_sum(memory_stats().frame).allocations, 0, &results[9]);
+
+    // ------------------------------ Scene ------------------------------
+    Scene* scene = scene_create(1);
+    int object = scene_add(scene, saved, WHITE, NO_TRANSFORM, 0);
+    int rebound = scene_set_mesh(scene, object, third);
+    const Object* obj = &scene->objects[object];
+    run_test("11. Object rebound to the new version",
+             rebound && obj->mesh == third && obj->draw.clipped_mesh->vertex_count == 9 &&
+                 obj->draw.clipped_mesh->triangles == third->triangles && obj->bounds.max.x == 2.0f,
+             1, &results[10]);
+
+    print_summary(results, TOTAL_TESTS);
+
+    // ------------------------------ Garbage collect ------------------------------
+    scene_destroy(scene);
+    assets_destroy(assets);
+    mesh_destroy(saved);
+    mesh_destroy(loaded);
+    mesh_destroy(relative);
+    mesh_destroy(quad);
+    remove(ASSET_PATH);
+    rmdir(ASSET_DIR);
+}
@@ -0,0 +1,157 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test_framework.h"
+#include "core/broadphase.h"
+#include "core/pipeline.h"
+#include "core/memory.h"
+
+#define TOTAL_TESTS 9
+
+#define OBJECTS 2000
+#define FRAMES 20
+#define WORLD 100.0f
+
+static float random_float(float lo, float hi) {
+    return lo + (hi - lo) * (float)rand() / RAND_MAX;
+}
+
+static Bounds random_box(float spread_x, float spread_y, float spread_z) {
+    Vector3 c = {random_float(0, spread_x), random_float(0, spread_y), random_float(0, spread_z)};
+    Vector3 h = {random_float(0.2f, 2.0f), random_float(0.2f, 2.0f), random_float(0.2f, 2.0f)};
+    return (Bounds){{{c.x - h.x, c.y - h.y, c.z - h.z}}, {{c.x + h.x, c.y + h.y, c.z + h.z}}};
+}
+
+static void move_box(Bounds* b, Vector3 d) {
+    for (int a = 0; a < 3; a++) {
+        b->min.v[a] += d.v[a];
+        b->max.v[a] += d.v[a];
+    }
+}
+
+static int compare_pairs(const void* x, const void* y) {
+    const BroadphasePair* p = x;
+    const BroadphasePair* q = y;
+    if (p->a != q->a) return p->a - q->a;
+    return p->b - q->b;
+}
+
+// Same pair set as the O(n^2) test of every pair
+static int matches_brute_force(Broadphase* bp, const Bounds* boxes, int count) {
+    int capacity = bp->pair_count + 16, expected_count = 0;
+    BroadphasePair* expected = malloc(sizeof(BroadphasePair) * capacity);
+    for (int i = 0; i < count; i++)
+        for (int j = i + 1; j < count; j++) {
+            const Bounds* a = &boxes[i];
+            const Bounds* b = &boxes[j];
+            int overlap = 1;
+            for (int k = 0; k < 3; k++)
+                overlap &= a->min.v[k] <= b->max.v[k] && b->min.v[k] <= a->max.v[k];
+            if (!overlap) continue;
+            if (expected_count == capacity) {
+                free(expected);
+                return 0;
+            }
+            expected[expected_count++] = (BroadphasePair){i, j};
+        }
+
+    qsort(bp->pairs, bp->pair_count, sizeof(BroadphasePair), compare_pairs);
+    qsort(expected, expected_count, sizeof(BroadphasePair), compare_pairs);
+    int same = expected_count == bp->pair_count &&
+               !memcmp(expected, bp->pairs, sizeof(BroadphasePair) * expected_count);
+    free(expected);
+    return same;
+}
+
+int main(void) {
+    TestResult results[TOTAL_TESTS];
+    srand(46);
+
+    // ------------------------------ World bounds ------------------------------
+    Bounds unit = {{{-1, -1, -1}}, {{1, 1, 1}}};
+    Transform t = NO_TRANSFORM;
+    t.translation = (Vector3){5.0f, 0.0f, -2.0f};
+    t.scale = (Vector3){1.0f, 3.0f, 1.0f};
+    t.rotation = (Vector3){0.0f, (float)M_PI / 4, 0.0f};
+    Bounds w = world_bounds(unit, t);
+    float r = sqrtf(2.0f);
+    int world_ok = fabsf(w.min.x - (5.0f - r)) < 1e-5f && fabsf(w.max.x - (5.0f + r)) < 1e-5f &&
+                   fabsf(w.min.y + 3.0f) < 1e-5f && fabsf(w.max.y - 3.0f) < 1e-5f &&
+                   fabsf(w.min.z - (-2.0f - r)) < 1e-5f && fabsf(w.max.z - (-2.0f + r)) < 1e-5f;
+    run_test("1. World bounds of a rotated, scaled and moved box", world_ok, 1, &results[0]);
+
+    // ------------------------------ Pairs ------------------------------
+    Broadphase* bp = broadphase_create(16);
+    Bounds* boxes = malloc(sizeof(Bounds) * OBJECTS);
+    for (int i = 0; i < OBJECTS; i++)
+        boxes[i] = random_box(WORLD, WORLD, WORLD / 4);
+    broadphase_update(bp, boxes, OBJECTS);
+    run_test("2. Pairs match the brute-force test", bp->pair_count > 0 && matches_brute_force(bp, boxes, OBJECTS), 1,
+             &results[1]);
+
+    // Small moves: the endpoints are re-sorted in place, never rebuilt
+    int incremental = 1;
+    for (int f = 0; f < FRAMES; f++) {
+        for (int i = 0; i < OBJECTS; i++)
+            move_box(&boxes[i], (Vector3){random_float(-0.3f, 0.3f), random_float(-0.3f, 0.3f), random_float(-0.3f, 0.3f)});
+        broadphase_update(bp, boxes, OBJECTS);
+        incremental &= !bp->stats.rebuilt && bp->stats.swaps > 0 && matches_brute_force(bp, boxes, OBJECTS);
+    }
+    run_test("3. Moving boxes keep matching with insertion sort updates", incremental, 1, &results[2]);
+
+    // Steady frames reuse every buffer
+    broadphase_update(bp, boxes, OBJECTS);
+    memory_frame_begin();
+    broadphase_update(bp, boxes, OBJECTS);
+    memory_frame_end();
+    run_test("4. Steady updates do not allocate", memory_sum(memory_stats().frame).allocations, 0, &results[3]);
+
+    // Teleported boxes exceed the swap budget: rebuilt with the radix sort
+    for (int i = 0; i < OBJECTS; i++)
+        boxes[i] = random_box(WORLD, WORLD, WORLD / 4);
+    broadphase_update(bp, boxes, OBJECTS);
+    run_test("5. Large moves fall back to a rebuild", bp->stats.rebuilt && matches_brute_force(bp, boxes, OBJECTS), 1,
+             &results[4]);
+
+    // ------------------------------ Axis and count changes ------------------------------
+    int first_axis = bp->axis;
+    for (int i = 0; i < OBJECTS; i++)
+        boxes[i] = random_box(WORLD / 8, WORLD / 8, WORLD * 2);
+    broadphase_update(bp, boxes, OBJECTS);
+    run_test("6. The sweep axis follows the spread of the boxes",
+             first_axis != 2 && bp->axis == 2 && matches_brute_force(bp, boxes, OBJECTS), 1, &results[5]);
+
+    broadphase_update(bp, boxes, OBJECTS / 3);
+    run_test("7. Fewer objects rebuild the endpoints",
+             bp->stats.rebuilt && matches_brute_force(bp, boxes, OBJECTS / 3), 1, &results[6]);
+
+    // Touching faces (at -0 and +0 too) overlap, a gap does not
+    Bounds touching[4] = {
+        {{{-1, 0, 0}}, {{-0.0f, 1, 1}}}, {{{0, 0, 0}}, {{1, 1, 1}}},
+        {{{1, 0, 0}}, {{2, 1, 1}}},      {{{2.5f, 0, 0}}, {{3, 1, 1}}}
+    };
+    broadphase_update(bp, touching, 4);
+    run_test("8. Touching boxes overlap", bp->pair_count == 2 && matches_brute_force(bp, touching, 4), 1, &results[7]);
+
+    // Unbounded boxes: a ground plane, and the last box in sweep order reaching +infinity
+    Bounds* open = malloc(sizeof(Bounds) * OBJECTS);
+    memcpy(open, boxes, sizeof(Bounds) * OBJECTS);
+    open[0] = (Bounds){{{-INFINITY, -1.0f, -INFINITY}}, {{INFINITY, 0.0f, INFINITY}}};
+    open[1] = (Bounds){{{WORLD, 0.0f, 0.0f}}, {{INFINITY, WORLD, WORLD}}};
+    open[2] = (Bounds){{{WORLD, -INFINITY, WORLD}}, {{INFINITY, INFINITY, INFINITY}}};
+    int unbounded = broadphase_update(bp, open, OBJECTS) && matches_brute_force(bp, open, OBJECTS);
+    for (int a = 0; a < 3; a++) {
+        for (int i = 3; i < OBJECTS; i++)
+            move_box(&open[i], (Vector3){a == 0 ? 0.5f : 0.0f, a == 1 ? 0.5f : 0.0f, a == 2 ? 0.5f : 0.0f});
+        unbounded &= broadphase_update(bp, open, OBJECTS) && matches_brute_force(bp, open, OBJECTS);
+    }
+    run_test("9. Infinite boxes overlap what they reach, the sweep stays in bounds", unbounded, 1, &results[8]);
+
+    print_summary(results, TOTAL_TESTS);
+
+    // ------------------------------ Garbage collect ------------------------------
+    free(open);
+    free(boxes);
+    broadphase_destroy(bp);
+}
@@ -0,0 +1,158 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test_framework.h"
+#include "core/capture.h"
+
+#define TOTAL_TESTS 10
+
+#define CAPTURE_FILE "test_capture.y4m"
+#define PPM_FILE "test_capture.ppm"
+#define FB_W 64
+#define FB_H 48
+#define RING 4
+#define FRAMES 40
+#define FPS 30
+
+static long file_size(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return -1;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    return size;
+}
+
+// Frame f is a solid gray level, so every frame of the file can be checked
+static uint32_t frame_color(int f) {
+    uint32_t level = (uint32_t)(f * 5) & 0xFF;
+    return 0xFF000000u | level << 16 | level << 8 | level;
+}
+
+// Every sample of every frame of the Y4M file matches the encoded frame color
+static int y4m_frames_match(const char* path, int frames, int width, int height) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return 0;
+    char header[64];
+    int ok = fgets(header, sizeof(header), file) != NULL;
+
+    size_t plane = (size_t)width * height;
+    uint8_t* data = malloc(plane * 3);
+    uint8_t expected[6 + 3];
+    for (int f = 0; ok && f < frames; f++) {
+        char tag[6];
+        ok = fread(tag, 1, 6, file) == 6 && !memcmp(tag, "FRAME\n", 6) &&
+             fread(data, 1, plane * 3, file) == plane * 3;
+        uint32_t pixel = frame_color(f);
+        capture_encode(CAPTURE_Y4M, &pixel, 1, 1, 1, expected);
+        for (size_t i = 0; ok && i < plane; i++)
+            ok = data[i] == expected[6] && data[plane + i] == expected[7] && data[2 * plane + i] == expected[8];
+    }
+    ok &= fgetc(file) == EOF;
+
+    free(data);
+    fclose(file);
+    return ok;
+}
+
+int main(void) {
+    TestResult results[TOTAL_TESTS];
+
+    // ------------------------------ Encoding ------------------------------
+    int sizes = capture_frame_bytes(CAPTURE_Y4M, FB_W, FB_H) == 6 + FB_W * FB_H * 3 &&
+                capture_frame_bytes(CAPTURE_PPM, FB_W, FB_H) == strlen("P6\n64 48\n255\n") + FB_W * FB_H * 3;
+    run_test("1. Encoded frame sizes include the frame headers", sizes, 1, &results[0]);
+
+    // 2 x 2 image in a 4-pixel pitch: the padding must not be encoded
+    uint32_t pixels[8] = {0xFFFF0000u, 0xFF00FF00u, 0xDEADBEEFu, 0xDEADBEEFu,
+                          0xFF0000FFu, 0xFFFFFFFFu, 0xDEADBEEFu, 0xDEADBEEFu};
+    uint8_t ppm[32];
+    size_t ppm_bytes = capture_encode(CAPTURE_PPM, pixels, 2, 2, 4, ppm);
+    const uint8_t rgb[12] = {255, 0, 0, 0, 255, 0, 0, 0, 255, 255, 255, 255};
+    int ppm_ok = ppm_bytes == capture_frame_bytes(CAPTURE_PPM, 2, 2) && !memcmp(ppm, "P6\n2 2\n255\n", 11) &&
+                 !memcmp(ppm + 11, rgb, 12);
+    run_test("2. PPM frames hold the RGB of the visible pixels", ppm_ok, 1, &results[1]);
+
+    uint32_t black_white[2] = {0xFF000000u, 0xFFFFFFFFu};
+    uint8_t y4m[6 + 6];
+    capture_encode(CAPTURE_Y4M, black_white, 2, 1, 2, y4m);
+    int studio = y4m[6] == 16 && y4m[7] == 235 && y4m[8] == 128 && y4m[9] == 128 && y4m[10] == 128 &&
+                 y4m[11] == 128;
+    run_test("3. Y4M uses BT.601 studio range (black 16, white 235)", studio, 1, &results[2]);
+
+    int rejected = capture_open(CAPTURE_FILE, CAPTURE_Y4M, 0, FB_H, RING, CAPTURE_BLOCK, FPS) == NULL &&
+                   capture_open(CAPTURE_FILE, CAPTURE_Y4M, FB_W, FB_H, 0, CAPTURE_BLOCK, FPS) == NULL &&
+                   capture_open("missing/dir/out.y4m", CAPTURE_Y4M, FB_W, FB_H, RING, CAPTURE_BLOCK, FPS) == NULL;
+    run_test("4. Invalid parameters and paths are rejected", rejected, 1, &results[3]);
+
+    // ------------------------------ Block policy ------------------------------
+    Framebuffer* fb = framebuffer_create(FB_W, FB_H);
+    Capture* capture = capture_open(CAPTURE_FILE, CAPTURE_Y4M, FB_W, FB_H, RING, CAPTURE_BLOCK, FPS);
+    if (!fb || !capture) {
+        print_summary(results, 4);
+        return 1;
+    }
+
+    int queued = 0;
+    for (int f = 0; f < FRAMES; f++) {
+        framebuffer_clear(fb, frame_color(f));
+        queued += capture_frame(capture, fb);
+    }
+    CaptureStats stats;
+    int closed = capture_close(capture, &stats);
+    run_test("5. Blocking capture queues every frame", closed && queued == FRAMES && stats.dropped == 0, 1,
+             &results[4]);
+
+    char header[64];
+    int header_bytes = snprintf(header, sizeof(header), "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C444\n", FB_W, FB_H, FPS);
+    long expected_size = header_bytes + (long)FRAMES * capture_frame_bytes(CAPTURE_Y4M, FB_W, FB_H);
+    run_test("6. File holds the header and every frame", file_size(CAPTURE_FILE) == expected_size, 1,
+             &results[5]);
+    run_test("7. Frames are written in order with their content",
+             y4m_frames_match(CAPTURE_FILE, FRAMES, FB_W, FB_H), 1, &results[6]);
+
+    // ------------------------------ Drop policy ------------------------------
+    // One buffer: frames submitted faster than the writer encodes them are dropped, never queued twice
+    capture = capture_open(PPM_FILE, CAPTURE_PPM, FB_W, FB_H, 1, CAPTURE_DROP, FPS);
+    queued = 0;
+    for (int f = 0; capture && f < FRAMES; f++)
+        queued += capture_frame(capture, fb);
+    closed = capture && capture_close(capture, &stats);
+    int accounted = closed && stats.submitted == FRAMES && stats.captured == queued &&
+                    stats.captured + stats.dropped == FRAMES && stats.max_queued <= 1 && stats.written == queued;
+    run_test("8. Dropping capture accounts for every frame", accounted, 1, &results[7]);
+    run_test("9. Only captured frames reach the file",
+             file_size(PPM_FILE) == (long)queued * (long)capture_frame_bytes(CAPTURE_PPM, FB_W, FB_H), 1,
+             &results[8]);
+
+    // ------------------------------ Size mismatch ------------------------------
+    // Dynamic resolution shrinks the visible framebuffer: the rest of the frame is black
+    framebuffer_clear(fb, 0xFFFFFFFFu);
+    framebuffer_resize(fb, FB_W / 2, FB_H / 2);
+    capture = capture_open(PPM_FILE, CAPTURE_PPM, FB_W, FB_H, RING, CAPTURE_BLOCK, FPS);
+    int padded = 0;
+    if (capture) {
+        capture_frame(capture, fb);
+        capture_close(capture, NULL);
+        FILE* file = fopen(PPM_FILE, "rb");
+        uint8_t* frame = malloc(capture_frame_bytes(CAPTURE_PPM, FB_W, FB_H));
+        size_t header_len = strlen("P6\n64 48\n255\n");
+        if (file && frame && fread(frame, 1, capture_frame_bytes(CAPTURE_PPM, FB_W, FB_H), file) ==
+                                 capture_frame_bytes(CAPTURE_PPM, FB_W, FB_H)) {
+            const uint8_t* rgb_data = frame + header_len;
+            padded = rgb_data[0] == 255 && rgb_data[(FB_W / 2 - 1) * 3] == 255 && rgb_data[(FB_W / 2) * 3] == 0 &&
+                     rgb_data[((FB_H / 2) * FB_W) * 3] == 0 && rgb_data[(FB_W * FB_H - 1) * 3] == 0;
+        }
+        if (file) fclose(file);
+        free(frame);
+    }
+    run_test("10. Smaller framebuffers are padded with black", padded, 1, &results[9]);
+
+    print_summary(results, TOTAL_TESTS);
+
+    // ------------------------------ Garbage collect ------------------------------
+    framebuffer_destroy(fb);
+    remove(CAPTURE_FILE);
+    remove(PPM_FILE);
+}
@@ -0,0 +1,189 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <SDL.h>
+
+#include "test_framework.h"
+#include "core/commands.h"
+
+#define TOTAL_TESTS 10
+
+#define RING 64
+#define ARENA_BYTES 1024
+#define WHITE (Color){255, 255, 255, 255}
+
+// Stress test: every frame moves every object to the frame number
+#define STRESS_FRAMES 5000
+#define STRESS_OBJECTS 24
+#define STRESS_RING 32
+
+static Mesh* create_triangle(void) {
+    Vector4 vertices[3] = {{0, 0, 0, 1}, {1, 0, 0, 1}, {0, 1, 0, 1}};
+    Triangle triangles[1] = {{0, 1, 2}};
+    return mesh_generate(vertices, 3, triangles, 1);
+}
+
+static Transform at(float x, float y, float z) {
+    Transform t = NO_TRANSFORM;
+    t.translation = (Vector3){x, y, z};
+    return t;
+}
+
+/* **************************** STRESS ****************************** */
+
+typedef struct Stress {
+    CommandQueue* queue;
+    int retries;
+} Stress;
+
+// Simulation thread: spins (yielding) whenever the ring, the arena or the render thread is behind
+static int simulate(void* data) {
+    Stress* stress = data;
+    CommandQueue* queue = stress->queue;
+
+    for (int f = 1; f <= STRESS_FRAMES; f++) {
+        while (!command_begin_frame(queue)) {
+            stress->retries++;
+            SDL_Delay(0);
+        }
+        for (int i = 0; i < STRESS_OBJECTS; i++)
+            while (!command_push_transform(queue, i, at((float)f, (float)i, (float)(f * STRESS_OBJECTS + i)))) {
+                stress->retries++;
+                SDL_Delay(0);
+            }
+        while (!command_end_frame(queue)) {
+            stress->retries++;
+            SDL_Delay(0);
+        }
+    }
+    return 0;
+}
+
+// Whole frames only: every object holds the same frame, with an intact payload
+static int scene_consistent(const Scene* scene, float* frame) {
+    float f = scene->objects[0].transform.translation.x;
+    *frame = f;
+    for (int i = 0; i < scene->count; i++) {
+        Vector3 t = scene->objects[i].transform.translation;
+        if (t.x != f || t.y != (float)i || t.z != f * STRESS_OBJECTS + i) return 0;
+    }
+    return 1;
+}
+
+int main(void) {
+    TestResult results[TOTAL_TESTS];
+
+    // ------------------------------ Arena ------------------------------
+    Arena* arena = arena_create(100);
+    uint8_t* a = arena_alloc(arena, 1);
+    uint8_t* b = arena_alloc(arena, 20);
+    uint8_t* c = arena_alloc(arena, 16);
+    int aligned = arena->capacity == 112 && a && b == a + 16 && c == b + 32 &&
+                  (uintptr_t)a % ARENA_ALIGNMENT == 0 && arena->used == 64;
+    run_test("1. Arena allocations are aligned and contiguous", aligned, 1, &results[0]);
+
+    int full = arena_alloc(arena, 64) == NULL && arena->failed == 1 && arena_alloc(arena, 48) != NULL;
+    arena_reset(arena);
+    int reset = arena->used == 0 && arena->peak == 112 && arena_alloc(arena, 1) == a;
+    run_test("2. Full arena refuses, reset frees everything", full && reset, 1, &results[1]);
+    arena_destroy(arena);
+
+    // ------------------------------ SPSC ring ------------------------------
+    SpscQueue* ring = spsc_create(5, sizeof(int));
+    int fifo = ring && ring->capacity == 8;
+    for (int round = 0; fifo && round < 5; round++) {
+        for (int i = 0; i < 6; i++)
+            fifo &= spsc_push(ring, &(int){round * 10 + i});
+        for (int i = 0; i < 6; i++) {
+            int value = -1;
+            fifo &= spsc_pop(ring, &value) && value == round * 10 + i;
+        }
+    }
+    run_test("3. Ring keeps FIFO order across wrap-arounds", fifo, 1, &results[2]);
+
+    int bounded = 1, value = 0;
+    for (int i = 0; ring && i < 8; i++)
+        bounded &= spsc_push(ring, &i);
+    bounded &= ring && !spsc_push(ring, &value) && spsc_count(ring) == 8;
+    for (int i = 0; ring && i < 8; i++)
+        bounded &= spsc_pop(ring, &value) && value == i;
+    bounded &= ring && !spsc_pop(ring, &value) && spsc_count(ring) == 0;
+    run_test("4. Ring holds exactly its capacity", bounded, 1, &results[3]);
+    if (ring) spsc_destroy(ring);
+
+    // ------------------------------ Commands ------------------------------
+    Mesh* mesh = create_triangle();
+    Scene* scene = scene_create(4);
+    CommandQueue* queue = command_queue_create(RING, ARENA_BYTES);
+    if (!mesh || !scene || !queue) {
+        print_summary(results, 4);
+        return 1;
+    }
+    scene_add(scene, mesh, WHITE, NO_TRANSFORM, 0);
+    Camera camera = {{0, 0, 5}, {0, 0, 0}, {0, 1, 0}};
+
+    command_begin_frame(queue);
+    command_push_transform(queue, 0, at(1, 2, 3));
+    command_push_camera(queue, (Camera){{0, 0, 9}, {0, 0, 0}, {0, 1, 0}});
+    command_push_mesh_add(queue, mesh, WHITE, at(4, 5, 6), 0);
+    command_push_mesh_add(queue, mesh, WHITE, at(7, 8, 9), 0);
+    int pending = command_drain(queue, scene, &camera) == 0 && scene->count == 1 && camera.pos.z == 5.0f;
+    run_test("5. Commands of an open frame are not applied", pending, 1, &results[4]);
+
+    command_push_mesh_remove(queue, 1);
+    command_end_frame(queue);
+    int drained = command_drain(queue, scene, &camera) == 5;
+    int state = scene->count == 2 && scene->objects[0].transform.translation.x == 1.0f &&
+                scene->objects[1].transform.translation.x == 7.0f && camera.pos.z == 9.0f;
+    run_test("6. An ended frame applies transforms, camera, adds and removes", drained && state, 1, &results[5]);
+
+    // Render thread falls behind: the arena of the oldest frame is still in use
+    int frames = 0;
+    while (command_begin_frame(queue) && command_push_transform(queue, 0, at(0, 0, 0)) && command_end_frame(queue))
+        frames++;
+    int stalled = frames == COMMAND_FRAMES && queue->stats.stalls == 1;
+    command_drain(queue, scene, &camera);
+    int resumed = command_begin_frame(queue);
+    run_test("7. A frame cannot start until its arena is released", stalled && resumed, 1, &results[6]);
+
+    int arena_full = 0;
+    for (int i = 0; i < ARENA_BYTES && !arena_full; i++)
+        arena_full = !command_push_transform(queue, 0, at(0, 0, 0));
+    arena_full &= queue->stats.arena_full == 1 && queue->stats.ring_full == 0;
+    command_end_frame(queue);
+    command_drain(queue, scene, &camera);
+    run_test("8. Pushes beyond the frame arena are refused", arena_full, 1, &results[7]);
+    command_queue_destroy(queue);
+
+    // ------------------------------ Threaded stress ------------------------------
+    // Run under ThreadSanitizer with `make tsan`
+    for (int i = scene->count; i < STRESS_OBJECTS; i++)
+        scene_add(scene, mesh, WHITE, NO_TRANSFORM, 0);
+    for (int i = 0; i < STRESS_OBJECTS; i++)
+        scene->objects[i].transform = at(0.0f, (float)i, (float)i);
+
+    Stress stress = {command_queue_create(STRESS_RING, STRESS_OBJECTS * sizeof(Transform) * 2), 0};
+    SDL_Thread* thread = stress.queue ? SDL_CreateThread(simulate, "simulation", &stress) : NULL;
+    int consistent = thread != NULL, monotonic = 1;
+    float last = 0.0f, frame = 0.0f;
+    while (thread && last < STRESS_FRAMES) {
+        command_drain(stress.queue, scene, NULL);
+        consistent &= scene_consistent(scene, &frame);
+        monotonic &= frame >= last;
+        last = frame;
+        SDL_Delay(0);
+    }
+    if (thread) SDL_WaitThread(thread, NULL);
+
+    CommandStats s = stress.queue ? stress.queue->stats : (CommandStats){0};
+    int complete = s.frames_applied == STRESS_FRAMES && s.applied == STRESS_FRAMES * STRESS_OBJECTS &&
+                   s.pushed == s.applied;
+    run_test("9. Every command crosses the threads once, in order", complete && monotonic, 1, &results[8]);
+    run_test("10. Only whole frames are applied, payloads intact", consistent, 1, &results[9]);
+
+    print_summary(results, TOTAL_TESTS);
+
+    // ------------------------------ Garbage collect ------------------------------
+    if (stress.queue) command_queue_destroy(stress.queue);
+    scene_destroy(scene);
+    mesh_destroy(mesh);
+}
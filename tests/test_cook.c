@@ -0,0 +1,180 @@
+#include <stdio.h>
+#include <string.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "test_framework.h"
+#include "core/cook.h"
+#include "core/hash.h"
+#include "core/assets.h"
+
+#define TOTAL_TESTS 12
+
+#define SOURCE "test_cook.obj"
+#define CACHE_DIR "test_cook_cache"
+#define TIMEOUT_MS 5000
+
+// n x n quads, each with its own 4 corners (welding merges them back to a grid)
+static void write_soup(const char* path, int n, float height) {
+    FILE* file = fopen(path, "w");
+    for (int z = 0; z < n; z++)
+        for (int x = 0; x < n; x++) {
+            fprintf(file, "v %d %g %d\nv %d %g %d\n", x, height, z, x, height, z + 1);
+            fprintf(file, "v %d %g %d\nv %d %g %d\n", x + 1, height, z + 1, x + 1, height, z);
+            fprintf(file, "f -4 -3 -2 -1\n");
+        }
+    fclose(file);
+}
+
+static uint64_t file_key(const char* path, const CookOptions* options) {
+    FILE* file = fopen(path, "rb");
+    char buffer[1 << 16];
+    size_t size = fread(buffer, 1, sizeof(buffer), file);
+    fclose(file);
+    return cook_key(buffer, size, options);
+}
+
+// Files in the cache directory, and how many are cooked meshes
+static int count_files(int* cooked) {
+    int files = 0;
+    *cooked = 0;
+    DIR* dir = opendir(CACHE_DIR);
+    for (struct dirent* entry; dir && (entry = readdir(dir));) {
+        if (entry->d_name[0] == '.') continue;
+        size_t length = strlen(entry->d_name);
+        files++;
+        *cooked += length == 16 + strlen(COOK_EXTENSION) && strcmp(entry->d_name + 16, COOK_EXTENSION) == 0;
+    }
+    if (dir) closedir(dir);
+    return files;
+}
+
+static void clear_cache(void) {
+    DIR* dir = opendir(CACHE_DIR);
+    char path[512];
+    for (struct dirent* entry; dir && (entry = readdir(dir));) {
+        if (entry->d_name[0] == '.') continue;
+        snprintf(path, sizeof(path), "%s/%s", CACHE_DIR, entry->d_name);
+        remove(path);
+    }
+    if (dir) closedir(dir);
+    rmdir(CACHE_DIR);
+}
+
+static int same_mesh(const Mesh* a, const Mesh* b) {
+    if (a->vertex_count != b->vertex_count || a->triangle_count != b->triangle_count) return 0;
+    if (!a->positions != !b->positions || !a->normals != !b->normals || !a->triangles16 != !b->triangles16) return 0;
+    int n = a->vertex_count, t = a->triangle_count;
+    return (a->positions ? !memcmp(a->positions, b->positions, sizeof(Vector3) * n)
+                         : !memcmp(a->vertices, b->vertices, sizeof(Vector4) * n)) &&
+           (!a->normals || !memcmp(a->normals, b->normals, sizeof(Vector4) * n)) &&
+           (a->triangles16 ? !memcmp(a->triangles16, b->triangles16, sizeof(Triangle16) * t)
+                           : !memcmp(a->triangles, b->triangles, sizeof(Triangle) * t));
+}
+
+int main(void) {
+    TestResult results[TOTAL_TESTS];
+    clear_cache();
+
+    // ------------------------------ Hash ------------------------------
+    const char* spam = "Nobody inspects the spammish repetition";
+    run_test("1. hash64 matches the XXH64 reference",
+             hash64("", 0, 0) == 0xEF46DB3751D8E999ull && hash64("a", 1, 0) == 0xD24EC4F1A98C6E5Bull &&
+                 hash64("abc", 3, 0) == 0x44BC2CF5AD770999ull && hash64(spam, strlen(spam), 0) == 0xFBCEA83C8A378BF1ull,
+             1, &results[0]);
+
+    CookOptions options = {0.001f, 1, 1};
+    CookOptions other = {0.001f, 1, 0};
+    CookOptions no_weld = {-1.0f, 1, 0}, no_weld_too = {-5.0f, 1, 0};
+    run_test("2. Key follows the content and the options",
+             cook_key("v 0 0 0", 7, &options) != cook_key("v 0 0 1", 7, &options) &&
+                 cook_key("v 0 0 0", 7, &options) != cook_key("v 0 0 0", 7, &other) &&
+                 cook_key("v 0 0 0", 7, &no_weld) == cook_key("v 0 0 0", 7, &no_weld_too),
+             1, &results[1]);
+
+    // ------------------------------ Cache ------------------------------
+    write_soup(SOURCE, 4, 0.0f);
+    CookStats stats = {0};
+    Bounds cold_bounds, warm_bounds;
+    Mesh* cold = cook_load_mesh(SOURCE, &options, CACHE_DIR, &cold_bounds, &stats);
+    int cooked, files = count_files(&cooked);
+    run_test("3. Cold load imports, processes and cooks",
+             cold && stats.misses == 1 && stats.hits == 0 && cooked == 1 && cold->vertex_count == 25 &&
+                 cold->triangle_count == 32 && cold->normals && cold->positions && cold->triangles16,
+             1, &results[2]);
+    run_test("4. Cooked file renamed into place, no temporary left", files, 1, &results[3]);
+
+    Mesh* warm = cook_load_mesh(SOURCE, &options, CACHE_DIR, &warm_bounds, &stats);
+    run_test("5. Warm load reads the cooked mesh as is",
+             warm && stats.hits == 1 && same_mesh(warm, cold) && !memcmp(&warm_bounds, &cold_bounds, sizeof(Bounds)) &&
+                 cold_bounds.max.x == 4.0f,
+             1, &results[4]);
+
+    Mesh* plain = cook_load_mesh(SOURCE, &other, CACHE_DIR, NULL, &stats);
+    count_files(&cooked);
+    run_test("6. Other options miss and cook another file",
+             plain && stats.misses == 2 && cooked == 2 && plain->vertices && plain->triangles, 1, &results[5]);
+
+    write_soup(SOURCE, 3, 1.0f);
+    Mesh* edited = cook_load_mesh(SOURCE, &options, CACHE_DIR, NULL, &stats);
+    count_files(&cooked);
+    run_test("7. Edited source misses", edited && stats.misses == 3 && cooked == 3 && edited->vertex_count == 16, 1,
+             &results[6]);
+
+    // Truncated cooked file (a crash mid-write on a file system without ordered renames)
+    char path[512];
+    uint64_t key = file_key(SOURCE, &options);
+    cook_path(path, sizeof(path), CACHE_DIR, key);
+    int truncated = truncate(path, sizeof(CookHeader) + 10) == 0;
+    Mesh* repaired = cook_load_mesh(SOURCE, &options, CACHE_DIR, NULL, &stats);
+    Mesh* reread = cook_read(path, key, NULL);
+    run_test("8. Truncated cooked file rejected and rewritten",
+             truncated && repaired && stats.misses == 4 && reread && same_mesh(reread, edited), 1, &results[7]);
+    run_test("9. Cooked file of another key rejected", cook_read(path, key + 1, NULL) == NULL, 1, &results[8]);
+
+    // Right size and key, but an index past the vertices, then a negative one
+    Vector4 corners[3] = {{0, 0, 0, 1}, {1, 0, 0, 1}, {0, 1, 0, 1}};
+    Triangle corrupt[1] = {{0, 1, 2}};
+    Mesh* bad = mesh_generate(corners, 3, corrupt, 1);
+    bad->triangles[0].vert[2] = 3;
+    int past = cook_write(path, bad, key) && cook_read(path, key, NULL) == NULL;
+    bad->triangles[0].vert[2] = -1;
+    int negative = cook_write(path, bad, key) && cook_read(path, key, NULL) == NULL;
+    mesh_destroy(bad);
+    run_test("10. Cooked file with an out-of-range index rejected", past && negative, 1, &results[9]);
+
+    Mesh* uncached = cook_load_mesh(SOURCE, &options, NULL, NULL, NULL);
+    run_test("11. Import without a cache", uncached && same_mesh(uncached, edited), 1, &results[10]);
+
+    // ------------------------------ Assets ------------------------------
+    write_soup(SOURCE, 2, 2.0f);
+    Assets* assets = assets_create(1, 1);
+    int set = assets_set_cooking(assets, options, CACHE_DIR);
+    int handle = assets_add_mesh(assets, SOURCE);
+    Uint64 frame = 0;
+    for (Uint32 start = SDL_GetTicks(); !assets_mesh(assets, handle) && SDL_GetTicks() - start < TIMEOUT_MS;) {
+        assets_update(assets, frame++);
+        SDL_Delay(1);
+    }
+    const Mesh* loaded = assets_mesh(assets, handle);
+    count_files(&cooked);
+    run_test("12. Asset loader cooks through the cache",
+             set && !assets_set_cooking(assets, options, NULL) && loaded && loaded->vertex_count == 9 &&
+                 loaded->triangles16 && cooked == 4,
+             1, &results[11]);
+
+    print_summary(results, TOTAL_TESTS);
+
+    // ------------------------------ Garbage collect ------------------------------
+    assets_destroy(assets);
+    mesh_destroy(cold);
+    mesh_destroy(warm);
+    mesh_destroy(plain);
+    mesh_destroy(edited);
+    mesh_destroy(repaired);
+    mesh_destroy(reread);
+    mesh_destroy(uncached);
+    remove(SOURCE);
+    clear_cache();
+}
@@ -0,0 +1,225 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test_framework.h"
+#include "test_fixtures.h"
+#include "core/depth_sort.h"
+#include "core/pipeline.h"
+#include "core/renderer.h"
+#include "core/scene.h"
+#include "core/memory.h"
+
+#define TOTAL_TESTS 13
+
+#define SORT_COUNT 100000
+#define GRID 200
+#define WORKERS 3
+#define SCREEN_W 64
+#define SCREEN_H 64
+#define WHITE (Color){255, 255, 255, 255}
+
+static uint64_t random_key(void) {
+    uint64_t key = 0;
+    for (int i = 0; i < 4; i++)
+        key = (key << 16) ^ (uint64_t)(rand() & 0xFFFF);
+    return key;
+}
+
+// Same entries in the same buffer
+static int same_sort(SortKey* items, SortKey* scratch, const SortKey* original, int count, JobSystem* jobs) {
+    SortKey* copy = malloc(sizeof(SortKey) * count);
+    memcpy(copy, original, sizeof(SortKey) * count);
+    memcpy(items, original, sizeof(SortKey) * count);
+    SortKey* expected = radix_sort(copy, scratch, count);
+    int expected_in_scratch = expected == scratch;
+    SortKey* reference = malloc(sizeof(SortKey) * count);
+    memcpy(reference, expected, sizeof(SortKey) * count);
+
+    SortKey* sorted = radix_sort_parallel(items, scratch, count, jobs);
+    int same = (sorted == scratch) == expected_in_scratch;
+    for (int i = 0; same && i < count; i++)
+        same = sorted[i].key == reference[i].key && sorted[i].index == reference[i].index;
+    free(copy);
+    free(reference);
+    return same;
+}
+
+static float triangle_depth(const Mesh* clipped, int t) {
+    Triangle tri = mesh_triangle(clipped, t);
+    return clipped->vertices[tri.vert[0]].w + clipped->vertices[tri.vert[1]].w + clipped->vertices[tri.vert[2]].w;
+}
+
+// Every triangle once, depths monotonic in the given order, equal depths in index order
+static int is_depth_order(const Mesh* clipped, const int* order, DepthOrder direction) {
+    int n = clipped->triangle_count;
+    char* seen = calloc(n, 1);
+    int ok = 1;
+    for (int i = 0; ok && i < n; i++) {
+        ok = order[i] >= 0 && order[i] < n && !seen[order[i]];
+        if (ok) seen[order[i]] = 1;
+        if (ok && i > 0) {
+            float a = triangle_depth(clipped, order[i - 1]), b = triangle_depth(clipped, order[i]);
+            ok = direction == DEPTH_BACK_TO_FRONT ? a >= b : a <= b;
+            if (ok && a == b) ok = order[i - 1] < order[i];
+        }
+    }
+    free(seen);
+    return ok;
+}
+
+int main(void) {
+    TestResult results[TOTAL_TESTS];
+    srand(42);
+    JobSystem* jobs = jobs_create(WORKERS);
+
+    // ------------------------------ Parallel radix sort ------------------------------
+    SortKey* items = malloc(sizeof(SortKey) * SORT_COUNT);
+    SortKey* scratch = malloc(sizeof(SortKey) * SORT_COUNT);
+    SortKey* original = malloc(sizeof(SortKey) * SORT_COUNT);
+    for (int i = 0; i < SORT_COUNT; i++)
+        original[i] = (SortKey){random_key(), i};
+    run_test("1. Parallel radix sort matches radix_sort on 64-bit keys",
+             same_sort(items, scratch, original, SORT_COUNT, jobs), 1, &results[0]);
+
+    // Few distinct keys in the low byte: one pass, equal keys keep their order across chunks
+    for (int i = 0; i < SORT_COUNT; i++)
+        original[i] = (SortKey){(uint64_t)(rand() % 7), i};
+    run_test("2. Parallel radix sort is stable and skips the same bytes",
+             same_sort(items, scratch, original, SORT_COUNT, jobs), 1, &results[1]);
+
+    for (int i = 0; i < SORT_COUNT; i++)
+        original[i] = (SortKey){random_key() & 0xFFFFFF, i};
+    run_test("3. Small sorts and sorts without workers fall back to radix_sort",
+             same_sort(items, scratch, original, RADIX_PARALLEL_MIN - 1, jobs) &&
+                 same_sort(items, scratch, original, SORT_COUNT, NULL),
+             1, &results[2]);
+
+    // ------------------------------ Keys ------------------------------
+    float depths[5] = {-2.0f, -0.5f, 0.0f, 0.5f, 3.0f};
+    int ascending = 1, descending = 1;
+    for (int i = 1; i < 5; i++) {
+        ascending &= depth_key(depths[i - 1], DEPTH_FRONT_TO_BACK) < depth_key(depths[i], DEPTH_FRONT_TO_BACK);
+        descending &= depth_key(depths[i - 1], DEPTH_BACK_TO_FRONT) > depth_key(depths[i], DEPTH_BACK_TO_FRONT);
+    }
+    run_test("4. Depth keys follow the order, negative depths included",
+             ascending && descending && depth_key(1.0f, DEPTH_BACK_TO_FRONT) >> 32 == 0, 1, &results[3]);
+
+    // ------------------------------ Mesh ------------------------------
+    Mesh* grid = create_grid_mesh(GRID, 2.0f);
+    Mesh* clipped = mesh_create_clipped(grid);
+    Transform tilted = NO_TRANSFORM;
+    tilted.translation = (Vector3){0.0f, 0.0f, -2.5f};
+    tilted.rotation = (Vector3){0.7f, 0.4f, 0.0f};
+    Camera cam = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, -1.0f}, {0.0f, 1.0f, 0.0f}};
+    Projection proj = {M_PI / 3, 1.0f, 0.1f, 100.0f};
+    update_mesh(grid, clipped, tilted, cam, proj);
+
+    DepthSort* sort = depth_sort_create(1);
+    const int* back = depth_sort_mesh(sort, clipped, DEPTH_BACK_TO_FRONT, NULL);
+    int* inline_order = malloc(sizeof(int) * clipped->triangle_count);
+    memcpy(inline_order, back, sizeof(int) * clipped->triangle_count);
+    run_test("5. Back to front: farthest triangles first",
+             back && sort->count == GRID * GRID * 2 && is_depth_order(clipped, back, DEPTH_BACK_TO_FRONT), 1,
+             &results[4]);
+
+    const int* front = depth_sort_mesh(sort, clipped, DEPTH_FRONT_TO_BACK, NULL);
+    run_test("6. Front to back: nearest triangles first", front && is_depth_order(clipped, front, DEPTH_FRONT_TO_BACK),
+             1, &results[5]);
+
+    // Sorted again at full size with the job system: no allocation, same order
+    memory_frame_begin();
+    const int* threaded = depth_sort_mesh(sort, clipped, DEPTH_BACK_TO_FRONT, jobs);
+    memory_frame_end();
+    MemoryStats stats = memory_stats();
+    run_test("7. Job split gives the same order without allocating",
+             threaded && !memcmp(threaded, inline_order, sizeof(int) * clipped->triangle_count) &&
+                 memory_sum(stats.frame).allocations == 0,
+             1, &results[6]);
+
+    Mesh* compact = mesh_copy(grid);
+    mesh_compact(compact);
+    Mesh* compact_clipped = mesh_create_clipped(compact);
+    update_mesh(compact, compact_clipped, tilted, cam, proj);
+    const int* compact_order = depth_sort_mesh(sort, compact_clipped, DEPTH_BACK_TO_FRONT, jobs);
+    run_test("8. 16-bit indices sort the same",
+             compact_clipped->triangles16 && compact_order &&
+                 !memcmp(compact_order, inline_order, sizeof(int) * clipped->triangle_count),
+             1, &results[7]);
+
+    // ------------------------------ Drawing ------------------------------
+    // Same screen triangle and NDC depth, w = 1 (index 0, red) and w = 2 (index 1, blue)
+    Vector4 vertices[6] = {{-0.5f, -0.5f, 0.5f, 1.0f}, {0.5f, -0.5f, 0.5f, 1.0f}, {0.0f, 0.5f, 0.5f, 1.0f},
+                           {-1.0f, -1.0f, 1.0f, 2.0f}, {1.0f, -1.0f, 1.0f, 2.0f}, {0.0f, 1.0f, 1.0f, 2.0f}};
+    Triangle triangles[2] = {{{0, 1, 2}}, {{3, 4, 5}}};
+    uint32_t colors[6] = {0xFFFF0000u, 0xFFFF0000u, 0xFFFF0000u, 0xFF0000FFu, 0xFF0000FFu, 0xFF0000FFu};
+    Mesh* pair = mesh_generate(vertices, 6, triangles, 2);
+    Framebuffer* fb = framebuffer_create(SCREEN_W, SCREEN_H);
+    Draw draw = {.clipped_mesh = pair, .color = {255, 255, 255, 255}, .backend = RENDER_SOFTWARE,
+                 .shading = SHADE_FLAT, .vertex_colors = colors};
+
+    // Equal depths: the first triangle drawn keeps the pixel
+    uint32_t center[3];
+    for (int pass = 0; pass < 3; pass++) {
+        DepthOrder order = pass == 1 ? DEPTH_BACK_TO_FRONT : DEPTH_FRONT_TO_BACK;
+        draw.triangle_order = pass == 0 ? NULL : depth_sort_mesh(sort, pair, order, NULL);
+        framebuffer_clear(fb, 0xFF000000u);
+        framebuffer_clear_depth(fb);
+        draw_mesh_software(fb, &draw);
+        framebuffer_resolve(fb);
+        center[pass] = fb->pixels[(SCREEN_H / 2) * fb->pitch + SCREEN_W / 2];
+    }
+    run_test("9. Draws follow triangle_order", center[1] == 0xFF0000FFu && center[2] == 0xFFFF0000u, 1, &results[8]);
+    run_test("10. Without an order, triangles draw in index order", center[0] == 0xFFFF0000u, 1, &results[9]);
+
+    // ------------------------------ Scene ------------------------------
+    Scene* scene = scene_create(2);
+    int translucent = scene_add(scene, grid, WHITE, tilted, OBJECT_DEPTH_SORT);
+    int painted = scene_add(scene, grid, WHITE, tilted, 0);
+    scene->objects[translucent].draw.backend = RENDER_SOFTWARE;
+    scene->objects[painted].draw.shading = SHADE_FLAT;
+    scene_update(scene, cam, proj, jobs);
+    const Draw* a = &scene->objects[translucent].draw;
+    const Draw* b = &scene->objects[painted].draw;
+    run_test("11. scene_update sorts filled SDL and OBJECT_DEPTH_SORT draws, each into its own order",
+             a->triangle_order && b->triangle_order && a->triangle_order != b->triangle_order &&
+                 is_depth_order(a->clipped_mesh, a->triangle_order, DEPTH_BACK_TO_FRONT) &&
+                 is_depth_order(b->clipped_mesh, b->triangle_order, DEPTH_BACK_TO_FRONT),
+             1, &results[10]);
+
+    scene->objects[painted].draw.shading = SHADE_WIREFRAME;
+    scene_update(scene, cam, proj, jobs);
+    run_test("12. SDL wireframes keep index order", scene->objects[painted].draw.triangle_order == NULL, 1,
+             &results[11]);
+
+    // A reload with fewer triangles: the grid order must not index the new mesh
+    int reloaded = scene_set_mesh(scene, translucent, pair);
+    a = &scene->objects[translucent].draw;
+    int unsorted = a->triangle_order == NULL;
+    framebuffer_clear(fb, 0xFF000000u);
+    framebuffer_clear_depth(fb);
+    draw_mesh_software(fb, a);
+    scene_update(scene, cam, proj, jobs);
+    draw_mesh_software(fb, a);
+    run_test("13. A reloaded mesh drops the old order until it is sorted again",
+             reloaded && unsorted && a->triangle_order && scene->objects[translucent].depth_sort->count == 2 &&
+                 is_depth_order(a->clipped_mesh, a->triangle_order, DEPTH_BACK_TO_FRONT),
+             1, &results[12]);
+
+    print_summary(results, TOTAL_TESTS);
+
+    // ------------------------------ Garbage collect ------------------------------
+    scene_destroy(scene);
+    depth_sort_destroy(sort);
+    framebuffer_destroy(fb);
+    mesh_destroy(pair);
+    mesh_destroy(compact_clipped);
+    mesh_destroy(compact);
+    mesh_destroy(clipped);
+    mesh_destroy(grid);
+    jobs_destroy(jobs);
+    free(inline_order);
+    free(items);
+    free(scratch);
+    free(original);
+}
@@ -0,0 +1,78 @@
+#include <stdlib.h>
+#include <math.h>
+
+#include "test_fixtures.h"
+
+Mesh* create_cube_mesh(void) {
+    Vector4 vertices[] = {
+        {-1.0f, -1.0f, -1.0f, 1.0f}, // 0
+        { 1.0f, -1.0f, -1.0f, 1.0f}, // 1
+        { 1.0f,  1.0f, -1.0f, 1.0f}, // 2
+        {-1.0f,  1.0f, -1.0f, 1.0f}, // 3
+        {-1.0f, -1.0f,  1.0f, 1.0f}, // 4
+        { 1.0f, -1.0f,  1.0f, 1.0f}, // 5
+        { 1.0f,  1.0f,  1.0f, 1.0f}, // 6
+        {-1.0f,  1.0f,  1.0f, 1.0f}  // 7
+    };
+
+    Triangle triangles[] = {
+        // Front face
+        {{0, 1, 2}}, {{2, 3, 0}},
+        // Back face
+        {{4, 6, 5}}, {{6, 4, 7}},
+        // Left face
+        {{4, 0, 3}}, {{3, 7, 4}},
+        // Right face
+        {{1, 5, 6}}, {{6, 2, 1}},
+        // Top face
+        {{3, 2, 6}}, {{6, 7, 3}},
+        // Bottom face
+        {{4, 5, 1}}, {{1, 0, 4}}
+    };
+
+    return mesh_generate(vertices, 8, triangles, 12);
+}
+
+Mesh* create_grid_mesh(int subdivisions, float size) {
+    int side = subdivisions + 1;
+    float half = size * 0.5f;
+    Vector4* vertices = malloc(sizeof(Vector4) * side * side);
+    Triangle* triangles = malloc(sizeof(Triangle) * subdivisions * subdivisions * 2);
+
+    for (int i = 0; i <= subdivisions; i++)
+        for (int j = 0; j <= subdivisions; j++) {
+            float u = (float)i / subdivisions * 2.0f - 1.0f;
+            float v = (float)j / subdivisions * 2.0f - 1.0f;
+            vertices[i * side + j] = (Vector4){u * half, 0.1f * half * sinf(4.0f * u) * cosf(3.0f * v), v * half, 1.0f};
+        }
+
+    int t = 0;
+    for (int i = 0; i < subdivisions; i++)
+        for (int j = 0; j < subdivisions; j++) {
+            int base = i * side + j;
+            triangles[t++] = (Triangle){{base, base + 1, base + side}};
+            triangles[t++] = (Triangle){{base + 1, base + side + 1, base + side}};
+        }
+
+    Mesh* mesh = mesh_generate(vertices, side * side, triangles, t);
+    free(vertices);
+    free(triangles);
+    mesh_compute_normals(mesh, NULL);
+    return mesh;
+}
+
+Scene* create_grid_scene(const Mesh* mesh, int cols, int rows, float spacing, float scale) {
+    Scene* scene = scene_create(cols * rows);
+    if (!scene) return NULL;
+
+    for (int i = 0; i < cols; i++) {
+        for (int j = 0; j < rows; j++) {
+            Transform t = NO_TRANSFORM;
+            t.translation = (Vector3){(i - cols / 2) * spacing, 0.0f, -j * spacing};
+            t.scale = (Vector3){scale, scale, scale};
+            scene_add(scene, mesh, (Color){255, 255, 255, 255}, t, 0);
+        }
+    }
+
+    return scene;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "core/mesh.h"
+#include "core/scene.h"
+
+/**
+ * @brief Cube of side 2 centered on the origin (8 vertices, 12 outward-wound triangles)
+ */
+Mesh* create_cube_mesh(void);
+
+/**
+ * @brief Square grid of subdivisions x subdivisions quads in the xz plane, size wide and centered on the origin
+ *
+ * Heights follow a gentle sine relief (a twentieth of the size) so that lit vertices vary. Normals are computed.
+ */
+Mesh* create_grid_mesh(int subdivisions, float size);
+
+/**
+ * @brief cols x rows copies of a mesh on the ground plane, in front of a camera looking down -z
+ *
+ * Object (i, j) is the one at index i * rows + j, white, at ((i - cols / 2) * spacing, 0, -j * spacing)
+ * and uniformly scaled.
+ */
+Scene* create_grid_scene(const Mesh* mesh, int cols, int rows, float spacing, float scale);
@@ -0,0 +1,166 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <SDL.h>
+
+#include "test_framework.h"
+#include "core/frame_stats.h"
+#include "core/framebuffer.h"
+#include "core/memory.h"
+
+#define TOTAL_TESTS 9
+
+#define WINDOW 4
+#define FRAMES 6
+#define FB_SIZE 32
+#define BACKGROUND 0xFF000000u
+
+static int count_not_background(Framebuffer* fb) {
+    framebuffer_resolve(fb);
+    int count = 0;
+    for (int y = 0; y < fb->height; y++)
+        for (int x = 0; x < fb->width; x++)
+            count += fb->pixels[y * fb->pitch + x] != BACKGROUND;
+    return count;
+}
+
+int main(void) {
+    TestResult results[TOTAL_TESTS];
+
+    // ------------------------------ Frames ------------------------------
+    EngineFrameStats* stats = frame_stats_create(WINDOW);
+    FrameSummary none = frame_stats_summary(stats, FRAME_TRIANGLES);
+    int empty = stats->window == WINDOW && stats->samples == 0 && none.avg == 0 && none.min == 0 && none.max == 0;
+
+    frame_stats_begin(stats);
+    frame_stats_add(stats, FRAME_TRIANGLES, 12);
+    frame_stats_add(stats, FRAME_TRIANGLES, 30);
+    frame_stats_add(stats, FRAME_DRAWS, 2);
+    frame_stats_end(stats);
+    frame_stats_begin(stats);
+    int counted = stats->last[FRAME_TRIANGLES] == 42 && stats->last[FRAME_DRAWS] == 2 &&
+                  stats->current[FRAME_TRIANGLES] == 0 && stats->frames == 1;
+    frame_stats_end(stats);
+    run_test("1. Counts of a frame land in last, the next frame starts at zero", empty && counted, 1, &results[0]);
+
+    frame_stats_begin(stats);
+    SDL_Delay(2);
+    double update_ms = frame_stats_stage(stats, FRAME_UPDATE_MS);
+    frame_stats_stage(stats, FRAME_RASTER_MS);
+    frame_stats_end(stats);
+    const double* last = stats->last;
+    int timed = update_ms >= 1.5 && last[FRAME_UPDATE_MS] == update_ms && last[FRAME_RASTER_MS] >= 0 &&
+                last[FRAME_TOTAL_MS] >= last[FRAME_UPDATE_MS] + last[FRAME_RASTER_MS];
+    run_test("2. Stages time the span since the previous stage", timed, 1, &results[1]);
+
+    // ------------------------------ Rolling window ------------------------------
+    frame_stats_set_window(stats, WINDOW);
+    for (int f = 1; f <= FRAMES; f++) {
+        frame_stats_begin(stats);
+        frame_stats_add(stats, FRAME_PIXELS, f);
+        frame_stats_end(stats);
+    }
+    FrameSummary pixels = frame_stats_summary(stats, FRAME_PIXELS);
+    int rolling = stats->samples == WINDOW && pixels.min == FRAMES - WINDOW + 1 && pixels.max == FRAMES &&
+                  pixels.avg == (FRAMES + FRAMES - WINDOW + 1) / 2.0;
+    run_test("3. Average, min and max cover the last window frames", rolling, 1, &results[2]);
+
+    frame_stats_set_window(stats, 0);
+    int resized = stats->window == FRAME_STATS_WINDOW && stats->samples == 0 &&
+                  frame_stats_summary(stats, FRAME_PIXELS).max == 0;
+    run_test("4. A new window starts empty", resized, 1, &results[3]);
+
+    // ------------------------------ CSV sink ------------------------------
+    FILE* csv = tmpfile();
+    frame_stats_set_csv(stats, csv);
+    long first = stats->frames;
+    for (int f = 0; f < 3; f++) {
+        frame_stats_begin(stats);
+        frame_stats_add(stats, FRAME_VERTICES, 8 * (f + 1));
+        frame_stats_end(stats);
+    }
+    frame_stats_set_csv(stats, NULL);
+    frame_stats_begin(stats);
+    frame_stats_end(stats);
+
+    rewind(csv);
+    char line[512];
+    int rows = 0, header = 0;
+    long frame = -1;
+    double vertices = 0;
+    while (fgets(line, sizeof(line), csv)) {
+        if (rows++ == 0) {
+            header = strncmp(line, "frame,vertices,triangles", 24) == 0 && strstr(line, ",total_ms\n") != NULL;
+            continue;
+        }
+        sscanf(line, "%ld,%lf", &frame, &vertices);
+    }
+    fclose(csv);
+    run_test("5. The CSV sink gets a header and one row per frame", header && rows == 4 && frame == first + 2 && vertices == 24,
+             1, &results[4]);
+
+    memory_frame_begin();
+    csv = tmpfile();
+    frame_stats_set_csv(stats, csv);
+    for (int f = 0; f < FRAMES; f++) {
+        frame_stats_begin(stats);
+        frame_stats_add(stats, FRAME_LINES, 3);
+        frame_stats_stage(stats, FRAME_RASTER_MS);
+        frame_stats_end(stats);
+        frame_stats_summary(stats, FRAME_LINES);
+    }
+    memory_frame_end();
+    frame_stats_set_csv(stats, NULL);
+    fclose(csv);
+    run_test("6. Collecting frames does not allocate", memory_sum(memory_stats().frame).allocations, 0, &results[5]);
+
+    // ------------------------------ Raster counters ------------------------------
+    Framebuffer* fb = framebuffer_create(FB_SIZE, FB_SIZE);
+    framebuffer_clear(fb, BACKGROUND);
+    framebuffer_draw_line(fb, 2, 3, 11, 3, 0xFFFFFFFFu);
+    size_t horizontal = fb->pixels_drawn;
+    framebuffer_draw_line(fb, 0, 10, 20, 15, 0xFFFFFFFFu);
+    framebuffer_draw_line(fb, -10, 20, 100, 20, 0xFFFFFFFFu);
+    int lines = horizontal == 10 && fb->pixels_drawn == 10 + 21 + FB_SIZE &&
+                (size_t)count_not_background(fb) == fb->pixels_drawn;
+    run_test("7. Lines count the pixels they store, after clipping", lines, 1, &results[6]);
+
+    framebuffer_clear(fb, BACKGROUND);
+    framebuffer_clear_depth(fb);
+    fb->pixels_drawn = 0;
+    float x[3] = {1, 25, 4}, y[3] = {2, 6, 28}, z[3] = {0.5f, 0.5f, 0.5f};
+    uint32_t colors[3] = {0xFFFF0000u, 0xFF00FF00u, 0xFF0000FFu};
+    framebuffer_fill_triangle(fb, x, y, z, colors);
+    size_t filled = fb->pixels_drawn;
+    framebuffer_fill_triangle(fb, x, y, z, colors); // same depth: rejected
+    int triangles = filled > 0 && (size_t)count_not_background(fb) == filled && fb->pixels_drawn == filled;
+    run_test("8. Triangles count the pixels that pass the depth test", triangles, 1, &results[7]);
+
+    // ------------------------------ Scene counters ------------------------------
+    Vector4 vertices4[4] = {{0, 0, 0, 1}, {1, 0, 0, 1}, {0, 1, 0, 1}, {1, 1, 0, 1}};
+    Triangle quad[2] = {{0, 1, 2}, {1, 3, 2}};
+    Mesh* mesh = mesh_generate(vertices4, 4, quad, 2);
+    Scene* scene = scene_create(3);
+    Color white = {255, 255, 255, 255};
+    scene_add(scene, mesh, white, NO_TRANSFORM, 0);
+    int shaded = scene_add(scene, mesh, white, NO_TRANSFORM, 0);
+    int culled = scene_add(scene, mesh, white, NO_TRANSFORM, 0);
+    scene->objects[shaded].draw.shading = SHADE_FLAT;
+    scene->objects[culled].visible = 0;
+
+    frame_stats_begin(stats);
+    frame_stats_add_scene(stats, scene);
+    frame_stats_add_frame(stats, 7);
+    frame_stats_end(stats);
+    int collected = last[FRAME_VERTICES] == 8 && last[FRAME_TRIANGLES] == 4 && last[FRAME_LINES] == 6 &&
+                    last[FRAME_DRAWS] == 2 && last[FRAME_CULLED] == 1 && last[FRAME_PIXELS] == 7;
+    run_test("9. Visible objects count as draws, filled ones without lines", collected, 1, &results[8]);
+
+    print_summary(results, TOTAL_TESTS);
+
+    // ------------------------------ Garbage collect ------------------------------
+    scene_destroy(scene);
+    mesh_destroy(mesh);
+    framebuffer_destroy(fb);
+    frame_stats_destroy(stats);
+}
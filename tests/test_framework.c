@@ -9,6 +9,19 @@ static int almost_equal(float a, float b) {
     return fabsf(a - b) < EPSILON;
 }
 
+void run_test_int(const char* name, int got, int expected, TestResult* result){
+    if (got == expected) {
+        printf("✅ %s passed\n", name);
+        result->passed = 1;
+    } else {
+        printf("❌ %s failed!\n", name);
+        printf("   Got      = %d\n", got);
+        printf("   Expected = %d\n", expected);
+        result->passed = 0;
+    }
+    result->name = name;
+}
+
 void run_test_float(const char* name, float got, float expected, TestResult* result){
     if (almost_equal(got, expected)) {
         printf("✅ %s passed\n", name);
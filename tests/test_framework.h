@@ -6,6 +6,8 @@ typedef struct {
     int passed;
 } TestResult;
 
+void run_test_int(const char* name, int got, int expected, TestResult* result);
+
 void run_test_float(const char* name, float got, float expected, TestResult* result);
 
 void run_test_vector3(const char* name, Vector3 got, Vector3 expected, TestResult* result);
@@ -20,6 +22,7 @@ void print_summary_f(const char* filename, TestResult* results, int total);
 
 #define run_test(name, got, expected, result) \
     _Generic((got), \
+        int: run_test_int, \
         float: run_test_float, \
         Vector3: run_test_vector3, \
         Vector4: run_test_vector4, \
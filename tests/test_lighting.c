@@ -0,0 +1,171 @@
+#include <math.h>
+#include <string.h>
+
+#include "test_framework.h"
+#include "core/pipeline.h"
+#include "core/renderer.h"
+
+#define TOTAL_TESTS 11
+
+#define GRID 64
+#define FB_SIZE 64
+#define BACKGROUND 0xFF000000u
+
+// Bumpy GRID x GRID height field, big enough to be split across threads
+static Mesh* create_terrain(void) {
+    int n = GRID + 1;
+    Vector4* vertices = malloc(sizeof(Vector4) * n * n);
+    Triangle* triangles = malloc(sizeof(Triangle) * GRID * GRID * 2);
+
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            vertices[i * n + j] = (Vector4){i * 0.1f, 0.3f * sinf(i * 0.4f) * cosf(j * 0.3f), j * 0.1f, 1.0f};
+
+    int t = 0;
+    for (int i = 0; i < GRID; i++)
+        for (int j = 0; j < GRID; j++) {
+            int q = i * n + j;
+            triangles[t++] = (Triangle){{q, q + 1, q + n}};
+            triangles[t++] = (Triangle){{q + 1, q + n + 1, q + n}};
+        }
+
+    Mesh* mesh = mesh_generate(vertices, n * n, triangles, t);
+    free(vertices);
+    free(triangles);
+    return mesh;
+}
+
+static int channel_error(uint32_t a, uint32_t b) {
+    int err = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        int d = abs((int)((a >> shift) & 0xFF) - (int)((b >> shift) & 0xFF));
+        if (d > err) err = d;
+    }
+    return err;
+}
+
+int main(void) {
+    TestResult results[TOTAL_TESTS];
+
+    // ------------------------------ Normals ------------------------------
+    // Big triangle facing +y and small one facing +x share vertex 0
+    Vector4 corner[5] = {{0, 0, 0, 1}, {0, 0, 4, 1}, {4, 0, 0, 1}, {0, 1, 0, 1}, {0, 0, 1, 1}};
+    Triangle corner_triangles[2] = {{0, 1, 2}, {0, 3, 4}};
+    Mesh* mesh = mesh_generate(corner, 5, corner_triangles, 2);
+    mesh_compute_normals(mesh, NULL);
+
+    Vector4 up = {0, 1, 0, 0};
+    run_test("1. Normal of a lone triangle is its face normal", mesh->normals[2], up, &results[0]);
+
+    // Face normal lengths are 2 * area: 16 for the +y face, 1 for the +x face
+    Vector3 weighted = normalize(((Vector3){1, 16, 0}));
+    Vector4 expected_shared = {weighted.x, weighted.y, weighted.z, 0};
+    run_test("2. Shared vertex normal is area weighted", mesh->normals[0], expected_shared, &results[1]);
+
+    Mesh* terrain = create_terrain();
+    Mesh* threaded = mesh_copy(terrain);
+    JobSystem* jobs = jobs_create(3);
+    mesh_compute_normals(terrain, NULL);
+    mesh_compute_normals(threaded, jobs);
+
+    int same = 1;
+    for (int i = 0; i < terrain->vertex_count; i++)
+        for (int c = 0; c < 4; c++)
+            same &= terrain->normals[i].v[c] == threaded->normals[i].v[c];
+    run_test("3. Threaded normals match serial", same, 1, &results[2]);
+
+    // ------------------------------ Lights ------------------------------
+    Lighting lighting = { .ambient = {0.1f, 0.1f, 0.1f} };
+    lighting_add(&lighting, (Light){ .type = LIGHT_DIRECTIONAL, .direction = {0, -1, 0}, .color = {1, 1, 1} });
+
+    Vector3 origin = NULL_VECTOR3, n_up = {0, 1, 0}, n_down = {0, -1, 0};
+    Vector3 full = {1, 1, 1}, ambient = {0.1f, 0.1f, 0.1f};
+    run_test("4. Directional light on a facing surface saturates", lighting_evaluate(&lighting, origin, n_up), full, &results[3]);
+
+    Lighting point = { .ambient = {0.1f, 0.1f, 0.1f} };
+    lighting_add(&point, (Light){ .type = LIGHT_POINT, .position = {0, 2, 0}, .color = {1, 0.5f, 0}, .range = 4 });
+    Vector3 half = {0.6f, 0.35f, 0.1f};
+    run_test("5. Point light fades linearly with distance", lighting_evaluate(&point, origin, n_up), half, &results[4]);
+    run_test("6. Back-facing surface only gets ambient", lighting_evaluate(&point, origin, n_down), ambient, &results[5]);
+
+    // ------------------------------ Lit transform pass ------------------------------
+    lighting_add(&lighting, (Light){ .type = LIGHT_POINT, .position = {3, 2, 3}, .color = {1, 0.2f, 0.2f}, .range = 6 });
+
+    Camera cam = {.pos = {3, 4, 10}, .target = {3, 0, 3}, .up = {0, 1, 0}};
+    Projection proj = {.fov = M_PI / 3, .aspect_ratio = 1.0f, .near = 0.1f, .far = 100.0f};
+    Transform t = NO_TRANSFORM;
+    t.rotation = (Vector3){0.2f, 0.5f, 0.0f};
+    t.scale = (Vector3){1.0f, 2.0f, 0.5f};
+    uint32_t base = 0xFFC08040u;
+
+    Mesh* plain = mesh_copy(terrain);
+    Mesh* lit = mesh_copy(terrain);
+    uint32_t* colors = malloc(sizeof(uint32_t) * terrain->vertex_count);
+    update_mesh(terrain, plain, t, cam, proj);
+    update_mesh_lit(terrain, lit, colors, base, t, cam, proj, &lighting);
+    run_test("7. Lit pass outputs the same clip positions", lit, plain, &results[6]);
+
+    // Scalar reference: world position and inverse-transpose normal
+    Matrix model = model_matrix(t), normal;
+    matrix_inverse(&normal, &model);
+    matrix_transpose(&normal, &normal);
+    int worst = 0;
+    for (int i = 0; i < terrain->vertex_count; i++) {
+        Vector4 wp = matrix_transform(&model, terrain->vertices[i]);
+        Vector4 wn = matrix_transform(&normal, terrain->normals[i]);
+        Vector3 pos = {wp.x, wp.y, wp.z};
+        Vector3 nrm = normalize(((Vector3){wn.x, wn.y, wn.z}));
+        uint32_t ref = lighting_shade_argb(base, lighting_evaluate(&lighting, pos, nrm));
+        int err = channel_error(colors[i], ref);
+        if (err > worst) worst = err;
+    }
+    run_test("8. Lit colors match the scalar reference", worst <= 1, 1, &results[7]);
+
+    // ------------------------------ Filled raster ------------------------------
+    Framebuffer* fb = framebuffer_create(FB_SIZE, FB_SIZE);
+    framebuffer_clear(fb, BACKGROUND);
+    framebuffer_clear_depth(fb);
+
+    float x[3] = {0, 64, 0}, y[3] = {0, 0, 64};
+    float near[3] = {0.2f, 0.2f, 0.2f}, far[3] = {0.8f, 0.8f, 0.8f};
+    uint32_t red[3] = {0xFFFF0000u, 0xFFFF0000u, 0xFFFF0000u};
+    uint32_t blue[3] = {0xFF0000FFu, 0xFF0000FFu, 0xFF0000FFu};
+    framebuffer_fill_triangle(fb, x, y, near, red);
+    framebuffer_fill_triangle(fb, x, y, far, blue);
+    framebuffer_resolve(fb);
+    int covered = fb->pixels[10 * fb->pitch + 10] == 0xFFFF0000u && fb->pixels[60 * fb->pitch + 60] == BACKGROUND;
+    run_test("9. Depth test keeps the nearest triangle", covered, 1, &results[8]);
+
+    // Red at (0, 0), green at (64, 0), blue at (0, 64): the middle of the hypotenuse is half green, half blue
+    uint32_t rgb[3] = {0xFFFF0000u, 0xFF00FF00u, 0xFF0000FFu};
+    framebuffer_clear_depth(fb);
+    framebuffer_fill_triangle(fb, x, y, near, rgb);
+    framebuffer_resolve(fb);
+    uint32_t mid = fb->pixels[31 * fb->pitch + 31];
+    run_test("10. Gouraud interpolates vertex colors", channel_error(mid, 0xFF007F7Fu) <= 6, 1, &results[9]);
+
+    // ------------------------------ Compact positions ------------------------------
+    Mesh* compact = mesh_copy(terrain);
+    Mesh* compact_lit = mesh_create_clipped(terrain);
+    uint32_t* compact_colors = malloc(sizeof(uint32_t) * terrain->vertex_count);
+    mesh_compact(compact);
+    update_mesh_lit(compact, compact_lit, compact_colors, base, t, cam, proj, &lighting);
+    int identical = !memcmp(compact_lit->vertices, lit->vertices, sizeof(Vector4) * terrain->vertex_count) &&
+                    !memcmp(compact_colors, colors, sizeof(uint32_t) * terrain->vertex_count);
+    run_test("11. Lit pass on Vector3 positions matches the Vector4 one", identical, 1, &results[10]);
+
+    print_summary(results, TOTAL_TESTS);
+
+    // ------------------------------ Garbage collect ------------------------------
+    framebuffer_destroy(fb);
+    free(colors);
+    free(compact_colors);
+    mesh_destroy(compact);
+    mesh_destroy(compact_lit);
+    jobs_destroy(jobs);
+    mesh_destroy(plain);
+    mesh_destroy(lit);
+    mesh_destroy(threaded);
+    mesh_destroy(terrain);
+    mesh_destroy(mesh);
+}
@@ -0,0 +1,97 @@
+#include <math.h>
+#include <string.h>
+
+#include "test_framework.h"
+#include "core/transform.h"
+
+#define TOTAL_TESTS 11
+
+static Matrix identity(void) {
+    return (Matrix){{
+        {1, 0, 0, 0},
+        {0, 1, 0, 0},
+        {0, 0, 1, 0},
+        {0, 0, 0, 1}
+    }};
+}
+
+int main(void) {
+    Matrix trs = multiply(translation_matrix(1, 2, 3),
+                 multiply(rotation_matrix(0.7f, Y), scaling_matrix(2, 3, 4)));
+    Matrix general = (Matrix){{
+        {2, 1, 0, 3},
+        {0, 4, 1, 1},
+        {1, 0, 5, 2},
+        {3, 2, 1, 6}
+    }};
+    Matrix singular = (Matrix){{
+        {1, 2, 3, 4},
+        {2, 4, 6, 8},
+        {0, 1, 0, 1},
+        {1, 0, 1, 0}
+    }};
+    Vector4 v = {1, -2, 3, 1};
+
+    TestResult results[TOTAL_TESTS];
+    Matrix got, expected;
+
+    // ------------------------------ SIMD vs scalar reference ------------------------------
+    matrix_multiply_simd(&got, &trs, &general);
+    matrix_multiply_scalar(&expected, &trs, &general);
+    run_test("1. SIMD multiply matches scalar", got, expected, &results[0]);
+
+    run_test("2. SIMD transform matches scalar",
+        matrix_transform_simd(&general, v),
+        matrix_transform_scalar(&general, v),
+        &results[1]);
+
+    Vector4 batch[3] = {{1, 0, 0, 1}, {0, 1, 0, 1}, {1, 2, 3, 1}};
+    matrix_transform_array_simd(&trs, batch, batch, 3);
+    run_test("3. SIMD batch transform matches scalar (in place)",
+        batch[2],
+        matrix_transform_scalar(&trs, (Vector4){1, 2, 3, 1}),
+        &results[2]);
+
+    matrix_transpose_simd(&got, &general);
+    matrix_transpose_scalar(&expected, &general);
+    run_test("4. SIMD transpose matches scalar", got, expected, &results[3]);
+
+    // ------------------------------ Transpose ------------------------------
+    matrix_transpose(&got, &general);
+    run_test("5. Transpose swaps rows and columns", got.m[0][3], general.m[3][0], &results[4]);
+
+    // ------------------------------ Inverse ------------------------------
+    Matrix inv;
+    matrix_inverse_scalar(&inv, &general);
+    run_test("6. Scalar inverse: M * M^-1 = I", multiply(general, inv), identity(), &results[5]);
+
+    matrix_inverse_simd(&inv, &general);
+    run_test("7. SIMD inverse: M * M^-1 = I", multiply(general, inv), identity(), &results[6]);
+
+    got = trs;
+    matrix_inverse(&got, &got);
+    run_test("8. Inverse of TRS (aliased output)", multiply(got, trs), identity(), &results[7]);
+
+    Matrix untouched = identity();
+    int ok_scalar = matrix_inverse_scalar(&untouched, &singular);
+    int ok_simd = matrix_inverse_simd(&untouched, &singular);
+    run_test("9. Singular matrix is rejected", ok_scalar || ok_simd, 0, &results[8]);
+    run_test("10. Output untouched on failure", untouched, identity(), &results[9]);
+
+    // ------------------------------ Vector3 points ------------------------------
+    Vector3 points[5] = {{1, 0, 0}, {0, 1, 0}, {1, 2, 3}, {-4, 0.5f, 2}, {7, -1, 0.25f}};
+    Vector4 simd_out[5], scalar_out[5], full_out[5];
+    Vector4 full[5];
+    for (int i = 0; i < 5; i++)
+        full[i] = (Vector4){points[i].x, points[i].y, points[i].z, 1};
+    matrix_transform_points_simd(&general, points, simd_out, 5);
+    matrix_transform_points_scalar(&general, points, scalar_out, 5);
+    matrix_transform_array(&general, full, full_out, 5);
+    int same = 1;
+    for (int i = 0; i < 5; i++)
+        same &= !memcmp(&simd_out[i], &scalar_out[i], sizeof(Vector4)) &&
+                !memcmp(&simd_out[i], &full_out[i], sizeof(Vector4));
+    run_test("11. Point transform (w = 1 implied) matches the Vector4 one exactly", same, 1, &results[10]);
+
+    print_summary(results, TOTAL_TESTS);
+}
@@ -0,0 +1,185 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <SDL.h>
+
+#include "test_framework.h"
+#include "test_fixtures.h"
+#include "core/memory.h"
+#include "core/scene.h"
+#include "core/texture.h"
+
+#define TOTAL_TESTS 8
+
+#define SCREEN_W 160
+#define SCREEN_H 120
+#define FRAMES 3
+#define CUBES 16
+
+static int frame_allocations(void) {
+    return memory_sum(memory_stats().frame).allocations;
+}
+
+// Another thread allocating while the main thread is in a frame
+static int allocate_elsewhere(void* data) {
+    (void)data;
+    memory_free(MEMORY_THREADS, memory_alloc(MEMORY_THREADS, 64));
+    return 0;
+}
+
+int main(void) {
+    TestResult results[TOTAL_TESTS];
+
+    // ------------------------------ Counters ------------------------------
+    MemoryStats before = memory_stats();
+    void* a = memory_alloc(MEMORY_TEXTURE, 100);
+    void* b = memory_calloc(MEMORY_TEXTURE, 4, 8);
+    b = memory_realloc(MEMORY_TEXTURE, b, 64);
+    void* c = memory_aligned_alloc(MEMORY_TEXTURE, 64, 65);
+    memory_free(MEMORY_TEXTURE, a);
+    memory_free(MEMORY_TEXTURE, b);
+    memory_free(MEMORY_TEXTURE, c);
+    memory_free(MEMORY_TEXTURE, NULL);
+    MemoryStats after = memory_stats();
+    MemoryCounters tex = after.total[MEMORY_TEXTURE], old = before.total[MEMORY_TEXTURE];
+    int counted = tex.bytes - old.bytes == 100 + 32 + 64 + 128 && tex.allocations - old.allocations == 4 &&
+                  tex.frees - old.frees == 3 && after.total[MEMORY_MESH].allocations == before.total[MEMORY_MESH].allocations;
+    run_test("1. Bytes and calls are counted per subsystem", counted, 1, &results[0]);
+
+    memory_frame_begin();
+    memory_free(MEMORY_ENGINE, memory_alloc(MEMORY_ENGINE, 10));
+    SDL_Thread* thread = SDL_CreateThread(allocate_elsewhere, "elsewhere", NULL);
+    SDL_WaitThread(thread, NULL);
+    memory_frame_end();
+    memory_free(MEMORY_ENGINE, memory_alloc(MEMORY_ENGINE, 10));
+    MemoryStats frame = memory_stats();
+    int framed = frame.frame[MEMORY_ENGINE].allocations == 1 && frame.frame[MEMORY_ENGINE].bytes == 10 &&
+                 frame.frame[MEMORY_THREADS].allocations == 0 && frame_allocations() == 1;
+    memory_frame_begin();
+    memory_frame_end();
+    framed &= frame_allocations() == 0;
+    run_test("2. Frame counters only see the frame thread, between begin and end", framed, 1, &results[1]);
+
+    // ------------------------------ Clipped meshes ------------------------------
+    Mesh* cube = create_cube_mesh();
+    MemoryCounters mesh_before = memory_stats().total[MEMORY_MESH];
+    Mesh* clipped = mesh_create_clipped(cube);
+    MemoryCounters mesh_after = memory_stats().total[MEMORY_MESH];
+    int borrowed = clipped->triangles == cube->triangles && clipped->vertices != cube->vertices &&
+                   mesh_after.allocations - mesh_before.allocations == 2 &&
+                   mesh_after.bytes - mesh_before.bytes == sizeof(Mesh) + 8 * sizeof(Vector4);
+    mesh_destroy(clipped);
+    run_test("3. Clipped meshes borrow the source indices", borrowed, 1, &results[2]);
+
+    // ------------------------------ Zero-allocation frames ------------------------------
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, SCREEN_W, SCREEN_H, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer* sdl = SDL_CreateSoftwareRenderer(surface);
+    Framebuffer* fb = framebuffer_create(SCREEN_W, SCREEN_H);
+    Camera cam = {{0, 0, 6}, {0, 0, 0}, {0, 1, 0}};
+    Projection proj = {M_PI / 3, (float)SCREEN_W / SCREEN_H, 0.1f, 100.0f};
+    Transform t = NO_TRANSFORM;
+
+    TexCoord uvs[8] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}, {0, 0}, {1, 0}, {1, 1}, {0, 1}};
+    mesh_set_uvs(cube, uvs);
+    mesh_compute_normals(cube, NULL);
+    clipped = mesh_create_clipped(cube);
+    uint32_t* colors = malloc(sizeof(uint32_t) * cube->vertex_count);
+    Lighting lighting = {.ambient = {0.2f, 0.2f, 0.2f}};
+    lighting_add(&lighting, (Light){.type = LIGHT_DIRECTIONAL, .direction = {0, 0, -1}, .color = {1, 1, 1}});
+    Draw draw = {.clipped_mesh = clipped, .color = {255, 0, 0, 255}, .backend = RENDER_SDL, .vertex_colors = colors};
+
+    memory_frame_begin();
+    for (int f = 0; f < FRAMES; f++) {
+        t.rotation.y += 0.3f;
+        update_mesh(cube, clipped, t, cam, proj);
+        draw.shading = SHADE_WIREFRAME;
+        draw_mesh(sdl, &draw, SCREEN_W, SCREEN_H);
+        draw_mesh_software(fb, &draw);
+    }
+    memory_frame_end();
+    run_test("4. update_mesh and wireframe draws do not allocate", frame_allocations(), 0, &results[3]);
+
+    uint32_t texels[16] = {0};
+    Texture* texture = texture_create(texels, 4, 4, TEXTURE_TILED);
+    draw.texture = texture;
+
+    memory_frame_begin();
+    for (int f = 0; f < FRAMES; f++) {
+        t.rotation.x += 0.3f;
+        update_mesh_lit(cube, clipped, colors, 0xFFFF0000u, t, cam, proj, &lighting);
+        framebuffer_clear_depth(fb);
+        for (ShadeMode mode = SHADE_FLAT; mode <= SHADE_TEXTURED; mode++) {
+            draw.shading = mode;
+            draw_mesh(sdl, &draw, SCREEN_W, SCREEN_H);
+            draw_mesh_software(fb, &draw);
+        }
+    }
+    memory_frame_end();
+    run_test("5. update_mesh_lit and filled draws do not allocate", frame_allocations(), 0, &results[4]);
+
+    Mesh* compact = mesh_copy(cube);
+    mesh_compact(compact);
+    Mesh* compact_clipped = mesh_create_clipped(compact);
+    draw.clipped_mesh = compact_clipped;
+    draw.shading = SHADE_WIREFRAME;
+    memory_frame_begin();
+    for (int f = 0; f < FRAMES; f++) {
+        update_mesh(compact, compact_clipped, t, cam, proj);
+        draw_mesh(sdl, &draw, SCREEN_W, SCREEN_H);
+        draw_mesh_software(fb, &draw);
+    }
+    memory_frame_end();
+    run_test("6. Compact meshes do not allocate either", frame_allocations(), 0, &results[5]);
+
+    // ------------------------------ Scene frames ------------------------------
+    Scene* scene = scene_create(4);
+    for (int i = 0; i < CUBES; i++) {
+        Transform at = NO_TRANSFORM;
+        at.translation = (Vector3){(float)(i % 4) * 3 - 4.5f, 0, -(float)(i / 4) * 3};
+        scene_add(scene, cube, (Color){(size_t)(i * 16), 128, 255, 255}, at, i == 0 ? OBJECT_OCCLUDER : 0);
+    }
+    scene_set_culler(scene, occlusion_create(64, 48, 4));
+    RenderQueue* queue = render_queue_create(1);
+
+    // Buffers are sized before the frames: any frame allocation aborts
+    memory_set_strict(1);
+    int allocations = 0;
+    for (int f = 0; f < FRAMES; f++) {
+        render_queue_reserve(queue, scene->count);
+        memory_frame_begin();
+        scene_update(scene, cam, proj, NULL);
+        render_queue_reset(queue);
+        for (int i = 0; i < scene->count; i++)
+            if (scene->objects[i].visible) render_queue_push(queue, &scene->objects[i].draw, 0, 0.5f);
+        render_queue_sort(queue);
+        render_queue_execute(queue, RENDER_SOFTWARE, sdl, fb, SCREEN_W, SCREEN_H);
+        render_queue_execute(queue, RENDER_SDL, sdl, fb, SCREEN_W, SCREEN_H);
+        memory_frame_end();
+        allocations += frame_allocations();
+    }
+    memory_set_strict(0);
+    run_test("7. Scene frames do not allocate from the first one", allocations, 0, &results[6]);
+
+    // Allocations before the frame begins (scene growth) are not frame allocations
+    scene_add(scene, cube, (Color){255, 255, 255, 255}, t, 0);
+    render_queue_reserve(queue, scene->count);
+    memory_frame_begin();
+    scene_update(scene, cam, proj, NULL);
+    memory_frame_end();
+    run_test("8. Growth before the frame begins is not counted in it", frame_allocations(), 0, &results[7]);
+
+    print_summary(results, TOTAL_TESTS);
+
+    // ------------------------------ Garbage collect ------------------------------
+    render_queue_destroy(queue);
+    occlusion_destroy(scene->culler);
+    scene_destroy(scene);
+    mesh_destroy(compact_clipped);
+    mesh_destroy(compact);
+    texture_destroy(texture);
+    mesh_destroy(clipped);
+    free(colors);
+    framebuffer_destroy(fb);
+    SDL_DestroyRenderer(sdl);
+    SDL_FreeSurface(surface);
+    mesh_destroy(cube);
+}
@@ -0,0 +1,187 @@
+#include <string.h>
+#include <math.h>
+
+#include "test_framework.h"
+#include "core/mesh.h"
+
+#define TOTAL_TESTS 13
+
+#define EPSILON 1e-4f
+#define GRID 96
+
+// Quad as a triangle soup: every triangle has its own 3 vertices
+static Mesh* create_soup_quad(float offset) {
+    Vector4 vertices[6] = {
+        {0, 0, 0, 1}, {1, 0, 0, 1}, {1, 1, 0, 1},
+        {0 + offset, 0, 0, 1}, {1, 1 + offset, 0, 1}, {0, 1, 0, 1}
+    };
+    Triangle triangles[2] = {{{0, 1, 2}}, {{3, 4, 5}}};
+    return mesh_generate(vertices, 6, triangles, 2);
+}
+
+// GRID x GRID height field, one set of vertices per triangle
+static Mesh* create_soup_terrain(void) {
+    int t = 0, count = GRID * GRID * 2;
+    Vector4* vertices = malloc(sizeof(Vector4) * count * 3);
+    Triangle* triangles = malloc(sizeof(Triangle) * count);
+
+    for (int i = 0; i < GRID; i++)
+        for (int j = 0; j < GRID; j++) {
+            Vector4 q[4];
+            for (int k = 0; k < 4; k++) {
+                int x = i + (k & 1), z = j + (k >> 1);
+                q[k] = (Vector4){x * 0.1f, sinf(x * 0.3f) * cosf(z * 0.2f), z * 0.1f, 1.0f};
+            }
+            int corners[2][3] = {{0, 1, 2}, {1, 3, 2}};
+            for (int h = 0; h < 2; h++, t++)
+                for (int k = 0; k < 3; k++) {
+                    vertices[t * 3 + k] = q[corners[h][k]];
+                    triangles[t].vert[k] = t * 3 + k;
+                }
+        }
+
+    Mesh* mesh = mesh_generate(vertices, count * 3, triangles, count);
+    free(vertices);
+    free(triangles);
+    return mesh;
+}
+
+// Every welded triangle still has its original corner positions
+static int same_geometry(const Mesh* before, const Mesh* after) {
+    if (before->triangle_count != after->triangle_count) return 0;
+    for (int t = 0; t < before->triangle_count; t++) {
+        // Welded triangles are rotated so their smallest index comes first
+        const int* a = before->triangles[t].vert;
+        const int* b = after->triangles[t].vert;
+        int match = 0;
+        for (int r = 0; r < 3 && !match; r++) {
+            match = 1;
+            for (int k = 0; k < 3; k++) {
+                Vector4 p = before->vertices[a[(k + r) % 3]], q = after->vertices[b[k]];
+                match &= fabsf(p.x - q.x) <= EPSILON && fabsf(p.y - q.y) <= EPSILON && fabsf(p.z - q.z) <= EPSILON;
+            }
+        }
+        if (!match) return 0;
+    }
+    return 1;
+}
+
+int main(void) {
+    TestResult results[TOTAL_TESTS];
+    MeshWeldStats stats;
+
+    // ------------------------------ Welding ------------------------------
+    Mesh* quad = create_soup_quad(0.0f);
+    Mesh* original = mesh_copy(quad);
+    int ok = mesh_weld(quad, EPSILON, NULL, &stats);
+    run_test("1. Shared corners are welded", ok && quad->vertex_count == 4 && quad->triangle_count == 2, 1, &results[0]);
+    run_test("2. Triangles keep their positions", same_geometry(original, quad), 1, &results[1]);
+
+    Mesh* near = create_soup_quad(EPSILON * 0.5f);
+    Mesh* far = create_soup_quad(EPSILON * 4.0f);
+    mesh_weld(near, EPSILON, NULL, NULL);
+    mesh_weld(far, EPSILON, NULL, NULL);
+    run_test("3. Only vertices within epsilon are welded", near->vertex_count == 4 && far->vertex_count == 6, 1, &results[2]);
+
+    // Vertex 3 duplicates vertex 1, vertex 4 lies on the 0-2 diagonal
+    Vector4 vertices[5] = {{0, 0, 0, 1}, {1, 0, 0, 1}, {1, 1, 0, 1}, {1, 0, 0, 1}, {0.5f, 0.5f, 0, 1}};
+    Triangle triangles[6] = {
+        {{0, 1, 2}},    // kept
+        {{0, 3, 2}},    // same as the first once 3 is welded to 1
+        {{2, 0, 1}},    // same triangle, rotated
+        {{0, 2, 1}},    // back face: kept
+        {{1, 3, 2}},    // collapses to an edge
+        {{0, 4, 2}}     // zero area (4 is on the diagonal)
+    };
+    Mesh* dirty = mesh_generate(vertices, 5, triangles, 6);
+    mesh_weld(dirty, EPSILON, NULL, &stats);
+    run_test("4. Degenerate triangles are removed", stats.degenerate, 2, &results[3]);
+    run_test("5. Duplicates are removed, back faces kept", stats.duplicates == 2 && dirty->triangle_count == 2, 1, &results[4]);
+
+    int reported = stats.vertices_before == 5 && stats.vertices_after == 4 &&
+                   stats.triangles_before == 6 && stats.triangles_after == 2;
+    run_test("6. Stats report the reduction", reported, 1, &results[5]);
+
+    // Same corner, two different UVs: a texture seam must survive
+    Mesh* seam = create_soup_quad(0.0f);
+    TexCoord uvs[6] = {{0, 0}, {1, 0}, {1, 1}, {0.5f, 0}, {1, 1}, {0, 1}};
+    mesh_set_uvs(seam, uvs);
+    mesh_weld(seam, EPSILON, NULL, NULL);
+    run_test("7. Vertices with different UVs are kept apart", seam->vertex_count, 5, &results[6]);
+
+    // ------------------------------ Large inputs ------------------------------
+    JobSystem* jobs = jobs_create(3);
+    Mesh* serial = create_soup_terrain();
+    Mesh* threaded = mesh_copy(serial);
+    Mesh* reference = mesh_copy(serial);
+    mesh_compute_normals(threaded, NULL);
+    mesh_weld(serial, EPSILON, NULL, &stats);
+    mesh_weld(threaded, EPSILON, jobs, NULL);
+
+    int grid = stats.vertices_after == (GRID + 1) * (GRID + 1) && stats.triangles_after == GRID * GRID * 2 &&
+               same_geometry(reference, serial);
+    run_test("8. Triangle soup welds to the indexed grid", grid, 1, &results[7]);
+
+    int identical = serial->vertex_count == threaded->vertex_count && serial->triangle_count == threaded->triangle_count &&
+                    !memcmp(serial->vertices, threaded->vertices, sizeof(Vector4) * serial->vertex_count) &&
+                    !memcmp(serial->triangles, threaded->triangles, sizeof(Triangle) * serial->triangle_count);
+    run_test("9. Threaded weld matches the serial one", identical, 1, &results[8]);
+
+    // Smooth normals across the welded seams
+    int normals = threaded->normals != NULL;
+    for (int i = 0; normals && i < threaded->vertex_count; i++) {
+        Vector3 n = {threaded->normals[i].x, threaded->normals[i].y, threaded->normals[i].z};
+        normals &= fabsf(norm(n) - 1.0f) < 1e-4f;
+    }
+    run_test("10. Normals are recomputed on the welded mesh", normals, 1, &results[9]);
+
+    // ------------------------------ Compact formats ------------------------------
+    Mesh* compact = mesh_copy(serial);
+    size_t full_bytes = mesh_geometry_bytes(compact);
+    int compacted = mesh_compact(compact) && !compact->vertices && compact->positions &&
+                    !compact->triangles && compact->triangles16 &&
+                    mesh_geometry_bytes(compact) == sizeof(Vector3) * compact->vertex_count +
+                                                    sizeof(Triangle16) * compact->triangle_count &&
+                    mesh_geometry_bytes(compact) < full_bytes * 2 / 3;
+    int kept = compacted;
+    for (int i = 0; i < serial->vertex_count && kept; i++) {
+        Vector3 p = mesh_position(compact, i);
+        kept = p.x == serial->vertices[i].x && p.y == serial->vertices[i].y && p.z == serial->vertices[i].z;
+    }
+    for (int t = 0; t < serial->triangle_count && kept; t++)
+        kept = !memcmp(mesh_triangle(compact, t).vert, serial->triangles[t].vert, sizeof(Triangle));
+    run_test("11. Compacting keeps positions and triangles in fewer bytes", kept, 1, &results[10]);
+
+    Vector4* points = calloc(MESH_INDEX16_MAX_VERTICES + 1, sizeof(Vector4));
+    Triangle far_corner = {{0, 1, MESH_INDEX16_MAX_VERTICES}};
+    Mesh* large = mesh_generate(points, MESH_INDEX16_MAX_VERTICES + 1, &far_corner, 1);
+    free(points);
+    int wide = mesh_compact(large) && large->positions && large->triangles && !large->triangles16 &&
+               large->triangles[0].vert[2] == MESH_INDEX16_MAX_VERTICES;
+    run_test("12. More than 65536 vertices keep 32-bit indices", wide, 1, &results[11]);
+
+    Mesh* compact_normals = mesh_copy(compact);
+    mesh_compute_normals(compact_normals, jobs);
+    int same_normals = compact_normals->normals != NULL;
+    for (int i = 0; i < threaded->vertex_count && same_normals; i++)
+        same_normals = !memcmp(&compact_normals->normals[i], &threaded->normals[i], sizeof(Vector4));
+    run_test("13. Normals of a compact mesh match the full one", same_normals && !mesh_weld(compact, 0.0f, NULL, NULL),
+             1, &results[12]);
+
+    print_summary(results, TOTAL_TESTS);
+
+    // ------------------------------ Garbage collect ------------------------------
+    jobs_destroy(jobs);
+    mesh_destroy(quad);
+    mesh_destroy(original);
+    mesh_destroy(near);
+    mesh_destroy(far);
+    mesh_destroy(dirty);
+    mesh_destroy(seam);
+    mesh_destroy(serial);
+    mesh_destroy(threaded);
+    mesh_destroy(reference);
+    mesh_destroy(compact);
+    mesh_destroy(compact_normals);
+    mesh_destroy(large);
+}
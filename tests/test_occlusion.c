@@ -0,0 +1,82 @@
+#include <math.h>
+
+#include "test_framework.h"
+#include "test_fixtures.h"
+#include "core/scene.h"
+
+#define TOTAL_TESTS 8
+
+#define WHITE (Color){255, 255, 255, 255}
+
+static Transform placed(float x, float y, float z, Vector3 scale) {
+    Transform t = NO_TRANSFORM;
+    t.translation = (Vector3){x, y, z};
+    t.scale = scale;
+    return t;
+}
+
+int main(void) {
+    TestResult results[TOTAL_TESTS];
+
+    Camera cam = {
+        .pos    = {0.0f, 0.0f, 10.0f},
+        .target = {0.0f, 0.0f, 0.0f},
+        .up     = {0.0f, 1.0f, 0.0f}
+    };
+    Projection proj = {
+        .fov          = M_PI / 3,
+        .aspect_ratio = 1.0f,
+        .near         = 0.1f,
+        .far          = 100.0f
+    };
+
+    Mesh* cube = create_cube_mesh();
+    Vector3 unit = {1.0f, 1.0f, 1.0f};
+
+    // Wall at z = 2, everything behind its middle is hidden from the camera
+    Scene* scene = scene_create(4);
+    int wall = scene_add(scene, cube, WHITE, placed(0, 0, 2, (Vector3){2.0f, 2.0f, 0.2f}), OBJECT_OCCLUDER);
+    int hidden = scene_add(scene, cube, WHITE, placed(0, 0, -5, unit), 0);
+    int front = scene_add(scene, cube, WHITE, placed(0, 0, 5, unit), 0);
+    int partial = scene_add(scene, cube, WHITE, placed(2.5f, 0, 0, unit), 0);
+    int outside = scene_add(scene, cube, WHITE, placed(50, 0, 0, unit), 0);
+
+    scene_set_culler(scene, occlusion_create(128, 128, 4));
+
+    // ------------------------------ Flagged occluder ------------------------------
+    scene_update(scene, cam, proj, NULL);
+
+    run_test("1. Object behind occluder is culled", scene->objects[hidden].visible, 0, &results[0]);
+    run_test("2. Object in front of occluder is visible", scene->objects[front].visible, 1, &results[1]);
+    run_test("3. Partly covered object is visible", scene->objects[partial].visible, 1, &results[2]);
+    run_test("4. Off-screen object is culled", scene->objects[outside].visible, 0, &results[3]);
+
+    OcclusionStats stats = scene->culler->stats;
+    run_test("5. Stats count occluded and frustum culled",
+        stats.occluded == 1 && stats.frustum_culled == 1 && stats.occluders == 1, 1, &results[4]);
+    run_test("6. Skipped vertices of culled objects", (int)stats.vertices_skipped, 16, &results[5]);
+
+    // ------------------------------ Automatic occluder ------------------------------
+    scene->objects[wall].flags = 0;
+    scene->culler->max_occluders = 1;
+    scene_update(scene, cam, proj, NULL);
+
+    run_test("7. Largest object is picked as occluder",
+        scene->objects[wall].occluding && !scene->objects[hidden].visible, 1, &results[6]);
+
+    // ------------------------------ No culler ------------------------------
+    occlusion_destroy(scene->culler);
+    scene_set_culler(scene, NULL);
+    scene_update(scene, cam, proj, NULL);
+
+    int all_visible = 1;
+    for (int i = 0; i < scene->count; i++)
+        all_visible &= scene->objects[i].visible;
+    run_test("8. Without culler every object is visible", all_visible, 1, &results[7]);
+
+    print_summary(results, TOTAL_TESTS);
+
+    // ------------------------------ Garbage collect ------------------------------
+    scene_destroy(scene);
+    mesh_destroy(cube);
+}
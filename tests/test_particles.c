@@ -0,0 +1,176 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test_framework.h"
+#include "core/particles.h"
+#include "core/memory.h"
+
+#define TOTAL_TESTS 10
+
+#define RANDOM_PARTICLES (3 * PARTICLE_CHUNK + 123)
+#define FRAMES 8
+#define DT (1.0f / 60.0f)
+
+#define SCREEN_W 160
+#define SCREEN_H 120
+#define BACKGROUND 0xFF000000u
+
+static const Vector3 GRAVITY = {0.0f, -9.81f, 0.0f};
+
+static float random_float(float lo, float hi) {
+    return lo + (hi - lo) * (float)rand() / RAND_MAX;
+}
+
+static void spawn_random(ParticleSystem* ps, int count) {
+    for (int i = 0; i < count; i++) {
+        Vector3 p = {random_float(-10, 10), random_float(-10, 10), random_float(-10, 10)};
+        Vector3 v = {random_float(-5, 5), random_float(0, 10), random_float(-5, 5)};
+        // Some die on every frame, in every chunk
+        particles_spawn(ps, p, v, random_float(0.001f, 0.2f), (uint32_t)i);
+    }
+}
+
+// Same particles in the same order, positions within tolerance
+static int same_particles(const ParticleSystem* a, const ParticleSystem* b, float tolerance) {
+    if (a->count != b->count) return 0;
+    const ParticleStreams* p = &a->live;
+    const ParticleStreams* q = &b->live;
+    for (int i = 0; i < a->count; i++) {
+        if (p->color[i] != q->color[i] || p->life[i] != q->life[i]) return 0;
+        float err = fmaxf(fabsf(p->x[i] - q->x[i]), fmaxf(fabsf(p->y[i] - q->y[i]), fabsf(p->z[i] - q->z[i])));
+        err = fmaxf(err, fmaxf(fabsf(p->vx[i] - q->vx[i]), fmaxf(fabsf(p->vy[i] - q->vy[i]), fabsf(p->vz[i] - q->vz[i]))));
+        if (err > tolerance) return 0;
+    }
+    return 1;
+}
+
+static uint32_t pixel(Framebuffer* fb, int x, int y) {
+    return fb->pixels[(size_t)y * fb->pitch + x];
+}
+
+static void clear(Framebuffer* fb) {
+    framebuffer_set_viewport(fb, (Viewport){0, 0, SCREEN_W, SCREEN_H});
+    framebuffer_clear(fb, BACKGROUND);
+    framebuffer_clear_depth(fb);
+    fb->pixels_drawn = 0;
+}
+
+int main(void) {
+    TestResult results[TOTAL_TESTS];
+    srand(47);
+
+    // ------------------------------ Pool ------------------------------
+    ParticleSystem* small = particles_create(10);
+    int spawned = 0;
+    for (int i = 0; i < 11; i++)
+        spawned += particles_spawn(small, (Vector3){0, 0, 0}, (Vector3){1, 0, 0}, 0.05f + 0.1f * i, (uint32_t)i);
+    run_test("1. Spawning stops when the pool is full", spawned, 10, &results[0]);
+
+    // ------------------------------ Integration ------------------------------
+    particles_update_scalar(small, 0.1f, (Vector3){0, -10, 0});
+    Vector3 moved = {small->live.x[0], small->live.y[0], small->live.z[0]};
+    run_test("2. Semi-implicit Euler step", moved, ((Vector3){0.1f, -0.1f, 0.0f}), &results[1]);
+
+    // Lives 0.05, 0.15, ...: after 0.3 s, the first three are dead
+    particles_update_scalar(small, 0.2f, (Vector3){0, -10, 0});
+    run_test("3. Dead particles removed, survivors in order",
+             small->count == 7 && small->live.color[0] == 3 && small->live.color[6] == 9, 1, &results[2]);
+
+    ParticleSystem* reference = particles_create(RANDOM_PARTICLES);
+    ParticleSystem* serial = particles_create(RANDOM_PARTICLES);
+    ParticleSystem* threaded = particles_create(RANDOM_PARTICLES);
+    JobSystem* jobs = jobs_create(3);
+    for (int i = 0; i < RANDOM_PARTICLES; i++) {
+        Vector3 p = {random_float(-10, 10), random_float(-10, 10), random_float(-10, 10)};
+        Vector3 v = {random_float(-5, 5), random_float(0, 10), random_float(-5, 5)};
+        float life = random_float(0.001f, 0.2f);
+        particles_spawn(reference, p, v, life, (uint32_t)i);
+        particles_spawn(serial, p, v, life, (uint32_t)i);
+        particles_spawn(threaded, p, v, life, (uint32_t)i);
+    }
+
+    int simd_ok = 1, threads_ok = 1;
+    for (int f = 0; f < FRAMES; f++) {
+        particles_update_scalar(reference, DT, GRAVITY);
+        particles_update(serial, DT, GRAVITY, NULL);
+        particles_update(threaded, DT, GRAVITY, jobs);
+        simd_ok &= same_particles(serial, reference, 1e-5f);
+        threads_ok &= same_particles(threaded, serial, 0.0f);
+    }
+    run_test("4. SIMD update matches scalar", simd_ok && serial->count > 0 && serial->count < RANDOM_PARTICLES, 1,
+             &results[3]);
+    run_test("5. Threaded update matches serial", threads_ok, 1, &results[4]);
+
+    spawn_random(threaded, RANDOM_PARTICLES - threaded->count);
+    memory_frame_begin();
+    particles_update(threaded, DT, GRAVITY, jobs);
+    memory_frame_end();
+    run_test("6. Updates do not allocate", memory_sum(memory_stats().frame).allocations, 0, &results[5]);
+
+    // ------------------------------ Draw ------------------------------
+    Framebuffer* fb = framebuffer_create(SCREEN_W, SCREEN_H);
+    Camera cam = {{0, 0, 5}, {0, 0, 0}, {0, 1, 0}};
+    Projection proj = {M_PI / 3, (float)SCREEN_W / SCREEN_H, 0.1f, 100.0f};
+    ParticleSystem* ps = particles_create(8);
+
+    // Camera target: center pixel
+    clear(fb);
+    particles_spawn(ps, (Vector3){0, 0, 0}, (Vector3){0, 0, 0}, 1.0f, 0xFFFF0000u);
+    int drawn = particles_draw(fb, ps, cam, proj, 0.0f);
+    framebuffer_resolve(fb);
+    run_test("7. Point at the camera target lands on the center pixel",
+             drawn == 1 && fb->pixels_drawn == 1 && pixel(fb, SCREEN_W / 2, SCREEN_H / 2) == 0xFFFF0000u, 1,
+             &results[6]);
+
+    // The farther particle comes second, the last one is behind the camera
+    clear(fb);
+    ps->count = 0;
+    particles_spawn(ps, (Vector3){0, 0, 1}, (Vector3){0, 0, 0}, 1.0f, 0xFF00FF00u);
+    particles_spawn(ps, (Vector3){0, 0, -1}, (Vector3){0, 0, 0}, 1.0f, 0xFF0000FFu);
+    particles_spawn(ps, (Vector3){0, 0, 10}, (Vector3){0, 0, 0}, 1.0f, 0xFFFFFFFFu);
+    drawn = particles_draw(fb, ps, cam, proj, 0.0f);
+    framebuffer_resolve(fb);
+    run_test("8. Depth tested, particles behind the camera skipped",
+             drawn == 2 && pixel(fb, SCREEN_W / 2, SCREEN_H / 2) == 0xFF00FF00u, 1, &results[7]);
+
+    // Squares twice as far cover a quarter of the pixels
+    clear(fb);
+    ps->count = 0;
+    particles_spawn(ps, (Vector3){-1, 0, 0}, (Vector3){0, 0, 0}, 1.0f, 0xFFFFFFFFu);
+    particles_draw(fb, ps, cam, proj, 2.0f);
+    size_t near_pixels = fb->pixels_drawn;
+    clear(fb);
+    ps->count = 0;
+    particles_spawn(ps, (Vector3){-2, 0, -5}, (Vector3){0, 0, 0}, 1.0f, 0xFFFFFFFFu);
+    particles_draw(fb, ps, cam, proj, 2.0f);
+    size_t far_pixels = fb->pixels_drawn;
+    run_test("9. Square size follows the distance",
+             near_pixels > 16 && fabsf((float)near_pixels / far_pixels - 4.0f) < 0.6f, 1, &results[8]);
+
+    // View in the left half, a square on its right edge (world -x here): the part past the edge is clipped
+    clear(fb);
+    framebuffer_set_viewport(fb, (Viewport){0, 0, SCREEN_W / 2, SCREEN_H});
+    ps->count = 0;
+    particles_spawn(ps, (Vector3){0, 0, 0}, (Vector3){0, 0, 0}, 1.0f, 0xFFFFFFFFu);
+    particles_spawn(ps, (Vector3){-5 * tanf(M_PI / 6) * proj.aspect_ratio, 0, 0}, (Vector3){0, 0, 0}, 1.0f, 0xFFFFFFFFu);
+    drawn = particles_draw(fb, ps, cam, proj, 1.0f);
+    framebuffer_resolve(fb);
+    int right_clean = 1;
+    for (int y = 0; y < SCREEN_H; y++)
+        for (int x = SCREEN_W / 2; x < SCREEN_W; x++)
+            right_clean &= pixel(fb, x, y) == BACKGROUND;
+    run_test("10. Particles clipped to the viewport",
+             drawn == 2 && right_clean && pixel(fb, SCREEN_W / 2 - 1, SCREEN_H / 2) == 0xFFFFFFFFu, 1, &results[9]);
+
+    print_summary(results, TOTAL_TESTS);
+
+    // ------------------------------ Garbage collect ------------------------------
+    particles_destroy(ps);
+    framebuffer_destroy(fb);
+    jobs_destroy(jobs);
+    particles_destroy(small);
+    particles_destroy(reference);
+    particles_destroy(serial);
+    particles_destroy(threaded);
+}
@@ -1,9 +1,11 @@
 #include <math.h>
+#include <string.h>
 
 #include "test_framework.h"
+#include "test_fixtures.h"
 #include "core/pipeline.h"
 
-#define TOTAL_TESTS 8
+#define TOTAL_TESTS 11
 
 #define FOV (M_PI / 2)
 #define NEAR_PLANE 0.2f
@@ -19,6 +21,14 @@ static inline Mesh* got_value(Mesh* original, Transform transform, Camera cam, P
     return copy;
 }
 
+static int close_vertices(const Vector4* a, const Vector4* b, int count, float tolerance) {
+    for (int i = 0; i < count; i++)
+        for (int k = 0; k < 4; k++)
+            if (fabsf(a[i].v[k] - b[i].v[k]) > tolerance * fmaxf(1.0f, fabsf(b[i].v[k])))
+                return 0;
+    return 1;
+}
+
 int main(void) {
     float theta = M_PI/2;
 
@@ -172,6 +182,54 @@ int main(void) {
         triangle_rt,
         &results[7]);
 
+    // Same clip-space output from Vector3 positions and 16-bit indices
+    Mesh* compact = mesh_copy(triangle_before);
+    mesh_compact(compact);
+    Mesh* compact_got = mesh_create_clipped(compact);
+    update_mesh(compact, compact_got, rotationZ_and_translationX, cam, proj);
+    int same = compact->positions && compact->triangles16 &&
+               !memcmp(compact_got->vertices, triangle_rt_got->vertices, sizeof(Vector4) * 3);
+    run_test("9. Compact mesh transforms like the full one", same, 1, &results[8]);
+
+    // ------------------------------ Multi-view ------------------------------
+    Mesh* grid = create_grid_mesh(59, 6.0f);
+    Transform placed = {{0.5f, -0.2f, -1.0f}, {1.0f, 2.0f, 1.0f}, {0.3f, 0.6f, 0.1f}};
+    View views[3] = {
+        {cam, proj, {0, 0, 100, 100}},
+        {{{4.0f, 3.0f, 6.0f}, CAM_TARGET, CAM_UP}, {FOV, 2.0f, NEAR_PLANE, FAR_PLANE}, {100, 0, 200, 100}},
+        {{{0.0f, 12.0f, 0.1f}, CAM_TARGET, CAM_UP}, {FOV / 2, ASPECT_RATIO, NEAR_PLANE, FAR_PLANE}, {0, 100, 50, 50}},
+    };
+    Vector4* world = malloc(sizeof(Vector4) * grid->vertex_count);
+    Mesh* view_clipped[3];
+    Mesh* expected = mesh_create_clipped(grid);
+    for (int v = 0; v < 3; v++)
+        view_clipped[v] = mesh_create_clipped(grid);
+
+    // Ranges of the parallel loop cross from one view to the next
+    JobSystem* jobs = jobs_create(2);
+    update_mesh_world(grid, world, placed);
+    update_mesh_views(world, grid->vertex_count, views, 3, view_clipped, jobs);
+    int views_match = 1;
+    for (int v = 0; v < 3; v++) {
+        update_mesh(grid, expected, placed, views[v].camera, views[v].projection);
+        views_match &= close_vertices(view_clipped[v]->vertices, expected->vertices, grid->vertex_count, 1e-4f);
+    }
+    run_test("10. Shared world-space vertices project like update_mesh from each camera", views_match, 1, &results[9]);
+
+    Lighting lighting = {.ambient = {0.1f, 0.1f, 0.1f}};
+    lighting_add(&lighting, (Light){.type = LIGHT_DIRECTIONAL, .direction = {0.3f, -0.5f, -1.0f}, .color = {1, 1, 1}});
+    lighting_add(&lighting, (Light){.type = LIGHT_POINT, .position = {1.0f, 2.0f, 1.0f}, .color = {1, 0.5f, 0},
+                                    .range = 6.0f});
+    uint32_t* world_colors = malloc(sizeof(uint32_t) * grid->vertex_count);
+    uint32_t* expected_colors = malloc(sizeof(uint32_t) * grid->vertex_count);
+    update_mesh_world_lit(grid, world, world_colors, 0xFFC08040u, placed, &lighting);
+    update_mesh_lit(grid, expected, expected_colors, 0xFFC08040u, placed, cam, proj, &lighting);
+    Vector4* world_unlit = malloc(sizeof(Vector4) * grid->vertex_count);
+    update_mesh_world(grid, world_unlit, placed);
+    int lit_match = !memcmp(world_colors, expected_colors, sizeof(uint32_t) * grid->vertex_count) &&
+                    close_vertices(world, world_unlit, grid->vertex_count, 1e-5f);
+    run_test("11. World-space lighting gives the colors of update_mesh_lit", lit_match, 1, &results[10]);
+
     print_summary(results, TOTAL_TESTS);
 
     // ------------------------------ Garbage collect ------------------------------
@@ -191,4 +249,15 @@ int main(void) {
     mesh_destroy(triangle_rt_got);
     mesh_destroy(triangle_s);
     mesh_destroy(triangle_s_got);
+    mesh_destroy(compact);
+    mesh_destroy(compact_got);
+    for (int v = 0; v < 3; v++)
+        mesh_destroy(view_clipped[v]);
+    mesh_destroy(expected);
+    mesh_destroy(grid);
+    jobs_destroy(jobs);
+    free(world);
+    free(world_unlit);
+    free(world_colors);
+    free(expected_colors);
 }
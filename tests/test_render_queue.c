@@ -0,0 +1,138 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <SDL.h>
+
+#include "test_framework.h"
+#include "core/render_queue.h"
+
+#define TOTAL_TESTS 7
+
+#define SCREEN_W 64
+#define SCREEN_H 64
+#define SORT_COUNT 10000
+#define DRAWS 60
+#define COLORS 3
+
+static const Color PALETTE[COLORS] = {{255, 0, 0, 255}, {0, 255, 0, 255}, {0, 0, 255, 255}};
+
+static int compare_keys(const void* a, const void* b) {
+    uint64_t x = ((const SortKey*)a)->key, y = ((const SortKey*)b)->key;
+    return (x > y) - (x < y);
+}
+
+static uint64_t random_key(void) {
+    uint64_t key = 0;
+    for (int i = 0; i < 4; i++)
+        key = (key << 16) ^ (uint64_t)(rand() & 0xFFFF);
+    return key;
+}
+
+int main(void) {
+    TestResult results[TOTAL_TESTS];
+    srand(42);
+
+    // ------------------------------ Radix sort ------------------------------
+    SortKey* items = malloc(sizeof(SortKey) * SORT_COUNT);
+    SortKey* scratch = malloc(sizeof(SortKey) * SORT_COUNT);
+    SortKey* expected = malloc(sizeof(SortKey) * SORT_COUNT);
+    for (int i = 0; i < SORT_COUNT; i++)
+        items[i] = expected[i] = (SortKey){random_key(), i};
+    qsort(expected, SORT_COUNT, sizeof(SortKey), compare_keys);
+    SortKey* sorted = radix_sort(items, scratch, SORT_COUNT);
+    int same = 1;
+    for (int i = 0; i < SORT_COUNT; i++)
+        same &= sorted[i].key == expected[i].key;
+    run_test("1. Radix sort matches qsort on 64-bit keys", same, 1, &results[0]);
+
+    // Few distinct keys, all in the low byte: one pass, equal keys keep their order
+    for (int i = 0; i < SORT_COUNT; i++)
+        items[i] = (SortKey){(uint64_t)(rand() % 7), i};
+    sorted = radix_sort(items, scratch, SORT_COUNT);
+    int stable = sorted == scratch;
+    for (int i = 1; i < SORT_COUNT; i++)
+        stable &= sorted[i - 1].key < sorted[i].key ||
+                  (sorted[i - 1].key == sorted[i].key && sorted[i - 1].index < sorted[i].index);
+    run_test("2. Radix sort is stable and skips constant bytes", stable, 1, &results[1]);
+
+    // ------------------------------ Keys ------------------------------
+    Vector4 vertices[3] = {{-0.5f, -0.5f, 0.5f, 1}, {0.5f, -0.5f, 0.5f, 1}, {0.0f, 0.5f, 0.5f, 1}};
+    Triangle triangles[1] = {{0, 1, 2}};
+    Mesh* mesh = mesh_generate(vertices, 3, triangles, 1);
+
+    Draw software = {.clipped_mesh = mesh, .color = PALETTE[2], .backend = RENDER_SOFTWARE};
+    Draw red = {.clipped_mesh = mesh, .color = PALETTE[0], .backend = RENDER_SDL};
+    Draw green = red;
+    green.color = PALETTE[1];
+    Draw flat = red;
+    flat.shading = SHADE_FLAT;
+
+    int ordered = render_key(&software, RENDER_LAYERS - 1, 1.0f) < render_key(&red, 0, 0.0f) &&
+                  render_key(&green, 0, 1.0f) < render_key(&red, 1, 0.0f) &&
+                  render_key(&green, 0, 1.0f) < render_key(&flat, 0, 0.0f) &&
+                  render_key(&green, 0, 1.0f) < render_key(&red, 0, 0.0f) &&
+                  render_key(&red, 99, 0.0f) == render_key(&red, RENDER_LAYERS - 1, 0.0f);
+    flat.vertex_colors = (uint32_t[3]){0};
+    int depth = render_key(&software, 0, 0.25f) < render_key(&software, 0, 0.5f) &&
+                render_key(&software, 0, -3.0f) == render_key(&software, 0, 0.0f) &&
+                render_key(&flat, 0, 0.5f) < render_key(&flat, 0, 0.25f) &&
+                render_key(&red, 0, 0.25f) == render_key(&red, 0, 0.5f);
+    run_test("3. Keys order backend, layer, shading, material, then depth", ordered && depth, 1, &results[2]);
+
+    // ------------------------------ Queue ------------------------------
+    Draw draws[DRAWS];
+    RenderQueue* queue = render_queue_create(4);
+    for (int i = 0; i < DRAWS; i++) {
+        draws[i] = red;
+        draws[i].color = PALETTE[i % COLORS];
+        render_queue_push(queue, &draws[i], 0, (float)(DRAWS - i) / DRAWS);
+    }
+    render_queue_sort(queue);
+    int grouped = queue->count == DRAWS && queue->capacity >= DRAWS && queue->stats.state_changes == COLORS &&
+                  queue->stats.submitted_state_changes == DRAWS;
+    int in_order = 1;
+    for (int i = 1; i < DRAWS; i++)
+        if ((queue->sorted[i - 1].key >> RENDER_KEY_DEPTH_BITS) == (queue->sorted[i].key >> RENDER_KEY_DEPTH_BITS))
+            in_order &= queue->sorted[i - 1].index < queue->sorted[i].index;
+    run_test("4. Sorting groups equal state, wireframes keep their order", grouped && in_order, 1, &results[3]);
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, SCREEN_W, SCREEN_H, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer* sdl = SDL_CreateSoftwareRenderer(surface);
+    Framebuffer* fb = framebuffer_create(SCREEN_W, SCREEN_H);
+    int executed = render_queue_execute(queue, RENDER_SDL, sdl, fb, SCREEN_W, SCREEN_H);
+    run_test("5. The draw color is set once per run of equal colors", executed == DRAWS && queue->stats.color_sets == COLORS,
+             1, &results[4]);
+
+    // Software draws run in their own pass, into the framebuffer
+    render_queue_reset(queue);
+    render_queue_push(queue, &red, 0, 0.0f);
+    render_queue_push(queue, &software, 0, 0.0f);
+    render_queue_push(queue, &green, 0, 0.0f);
+    render_queue_sort(queue);
+    framebuffer_clear(fb, 0xFF000000u);
+    int soft = render_queue_execute(queue, RENDER_SOFTWARE, sdl, fb, SCREEN_W, SCREEN_H);
+    framebuffer_resolve(fb);
+    int lit = 0;
+    for (int y = 0; y < fb->height; y++)
+        for (int x = 0; x < fb->width; x++)
+            lit += fb->pixels[y * fb->pitch + x] == color_to_argb(PALETTE[2]);
+    int hard = render_queue_execute(queue, RENDER_SDL, sdl, fb, SCREEN_W, SCREEN_H);
+    run_test("6. Each backend pass only executes its own draws", soft == 1 && hard == 2 && lit > 0, 1, &results[5]);
+
+    render_queue_reset(queue);
+    render_queue_sort(queue);
+    int empty = queue->count == 0 && queue->stats.draws == 0 && queue->stats.state_changes == 0 &&
+                render_queue_execute(queue, RENDER_SDL, sdl, fb, SCREEN_W, SCREEN_H) == 0;
+    run_test("7. A reset queue is empty", empty, 1, &results[6]);
+
+    print_summary(results, TOTAL_TESTS);
+
+    // ------------------------------ Garbage collect ------------------------------
+    render_queue_destroy(queue);
+    framebuffer_destroy(fb);
+    SDL_DestroyRenderer(sdl);
+    SDL_FreeSurface(surface);
+    mesh_destroy(mesh);
+    free(items);
+    free(scratch);
+    free(expected);
+}
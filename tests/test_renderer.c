@@ -0,0 +1,268 @@
+#include <math.h>
+#include <string.h>
+#include <SDL.h>
+
+#include "test_framework.h"
+#include "test_fixtures.h"
+#include "core/pipeline.h"
+#include "core/renderer.h"
+
+#define TOTAL_TESTS 13
+
+#define SCREEN_W 320
+#define SCREEN_H 240
+#define BACKGROUND 0xFF000000u
+#define WHITE (Color){255, 255, 255, 255}
+
+// Share of lit pixels allowed to have no lit neighbour in the other image
+#define MISMATCH_TOLERANCE 0.01
+
+static int is_lit(const uint32_t* pixels, int pitch, int x, int y) {
+    return (pixels[y * pitch + x] & 0x00FFFFFF) != 0;
+}
+
+// Lit pixels of a with no lit pixel of b in their 3x3 neighbourhood
+static int count_unmatched(const uint32_t* a, int pitch_a, const uint32_t* b, int pitch_b, int* lit) {
+    int unmatched = 0;
+    *lit = 0;
+    for (int y = 0; y < SCREEN_H; y++) {
+        for (int x = 0; x < SCREEN_W; x++) {
+            if (!is_lit(a, pitch_a, x, y)) continue;
+            (*lit)++;
+
+            int found = 0;
+            for (int dy = -1; dy <= 1 && !found; dy++)
+                for (int dx = -1; dx <= 1 && !found; dx++) {
+                    int nx = x + dx, ny = y + dy;
+                    if (nx >= 0 && ny >= 0 && nx < SCREEN_W && ny < SCREEN_H)
+                        found = is_lit(b, pitch_b, nx, ny);
+                }
+            unmatched += !found;
+        }
+    }
+    return unmatched;
+}
+
+// Tiles holding at least one pixel different from the background
+static int count_drawn_tiles(const Framebuffer* fb) {
+    int tiles = 0;
+    for (int ty = 0; ty < fb->tiles_y; ty++)
+        for (int tx = 0; tx < fb->tiles_x; tx++) {
+            int drawn = 0;
+            for (int y = ty * FRAMEBUFFER_TILE; y < (ty + 1) * FRAMEBUFFER_TILE && y < fb->height; y++)
+                for (int x = tx * FRAMEBUFFER_TILE; x < (tx + 1) * FRAMEBUFFER_TILE && x < fb->width; x++)
+                    drawn |= fb->pixels[y * fb->pitch + x] != BACKGROUND;
+            tiles += drawn;
+        }
+    return tiles;
+}
+
+// Renders the draw through both paths and checks they agree within tolerance
+static int same_image(SDL_Renderer* sdl, SDL_Surface* surface, Framebuffer* fb, const Draw* draw) {
+    SDL_SetRenderDrawColor(sdl, 0, 0, 0, 255);
+    SDL_RenderClear(sdl);
+    draw_mesh(sdl, draw, SCREEN_W, SCREEN_H);
+
+    framebuffer_clear(fb, BACKGROUND);
+    draw_mesh_software(fb, draw);
+    framebuffer_resolve(fb);
+
+    const uint32_t* sdl_pixels = surface->pixels;
+    int sdl_pitch = surface->pitch / (int)sizeof(uint32_t);
+
+    int lit_sdl, lit_soft;
+    int miss_sdl = count_unmatched(sdl_pixels, sdl_pitch, fb->pixels, fb->pitch, &lit_sdl);
+    int miss_soft = count_unmatched(fb->pixels, fb->pitch, sdl_pixels, sdl_pitch, &lit_soft);
+
+    return lit_sdl > 0 && lit_soft > 0 &&
+           miss_sdl <= lit_sdl * MISMATCH_TOLERANCE &&
+           miss_soft <= lit_soft * MISMATCH_TOLERANCE;
+}
+
+int main(void) {
+    TestResult results[TOTAL_TESTS];
+
+    Camera cam = {
+        .pos    = {0.0f, 0.0f, 6.0f},
+        .target = {0.0f, 0.0f, 0.0f},
+        .up     = {0.0f, 1.0f, 0.0f}
+    };
+    Projection proj = {
+        .fov          = M_PI / 3,
+        .aspect_ratio = (float)SCREEN_W / SCREEN_H,
+        .near         = 0.1f,
+        .far          = 100.0f
+    };
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, SCREEN_W, SCREEN_H, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer* sdl = SDL_CreateSoftwareRenderer(surface);
+    Framebuffer* fb = framebuffer_create(SCREEN_W, SCREEN_H);
+
+    Mesh* cube = create_cube_mesh();
+    Draw draw = {
+        .clipped_mesh = mesh_copy(cube),
+        .color = WHITE,
+        .backend = RENDER_SOFTWARE
+    };
+
+    // ------------------------------ Framebuffer primitives ------------------------------
+
+    framebuffer_clear(fb, 0xFF123456u);
+    framebuffer_resolve(fb);
+    int cleared = 1;
+    for (int i = 0; i < fb->pitch * fb->height; i++)
+        cleared &= fb->pixels[i] == 0xFF123456u;
+    run_test("1. Clear fills every pixel", cleared, 1, &results[0]);
+
+    framebuffer_clear(fb, BACKGROUND);
+    framebuffer_draw_line(fb, 10, 20, 15, 20, 0xFFFFFFFFu);
+    framebuffer_resolve(fb);
+    int span = 0;
+    for (int x = 0; x < SCREEN_W; x++)
+        span += fb->pixels[20 * fb->pitch + x] == 0xFFFFFFFFu;
+    run_test("2. Horizontal line includes both endpoints", span, 6, &results[1]);
+
+    framebuffer_clear(fb, BACKGROUND);
+    framebuffer_draw_line(fb, -1000, -500, 5000, 3000, 0xFFFFFFFFu);
+    framebuffer_draw_line(fb, -50, -50, -10, 400, 0xFFFFFFFFu);
+    framebuffer_resolve(fb);
+    int lit = 0;
+    for (int i = 0; i < fb->pitch * fb->height; i++)
+        lit += fb->pixels[i] == 0xFFFFFFFFu;
+    run_test("3. Clipped line stays in bounds", lit > 0 && lit <= SCREEN_W + SCREEN_H, 1, &results[2]);
+
+    // ------------------------------ Same image as the SDL path ------------------------------
+
+    Transform rotated = NO_TRANSFORM;
+    rotated.rotation = (Vector3){0.4f, 0.7f, 0.1f};
+    update_mesh(cube, draw.clipped_mesh, rotated, cam, proj);
+    run_test("4. Rotated cube matches SDL path", same_image(sdl, surface, fb, &draw), 1, &results[3]);
+
+    Transform scaled = NO_TRANSFORM;
+    scaled.scale = (Vector3){1.5f, 0.5f, 1.0f};
+    scaled.rotation = (Vector3){0.0f, 0.3f, 0.0f};
+    update_mesh(cube, draw.clipped_mesh, scaled, cam, proj);
+    run_test("5. Scaled cube matches SDL path", same_image(sdl, surface, fb, &draw), 1, &results[4]);
+
+    Transform off_screen = NO_TRANSFORM;
+    off_screen.translation = (Vector3){3.5f, 2.0f, 0.0f};
+    off_screen.rotation = (Vector3){0.2f, 0.5f, 0.0f};
+    update_mesh(cube, draw.clipped_mesh, off_screen, cam, proj);
+    run_test("6. Partly off-screen cube matches SDL path", same_image(sdl, surface, fb, &draw), 1, &results[5]);
+
+    // ------------------------------ Compact formats ------------------------------
+    uint32_t* full_image = malloc(sizeof(uint32_t) * fb->pitch * fb->height);
+    update_mesh(cube, draw.clipped_mesh, rotated, cam, proj);
+    framebuffer_clear(fb, BACKGROUND);
+    draw_mesh_software(fb, &draw);
+    framebuffer_resolve(fb);
+    memcpy(full_image, fb->pixels, sizeof(uint32_t) * fb->pitch * fb->height);
+
+    Mesh* compact = mesh_copy(cube);
+    mesh_compact(compact);
+    Draw compact_draw = draw;
+    compact_draw.clipped_mesh = mesh_create_clipped(compact);
+    update_mesh(compact, compact_draw.clipped_mesh, rotated, cam, proj);
+    framebuffer_clear(fb, BACKGROUND);
+    draw_mesh_software(fb, &compact_draw);
+    framebuffer_resolve(fb);
+    int same = compact_draw.clipped_mesh->triangles16 != NULL &&
+               !memcmp(full_image, fb->pixels, sizeof(uint32_t) * fb->pitch * fb->height);
+    run_test("7. Vector3 positions and 16-bit indices draw the same image", same, 1, &results[6]);
+
+    // ------------------------------ Tiles and lazy clears ------------------------------
+    framebuffer_clear(fb, BACKGROUND);
+    framebuffer_clear_depth(fb);
+    size_t before = fb->tiles_filled;
+    framebuffer_draw_line(fb, 9, 9, 14, 9, 0xFFFFFFFFu);
+    framebuffer_resolve(fb);
+    int lazy = fb->tiles_filled - before == 1 && count_drawn_tiles(fb) == 1 &&
+               fb->pixels[9 * fb->pitch + 9] == 0xFFFFFFFFu && fb->pixels[20 * fb->pitch + 20] == BACKGROUND;
+    run_test("8. Clears are deferred: one line fills one tile, the rest resolves to the clear color", lazy, 1, &results[7]);
+
+    float tx[3] = {20.0f, 200.0f, 20.0f}, ty[3] = {20.0f, 20.0f, 200.0f}, tz[3] = {0.5f, 0.5f, 0.5f};
+    uint32_t red[3] = {0xFFFF0000u, 0xFFFF0000u, 0xFFFF0000u}, blue[3] = {0xFF0000FFu, 0xFF0000FFu, 0xFF0000FFu};
+    framebuffer_clear(fb, BACKGROUND);
+    framebuffer_clear_depth(fb);
+    before = fb->tiles_filled;
+    framebuffer_fill_triangle(fb, tx, ty, tz, red);
+    framebuffer_resolve(fb);
+    int drawn_tiles = count_drawn_tiles(fb);
+    run_test("9. Triangles fill only the color and depth tiles they cover", (int)(fb->tiles_filled - before),
+             2 * drawn_tiles, &results[8]);
+
+    // Depth cleared alone: a farther triangle now passes, over the red one
+    framebuffer_clear_depth(fb);
+    float far_z[3] = {0.9f, 0.9f, 0.9f};
+    framebuffer_fill_triangle(fb, tx, ty, far_z, blue);
+    framebuffer_resolve(fb);
+    int depth_reset = fb->pixels[40 * fb->pitch + 40] == 0xFF0000FFu && fb->pixels[150 * fb->pitch + 150] == BACKGROUND;
+    run_test("10. A deferred depth clear resets the depth of drawn tiles", depth_reset, 1, &results[9]);
+
+    // Odd size and pitch: rows are copied up to width, the rest of dst is untouched
+    int rw = 37, rh = 21, rpitch = 41;
+    uint32_t* resolved = malloc(sizeof(uint32_t) * rpitch * rh);
+    for (int i = 0; i < rpitch * rh; i++)
+        resolved[i] = 0x12345678u;
+    framebuffer_resolve_to(fb, resolved, rpitch, rw, rh);
+    int linear = 1;
+    for (int y = 0; y < rh; y++)
+        for (int x = 0; x < rpitch; x++)
+            linear &= resolved[y * rpitch + x] == (x < rw ? fb->pixels[y * fb->pitch + x] : 0x12345678u);
+    free(resolved);
+    run_test("11. Resolving into a buffer of any pitch matches the linear pixels", linear, 1, &results[10]);
+
+    // ------------------------------ Viewports ------------------------------
+    Viewport rect = {96, 64, 80, 60};
+    framebuffer_clear(fb, BACKGROUND);
+    framebuffer_clear_depth(fb);
+    framebuffer_set_viewport(fb, rect);
+    float big_x[3] = {-500.0f, 900.0f, -500.0f}, big_y[3] = {-500.0f, -500.0f, 900.0f};
+    framebuffer_fill_triangle(fb, big_x, big_y, tz, red);
+    framebuffer_draw_line(fb, 0, 0, SCREEN_W - 1, SCREEN_H - 1, 0xFFFFFFFFu);
+    framebuffer_resolve(fb);
+    int clipped = 1;
+    for (int y = 0; y < SCREEN_H; y++)
+        for (int x = 0; x < SCREEN_W; x++) {
+            int inside = x >= rect.x && x < rect.x + rect.width && y >= rect.y && y < rect.y + rect.height;
+            clipped &= (fb->pixels[y * fb->pitch + x] != BACKGROUND) == inside;
+        }
+    run_test("12. Lines and triangles are clipped to the viewport", clipped, 1, &results[11]);
+
+    // A camera drawn into a viewport gives the image it renders alone at the viewport size
+    Projection view_proj = proj;
+    view_proj.aspect_ratio = (float)rect.width / rect.height;
+    update_mesh(cube, draw.clipped_mesh, rotated, cam, view_proj);
+    framebuffer_clear(fb, BACKGROUND);
+    framebuffer_set_viewport(fb, rect);
+    draw_mesh_software(fb, &draw);
+    framebuffer_resolve(fb);
+
+    Framebuffer* alone = framebuffer_create(rect.width, rect.height);
+    framebuffer_clear(alone, BACKGROUND);
+    draw_mesh_software(alone, &draw);
+    framebuffer_resolve(alone);
+    int view_lit = 0, view_diff = 0;
+    for (int y = 0; y < rect.height; y++)
+        for (int x = 0; x < rect.width; x++) {
+            uint32_t a = alone->pixels[y * alone->pitch + x];
+            view_lit += a != BACKGROUND;
+            view_diff += a != fb->pixels[(rect.y + y) * fb->pitch + rect.x + x];
+        }
+    framebuffer_destroy(alone);
+    framebuffer_resize(fb, SCREEN_W, SCREEN_H);
+    run_test("13. A view drawn into a viewport matches the same view rendered alone",
+             view_lit > 0 && view_diff <= view_lit * MISMATCH_TOLERANCE, 1, &results[12]);
+
+    print_summary(results, TOTAL_TESTS);
+
+    // ------------------------------ Garbage collect ------------------------------
+    free(full_image);
+    mesh_destroy(compact);
+    mesh_destroy(compact_draw.clipped_mesh);
+    mesh_destroy(draw.clipped_mesh);
+    mesh_destroy(cube);
+    framebuffer_destroy(fb);
+    SDL_DestroyRenderer(sdl);
+    SDL_FreeSurface(surface);
+}
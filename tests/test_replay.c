@@ -0,0 +1,128 @@
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "test_framework.h"
+#include "core/replay.h"
+
+#define TOTAL_TESTS 10
+
+#define RECORDING "test_replay.rec"
+#define SCREEN 64
+#define FRAMES 100
+#define DT (1.0f / 60.0f)
+#define BACKGROUND (Color){0, 0, 0, 255}
+#define RED (Color){255, 0, 0, 255}
+
+static Mesh* create_quad(float size) {
+    Vector4 vertices[4] = {
+        {-size, -size, 0, 1}, {size, -size, 0, 1}, {size, size, 0, 1}, {-size, size, 0, 1}
+    };
+    Triangle triangles[2] = {{{0, 1, 2}}, {{0, 2, 3}}};
+    return mesh_generate(vertices, 4, triangles, 2);
+}
+
+static long file_size(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return -1;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    return size;
+}
+
+int main(void) {
+    TestResult results[TOTAL_TESTS];
+
+    Mesh* quad = create_quad(1.0f);
+    Mesh* small = create_quad(0.5f);
+    Camera cam = {{0.0f, 0.0f, 5.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}};
+    Projection proj = {M_PI / 3, 1.0f, 0.1f, 100.0f};
+    Lighting lighting = { .ambient = {0.2f, 0.2f, 0.2f} };
+    lighting_add(&lighting, (Light){ .type = LIGHT_DIRECTIONAL, .direction = {0.0f, 0.0f, -1.0f}, .color = {1.0f, 1.0f, 1.0f} });
+    Draw draw = { .color = RED, .backend = RENDER_SOFTWARE, .shading = SHADE_WIREFRAME };
+
+    // ------------------------------ Recording ------------------------------
+    // A rotating quad; the second half is lit and switches to the small mesh
+    Recorder* rec = recorder_open(RECORDING, SCREEN, SCREEN, BACKGROUND);
+    int recorded = rec != NULL;
+    Transform transform = NO_TRANSFORM;
+    for (int f = 0; recorded && f < FRAMES; f++) {
+        transform.rotation.z = f * 0.05f;
+        if (f == FRAMES / 2) draw.shading = SHADE_GOURAUD;
+        recorded &= recorder_frame(rec, DT, f < FRAMES / 2 ? quad : small, &draw, transform, cam, proj, &lighting);
+    }
+    recorded &= rec && recorder_close(rec);
+
+    Replay* replay = replay_load(RECORDING);
+    int loaded = recorded && replay && replay->frame_count == FRAMES && replay->mesh_count == 2 &&
+                 replay->screen_w == SCREEN && replay->background == color_to_argb(BACKGROUND);
+    run_test("1. Recorded session loads back", loaded, 1, &results[0]);
+
+    int geometry = loaded && replay->meshes[1]->vertex_count == 4 && replay->meshes[1]->triangle_count == 2 &&
+                   !memcmp(replay->meshes[1]->vertices, small->vertices, sizeof(Vector4) * 4) &&
+                   !memcmp(replay->meshes[1]->triangles, small->triangles, sizeof(Triangle) * 2);
+    run_test("2. Mesh geometry round trips", geometry, 1, &results[1]);
+
+    int fields = 1;
+    for (int f = 0; loaded && f < FRAMES; f++) {
+        const ReplayFrame* frame = &replay->frames[f];
+        fields &= frame->dt == DT && frame->transform.rotation.z == f * 0.05f;
+        fields &= frame->mesh == (f < FRAMES / 2 ? 0 : 1);
+        fields &= frame->shading == (f < FRAMES / 2 ? SHADE_WIREFRAME : SHADE_GOURAUD);
+    }
+    run_test("3. Changed fields round trip", loaded && fields, 1, &results[2]);
+
+    // Camera, projection and lighting were only written with the first frame
+    const ReplayFrame* last = loaded ? &replay->frames[FRAMES - 1] : NULL;
+    int carried = last && !memcmp(&last->camera, &cam, sizeof(Camera)) &&
+                  !memcmp(&last->projection, &proj, sizeof(Projection)) &&
+                  last->lighting.count == 1 && last->color == color_to_argb(RED);
+    run_test("4. Unchanged fields carry over", carried, 1, &results[3]);
+
+    // Full state is several hundred bytes, a transform-only frame about 42
+    long full_frame = (long)(sizeof(Transform) + sizeof(Camera) + sizeof(Projection) + sizeof(Lighting));
+    long size = file_size(RECORDING);
+    run_test("5. Recording is delta encoded", size > 0 && size < FRAMES * full_frame / 4, 1, &results[4]);
+
+    // ------------------------------ Replay ------------------------------
+    ReplayReport first, second;
+    int ran = loaded && replay_run(replay, &first);
+    ran = ran && replay_run(replay, &second);
+    int same = ran && first.frame_count == FRAMES &&
+               !memcmp(first.checksums, second.checksums, sizeof(uint32_t) * FRAMES);
+    run_test("6. Checksums are deterministic", same, 1, &results[5]);
+
+    int distinct = ran && first.checksums[0] != first.checksums[1] &&
+                   first.checksums[FRAMES / 2 - 1] != first.checksums[FRAMES / 2];
+    run_test("7. Checksums follow the rendered frame", distinct, 1, &results[6]);
+
+    int ordered = ran && first.p50_ms <= first.p90_ms && first.p90_ms <= first.p99_ms &&
+                  first.p99_ms <= first.max_ms && first.max_ms <= first.total_ms;
+    run_test("8. Percentiles are ordered", ordered, 1, &results[7]);
+
+    int session = ran && fabs(first.session_ms - FRAMES * DT * 1000.0) < 1e-3;
+    run_test("9. Session time is the sum of the deltas", session, 1, &results[8]);
+
+    // ------------------------------ Invalid files ------------------------------
+    FILE* bad = fopen(RECORDING, "wb");
+    if (bad) {
+        fwrite("3DRQ", 1, 4, bad);
+        fclose(bad);
+    }
+    Replay* rejected = replay_load(RECORDING);
+    Replay* missing = replay_load("missing.rec");
+    run_test("10. Invalid or missing files are rejected", rejected == NULL && missing == NULL, 1, &results[9]);
+
+    print_summary(results, TOTAL_TESTS);
+
+    // ------------------------------ Garbage collect ------------------------------
+    remove(RECORDING);
+    if (ran) {
+        replay_report_free(&first);
+        replay_report_free(&second);
+    }
+    if (replay) replay_destroy(replay);
+    mesh_destroy(quad);
+    mesh_destroy(small);
+}
@@ -0,0 +1,83 @@
+#include <math.h>
+
+#include "test_framework.h"
+#include "core/resolution.h"
+#include "core/framebuffer.h"
+
+#define TOTAL_TESTS 9
+
+#define BUDGET_MS 4.0f
+#define FULL_RES_MS 16.0f  // simulated raster time at scale 1
+#define FRAMES 60
+#define FB_W 64
+#define FB_H 48
+
+// Raster time proportional to the pixel count
+static float simulated_ms(float scale, float full_ms) {
+    return full_ms * scale * scale;
+}
+
+static float run_frames(ResolutionController* rc, float full_ms, int frames) {
+    for (int f = 0; f < frames; f++)
+        resolution_update(rc, simulated_ms(rc->scale, full_ms));
+    return rc->scale;
+}
+
+int main(void) {
+    TestResult results[TOTAL_TESTS];
+
+    // ------------------------------ Controller ------------------------------
+    ResolutionController rc = resolution_controller(BUDGET_MS, 0.25f, 1.0f);
+    run_test("1. Starts at the max scale", rc.scale, 1.0f, &results[0]);
+
+    resolution_update(&rc, FULL_RES_MS);
+    run_test("2. Over budget lowers the scale", rc.scale < 1.0f, 1, &results[1]);
+
+    run_frames(&rc, FULL_RES_MS, FRAMES);
+    float settled_ms = simulated_ms(rc.scale, FULL_RES_MS);
+    run_test("3. Settles within the budget dead band", fabsf(settled_ms - BUDGET_MS) < 0.1f * BUDGET_MS, 1, &results[2]);
+
+    ResolutionController heavy = resolution_controller(BUDGET_MS, 0.25f, 1.0f);
+    ResolutionController light = resolution_controller(BUDGET_MS, 0.25f, 1.0f);
+    int clamped = run_frames(&heavy, 1000.0f, FRAMES) == 0.25f && run_frames(&light, 1.0f, FRAMES) == 1.0f;
+    run_test("4. Scale stays within its bounds", clamped, 1, &results[3]);
+
+    // Steady at the budget, then a single slow frame
+    float steady = rc.scale;
+    resolution_update(&rc, BUDGET_MS * 1.02f);
+    int kept = rc.scale == steady;
+    resolution_update(&rc, BUDGET_MS * 10.0f);
+    run_test("5. Small deviations are ignored", kept, 1, &results[4]);
+    run_test("6. A spike is smoothed", rc.scale > steady * sqrtf(0.1f), 1, &results[5]);
+
+    // ------------------------------ Sizes ------------------------------
+    ResolutionController half = resolution_controller(BUDGET_MS, 0.5f, 0.5f);
+    int w, h;
+    resolution_size(&half, 801, 600, &w, &h);
+    run_test("7. Internal size follows the scale", w == 401 && h == 300, 1, &results[6]);
+
+    Framebuffer* fb = framebuffer_create(FB_W, FB_H);
+    framebuffer_resize(fb, 1000, 0);
+    int bounds = fb->width == FB_W && fb->height == 1;
+    framebuffer_resize(fb, FB_W / 2, FB_H / 2);
+    bounds &= fb->width == FB_W / 2 && fb->height == FB_H / 2 && fb->pitch == FB_W;
+    run_test("8. Framebuffer resize is clamped to the allocation", bounds, 1, &results[7]);
+
+    // Drawing at the lower resolution stays in the top-left corner
+    framebuffer_resize(fb, FB_W, FB_H);
+    framebuffer_clear(fb, 0);
+    framebuffer_resize(fb, FB_W / 2, FB_H / 2);
+    framebuffer_draw_line(fb, 0, 0, FB_W - 1, FB_H - 1, 0xFFFFFFFFu);
+    framebuffer_resolve(fb);
+    int inside = fb->pixels[0] == 0xFFFFFFFFu;
+    for (int y = 0; y < FB_H; y++)
+        for (int x = 0; x < FB_W; x++)
+            if (x >= FB_W / 2 || y >= FB_H / 2)
+                inside &= fb->pixels[y * fb->pitch + x] == 0;
+    run_test("9. Draws are clipped to the visible size", inside, 1, &results[8]);
+
+    print_summary(results, TOTAL_TESTS);
+
+    // ------------------------------ Garbage collect ------------------------------
+    framebuffer_destroy(fb);
+}
@@ -0,0 +1,168 @@
+#include <math.h>
+
+#include "test_framework.h"
+#include "core/pipeline.h"
+
+#define TOTAL_TESTS 10
+
+#define RANDOM_VERTICES 5000
+#define RANDOM_JOINTS 16
+
+// Two-bone arm along +y: shoulder at the origin, elbow at y = 1
+static const int ARM_PARENTS[2] = {-1, 0};
+
+static Transform at(float x, float y, float z) {
+    Transform t = NO_TRANSFORM;
+    t.translation = (Vector3){x, y, z};
+    return t;
+}
+
+static float random_float(void) {
+    return (float)rand() / RAND_MAX * 2.0f - 1.0f;
+}
+
+static float max_error(const Vector4* a, const Vector4* b, int count) {
+    float err = 0.0f;
+    for (int i = 0; i < count; i++)
+        for (int c = 0; c < 4; c++)
+            err = fmaxf(err, fabsf(a[i].v[c] - b[i].v[c]));
+    return err;
+}
+
+// Marks every index it is given, to check the loop covers [0, count) once
+static void mark_range(void* ctx, int start, int end) {
+    SDL_atomic_t* hits = ctx;
+    for (int i = start; i < end; i++)
+        SDL_AtomicAdd(&hits[i], 1);
+}
+
+int main(void) {
+    TestResult results[TOTAL_TESTS];
+
+    // ------------------------------ Arm ------------------------------
+    Transform bind_pose[2] = {at(0, 0, 0), at(0, 1, 0)};
+    Skeleton* arm = skeleton_create(2, ARM_PARENTS, bind_pose);
+
+    Vector4 arm_vertices[3] = {{0, 0.5f, 0, 1}, {0, 1.5f, 0, 1}, {0, 2, 0, 1}};
+    uint8_t arm_joints[3 * SKIN_MAX_INFLUENCES] = {0, 0, 0, 0, 0, 1, 0, 0, 1, 0, 0, 0};
+    float arm_weights[3 * SKIN_MAX_INFLUENCES] = {1, 0, 0, 0, 0.5f, 0.5f, 0, 0, 1, 0, 0, 0};
+    Mesh* arm_mesh = mesh_generate(arm_vertices, 3, (Triangle[1]){{0, 1, 2}}, 1);
+    SkinnedMesh* arm_skin = skinned_mesh_create(arm_mesh, arm_joints, arm_weights);
+
+    Matrix palette[RANDOM_JOINTS];
+    Vector4 posed[3];
+
+    skeleton_pose(arm, bind_pose, palette);
+    skin_vertices(arm_skin, palette, posed, NULL);
+    run_test("1. Bind pose leaves vertices in place", max_error(posed, arm_vertices, 3), 0.0f, &results[0]);
+
+    // Elbow bent by 90 degrees around z
+    Transform bent[2] = {at(0, 0, 0), at(0, 1, 0)};
+    bent[1].rotation.z = M_PI / 2;
+    skeleton_pose(arm, bent, palette);
+    skin_vertices(arm_skin, palette, posed, NULL);
+    Vector4 hand = {-1, 1, 0, 1};
+    Vector4 forearm = {-0.25f, 1.25f, 0, 1};
+    run_test("2. Fully weighted vertex follows its joint", posed[2], hand, &results[1]);
+    run_test("3. Half weighted vertex is blended", posed[1], forearm, &results[2]);
+
+    // ------------------------------ Animation ------------------------------
+    float times[2] = {0.0f, 2.0f};
+    Transform keys[4] = {at(0, 0, 0), at(0, 1, 0), at(4, 0, 0), at(0, 1, 0)};
+    keys[3].rotation.z = 1.0f;
+    AnimationClip* clip = animation_clip_create(2, 2, times, keys);
+
+    Transform local[2], wrapped[2];
+    animation_sample(clip, 1.0f, local);
+    run_test("4. Sampling interpolates between keys",
+        local[0].translation.x == 2.0f && local[1].rotation.z == 0.5f, 1, &results[3]);
+
+    animation_sample(clip, 0.5f, local);
+    animation_sample(clip, 2.5f, wrapped);
+    run_test("5. Sampling wraps around the clip", wrapped[1].rotation.z, local[1].rotation.z, &results[4]);
+
+    // ------------------------------ SIMD / threads vs scalar ------------------------------
+    srand(7);
+    int parents[RANDOM_JOINTS];
+    Transform rest[RANDOM_JOINTS], pose[RANDOM_JOINTS];
+    for (int j = 0; j < RANDOM_JOINTS; j++) {
+        parents[j] = j - 1;
+        rest[j] = at(0, 0.5f, 0);
+        pose[j] = rest[j];
+        pose[j].rotation = (Vector3){random_float(), random_float(), random_float()};
+    }
+    Skeleton* chain = skeleton_create(RANDOM_JOINTS, parents, rest);
+    skeleton_pose(chain, pose, palette);
+
+    Vector4* vertices = malloc(sizeof(Vector4) * RANDOM_VERTICES);
+    uint8_t* joints = malloc(RANDOM_VERTICES * SKIN_MAX_INFLUENCES);
+    float* weights = malloc(sizeof(float) * RANDOM_VERTICES * SKIN_MAX_INFLUENCES);
+    for (int i = 0; i < RANDOM_VERTICES; i++) {
+        vertices[i] = (Vector4){random_float(), random_float() * 4.0f, random_float(), 1.0f};
+        for (int k = 0; k < SKIN_MAX_INFLUENCES; k++) {
+            joints[i * SKIN_MAX_INFLUENCES + k] = rand() % RANDOM_JOINTS;
+            weights[i * SKIN_MAX_INFLUENCES + k] = (float)rand() / RAND_MAX;
+        }
+    }
+    Mesh* body = mesh_generate(vertices, RANDOM_VERTICES, (Triangle[1]){{0, 1, 2}}, 1);
+    SkinnedMesh* skin = skinned_mesh_create(body, joints, weights);
+
+    Vector4* reference = malloc(sizeof(Vector4) * RANDOM_VERTICES);
+    Vector4* serial = malloc(sizeof(Vector4) * RANDOM_VERTICES);
+    Vector4* threaded = malloc(sizeof(Vector4) * RANDOM_VERTICES);
+
+    JobSystem* jobs = jobs_create(3);
+
+    skin_vertices_scalar(skin, palette, reference);
+    skin_vertices(skin, palette, serial, NULL);
+    skin_vertices(skin, palette, threaded, jobs);
+    run_test("6. SIMD skinning matches scalar", max_error(serial, reference, RANDOM_VERTICES) < 1e-4f, 1, &results[5]);
+    run_test("7. Threaded skinning matches serial", max_error(threaded, serial, RANDOM_VERTICES), 0.0f, &results[6]);
+
+    // Single pass skin + MVP vs skinning then update_mesh
+    Camera cam = {.pos = {0, 2, 8}, .target = {0, 1, 0}, .up = {0, 1, 0}};
+    Projection proj = {.fov = M_PI / 3, .aspect_ratio = 1.0f, .near = 0.1f, .far = 100.0f};
+    Transform placement = at(1, 0, -2);
+    placement.rotation.y = 0.3f;
+
+    Mesh* posed_mesh = mesh_copy(body);
+    Mesh* expected = mesh_copy(body);
+    Mesh* clipped = mesh_copy(body);
+    skin_vertices_scalar(skin, palette, posed_mesh->vertices);
+    update_mesh(posed_mesh, expected, placement, cam, proj);
+    update_skinned_mesh(skin, palette, clipped, placement, cam, proj, jobs);
+    run_test("8. Skinned MVP pass matches skin then update_mesh",
+        max_error(clipped->vertices, expected->vertices, RANDOM_VERTICES) < 1e-3f, 1, &results[7]);
+
+    // ------------------------------ Validation / job system ------------------------------
+    int bad_parents[2] = {1, -1};
+    run_test("9. Child before parent is rejected", skeleton_create(2, bad_parents, bind_pose) == NULL, 1, &results[8]);
+
+    SDL_atomic_t hits[10007] = {0};
+    jobs_parallel_for(jobs, 10007, 7, mark_range, hits);
+    int once = 1;
+    for (int i = 0; i < 10007; i++)
+        once &= SDL_AtomicGet(&hits[i]) == 1;
+    run_test("10. Parallel loop visits every index once", once, 1, &results[9]);
+
+    print_summary(results, TOTAL_TESTS);
+
+    // ------------------------------ Garbage collect ------------------------------
+    jobs_destroy(jobs);
+    free(vertices);
+    free(joints);
+    free(weights);
+    free(reference);
+    free(serial);
+    free(threaded);
+    mesh_destroy(posed_mesh);
+    mesh_destroy(expected);
+    mesh_destroy(clipped);
+    mesh_destroy(body);
+    mesh_destroy(arm_mesh);
+    skinned_mesh_destroy(skin);
+    skinned_mesh_destroy(arm_skin);
+    skeleton_destroy(chain);
+    skeleton_destroy(arm);
+    animation_clip_destroy(clip);
+}
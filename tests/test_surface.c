@@ -0,0 +1,147 @@
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "test_framework.h"
+#include "core/surface.h"
+
+#define TOTAL_TESTS 10
+
+#define RADIUS 2.0f
+#define PATCHES 4
+#define MAX_SEGMENTS 32
+#define SCREEN_W 320
+#define SCREEN_H 240
+#define TARGET_PX 8.0f
+
+static float distance3(Vector4 a, Vector4 b) {
+    return sqrtf((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y) + (a.z - b.z) * (a.z - b.z));
+}
+
+// Every vertex on the edge shared by two patches lies on the other patch's edge polyline
+static int edge_on_polyline(const Vector4* edge, int n, const Vector4* other, int m) {
+    for (int k = 0; k <= n; k++) {
+        int found = 0;
+        for (int s = 0; s < m && !found; s++) {
+            float along = distance3(other[s], edge[k]) + distance3(edge[k], other[s + 1]);
+            found = along - distance3(other[s], other[s + 1]) < 1e-5f;
+        }
+        if (!found) return 0;
+    }
+    return 1;
+}
+
+// Side of a patch: 0 = left (a = 0), 1 = right (a = n), 2 = bottom (b = 0), 3 = top (b = n)
+static void patch_edge(const Tessellation* tess, int patch, int side, Vector4* out) {
+    int offset = 0;
+    for (int p = 0; p < patch; p++)
+        offset += (tess->levels[p] + 1) * (tess->levels[p] + 1);
+    int n = tess->levels[patch];
+    for (int k = 0; k <= n; k++) {
+        int a = side < 2 ? (side == 1 ? n : 0) : k;
+        int b = side < 2 ? k : (side == 3 ? n : 0);
+        out[k] = tess->mesh->vertices[offset + b * (n + 1) + a];
+    }
+}
+
+// The finer of the two edges must follow the coarser one
+static int edges_match(const Tessellation* tess, int p, int p_side, int q, int q_side) {
+    Vector4 a[SURFACE_MAX_SEGMENTS + 1], b[SURFACE_MAX_SEGMENTS + 1];
+    int n = tess->levels[p], m = tess->levels[q];
+    patch_edge(tess, p, p_side, a);
+    patch_edge(tess, q, q_side, b);
+    return n >= m ? edge_on_polyline(a, n, b, m) : edge_on_polyline(b, m, a, n);
+}
+
+static int powers_of_two(const Tessellation* tess, int patches, int max_segments) {
+    for (int p = 0; p < patches; p++) {
+        int n = tess->levels[p];
+        if (n < 1 || n > max_segments || (n & (n - 1))) return 0;
+    }
+    return 1;
+}
+
+int main(void) {
+    TestResult results[TOTAL_TESTS];
+
+    Surface sphere = surface_sphere(RADIUS, PATCHES, PATCHES, MAX_SEGMENTS);
+    int on_sphere = 1;
+    for (int i = 0; i <= 8; i++) {
+        Vector3 p = surface_eval(&sphere, i / 8.0f, i / 16.0f);
+        on_sphere &= fabsf(sqrtf(p.x * p.x + p.y * p.y + p.z * p.z) - RADIUS) < 1e-5f;
+    }
+    run_test("1. Sphere points lie at the radius", on_sphere, 1, &results[0]);
+
+    Vector3 control[16];
+    for (int j = 0; j < 4; j++)
+        for (int i = 0; i < 4; i++)
+            control[j * 4 + i] = (Vector3){(float)i, (float)((i + j) % 2), (float)j};
+    Surface bezier = surface_bezier(control, 2, 2, MAX_SEGMENTS);
+    Vector3 c0 = surface_eval(&bezier, 0.0f, 0.0f), c1 = surface_eval(&bezier, 1.0f, 1.0f);
+    int corners = c0.x == 0.0f && c0.y == 0.0f && c0.z == 0.0f && c1.x == 3.0f && c1.y == 0.0f && c1.z == 3.0f;
+    run_test("2. Bezier patch interpolates its corner control points", corners, 1, &results[1]);
+
+    // ------------------------------ Uniform ------------------------------
+    Tessellation* tess = tessellation_create(&sphere);
+    if (!tess) {
+        print_summary(results, 2);
+        return 1;
+    }
+    Vector4* vertices = tess->mesh->vertices;
+    Triangle* triangles = tess->mesh->triangles;
+
+    surface_tessellate_uniform(&sphere, tess, 4);
+    int counts = tess->mesh->vertex_count == PATCHES * PATCHES * 25 &&
+                 tess->mesh->triangle_count == PATCHES * PATCHES * 32;
+    run_test("3. Uniform tessellation has the expected counts", counts, 1, &results[2]);
+
+    surface_tessellate_uniform(&sphere, tess, 1000);
+    int clamped = tess->levels[0] == MAX_SEGMENTS && tess->mesh->vertex_count == tess->vertex_capacity &&
+                  tess->mesh->triangle_count == tess->triangle_capacity;
+    run_test("4. Segments are clamped to the preallocated capacity", clamped, 1, &results[3]);
+
+    // ------------------------------ Adaptive ------------------------------
+    Transform transform = NO_TRANSFORM;
+    Projection proj = {M_PI / 3, (float)SCREEN_W / SCREEN_H, 0.1f, 1000.0f};
+    Camera far = {{0.0f, 0.0f, 200.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}};
+    Camera near = {{0.0f, 0.0f, 4.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}};
+
+    int rebuilt = surface_tessellate(&sphere, tess, transform, far, proj, SCREEN_W, SCREEN_H, TARGET_PX);
+    int far_triangles = tess->mesh->triangle_count;
+    int far_levels = powers_of_two(tess, PATCHES * PATCHES, MAX_SEGMENTS);
+    surface_tessellate(&sphere, tess, transform, near, proj, SCREEN_W, SCREEN_H, TARGET_PX);
+    int near_triangles = tess->mesh->triangle_count;
+    run_test("5. Closer views get more triangles", rebuilt && near_triangles > 4 * far_triangles, 1, &results[4]);
+
+    int levels = far_levels && powers_of_two(tess, PATCHES * PATCHES, MAX_SEGMENTS);
+    run_test("6. Levels are powers of two within bounds", levels, 1, &results[5]);
+
+    int reused = surface_tessellate(&sphere, tess, transform, near, proj, SCREEN_W, SCREEN_H, TARGET_PX) == 0 &&
+                 surface_tessellate(&sphere, tess, transform, near, proj, SCREEN_W, SCREEN_H, 2.0f) == 1;
+    run_test("7. Unchanged view reuses the tessellation", reused, 1, &results[6]);
+
+    run_test("8. Buffers are never reallocated",
+             tess->mesh->vertices == vertices && tess->mesh->triangles == triangles, 1, &results[7]);
+
+    // Torus seen from one side: near patches are finer than far ones
+    Surface torus = surface_torus(3.0f, 1.0f, PATCHES, PATCHES, MAX_SEGMENTS);
+    Tessellation* ring = tessellation_create(&torus);
+    Camera side = {{5.0f, 1.0f, 5.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}};
+    surface_tessellate(&torus, ring, transform, side, proj, SCREEN_W, SCREEN_H, TARGET_PX);
+    int mixed = 0, watertight = 1;
+    for (int j = 0; j < PATCHES; j++)
+        for (int i = 0; i < PATCHES; i++) {
+            int p = j * PATCHES + i;
+            int next_u = j * PATCHES + (i + 1) % PATCHES, next_v = ((j + 1) % PATCHES) * PATCHES + i;
+            mixed |= ring->levels[p] != ring->levels[next_u] || ring->levels[p] != ring->levels[next_v];
+            watertight &= edges_match(ring, p, 1, next_u, 0) && edges_match(ring, p, 3, next_v, 2);
+        }
+    run_test("9. Patches differ in level around the torus", mixed, 1, &results[8]);
+    run_test("10. Shared edges have no cracks (seams included)", watertight, 1, &results[9]);
+
+    print_summary(results, TOTAL_TESTS);
+
+    // ------------------------------ Garbage collect ------------------------------
+    tessellation_destroy(ring);
+    tessellation_destroy(tess);
+}
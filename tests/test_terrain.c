@@ -0,0 +1,125 @@
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "test_framework.h"
+#include "core/terrain.h"
+
+#define TOTAL_TESTS 10
+
+#define HEIGHT_FILE "test_terrain.bin"
+#define CELLS 16
+#define CHUNKS 8
+#define LEVELS 3
+#define SPACING 1.0f
+#define CACHE 12
+#define VIEW_DISTANCE 40.0f
+#define LOD_DISTANCE 8.0f
+#define WAIT_MS 2000
+#define FB_SIZE 64
+
+static float height_at(void* ctx, int x, int z) {
+    (void)ctx;
+    return 0.01f * x + 0.001f * z;
+}
+
+// Updates until every selected chunk is resident at its wanted level
+static int settle(Terrain* terrain, Vector3 eye) {
+    for (int waited = 0; waited < WAIT_MS; waited++) {
+        terrain_update(terrain, eye, NULL);
+        if (terrain->stats.missing == 0 && terrain->stats.fallbacks == 0 && terrain->stats.requested == 0)
+            return 1;
+        SDL_Delay(1);
+    }
+    return 0;
+}
+
+static int heights_match(const float* heights, int cx, int cz, int level) {
+    if (!heights) return 0;
+    int side = (CELLS >> level) + 1;
+    for (int j = 0; j < side; j++)
+        for (int i = 0; i < side; i++)
+            if (heights[j * side + i] != height_at(NULL, cx * CELLS + (i << level), cz * CELLS + (j << level)))
+                return 0;
+    return 1;
+}
+
+int main(void) {
+    TestResult results[TOTAL_TESTS];
+
+    int built = terrain_build_file(HEIGHT_FILE, CELLS, CHUNKS, CHUNKS, LEVELS, SPACING, height_at, NULL);
+    Terrain* terrain = built ? terrain_open(HEIGHT_FILE, CACHE, VIEW_DISTANCE, LOD_DISTANCE) : NULL;
+    int opened = terrain && terrain->chunks_x == CHUNKS && terrain->levels == LEVELS && terrain->cells == CELLS;
+    run_test("1. Height file is built and opened", opened, 1, &results[0]);
+
+    int rejected = terrain_build_file(HEIGHT_FILE ".bad", 12, 1, 1, 1, SPACING, height_at, NULL) == 0 &&
+                   terrain_open("missing.bin", CACHE, VIEW_DISTANCE, LOD_DISTANCE) == NULL;
+    run_test("2. Invalid parameters and missing files are rejected", rejected, 1, &results[1]);
+    if (!opened) {
+        print_summary(results, 2);
+        return 1;
+    }
+
+    // ------------------------------ Streaming ------------------------------
+    // Nothing is resident yet: the first frame queues loads and returns
+    Vector3 corner = {1.0f, 10.0f, 1.0f};
+    terrain_update(terrain, corner, NULL);
+    int async = terrain->stats.missing > 0 && terrain->stats.requested >= terrain->stats.missing &&
+                terrain->stats.hitches == 1 && terrain->visible_count == 0;
+    run_test("3. First frame does not wait for the disk", async, 1, &results[2]);
+
+    run_test("4. Chunks around the camera arrive", settle(terrain, corner), 1, &results[3]);
+
+    int lod = 1, nearest_level = -1, farthest_level = -1;
+    for (int v = 0; v < terrain->visible_count; v++) {
+        const TerrainVisible* vis = &terrain->visible[v];
+        int level = terrain->slots[vis->slot].level;
+        lod &= level == vis->wanted && (v == 0 || vis->distance >= terrain->visible[v - 1].distance);
+        if (v == 0) nearest_level = level;
+        farthest_level = level;
+    }
+    run_test("5. Coarser levels farther out", lod && nearest_level == 0 && farthest_level > 0, 1, &results[4]);
+
+    int exact = heights_match(terrain_chunk_heights(terrain, 0, 0, 0), 0, 0, 0);
+    int coarse = 0;
+    for (int v = 0; v < terrain->visible_count; v++) {
+        const TerrainChunk* chunk = &terrain->slots[terrain->visible[v].slot];
+        if (chunk->level > 0)
+            coarse = heights_match(terrain_chunk_heights(terrain, chunk->cx, chunk->cz, chunk->level),
+                                   chunk->cx, chunk->cz, chunk->level);
+    }
+    run_test("6. Streamed heights match the source", exact && coarse, 1, &results[5]);
+
+    run_test("7. Selection is capped by the cache size", terrain->visible_count <= CACHE, 1, &results[6]);
+
+    // Fly to the opposite corner: old chunks get evicted
+    Vector3 far = {CHUNKS * CELLS * SPACING - 1.0f, 10.0f, CHUNKS * CELLS * SPACING - 1.0f};
+    int moved = settle(terrain, far);
+    int last = CHUNKS - 1;
+    int evicted = moved && terrain->stats.evictions > 0 && terrain_chunk_heights(terrain, 0, 0, 0) == NULL &&
+                  heights_match(terrain_chunk_heights(terrain, last, last, 0), last, last, 0);
+    run_test("8. LRU slots are reused for new chunks", evicted, 1, &results[7]);
+
+    int latency = terrain->stats.loads >= terrain->stats.evictions && terrain->stats.errors == 0 &&
+                  terrain->stats.max_load_ms >= terrain->stats.total_load_ms / terrain->stats.loads;
+    run_test("9. Load latency is reported", latency, 1, &results[8]);
+
+    // ------------------------------ Rendering ------------------------------
+    Framebuffer* fb = framebuffer_create(FB_SIZE, FB_SIZE);
+    framebuffer_clear(fb, 0);
+    Camera cam = {far, {far.x - 20.0f, 0.0f, far.z - 20.0f}, {0.0f, 1.0f, 0.0f}};
+    Projection proj = {M_PI / 3, 1.0f, 0.1f, 200.0f};
+    terrain_render(terrain, fb, cam, proj, (Color){255, 255, 255, 255});
+    framebuffer_resolve(fb);
+    int drawn = 0;
+    for (int i = 0; i < FB_SIZE * FB_SIZE; i++)
+        drawn += fb->pixels[i] != 0;
+    run_test("10. Resident chunks are drawn", drawn > 0, 1, &results[9]);
+
+    print_summary(results, TOTAL_TESTS);
+
+    // ------------------------------ Garbage collect ------------------------------
+    framebuffer_destroy(fb);
+    terrain_close(terrain);
+    remove(HEIGHT_FILE);
+}
@@ -0,0 +1,133 @@
+#include <math.h>
+
+#include "test_framework.h"
+#include "core/renderer.h"
+
+#define TOTAL_TESTS 10
+
+#define TEX_W 32
+#define TEX_H 8
+#define SAMPLES 1003
+#define FB_SIZE 64
+
+static float random_uv(void) {
+    return (float)rand() / RAND_MAX * 6.0f - 3.0f; // wraps a few times both ways
+}
+
+static int channel_error(uint32_t a, uint32_t b) {
+    int err = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        int d = abs((int)((a >> shift) & 0xFF) - (int)((b >> shift) & 0xFF));
+        if (d > err) err = d;
+    }
+    return err;
+}
+
+int main(void) {
+    TestResult results[TOTAL_TESTS];
+
+    // Non-square, every texel different
+    uint32_t image[TEX_W * TEX_H];
+    for (int y = 0; y < TEX_H; y++)
+        for (int x = 0; x < TEX_W; x++)
+            image[y * TEX_W + x] = 0xFF000000u | (uint32_t)(x * 8) << 16 | (uint32_t)(y * 32) << 8 | (uint32_t)((x * 7 + y * 13) & 0xFF);
+
+    Texture* linear = texture_create(image, TEX_W, TEX_H, TEXTURE_LINEAR);
+    Texture* tiled = texture_create(image, TEX_W, TEX_H, TEXTURE_TILED);
+    Texture* morton = texture_create(image, TEX_W, TEX_H, TEXTURE_MORTON);
+    Texture* layouts[3] = {linear, tiled, morton};
+
+    // ------------------------------ Creation ------------------------------
+    int same = 1;
+    for (int t = 0; t < 3; t++)
+        for (int y = -2; y < TEX_H + 2; y++)
+            for (int x = -2; x < TEX_W + 2; x++)
+                same &= texture_fetch(layouts[t], 0, x, y) == image[((y + TEX_H) % TEX_H) * TEX_W + (x + TEX_W) % TEX_W];
+    run_test("1. Every layout stores the source image (wrapping)", same, 1, &results[0]);
+
+    int chain = linear->level_count == 6 && linear->levels[3].width == 4 && linear->levels[3].height == 1 &&
+                linear->levels[5].width == 1 && linear->levels[5].height == 1;
+    run_test("2. Mip chain halves down to 1x1", chain, 1, &results[1]);
+
+    // Green channel only depends on y: level 1 texel (0, 0) averages rows 0 and 1
+    int g = (texture_fetch(tiled, 1, 0, 0) >> 8) & 0xFF;
+    run_test("3. Mip levels are box filtered", g, 16, &results[2]);
+
+    int levels_match = 1;
+    for (int level = 1; level < linear->level_count; level++)
+        for (int y = 0; y < linear->levels[level].height; y++)
+            for (int x = 0; x < linear->levels[level].width; x++)
+                levels_match &= texture_fetch(linear, level, x, y) == texture_fetch(morton, level, x, y) &&
+                                texture_fetch(linear, level, x, y) == texture_fetch(tiled, level, x, y);
+    run_test("4. Mip levels match across layouts", levels_match, 1, &results[3]);
+
+    uint32_t three[3 * 4] = {0};
+    run_test("5. Non power of two is rejected", texture_create(three, 3, 4, TEXTURE_MORTON) == NULL, 1, &results[4]);
+
+    // ------------------------------ Sampling ------------------------------
+    srand(11);
+    float u[SAMPLES], v[SAMPLES];
+    for (int i = 0; i < SAMPLES; i++) {
+        u[i] = random_uv();
+        v[i] = random_uv();
+    }
+
+    uint32_t reference[SAMPLES], simd[SAMPLES];
+    int nearest_ok = 1, bilinear_worst = 0;
+    for (int t = 0; t < 3; t++)
+        for (int level = 0; level < 3; level++) {
+            texture_sample_scalar(layouts[t], u, v, SAMPLES, level, TEXTURE_NEAREST, reference);
+            texture_sample(layouts[t], u, v, SAMPLES, level, TEXTURE_NEAREST, simd);
+            for (int i = 0; i < SAMPLES; i++)
+                nearest_ok &= reference[i] == simd[i];
+
+            texture_sample_scalar(layouts[t], u, v, SAMPLES, level, TEXTURE_BILINEAR, reference);
+            texture_sample(layouts[t], u, v, SAMPLES, level, TEXTURE_BILINEAR, simd);
+            for (int i = 0; i < SAMPLES; i++) {
+                int err = channel_error(reference[i], simd[i]);
+                if (err > bilinear_worst) bilinear_worst = err;
+            }
+        }
+    run_test("6. SIMD nearest matches scalar", nearest_ok, 1, &results[5]);
+    run_test("7. SIMD bilinear matches scalar", bilinear_worst <= 1, 1, &results[6]);
+
+    // Halfway between texel centers (3, 2) and (4, 2): red is 28
+    float mid_u = 4.0f / TEX_W, mid_v = 2.5f / TEX_H;
+    uint32_t mid;
+    texture_sample(morton, &mid_u, &mid_v, 1, 0, TEXTURE_BILINEAR, &mid);
+    run_test("8. Bilinear blends neighbouring texels", (int)((mid >> 16) & 0xFF), 28, &results[7]);
+
+    // 1 texel per pixel -> 0, 4 texels -> 2, far away -> last level
+    int chosen = texture_select_level(linear, 1.0f / TEX_W, 0, 0, 1.0f / TEX_H) == 0 &&
+                 texture_select_level(linear, 4.0f / TEX_W, 0, 0, 0) == 2 &&
+                 texture_select_level(linear, 100.0f, 0, 0, 100.0f) == linear->level_count - 1;
+    run_test("9. Mip level follows UV derivatives", chosen, 1, &results[8]);
+
+    // ------------------------------ Perspective-correct raster ------------------------------
+    // Red = 4 * column on a 64x1 texture; the right edge is 3x farther (w = 3)
+    uint32_t ramp[64];
+    for (int x = 0; x < 64; x++)
+        ramp[x] = 0xFF000000u | (uint32_t)(x * 4) << 16;
+    Texture* stripes = texture_create(ramp, 64, 1, TEXTURE_TILED);
+
+    Framebuffer* fb = framebuffer_create(FB_SIZE, FB_SIZE);
+    framebuffer_clear(fb, 0);
+    framebuffer_clear_depth(fb);
+    float tx[3] = {0, 64, 0}, ty[3] = {0, 0, 64}, tz[3] = {0.5f, 0.5f, 0.5f};
+    float inv_w[3] = {1.0f, 1.0f / 3.0f, 1.0f}, tu[3] = {0, 1, 0}, tv[3] = {0, 0, 1};
+    framebuffer_fill_triangle_textured(fb, tx, ty, tz, inv_w, tu, tv, stripes, TEXTURE_NEAREST);
+    framebuffer_resolve(fb);
+
+    // Screen x = 32 on the top row is u = 0.25 (affine interpolation would give 0.5)
+    int column = (int)((fb->pixels[32] >> 16) & 0xFF) / 4;
+    run_test("10. Texture coordinates are perspective correct", abs(column - 16) <= 1, 1, &results[9]);
+
+    print_summary(results, TOTAL_TESTS);
+
+    // ------------------------------ Garbage collect ------------------------------
+    framebuffer_destroy(fb);
+    texture_destroy(stripes);
+    texture_destroy(linear);
+    texture_destroy(tiled);
+    texture_destroy(morton);
+}
@@ -3,7 +3,7 @@
 #include "test_framework.h"
 #include "math/vector.h"
 
-#define TOTAL_TESTS 7
+#define TOTAL_TESTS 12
 
 int main(void) {
     Vector3 u1 = {3, 4, 5};
@@ -58,5 +58,35 @@ int main(void) {
         ((Vector4){1 / v_n, 0, 0, -1 / v_n}),
         &results[6]);
 
+    // Vector4 operations (SIMD backed when available)
+    Vector4 a = {3, 4, 5, 1};
+    Vector4 b = {7, 8, 9, 2};
+
+    run_test("Add Vector4",
+        add(a, b),
+        add4_scalar(a, b),
+        &results[7]);
+
+    run_test("Dot Vector4",
+        dot(a, b),
+        dot4_scalar(a, b),
+        &results[8]);
+
+    run_test("Cross product Vector4",
+        cross(a, b),
+        ((Vector4){-4, 8, -4, 0}),
+        &results[9]);
+
+    // Fast normalize (approximate reciprocal square root)
+    run_test("Fast normalize 3D vector",
+        normalize_fast(u1),
+        normalize(u1),
+        &results[10]);
+
+    run_test("Fast normalize 4D vector",
+        normalize_fast(b),
+        normalize4_scalar(b),
+        &results[11]);
+
     print_summary(results, TOTAL_TESTS);
 }